@@ -1,5 +1,9 @@
 #include "Window.h"
 
+#include "rendering/opengl/OpenGLDeletionQueue.h"
+#include "rendering/opengl/OpenGLExtensions.h"
+#include "rendering/opengl/OpenGLUploadContext.h"
+
 #define GLFW_INCLUDE_NONE
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -53,6 +57,22 @@ bool Window::init(WindowSettings windowProps) {
         return -1;
     }
     
+    // Optional extensions are not covered by the core loader, so resolve them separately
+    OpenGLExtensions::load((GLADloadproc)glfwGetProcAddress);
+    
+    // A second context, sharing buffers and textures with this one, lets loader threads upload without stalling rendering
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    _uploadWindowPtr = glfwCreateWindow(1, 1, "", nullptr, _windowPtr);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (_uploadWindowPtr != nullptr) {
+        GLFWwindow* uploadWindow = _uploadWindowPtr;
+        OpenGLUploadContext::get()->start(
+            [uploadWindow]() { glfwMakeContextCurrent(uploadWindow); },
+            []() { glfwMakeContextCurrent(nullptr); });
+    } else {
+        std::cerr << "Failed to create upload context, uploading on the render thread." << std::endl;
+    }
+    
     glEnable(GL_DEPTH_TEST);
     
     // Set initial clear color
@@ -63,6 +83,18 @@ bool Window::init(WindowSettings windowProps) {
 
 void Window::shutdown() {
     
+    // The upload thread must let go of its context before the window holding it is destroyed
+    OpenGLUploadContext::get()->shutdown();
+    // Objects still waiting on frame fences are deleted while there is a context to delete them from
+    if (_windowPtr != nullptr) {
+        OpenGLDeletionQueue::get()->flush();
+    }
+    
+    if (_uploadWindowPtr != nullptr) {
+        glfwDestroyWindow(_uploadWindowPtr);
+        _uploadWindowPtr = nullptr;
+    }
+    
     if (_windowPtr != nullptr) {   
         glfwDestroyWindow(_windowPtr);
         _windowPtr = nullptr;
@@ -51,4 +51,7 @@ public:
 private:
     // Pointer to the underlying GLFW window
     GLFWwindow* _windowPtr;
+
+    // Hidden window whose context shares objects with the main one, made current on the upload thread
+    GLFWwindow* _uploadWindowPtr = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "AssetArchive.h"
+
+#include "core/Compression.h"
+#include "core/Hash.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+// "LFPK" - Lightframe pack
+static constexpr uint32_t ARCHIVE_MAGIC = 0x4B50464C;
+static constexpr uint32_t ARCHIVE_VERSION = 2;
+
+// Set on a chunk's stored size when the chunk didn't compress and is stored as it is
+static constexpr uint32_t RAW_CHUNK_FLAG = 0x80000000u;
+
+// Files start on page boundaries, so every blob is aligned however it is used
+static constexpr uint64_t ARCHIVE_ALIGNMENT = 4096;
+
+/**
+ * @brief Header written at the start of every archive, followed by the table of contents and then the names.
+ */
+struct ArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+};
+
+/**
+ * @brief Location of one file within an archive.
+ *
+ * A compressed file starts with the stored size of each of its chunks, followed by the chunks themselves.
+ */
+struct ArchiveTocEntry {
+    uint64_t nameHash;
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t size;
+    uint32_t chunkSize;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t reserved;
+};
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + ARCHIVE_ALIGNMENT - 1) & ~(ARCHIVE_ALIGNMENT - 1);
+}
+
+static size_t getChunkCount(uint64_t size, uint32_t chunkSize) {
+    return static_cast<size_t>(size / chunkSize + (size % chunkSize != 0 ? 1 : 0));
+}
+
+/**
+ * @brief Compresses a file in independent chunks, spread across the thread pool.
+ * @param data The contents of the file.
+ * @param chunkSize Uncompressed size of each chunk.
+ * @return std::vector<uint8_t> The table of chunk sizes followed by the chunks.
+ */
+static std::vector<uint8_t> compressChunks(std::span<const uint8_t> data, uint32_t chunkSize) {
+    const size_t chunkCount = getChunkCount(data.size(), chunkSize);
+    std::vector<std::vector<uint8_t>> chunks(chunkCount);
+    ThreadPool::get()->parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const std::span<const uint8_t> source = data.subspan(i * chunkSize, std::min<size_t>(chunkSize, data.size() - i * chunkSize));
+            chunks[i].resize(getCompressBound(source.size()));
+            const size_t compressedSize = compressBlock(source, chunks[i]);
+            if (compressedSize == 0 || compressedSize >= source.size()) {
+                chunks[i].clear();
+            } else {
+                chunks[i].resize(compressedSize);
+            }
+        }
+    });
+
+    std::vector<uint8_t> stored(chunkCount * sizeof(uint32_t));
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const std::span<const uint8_t> source = data.subspan(i * chunkSize, std::min<size_t>(chunkSize, data.size() - i * chunkSize));
+        const bool raw = chunks[i].empty();
+        const uint32_t storedSize = raw ? static_cast<uint32_t>(source.size()) | RAW_CHUNK_FLAG : static_cast<uint32_t>(chunks[i].size());
+        std::memcpy(stored.data() + i * sizeof(uint32_t), &storedSize, sizeof(storedSize));
+        if (raw) {
+            stored.insert(stored.end(), source.begin(), source.end());
+        } else {
+            stored.insert(stored.end(), chunks[i].begin(), chunks[i].end());
+        }
+    }
+    return stored;
+}
+
+bool writeAssetArchive(const std::string& path, const std::vector<AssetArchiveEntry>& entries, uint32_t chunkSize) {
+    std::vector<size_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<uint64_t> hashes(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        hashes[i] = hash64(entries[i].name);
+    }
+
+    // Sorting by hash lets lookups binary search; equal hashes are ordered by name so duplicates end up adjacent
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : entries[a].name < entries[b].name;
+    });
+    for (size_t i = 1; i < order.size(); ++i) {
+        if (entries[order[i]].name == entries[order[i - 1]].name) {
+            LOG_WARN("Archive {} lists {} more than once.", path, entries[order[i]].name);
+            return false;
+        }
+    }
+
+    // Compressed files are only kept if they save a worthwhile amount, as uncompressed files can be used in place
+    std::vector<std::vector<uint8_t>> compressed(entries.size());
+    if (chunkSize > 0) {
+        ThreadPool::get()->parallelFor(entries.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const std::vector<uint8_t>& data = entries[i].data;
+                if (!data.empty()) {
+                    compressed[i] = compressChunks(data, chunkSize);
+                    if (compressed[i].size() > data.size() - data.size() / 16) {
+                        compressed[i] = std::vector<uint8_t>();
+                    }
+                }
+            }
+        });
+    }
+
+    // Lay out the names after the table of contents, then each file on its own page boundary
+    std::vector<ArchiveTocEntry> toc;
+    toc.reserve(entries.size());
+    std::string names;
+    const uint64_t namesOffset = sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveTocEntry);
+    uint64_t storedBytes = 0;
+    uint64_t totalBytes = 0;
+    for (size_t index : order) {
+        const bool isCompressed = !compressed[index].empty();
+        toc.push_back(ArchiveTocEntry {
+            .nameHash = hashes[index],
+            .offset = 0,
+            .storedSize = isCompressed ? compressed[index].size() : entries[index].data.size(),
+            .size = entries[index].data.size(),
+            .chunkSize = isCompressed ? chunkSize : 0,
+            .nameOffset = static_cast<uint32_t>(names.size()),
+            .nameLength = static_cast<uint32_t>(entries[index].name.size()),
+            .reserved = 0
+        });
+        names += entries[index].name;
+        storedBytes += toc.back().storedSize;
+        totalBytes += toc.back().size;
+    }
+
+    uint64_t offset = alignOffset(namesOffset + names.size());
+    for (ArchiveTocEntry& entry : toc) {
+        entry.offset = offset;
+        offset = alignOffset(offset + entry.storedSize);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_WARN("Unable to open archive {} for writing.", path);
+        return false;
+    }
+
+    const ArchiveHeader header = {
+        .magic = ARCHIVE_MAGIC,
+        .version = ARCHIVE_VERSION,
+        .entryCount = static_cast<uint32_t>(entries.size()),
+        .reserved = 0,
+        .namesOffset = namesOffset,
+        .namesSize = names.size()
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(ArchiveTocEntry)));
+    file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    const std::vector<char> padding(ARCHIVE_ALIGNMENT, 0);
+    uint64_t written = namesOffset + names.size();
+    for (size_t i = 0; i < toc.size(); ++i) {
+        const std::vector<uint8_t>& data = toc[i].chunkSize > 0 ? compressed[order[i]] : entries[order[i]].data;
+        file.write(padding.data(), static_cast<std::streamsize>(toc[i].offset - written));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        written = toc[i].offset + data.size();
+    }
+
+    if (chunkSize > 0) {
+        LOG_INFO("Compressed {} bytes of files in {} to {} bytes.", totalBytes, path, storedBytes);
+    }
+    return file.good();
+}
+
+AssetArchive::AssetArchive(std::shared_ptr<MappedFile> mapping) : _mapping(std::move(mapping)) {}
+
+std::unique_ptr<AssetArchive> AssetArchive::open(const std::string& path) {
+    std::shared_ptr<MappedFile> mapping = MappedFile::open(path);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    ArchiveHeader header = {};
+    if (mapping->getSize() >= sizeof(header)) {
+        std::memcpy(&header, mapping->getData(), sizeof(header));
+    }
+
+    const uint64_t tocEnd = sizeof(header) + static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveTocEntry);
+    if (header.magic != ARCHIVE_MAGIC || header.version != ARCHIVE_VERSION || header.namesOffset != tocEnd ||
+        header.namesOffset + header.namesSize > mapping->getSize()) {
+        LOG_WARN("Archive {} is not a valid version {} archive.", path, ARCHIVE_VERSION);
+        return nullptr;
+    }
+
+    std::unique_ptr<AssetArchive> archive(new AssetArchive(std::move(mapping)));
+    const uint8_t* base = archive->_mapping->getData();
+    archive->_toc = reinterpret_cast<const ArchiveTocEntry*>(base + sizeof(header));
+    archive->_entryCount = header.entryCount;
+    archive->_names = reinterpret_cast<const char*>(base + header.namesOffset);
+
+    // Check every entry once up front, so lookups can trust the table
+    for (size_t i = 0; i < archive->_entryCount; ++i) {
+        const ArchiveTocEntry& entry = archive->_toc[i];
+        const bool validStorage = entry.chunkSize == 0
+            ? entry.storedSize == entry.size
+            : getChunkCount(entry.size, entry.chunkSize) * sizeof(uint32_t) <= entry.storedSize;
+        if (!validStorage || entry.offset + entry.storedSize > archive->_mapping->getSize() ||
+            static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize ||
+            (i > 0 && entry.nameHash < archive->_toc[i - 1].nameHash)) {
+            LOG_WARN("Archive {} has an invalid table of contents.", path);
+            return nullptr;
+        }
+    }
+
+    LOG_INFO("Mapped archive {} with {} files.", path, archive->_entryCount);
+    return archive;
+}
+
+bool AssetArchive::find(std::string_view name, AssetBlob& blob) const {
+    AssetArchiveFile file;
+    return locate(name, file) && read(file, blob);
+}
+
+bool AssetArchive::locate(std::string_view name, AssetArchiveFile& file) const {
+    const uint64_t nameHash = hash64(name);
+    const ArchiveTocEntry* end = _toc + _entryCount;
+    const ArchiveTocEntry* it = std::lower_bound(_toc, end, nameHash,
+        [](const ArchiveTocEntry& entry, uint64_t hash) { return entry.nameHash < hash; });
+
+    // Colliding names sit next to each other, so only the run with a matching hash needs comparing
+    for (; it != end && it->nameHash == nameHash; ++it) {
+        if (std::string_view(_names + it->nameOffset, it->nameLength) == name) {
+            file.stored = std::span<const uint8_t>(_mapping->getData() + it->offset, it->storedSize);
+            file.size = it->size;
+            file.chunkSize = it->chunkSize;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetArchive::read(const AssetArchiveFile& file, AssetBlob& blob) const {
+    if (!file.isCompressed()) {
+        blob.data = file.stored;
+        blob.owner = _mapping;
+        return true;
+    }
+
+    auto contents = std::make_shared<std::vector<uint8_t>>(file.size);
+    if (!decompress(file, *contents)) {
+        return false;
+    }
+    blob.data = std::span<const uint8_t>(contents->data(), contents->size());
+    blob.owner = std::move(contents);
+    return true;
+}
+
+bool AssetArchive::decompress(const AssetArchiveFile& file, std::span<uint8_t> destination) const {
+    if (destination.size() != file.size) {
+        return false;
+    }
+    if (!file.isCompressed()) {
+        std::memcpy(destination.data(), file.stored.data(), destination.size());
+        return true;
+    }
+
+    // Find where each chunk starts up front, so they can be decompressed in any order
+    const size_t chunkCount = getChunkCount(file.size, file.chunkSize);
+    std::vector<size_t> chunkOffsets(chunkCount + 1);
+    chunkOffsets[0] = chunkCount * sizeof(uint32_t);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        uint32_t storedSize;
+        std::memcpy(&storedSize, file.stored.data() + i * sizeof(uint32_t), sizeof(storedSize));
+        chunkOffsets[i + 1] = chunkOffsets[i] + (storedSize & ~RAW_CHUNK_FLAG);
+    }
+    if (chunkOffsets[chunkCount] != file.stored.size()) {
+        LOG_WARN("Archive {} has a compressed file with an invalid chunk table.", getPath());
+        return false;
+    }
+
+    std::atomic<bool> valid = true;
+    ThreadPool::get()->parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const std::span<const uint8_t> source = file.stored.subspan(chunkOffsets[i], chunkOffsets[i + 1] - chunkOffsets[i]);
+            const std::span<uint8_t> chunk = destination.subspan(i * file.chunkSize, std::min<size_t>(file.chunkSize, destination.size() - i * file.chunkSize));
+
+            uint32_t storedSize;
+            std::memcpy(&storedSize, file.stored.data() + i * sizeof(uint32_t), sizeof(storedSize));
+            if ((storedSize & RAW_CHUNK_FLAG) != 0) {
+                if (source.size() != chunk.size()) {
+                    valid.store(false, std::memory_order_relaxed);
+                    continue;
+                }
+                std::memcpy(chunk.data(), source.data(), chunk.size());
+            } else if (!decompressBlock(source, chunk)) {
+                valid.store(false, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    if (!valid.load(std::memory_order_relaxed)) {
+        LOG_WARN("Archive {} has a corrupt compressed file.", getPath());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file AssetArchive.h
+ * @author Justin McKay
+ * @brief Memory-mapped .lfpak archives of cooked asset blobs.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include "platform/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ArchiveTocEntry;
+
+/**
+ * @brief A file to pack into an archive.
+ */
+struct AssetArchiveEntry {
+    std::string name;               ///< Path of the file relative to the archive's mount point, using '/' separators
+    std::vector<uint8_t> data;      ///< Contents of the file
+};
+
+/**
+ * @brief The contents of a file, read from an archive, a mapped file or memory. The data stays valid for as long as
+ * the blob is held.
+ */
+struct AssetBlob {
+    std::span<const uint8_t> data;      ///< Contents of the file
+    std::shared_ptr<const void> owner;  ///< Keeps the mapping or buffer the data points into alive
+
+    /**
+     * @brief Gets a pointer into the blob that shares ownership of its storage.
+     * @param offset Byte offset into the blob.
+     * @return std::shared_ptr<const uint8_t> Pointer to the data at the offset.
+     */
+    std::shared_ptr<const uint8_t> share(size_t offset = 0) const {
+        return std::shared_ptr<const uint8_t>(owner, data.data() + offset);
+    }
+};
+
+/**
+ * @brief Default uncompressed size of each independently compressed chunk of an archived file.
+ */
+constexpr uint32_t ASSET_ARCHIVE_CHUNK_SIZE = 128 * 1024;
+
+/**
+ * @brief Where a file is stored within a mapped archive, and how.
+ */
+struct AssetArchiveFile {
+    std::span<const uint8_t> stored;    ///< Bytes of the file within the mapping, compressed or not
+    uint64_t size = 0;                  ///< Size of the file once decompressed
+    uint32_t chunkSize = 0;             ///< Uncompressed size of each compressed chunk, or 0 if stored uncompressed
+
+    /**
+     * @brief Checks whether the file must be decompressed before use, rather than used in place.
+     */
+    bool isCompressed() const { return chunkSize != 0; }
+};
+
+/**
+ * @brief Writes files into a .lfpak archive.
+ *
+ * The archive starts with a table of contents sorted by the hash of each name, followed by the names, followed by
+ * the file contents. Every file starts on a 4 KiB boundary, so blobs are page aligned when mapped.
+ *
+ * Files are split into chunks that are compressed independently, so they can be decompressed in parallel. Files
+ * that compression barely shrinks are stored as they are, so they can still be used in place.
+ *
+ * @param path The path of the archive to write.
+ * @param entries The files to pack. Names must be unique.
+ * @param chunkSize Uncompressed size of each chunk, or 0 to store every file uncompressed.
+ * @return true if the archive was written.
+ */
+bool writeAssetArchive(const std::string& path, const std::vector<AssetArchiveEntry>& entries,
+    uint32_t chunkSize = ASSET_ARCHIVE_CHUNK_SIZE);
+
+/**
+ * @brief A memory-mapped .lfpak archive.
+ *
+ * Opening an archive maps it and validates its table of contents; nothing else is read until a blob is used. Blobs
+ * of uncompressed files point straight into the mapping, so cooked data can be uploaded without being copied or
+ * parsed first, and a whole archive of assets costs a single open(). Compressed files are decompressed across the
+ * thread pool, one chunk per task.
+ */
+class AssetArchive {
+public:
+
+    /**
+     * @brief Maps an archive.
+     * @param path The path of the .lfpak file.
+     * @return std::unique_ptr<AssetArchive> The archive, or nullptr if it could not be mapped or is invalid.
+     */
+    static std::unique_ptr<AssetArchive> open(const std::string& path);
+
+    /**
+     * @brief Looks up a file by name and reads it, decompressing it if it is compressed.
+     * @param name Path of the file relative to the archive root.
+     * @param blob Receives the contents of the file.
+     * @return true if the archive contains the file and it could be read.
+     */
+    bool find(std::string_view name, AssetBlob& blob) const;
+
+    /**
+     * @brief Looks up where a file is stored, without reading it.
+     * @param name Path of the file relative to the archive root.
+     * @param file Receives the location of the file.
+     * @return true if the archive contains the file.
+     */
+    bool locate(std::string_view name, AssetArchiveFile& file) const;
+
+    /**
+     * @brief Reads a located file: a view of the mapping if it is uncompressed, otherwise a new buffer holding it
+     * decompressed.
+     * @param file The location of the file in this archive.
+     * @param blob Receives the contents of the file.
+     * @return true if the file could be read.
+     */
+    bool read(const AssetArchiveFile& file, AssetBlob& blob) const;
+
+    /**
+     * @brief Decompresses a located file into memory the caller provides, such as a mapped staging buffer, spreading
+     * its chunks across the thread pool.
+     * @param file The location of the file in this archive.
+     * @param destination Receives the file. Must be exactly the file's decompressed size.
+     * @return true if the file was valid and decompressed.
+     */
+    bool decompress(const AssetArchiveFile& file, std::span<uint8_t> destination) const;
+
+    /**
+     * @brief Gets the number of files in the archive.
+     */
+    size_t getEntryCount() const { return _entryCount; }
+
+    /**
+     * @brief Gets the path of the archive file.
+     */
+    const std::string& getPath() const { return _mapping->getPath(); }
+
+    /**
+     * @brief Gets the mapping of the archive file, which every blob points into.
+     */
+    const MappedFile& getMapping() const { return *_mapping; }
+
+private:
+    explicit AssetArchive(std::shared_ptr<MappedFile> mapping);
+
+    // The mapped archive file
+    std::shared_ptr<MappedFile> _mapping;
+
+    // Table of contents within the mapping, sorted by name hash
+    const ArchiveTocEntry* _toc = nullptr;
+    size_t _entryCount = 0;
+
+    // Names of the files within the mapping, referenced by the table of contents
+    const char* _names = nullptr;
+};
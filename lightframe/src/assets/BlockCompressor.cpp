@@ -0,0 +1,357 @@
+#include "BlockCompressor.h"
+
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LF_BC_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Approximate number of blocks encoded per thread pool task
+static constexpr size_t BLOCKS_PER_TASK = 512;
+
+// The 16 pixels of a 4x4 block as RGBA, row by row
+using Block = std::array<uint8_t, 64>;
+
+using BlockEncoder = void (*)(const Block& block, uint8_t* output);
+
+/**
+ * @brief Packs 128 bits of a BC7 block, least significant bit first.
+ */
+struct BitWriter {
+    uint64_t bits[2] = {};
+    uint32_t position = 0;
+
+    void write(uint32_t value, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i, ++position) {
+            bits[position / 64] |= static_cast<uint64_t>((value >> i) & 1) << (position % 64);
+        }
+    }
+};
+
+/**
+ * @brief Copies a 4x4 block of pixels into RGBA, repeating edge pixels where the block overhangs the level.
+ */
+static void loadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+    uint32_t blockX, uint32_t blockY, Block& block) {
+
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+            const uint8_t* source = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * channels;
+            uint8_t* target = block.data() + (y * 4 + x) * 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                target[c] = c < channels ? source[c] : (c == 3 ? 255 : 0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds the per-channel minimum and maximum of a block.
+ */
+static void findBlockRange(const Block& block, uint8_t minColor[4], uint8_t maxColor[4]) {
+#ifdef LF_BC_SSE2
+    const auto* rows = reinterpret_cast<const __m128i*>(block.data());
+    const __m128i row0 = _mm_loadu_si128(rows);
+    const __m128i row1 = _mm_loadu_si128(rows + 1);
+    const __m128i row2 = _mm_loadu_si128(rows + 2);
+    const __m128i row3 = _mm_loadu_si128(rows + 3);
+
+    __m128i minimum = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+    __m128i maximum = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+
+    // Fold the four pixels of each row down to one
+    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 8));
+    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 4));
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 8));
+    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 4));
+
+    const int packedMin = _mm_cvtsi128_si32(minimum);
+    const int packedMax = _mm_cvtsi128_si32(maximum);
+    std::memcpy(minColor, &packedMin, 4);
+    std::memcpy(maxColor, &packedMax, 4);
+#else
+    for (int c = 0; c < 4; ++c) {
+        minColor[c] = 255;
+        maxColor[c] = 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            minColor[c] = std::min(minColor[c], block[i * 4 + c]);
+            maxColor[c] = std::max(maxColor[c], block[i * 4 + c]);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Shrinks a bounding box by 1/16 of its size on each side, which lowers the average error of the palette.
+ */
+static void insetRange(uint8_t minColor[4], uint8_t maxColor[4], int channelCount) {
+    for (int c = 0; c < channelCount; ++c) {
+        const int inset = (maxColor[c] - minColor[c]) >> 4;
+        minColor[c] = static_cast<uint8_t>(minColor[c] + inset);
+        maxColor[c] = static_cast<uint8_t>(maxColor[c] - inset);
+    }
+}
+
+static uint16_t packRgb565(const uint8_t color[4]) {
+    return static_cast<uint16_t>(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+}
+
+static void unpackRgb565(uint16_t packed, int color[3]) {
+    const int r = (packed >> 11) & 31;
+    const int g = (packed >> 5) & 63;
+    const int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+static void writeUint16(uint8_t* output, uint16_t value) {
+    output[0] = static_cast<uint8_t>(value);
+    output[1] = static_cast<uint8_t>(value >> 8);
+}
+
+/**
+ * @brief Encodes the RGB of a block as an 8-byte BC1 colour block, always in four-colour mode.
+ */
+static void encodeColorBlock(const Block& block, uint8_t* output) {
+    uint8_t minColor[4];
+    uint8_t maxColor[4];
+    findBlockRange(block, minColor, maxColor);
+    insetRange(minColor, maxColor, 3);
+
+    // Every field of the maximum is at least that of the minimum, so color0 >= color1 (four-colour mode)
+    const uint16_t color0 = packRgb565(maxColor);
+    const uint16_t color1 = packRgb565(minColor);
+    writeUint16(output, color0);
+    writeUint16(output + 2, color1);
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int endpoint0[3];
+        int endpoint1[3];
+        unpackRgb565(color0, endpoint0);
+        unpackRgb565(color1, endpoint1);
+
+        const int axis[3] = { endpoint1[0] - endpoint0[0], endpoint1[1] - endpoint0[1], endpoint1[2] - endpoint0[2] };
+        const int lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+        // Palette order along the axis is color0, color2, color3, color1
+        static constexpr uint32_t POSITION_TO_INDEX[4] = { 0, 2, 3, 1 };
+
+        for (int i = 0; i < 16; ++i) {
+            const uint8_t* pixel = block.data() + i * 4;
+            const int projection = (pixel[0] - endpoint0[0]) * axis[0] + (pixel[1] - endpoint0[1]) * axis[1]
+                + (pixel[2] - endpoint0[2]) * axis[2];
+            const int position = std::clamp((projection * 6 + lengthSquared) / (lengthSquared * 2), 0, 3);
+            indices |= POSITION_TO_INDEX[position] << (i * 2);
+        }
+    }
+
+    output[4] = static_cast<uint8_t>(indices);
+    output[5] = static_cast<uint8_t>(indices >> 8);
+    output[6] = static_cast<uint8_t>(indices >> 16);
+    output[7] = static_cast<uint8_t>(indices >> 24);
+}
+
+/**
+ * @brief Encodes one channel of a block as an 8-byte BC4 block, in eight-value mode.
+ */
+static void encodeChannelBlock(const Block& block, int channel, uint8_t* output) {
+    uint8_t maxValue = 0;
+    uint8_t minValue = 255;
+    for (int i = 0; i < 16; ++i) {
+        maxValue = std::max(maxValue, block[i * 4 + channel]);
+        minValue = std::min(minValue, block[i * 4 + channel]);
+    }
+
+    output[0] = maxValue;
+    output[1] = minValue;
+
+    uint64_t indices = 0;
+    if (maxValue != minValue) {
+        const int range = maxValue - minValue;
+        for (int i = 0; i < 16; ++i) {
+            // Position 0 is the maximum and 7 the minimum; indices 0 and 1 are the endpoints, 2-7 the values between
+            const int position = ((maxValue - block[i * 4 + channel]) * 14 + range) / (range * 2);
+            const uint64_t index = position == 0 ? 0 : position == 7 ? 1 : position + 1;
+            indices |= index << (i * 3);
+        }
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        output[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+}
+
+static void encodeBlockBC1(const Block& block, uint8_t* output) {
+    encodeColorBlock(block, output);
+}
+
+static void encodeBlockBC3(const Block& block, uint8_t* output) {
+    encodeChannelBlock(block, 3, output);
+    encodeColorBlock(block, output + 8);
+}
+
+static void encodeBlockBC4(const Block& block, uint8_t* output) {
+    encodeChannelBlock(block, 0, output);
+}
+
+static void encodeBlockBC5(const Block& block, uint8_t* output) {
+    encodeChannelBlock(block, 0, output);
+    encodeChannelBlock(block, 1, output + 8);
+}
+
+/**
+ * @brief Quantizes an endpoint to 7 bits per channel plus a shared p-bit, picking the p-bit with the lower error.
+ */
+static void quantizeEndpointBC7(const uint8_t color[4], uint8_t quantized[4], uint32_t& pBit) {
+    int bestError = -1;
+    for (uint32_t p = 0; p < 2; ++p) {
+        int error = 0;
+        uint8_t candidate[4];
+        for (int c = 0; c < 4; ++c) {
+            candidate[c] = static_cast<uint8_t>(std::clamp((color[c] - static_cast<int>(p) + 1) >> 1, 0, 127));
+            const int difference = ((candidate[c] << 1) | p) - color[c];
+            error += difference * difference;
+        }
+        if (bestError < 0 || error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::copy(candidate, candidate + 4, quantized);
+        }
+    }
+}
+
+/**
+ * @brief Encodes a block as a 16-byte BC7 mode 6 block.
+ */
+static void encodeBlockBC7(const Block& block, uint8_t* output) {
+    uint8_t minColor[4];
+    uint8_t maxColor[4];
+    findBlockRange(block, minColor, maxColor);
+    insetRange(minColor, maxColor, 4);
+
+    uint8_t quantized[2][4];
+    uint32_t pBits[2];
+    quantizeEndpointBC7(minColor, quantized[0], pBits[0]);
+    quantizeEndpointBC7(maxColor, quantized[1], pBits[1]);
+
+    int endpoints[2][4];
+    for (int e = 0; e < 2; ++e) {
+        for (int c = 0; c < 4; ++c) {
+            endpoints[e][c] = (quantized[e][c] << 1) | pBits[e];
+        }
+    }
+
+    int axis[4];
+    int lengthSquared = 0;
+    for (int c = 0; c < 4; ++c) {
+        axis[c] = endpoints[1][c] - endpoints[0][c];
+        lengthSquared += axis[c] * axis[c];
+    }
+
+    uint32_t indices[16] = {};
+    if (lengthSquared > 0) {
+        for (int i = 0; i < 16; ++i) {
+            const uint8_t* pixel = block.data() + i * 4;
+            int projection = 0;
+            for (int c = 0; c < 4; ++c) {
+                projection += (pixel[c] - endpoints[0][c]) * axis[c];
+            }
+            indices[i] = static_cast<uint32_t>(std::clamp((projection * 30 + lengthSquared) / (lengthSquared * 2), 0, 15));
+        }
+    }
+
+    // The first index is stored with its top bit implied to be zero, so flip the block if it needs that bit
+    if (indices[0] >= 8) {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pBits[0], pBits[1]);
+        for (uint32_t& index : indices) {
+            index = 15 - index;
+        }
+    }
+
+    BitWriter writer;
+    writer.write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.write(quantized[0][c], 7);
+        writer.write(quantized[1][c], 7);
+    }
+    writer.write(pBits[0], 1);
+    writer.write(pBits[1], 1);
+    writer.write(indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.write(indices[i], 4);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        output[i] = static_cast<uint8_t>(writer.bits[i / 8] >> ((i % 8) * 8));
+    }
+}
+
+static BlockEncoder getBlockEncoder(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::BC1: return encodeBlockBC1;
+        case ImageFormat::BC3: return encodeBlockBC3;
+        case ImageFormat::BC4: return encodeBlockBC4;
+        case ImageFormat::BC5: return encodeBlockBC5;
+        case ImageFormat::BC7: return encodeBlockBC7;
+        default: return nullptr;
+    }
+}
+
+Image compressImage(const Image& image, ImageFormat format) {
+    const BlockEncoder encoder = getBlockEncoder(format);
+    if (!encoder || isCompressedFormat(image.format) || image.channels == 0 || image.mips.empty()) {
+        LOG_WARN("Unable to block-compress image: unsupported source or target format.");
+        return Image();
+    }
+
+    Image result;
+    result.width = image.width;
+    result.height = image.height;
+    result.channels = image.channels;
+    result.format = format;
+    result.srgb = image.srgb;
+
+    const uint32_t blockBytes = getBlockBytes(format);
+    size_t offset = 0;
+    for (const ImageMip& mip : image.mips) {
+        const size_t size = static_cast<size_t>((mip.width + 3) / 4) * ((mip.height + 3) / 4) * blockBytes;
+        result.mips.push_back(ImageMip { .width = mip.width, .height = mip.height, .offset = offset, .size = size });
+        offset += size;
+    }
+    result.data.resize(offset);
+
+    for (uint32_t level = 0; level < image.getMipCount(); ++level) {
+        const ImageMip& mip = image.mips[level];
+        const uint8_t* pixels = image.getMipData(level);
+        uint8_t* blocks = result.getMipData(level);
+
+        const uint32_t blocksWide = (mip.width + 3) / 4;
+        const uint32_t blocksHigh = (mip.height + 3) / 4;
+        const size_t rowsPerTask = std::max<size_t>(1, BLOCKS_PER_TASK / blocksWide);
+
+        ThreadPool::get()->parallelFor(blocksHigh, rowsPerTask, [&](size_t firstRow, size_t lastRow) {
+            Block block;
+            for (size_t blockY = firstRow; blockY < lastRow; ++blockY) {
+                for (uint32_t blockX = 0; blockX < blocksWide; ++blockX) {
+                    loadBlock(pixels, mip.width, mip.height, image.channels, blockX, static_cast<uint32_t>(blockY), block);
+                    encoder(block, blocks + (blockY * blocksWide + blockX) * blockBytes);
+                }
+            }
+        });
+    }
+
+    return result;
+}
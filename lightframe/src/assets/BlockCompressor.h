@@ -0,0 +1,25 @@
+/**
+ * @file BlockCompressor.h
+ * @author Justin McKay
+ * @brief CPU encoder for BC1, BC3, BC4, BC5 and BC7 block-compressed textures.
+ * @date 2026-03-13
+ */
+
+#pragma once
+
+#include "rendering/Image.h"
+
+/**
+ * @brief Encodes an image, including every mip level, into a block-compressed format.
+ *
+ * Blocks are encoded in parallel on the engine thread pool, with SSE2 used for the endpoint search. Partial blocks at
+ * the edges of levels that aren't a multiple of 4 pixels repeat the edge pixels. The encoder favours speed:
+ * - BC1/BC3 colour uses an inset bounding box with indices projected onto the endpoint axis.
+ * - BC4/BC5 channels use their exact range in 8-value mode.
+ * - BC7 uses mode 6 only (single subset, RGBA endpoints with p-bits, 4-bit indices).
+ *
+ * @param image The uncompressed (RGB8 or RGBA8) source image, with any mips already generated.
+ * @param format The compressed format to encode to.
+ * @return Image The compressed image, with the same mip layout. Empty if the source can't be encoded.
+ */
+Image compressImage(const Image& image, ImageFormat format);
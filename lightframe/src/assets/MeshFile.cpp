@@ -0,0 +1,162 @@
+#include "MeshFile.h"
+
+#include "assets/VirtualFileSystem.h"
+#include "core/Logger.h"
+
+#include <cstring>
+#include <fstream>
+
+// "LFMS" - Lightframe mesh
+static constexpr uint32_t MESH_FILE_MAGIC = 0x534D464C;
+static constexpr uint32_t MESH_FILE_VERSION = 1;
+
+/**
+ * @brief Header written at the start of every cooked mesh file, followed by a MeshFileElement per attribute, the
+ * vertex data padded to a multiple of 4 bytes, and then the indices.
+ */
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t elementCount;
+    uint32_t stride;
+    float boundsMin[3];
+    float boundsMax[3];
+    float radius;
+    float uvDensity;
+};
+
+/**
+ * @brief One vertex attribute of a cooked mesh file.
+ */
+struct MeshFileElement {
+    char name[32];
+    uint32_t dataType;
+    uint32_t normalised;
+};
+
+static size_t alignToFour(size_t size) {
+    return (size + 3) & ~size_t(3);
+}
+
+/**
+ * @brief Checks a mesh file header and its attributes, and builds the vertex layout they describe.
+ * @return true if the header is valid and its stride matches the layout.
+ */
+static bool readLayout(const MeshFileHeader& header, const MeshFileElement* elements, const std::string& path,
+    BufferLayout& layout, MeshBounds& bounds) {
+    if (header.magic != MESH_FILE_MAGIC || header.version != MESH_FILE_VERSION) {
+        LOG_WARN("Mesh file {} is not a valid version {} mesh.", path, MESH_FILE_VERSION);
+        return false;
+    }
+
+    std::vector<BufferElement> bufferElements;
+    bufferElements.reserve(header.elementCount);
+    for (uint32_t i = 0; i < header.elementCount; ++i) {
+        const MeshFileElement& element = elements[i];
+        if (element.dataType < static_cast<uint32_t>(ShaderDataType::Float) ||
+            element.dataType > static_cast<uint32_t>(ShaderDataType::UByte4) ||
+            std::memchr(element.name, '\0', sizeof(element.name)) == nullptr) {
+            LOG_WARN("Mesh file {} has an invalid vertex attribute.", path);
+            return false;
+        }
+        bufferElements.emplace_back(element.name, static_cast<ShaderDataType>(element.dataType), element.normalised != 0);
+    }
+
+    layout = BufferLayout(std::move(bufferElements));
+    if (layout.getStride() != header.stride) {
+        LOG_WARN("Mesh file {} has a vertex stride that does not match its attributes.", path);
+        return false;
+    }
+
+    bounds.min = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    bounds.max = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    bounds.radius = header.radius;
+    bounds.uvDensity = header.uvDensity;
+    return true;
+}
+
+bool writeMeshFile(const std::string& path, const MeshData& mesh) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_WARN("Unable to open mesh file {} for writing.", path);
+        return false;
+    }
+
+    const MeshFileHeader header = {
+        .magic = MESH_FILE_MAGIC,
+        .version = MESH_FILE_VERSION,
+        .vertexCount = mesh.getVertexCount(),
+        .indexCount = static_cast<uint32_t>(mesh.indices.size()),
+        .elementCount = static_cast<uint32_t>(mesh.layout.getElements().size()),
+        .stride = mesh.layout.getStride(),
+        .boundsMin = { mesh.bounds.min.x, mesh.bounds.min.y, mesh.bounds.min.z },
+        .boundsMax = { mesh.bounds.max.x, mesh.bounds.max.y, mesh.bounds.max.z },
+        .radius = mesh.bounds.radius,
+        .uvDensity = mesh.bounds.uvDensity
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const BufferElement& element : mesh.layout) {
+        MeshFileElement fileElement = {};
+        std::strncpy(fileElement.name, element.name.c_str(), sizeof(fileElement.name) - 1);
+        fileElement.dataType = static_cast<uint32_t>(element.dataType);
+        fileElement.normalised = element.normalised ? 1 : 0;
+        file.write(reinterpret_cast<const char*>(&fileElement), sizeof(fileElement));
+    }
+
+    // Pad the vertices so the indices that follow stay 4 byte aligned
+    const size_t vertexBytes = static_cast<size_t>(header.vertexCount) * header.stride;
+    const uint32_t zero = 0;
+    file.write(reinterpret_cast<const char*>(mesh.vertices.data()), static_cast<std::streamsize>(vertexBytes));
+    file.write(reinterpret_cast<const char*>(&zero), static_cast<std::streamsize>(alignToFour(vertexBytes) - vertexBytes));
+    file.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+    return file.good();
+}
+
+bool readMeshFile(const std::string& path, MeshData& mesh) {
+    AssetBlob blob;
+    return VirtualFileSystem::get()->read(path, blob) && readMeshFile(blob.data, path, mesh);
+}
+
+bool readMeshFile(std::span<const uint8_t> data, const std::string& path, MeshData& mesh) {
+    MeshFileView view;
+    if (!readMeshFile(data, path, view)) {
+        return false;
+    }
+
+    mesh = MeshData();
+    mesh.layout = view.layout;
+    mesh.vertices.assign(view.vertices.begin(), view.vertices.end());
+    mesh.indices.assign(view.indices.begin(), view.indices.end());
+    mesh.bounds = view.bounds;
+    return true;
+}
+
+bool readMeshFile(std::span<const uint8_t> data, const std::string& path, MeshFileView& view) {
+    MeshFileHeader header = {};
+    if (data.size() < sizeof(header)) {
+        LOG_WARN("Mesh file {} is truncated.", path);
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const size_t elementsEnd = sizeof(header) + static_cast<size_t>(header.elementCount) * sizeof(MeshFileElement);
+    const size_t vertexBytes = static_cast<size_t>(header.vertexCount) * header.stride;
+    const size_t indicesOffset = alignToFour(elementsEnd + vertexBytes);
+    if (data.size() < indicesOffset + static_cast<size_t>(header.indexCount) * sizeof(uint32_t)) {
+        LOG_WARN("Mesh file {} is truncated.", path);
+        return false;
+    }
+
+    std::vector<MeshFileElement> elements(header.elementCount);
+    std::memcpy(elements.data(), data.data() + sizeof(header), elements.size() * sizeof(MeshFileElement));
+    if (!readLayout(header, elements.data(), path, view.layout, view.bounds)) {
+        return false;
+    }
+
+    view.vertices = data.subspan(elementsEnd, vertexBytes);
+    view.indices = std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(data.data() + indicesOffset), header.indexCount);
+    return true;
+}
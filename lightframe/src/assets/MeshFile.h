@@ -0,0 +1,58 @@
+/**
+ * @file MeshFile.h
+ * @author Justin McKay
+ * @brief Reading and writing of cooked .lfmesh meshes, which store vertices and indices ready for upload.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include "rendering/MeshData.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ * @brief A cooked mesh read in place from memory, such as a blob in a mapped archive.
+ */
+struct MeshFileView {
+    BufferLayout layout;                    ///< Attributes of each vertex
+    std::span<const uint8_t> vertices;      ///< Interleaved vertex data, pointing into the file
+    std::span<const uint32_t> indices;      ///< Triangle list indices, pointing into the file
+    MeshBounds bounds;                      ///< Bounds measured when the mesh was cooked
+};
+
+/**
+ * @brief Writes a mesh to a cooked mesh file.
+ * @param path The path of the .lfmesh file to write.
+ * @param mesh The mesh to write. Attribute names are limited to 31 characters.
+ * @return true if the file was written.
+ */
+bool writeMeshFile(const std::string& path, const MeshData& mesh);
+
+/**
+ * @brief Reads a cooked mesh file through the virtual file system, copying its vertices and indices into the mesh.
+ * @param path The path of the .lfmesh file to read.
+ * @param mesh Receives the mesh.
+ * @return true if the file was read and is valid.
+ */
+bool readMeshFile(const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Reads a cooked mesh held in memory, copying its vertices and indices into the mesh.
+ * @param data The contents of the .lfmesh file. Must be 4 byte aligned.
+ * @param path The path the data was read from, for logging.
+ * @param mesh Receives the mesh.
+ * @return true if the data is a valid mesh file.
+ */
+bool readMeshFile(std::span<const uint8_t> data, const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Reads a cooked mesh held in memory without copying its vertices or indices.
+ * @param data The contents of the .lfmesh file. Must be 4 byte aligned and outlive the view.
+ * @param path The path the data was read from, for logging.
+ * @param view Receives the layout and views of the geometry.
+ * @return true if the data is a valid mesh file.
+ */
+bool readMeshFile(std::span<const uint8_t> data, const std::string& path, MeshFileView& view);
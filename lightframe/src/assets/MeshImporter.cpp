@@ -0,0 +1,1361 @@
+#include "MeshImporter.h"
+
+#include "assets/MeshOptimizer.h"
+#include "assets/VirtualFileSystem.h"
+#include "core/Json.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+/**
+ * @brief The vertex every importer writes, laid out as importedLayout() describes.
+ * Written straight into the byte storage of MeshData::vertices, so every field must be set.
+ */
+struct ImportedVertex {
+    glm::vec3 position;
+    glm::vec3 color;
+    glm::vec2 texCoords;
+    glm::vec3 normal;
+};
+static_assert(sizeof(ImportedVertex) == 44, "ImportedVertex must match importedLayout() exactly.");
+
+// Smallest share of an OBJ file worth handing to a worker of its own
+static constexpr size_t OBJ_MIN_CHUNK_SIZE = 1024 * 1024;
+
+// Deepest glTF node hierarchy followed, which also stops cyclic files recursing forever
+static constexpr int GLTF_MAX_NODE_DEPTH = 64;
+
+// "glTF" and the chunk types of a binary glTF file
+static constexpr uint32_t GLB_MAGIC = 0x46546C67;
+static constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+static constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+// glTF accessor component types
+static constexpr uint32_t GLTF_BYTE = 5120;
+static constexpr uint32_t GLTF_UNSIGNED_BYTE = 5121;
+static constexpr uint32_t GLTF_SHORT = 5122;
+static constexpr uint32_t GLTF_UNSIGNED_SHORT = 5123;
+static constexpr uint32_t GLTF_UNSIGNED_INT = 5125;
+static constexpr uint32_t GLTF_FLOAT = 5126;
+
+// glTF primitive mode for triangle lists, the default
+static constexpr uint32_t GLTF_TRIANGLES = 4;
+
+// Powers of ten that are exact as doubles, for the fast path of parseFloat
+static constexpr double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * @brief Gets the layout of ImportedVertex.
+ */
+static BufferLayout importedLayout() {
+    return BufferLayout({
+        BufferElement(std::string(MESH_ATTRIBUTE_POSITION), ShaderDataType::Float3, false),
+        BufferElement(std::string(MESH_ATTRIBUTE_COLOR), ShaderDataType::Float3, false),
+        BufferElement(std::string(MESH_ATTRIBUTE_TEXCOORD), ShaderDataType::Float2, false),
+        BufferElement(std::string(MESH_ATTRIBUTE_NORMAL), ShaderDataType::Float3, false)
+    });
+}
+
+/**
+ * @brief Sizes a mesh for a number of vertices and gets them as ImportedVertex, to be written in place.
+ */
+static ImportedVertex* allocateImportedVertices(MeshData& mesh, size_t vertexCount) {
+    mesh.layout = importedLayout();
+    mesh.vertices.resize(vertexCount * sizeof(ImportedVertex));
+    return reinterpret_cast<ImportedVertex*>(mesh.vertices.data());
+}
+
+/**
+ * @brief Gives vertices without a normal the area weighted average of the normals of the triangles using them.
+ * @param vertices The vertices the indices refer to.
+ * @param vertexCount The number of vertices.
+ * @param indices The triangle list indices, relative to vertices.
+ * @param indexCount The number of indices.
+ */
+static void generateMissingNormals(ImportedVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+    // Only vertices that arrived without a normal are touched, so authored normals survive on mixed meshes
+    std::vector<uint8_t> missing(vertexCount);
+    bool anyMissing = false;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        missing[i] = vertices[i].normal == glm::vec3(0.0f);
+        anyMissing = anyMissing || missing[i];
+    }
+    if (!anyMissing) {
+        return;
+    }
+
+    // The unnormalised cross product is twice the triangle's area, which weights the average
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const uint32_t a = indices[i];
+        const uint32_t b = indices[i + 1];
+        const uint32_t c = indices[i + 2];
+        if (!missing[a] && !missing[b] && !missing[c]) {
+            continue;
+        }
+        const glm::vec3 p0 = vertices[a].position;
+        const glm::vec3 faceNormal = glm::cross(vertices[b].position - p0, vertices[c].position - p0);
+        for (uint32_t index : { a, b, c }) {
+            if (missing[index]) {
+                vertices[index].normal += faceNormal;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        if (missing[i]) {
+            const float length = glm::length(vertices[i].normal);
+            vertices[i].normal = length > 0.0f ? vertices[i].normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+}
+
+/**
+ * @brief Gets the lowercase extension of a path, including the dot.
+ */
+static std::string getLowerExtension(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return extension;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Number parsing
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Checks whether all eight bytes of a little endian word are ASCII digits, testing them all at once.
+ */
+static inline bool isEightDigits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+        0x3333333333333333ull;
+}
+
+/**
+ * @brief Converts eight ASCII digits in a little endian word to their value, combining pairs, then quads, then halves.
+ */
+static inline uint32_t parseEightDigits(uint64_t word) {
+    word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return static_cast<uint32_t>(((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+}
+
+/**
+ * @brief Accumulates a run of decimal digits into a mantissa, eight at a time where it can.
+ * @param p The first character.
+ * @param end The end of the text.
+ * @param mantissa The mantissa to accumulate into. Only meaningful while digitCount is at most 19.
+ * @param digitCount Incremented by the number of digits read.
+ * @return const char* The first character after the digits.
+ */
+static inline const char* parseDigits(const char* p, const char* end, uint64_t& mantissa, int& digitCount) {
+    if constexpr (std::endian::native == std::endian::little) {
+        while (end - p >= 8 && digitCount <= 11) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if (!isEightDigits(word)) {
+                break;
+            }
+            mantissa = mantissa * 100000000 + parseEightDigits(word);
+            p += 8;
+            digitCount += 8;
+        }
+    }
+
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+        if (digitCount < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        }
+        ++digitCount;
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Parses a decimal floating point number.
+ *
+ * Numbers with at most 19 significant digits and a small exponent, which is nearly every number a mesh exporter
+ * writes, are built from an integer mantissa and one exact power of ten. Anything else falls back to from_chars.
+ *
+ * @param p The first character of the number.
+ * @param end The end of the text.
+ * @param value Receives the number.
+ * @return const char* The first character after the number, or nullptr if there is no number.
+ */
+static const char* parseFloat(const char* p, const char* end, float& value) {
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    const char* unsignedStart = p;
+
+    uint64_t mantissa = 0;
+    int digitCount = 0;
+    p = parseDigits(p, end, mantissa, digitCount);
+    int exponent = 0;
+    if (p < end && *p == '.') {
+        const char* fractionStart = ++p;
+        p = parseDigits(p, end, mantissa, digitCount);
+        exponent = -static_cast<int>(p - fractionStart);
+    }
+    if (digitCount == 0) {
+        return nullptr;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        const char* exponentStart = p;
+        int explicitExponent = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+            explicitExponent = std::min(explicitExponent * 10 + (*p - '0'), 100000);
+            ++p;
+        }
+        if (p == exponentStart) {
+            return nullptr;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (digitCount <= 19 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+        value = static_cast<float>(negative ? -result : result);
+        return p;
+    }
+
+    // from_chars doesn't accept a leading plus
+    const auto result = std::from_chars(*start == '+' ? unsignedStart : start, end, value);
+    return result.ec == std::errc() || result.ec == std::errc::result_out_of_range ? result.ptr : nullptr;
+}
+
+/**
+ * @brief Parses a signed decimal integer.
+ * @return const char* The first character after the number, or nullptr if there is no number.
+ */
+static const char* parseInteger(const char* p, const char* end, int64_t& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    const char* digitsStart = p;
+    int64_t result = 0;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+        result = std::min<int64_t>(result * 10 + (*p - '0'), std::numeric_limits<int32_t>::max());
+        ++p;
+    }
+    if (p == digitsStart) {
+        return nullptr;
+    }
+    value = negative ? -result : result;
+    return p;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// OBJ
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief A range of an OBJ file parsed by one task, and what it holds.
+ */
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    // Statements of each kind in the chunk, from the counting pass
+    size_t positionCount = 0;
+    size_t texCoordCount = 0;
+    size_t normalCount = 0;
+    size_t triangleCount = 0;
+    bool hasColors = false;
+
+    // Index of the chunk's first element of each kind across the whole file
+    size_t positionStart = 0;
+    size_t texCoordStart = 0;
+    size_t normalStart = 0;
+    size_t triangleStart = 0;
+
+    // Set by the parsing pass
+    bool usesTexCoords = false;
+    bool usesNormals = false;
+    bool failed = false;
+};
+
+/**
+ * @brief A face corner: zero based position, texture coordinate and normal indices, -1 where it has none.
+ */
+struct ObjCorner {
+    int32_t position;
+    int32_t texCoord;
+    int32_t normal;
+
+    bool operator==(const ObjCorner& other) const = default;
+};
+
+/**
+ * @brief Everything an OBJ file defines, each array sized by the counting pass before parsing fills it.
+ */
+struct ObjArrays {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> colors;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<ObjCorner> corners;
+};
+
+static inline bool isObjSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline const char* skipObjSpaces(const char* p, const char* end) {
+    while (p < end && isObjSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Finds the end of the line starting at p: its newline, or the end of the text.
+ */
+static inline const char* findLineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+/**
+ * @brief Counts the whitespace separated tokens from p to the end of a line.
+ */
+static size_t countObjTokens(const char* p, const char* lineEnd) {
+    size_t count = 0;
+    while (true) {
+        p = skipObjSpaces(p, lineEnd);
+        if (p >= lineEnd || *p == '#') {
+            return count;
+        }
+        ++count;
+        while (p < lineEnd && !isObjSpace(*p)) {
+            ++p;
+        }
+    }
+}
+
+/**
+ * @brief Classifies an OBJ line by its keyword.
+ * @param p The first non-space character of the line.
+ * @param lineEnd The end of the line.
+ * @param arguments Receives the first character after the keyword.
+ * @return char 'v', 't' (vt), 'n' (vn), 'f', or 0 for lines the importer ignores.
+ */
+static inline char classifyObjLine(const char* p, const char* lineEnd, const char*& arguments) {
+    if (lineEnd - p < 2) {
+        return 0;
+    }
+    if (p[0] == 'v') {
+        if (isObjSpace(p[1])) {
+            arguments = p + 2;
+            return 'v';
+        }
+        if ((p[1] == 't' || p[1] == 'n') && lineEnd - p > 2 && isObjSpace(p[2])) {
+            arguments = p + 3;
+            return p[1];
+        }
+    } else if (p[0] == 'f' && isObjSpace(p[1])) {
+        arguments = p + 2;
+        return 'f';
+    }
+    return 0;
+}
+
+/**
+ * @brief First pass over a chunk: counts the statements of each kind, so every array can be sized exactly.
+ */
+static void countObjChunk(ObjChunk& chunk) {
+    bool colorsChecked = false;
+    for (const char* line = chunk.begin; line < chunk.end;) {
+        const char* lineEnd = findLineEnd(line, chunk.end);
+        const char* arguments = nullptr;
+        switch (classifyObjLine(skipObjSpaces(line, lineEnd), lineEnd, arguments)) {
+            case 'v':
+                // Vertex colors are all or nothing in practice, so the first vertex decides
+                if (!colorsChecked) {
+                    chunk.hasColors = countObjTokens(arguments, lineEnd) >= 6;
+                    colorsChecked = true;
+                }
+                ++chunk.positionCount;
+                break;
+            case 't':
+                ++chunk.texCoordCount;
+                break;
+            case 'n':
+                ++chunk.normalCount;
+                break;
+            case 'f': {
+                const size_t cornerCount = countObjTokens(arguments, lineEnd);
+                chunk.triangleCount += cornerCount >= 3 ? cornerCount - 2 : 0;
+                break;
+            }
+            default:
+                break;
+        }
+        line = lineEnd + 1;
+    }
+}
+
+/**
+ * @brief Parses up to count floats from an OBJ statement.
+ * @return size_t The number of floats parsed.
+ */
+static size_t parseObjFloats(const char* p, const char* lineEnd, float* values, size_t count) {
+    size_t parsed = 0;
+    while (parsed < count) {
+        p = skipObjSpaces(p, lineEnd);
+        if (p >= lineEnd || *p == '#') {
+            break;
+        }
+        p = parseFloat(p, lineEnd, values[parsed]);
+        if (!p) {
+            break;
+        }
+        ++parsed;
+    }
+    return parsed;
+}
+
+/**
+ * @brief Resolves an OBJ index, which is one based or, if negative, relative to the elements defined so far.
+ * @param index The index as written.
+ * @param definedCount The number of elements of its kind defined before the statement.
+ * @param totalCount The number of elements of its kind in the file.
+ * @return int32_t The zero based index, or -1 if it is out of range.
+ */
+static inline int32_t resolveObjIndex(int64_t index, size_t definedCount, size_t totalCount) {
+    const int64_t resolved = index > 0 ? index - 1 : static_cast<int64_t>(definedCount) + index;
+    return index != 0 && resolved >= 0 && resolved < static_cast<int64_t>(totalCount) ? static_cast<int32_t>(resolved) : -1;
+}
+
+/**
+ * @brief Parses one corner of a face: p, p/t, p//n or p/t/n.
+ * @return const char* The first character after the corner, or nullptr if it is malformed.
+ */
+static const char* parseObjCorner(const char* p, const char* lineEnd, const ObjChunk& chunk, size_t positionsDefined,
+    size_t texCoordsDefined, size_t normalsDefined, const ObjArrays& arrays, ObjCorner& corner) {
+
+    int64_t index;
+    p = parseInteger(p, lineEnd, index);
+    if (!p) {
+        return nullptr;
+    }
+    corner.position = resolveObjIndex(index, chunk.positionStart + positionsDefined, arrays.positions.size());
+    corner.texCoord = -1;
+    corner.normal = -1;
+    if (corner.position < 0) {
+        return nullptr;
+    }
+
+    if (p < lineEnd && *p == '/') {
+        ++p;
+        if (p < lineEnd && *p != '/') {
+            p = parseInteger(p, lineEnd, index);
+            if (!p) {
+                return nullptr;
+            }
+            corner.texCoord = resolveObjIndex(index, chunk.texCoordStart + texCoordsDefined, arrays.texCoords.size());
+            if (corner.texCoord < 0) {
+                return nullptr;
+            }
+        }
+        if (p < lineEnd && *p == '/') {
+            p = parseInteger(p + 1, lineEnd, index);
+            if (!p) {
+                return nullptr;
+            }
+            corner.normal = resolveObjIndex(index, chunk.normalStart + normalsDefined, arrays.normals.size());
+            if (corner.normal < 0) {
+                return nullptr;
+            }
+        }
+    }
+
+    return p < lineEnd && !isObjSpace(*p) && *p != '#' ? nullptr : p;
+}
+
+/**
+ * @brief Second pass over a chunk: parses its statements into the ranges of the arrays the counting pass reserved.
+ */
+static void parseObjChunk(ObjChunk& chunk, ObjArrays& arrays) {
+    size_t positions = 0;
+    size_t texCoords = 0;
+    size_t normals = 0;
+    size_t corners = 0;
+
+    for (const char* line = chunk.begin; line < chunk.end;) {
+        const char* lineEnd = findLineEnd(line, chunk.end);
+        const char* p = nullptr;
+        switch (classifyObjLine(skipObjSpaces(line, lineEnd), lineEnd, p)) {
+            case 'v': {
+                float values[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+                const size_t parsed = parseObjFloats(p, lineEnd, values, arrays.colors.empty() ? 3 : 6);
+                const size_t index = chunk.positionStart + positions++;
+                arrays.positions[index] = glm::vec3(values[0], values[1], values[2]);
+                if (!arrays.colors.empty()) {
+                    arrays.colors[index] = parsed >= 6 ? glm::vec3(values[3], values[4], values[5]) : glm::vec3(1.0f);
+                }
+                chunk.failed = chunk.failed || parsed < 3;
+                break;
+            }
+            case 't': {
+                float values[2] = { 0.0f, 0.0f };
+                chunk.failed = chunk.failed || parseObjFloats(p, lineEnd, values, 2) == 0;
+                arrays.texCoords[chunk.texCoordStart + texCoords++] = glm::vec2(values[0], values[1]);
+                break;
+            }
+            case 'n': {
+                float values[3] = { 0.0f, 0.0f, 0.0f };
+                chunk.failed = chunk.failed || parseObjFloats(p, lineEnd, values, 3) < 3;
+                arrays.normals[chunk.normalStart + normals++] = glm::vec3(values[0], values[1], values[2]);
+                break;
+            }
+            case 'f': {
+                // Fan triangulation: every corner after the second closes a triangle with the first and previous
+                ObjCorner first = {};
+                ObjCorner previous = {};
+                size_t cornerCount = 0;
+                while (true) {
+                    p = skipObjSpaces(p, lineEnd);
+                    if (p >= lineEnd || *p == '#') {
+                        break;
+                    }
+
+                    ObjCorner corner;
+                    p = parseObjCorner(p, lineEnd, chunk, positions, texCoords, normals, arrays, corner);
+                    if (!p) {
+                        chunk.failed = true;
+                        return;
+                    }
+                    chunk.usesTexCoords = chunk.usesTexCoords || corner.texCoord >= 0;
+                    chunk.usesNormals = chunk.usesNormals || corner.normal >= 0;
+
+                    if (cornerCount == 0) {
+                        first = corner;
+                    } else if (cornerCount >= 2) {
+                        ObjCorner* triangle = &arrays.corners[(chunk.triangleStart * 3) + corners];
+                        triangle[0] = first;
+                        triangle[1] = previous;
+                        triangle[2] = corner;
+                        corners += 3;
+                    }
+                    previous = corner;
+                    ++cornerCount;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (chunk.failed) {
+            return;
+        }
+        line = lineEnd + 1;
+    }
+}
+
+/**
+ * @brief Hashes a face corner for welding.
+ */
+static inline uint64_t hashObjCorner(const ObjCorner& corner) {
+    uint64_t hash = static_cast<uint32_t>(corner.position) * 0x9E3779B97F4A7C15ull;
+    hash ^= (static_cast<uint32_t>(corner.texCoord) + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+    hash ^= (static_cast<uint32_t>(corner.normal) + 0x165667B19E3779F9ull) * 0x27D4EB2F165667C5ull;
+    return hash ^ (hash >> 29);
+}
+
+bool importObjMesh(const std::string& path, MeshData& mesh) {
+    AssetBlob blob;
+    if (!VirtualFileSystem::get()->read(path, blob)) {
+        mesh = MeshData();
+        return false;
+    }
+    return importObjMesh(blob, path, mesh);
+}
+
+bool importObjMesh(const AssetBlob& blob, const std::string& path, MeshData& mesh) {
+    mesh = MeshData();
+
+    const char* text = reinterpret_cast<const char*>(blob.data.data());
+    const char* textEnd = text + blob.data.size();
+
+    // Split into chunks at line boundaries, a few per worker so uneven chunks even out
+    ThreadPool* threadPool = ThreadPool::get();
+    const size_t maxChunks = (threadPool->getThreadCount() + 1) * 4;
+    const size_t chunkCount = std::clamp<size_t>(blob.data.size() / OBJ_MIN_CHUNK_SIZE, 1, maxChunks);
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* chunkBegin = text;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const char* chunkEnd = i + 1 == chunkCount ? textEnd : text + blob.data.size() * (i + 1) / chunkCount;
+        chunkEnd = std::max(chunkEnd, chunkBegin);
+        chunkEnd = chunkEnd < textEnd ? std::min(findLineEnd(chunkEnd, textEnd) + 1, textEnd) : textEnd;
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+
+    threadPool->parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            countObjChunk(chunks[i]);
+        }
+    });
+
+    // Each chunk's elements start where the previous chunk's end
+    ObjArrays arrays;
+    size_t positionCount = 0;
+    size_t texCoordCount = 0;
+    size_t normalCount = 0;
+    size_t triangleCount = 0;
+    bool hasColors = false;
+    for (ObjChunk& chunk : chunks) {
+        chunk.positionStart = positionCount;
+        chunk.texCoordStart = texCoordCount;
+        chunk.normalStart = normalCount;
+        chunk.triangleStart = triangleCount;
+        positionCount += chunk.positionCount;
+        texCoordCount += chunk.texCoordCount;
+        normalCount += chunk.normalCount;
+        triangleCount += chunk.triangleCount;
+        hasColors = hasColors || chunk.hasColors;
+    }
+    if (positionCount >= static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+        triangleCount * 3 >= std::numeric_limits<uint32_t>::max()) {
+        LOG_WARN("OBJ file {} is too large to import.", path);
+        return false;
+    }
+
+    arrays.positions.resize(positionCount);
+    arrays.colors.resize(hasColors ? positionCount : 0);
+    arrays.texCoords.resize(texCoordCount);
+    arrays.normals.resize(normalCount);
+    arrays.corners.resize(triangleCount * 3);
+
+    threadPool->parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            parseObjChunk(chunks[i], arrays);
+        }
+    });
+
+    bool usesTexCoords = false;
+    bool usesNormals = false;
+    for (const ObjChunk& chunk : chunks) {
+        if (chunk.failed) {
+            LOG_WARN("OBJ file {} is malformed.", path);
+            return false;
+        }
+        usesTexCoords = usesTexCoords || chunk.usesTexCoords;
+        usesNormals = usesNormals || chunk.usesNormals;
+    }
+    if (arrays.corners.empty()) {
+        LOG_WARN("OBJ file {} has no faces.", path);
+        return false;
+    }
+
+    // Position-only files, such as scans, index their positions directly. Otherwise each distinct v/vt/vn
+    // combination becomes a vertex, found through an open addressing table sized for at most half occupancy.
+    std::vector<ObjCorner> uniqueCorners;
+    mesh.indices.resize(arrays.corners.size());
+    if (!usesTexCoords && !usesNormals) {
+        threadPool->parallelFor(arrays.corners.size(), 1 << 16, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                mesh.indices[i] = static_cast<uint32_t>(arrays.corners[i].position);
+            }
+        });
+    } else {
+        const size_t tableSize = std::bit_ceil(arrays.corners.size() * 2);
+        const size_t tableMask = tableSize - 1;
+        std::vector<uint32_t> table(tableSize, std::numeric_limits<uint32_t>::max());
+        uniqueCorners.reserve(std::min(arrays.corners.size(), positionCount * 2));
+
+        for (size_t i = 0; i < arrays.corners.size(); ++i) {
+            const ObjCorner& corner = arrays.corners[i];
+            size_t slot = hashObjCorner(corner) & tableMask;
+            while (table[slot] != std::numeric_limits<uint32_t>::max() && uniqueCorners[table[slot]] != corner) {
+                slot = (slot + 1) & tableMask;
+            }
+            if (table[slot] == std::numeric_limits<uint32_t>::max()) {
+                table[slot] = static_cast<uint32_t>(uniqueCorners.size());
+                uniqueCorners.push_back(corner);
+            }
+            mesh.indices[i] = table[slot];
+        }
+    }
+    arrays.corners = std::vector<ObjCorner>();
+
+    const bool welded = !uniqueCorners.empty();
+    const size_t vertexCount = welded ? uniqueCorners.size() : positionCount;
+    ImportedVertex* vertices = allocateImportedVertices(mesh, vertexCount);
+    threadPool->parallelFor(vertexCount, 1 << 14, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ObjCorner corner = welded ? uniqueCorners[i] : ObjCorner { static_cast<int32_t>(i), -1, -1 };
+            ImportedVertex& vertex = vertices[i];
+            vertex.position = arrays.positions[corner.position];
+            vertex.color = hasColors ? arrays.colors[corner.position] : glm::vec3(1.0f);
+            vertex.texCoords = corner.texCoord >= 0 ? arrays.texCoords[corner.texCoord] : glm::vec2(0.0f);
+            vertex.normal = corner.normal >= 0 ? arrays.normals[corner.normal] : glm::vec3(0.0f);
+        }
+    });
+
+    generateMissingNormals(vertices, vertexCount, mesh.indices.data(), mesh.indices.size());
+    calculateMeshBounds(mesh);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// glTF
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief A parsed glTF document and the buffers its accessors read from.
+ */
+struct GltfDocument {
+    JsonValue json;
+    std::vector<std::span<const uint8_t>> buffers;
+
+    // Keep the buffers alive: the source and external files as mappings, embedded base64 buffers decoded
+    std::vector<AssetBlob> mappings;
+    std::vector<std::vector<uint8_t>> decodedBuffers;
+};
+
+/**
+ * @brief A typed, strided view of an accessor's elements within a buffer.
+ */
+struct GltfAccessor {
+    const uint8_t* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    uint32_t componentType = 0;
+    uint32_t componentCount = 0;
+    bool normalized = false;
+};
+
+/**
+ * @brief A triangle primitive to import, where it goes in the output, and the transform of the node drawing it.
+ */
+struct GltfDraw {
+    const JsonValue* primitive = nullptr;
+    glm::mat4 transform = glm::mat4(1.0f);
+    size_t vertexStart = 0;
+    size_t vertexCount = 0;
+    size_t indexStart = 0;
+    size_t indexCount = 0;
+};
+
+/**
+ * @brief Reads a glTF index property, or SIZE_MAX if it is missing or not a valid index.
+ */
+static size_t getGltfIndex(const JsonValue& value) {
+    const double number = value.asNumber(-1.0);
+    return number >= 0.0 && number < 4294967296.0 ? static_cast<size_t>(number) : std::numeric_limits<size_t>::max();
+}
+
+/**
+ * @brief Reads a glTF count, offset or length property, or 0 if it is missing or not valid.
+ */
+static size_t getGltfSize(const JsonValue& value) {
+    const double number = value.asNumber();
+    return number > 0.0 && number < 1e15 ? static_cast<size_t>(number) : 0;
+}
+
+/**
+ * @brief Decodes a base64 string.
+ * @return true if the string is valid base64.
+ */
+static bool decodeBase64(std::string_view text, std::vector<uint8_t>& output) {
+    auto decodeCharacter = [](char c) -> int {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+' || c == '-') return 62;
+        if (c == '/' || c == '_') return 63;
+        return -1;
+    };
+
+    output.clear();
+    output.reserve(text.size() / 4 * 3);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (char c : text) {
+        if (c == '=') {
+            break;
+        }
+        const int value = decodeCharacter(c);
+        if (value < 0) {
+            return false;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            output.push_back(static_cast<uint8_t>(bits >> bitCount));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes the %XX escapes of a relative URI into a path.
+ */
+static std::string decodeUri(std::string_view uri) {
+    std::string path;
+    path.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        uint32_t value;
+        if (uri[i] == '%' && i + 2 < uri.size() &&
+            std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ptr == uri.data() + i + 3) {
+            path += static_cast<char>(value);
+            i += 2;
+        } else {
+            path += uri[i];
+        }
+    }
+    return path;
+}
+
+/**
+ * @brief Gets the path of a buffer stored in a file of its own, or an empty string for embedded buffers.
+ */
+static std::string getGltfBufferPath(const std::string& documentPath, const JsonValue& buffer) {
+    const std::string& uri = buffer["uri"].asString();
+    if (uri.empty() || uri.starts_with("data:")) {
+        return std::string();
+    }
+    return (std::filesystem::path(documentPath).parent_path() / decodeUri(uri)).generic_string();
+}
+
+/**
+ * @brief Parses a .gltf or .glb file already read into memory, and reads the buffers it refers to.
+ * @param source The contents of the file.
+ * @param path The path of the file, which external buffers are relative to.
+ * @param loadBuffers Whether to map and decode the buffers, or only parse the JSON.
+ * @param document Receives the document.
+ * @return true if the file and its buffers were read.
+ */
+static bool loadGltfDocument(const AssetBlob& source, const std::string& path, bool loadBuffers, GltfDocument& document) {
+    std::string_view jsonText(reinterpret_cast<const char*>(source.data.data()), source.data.size());
+    std::span<const uint8_t> binaryChunk;
+
+    uint32_t magic = 0;
+    if (source.data.size() >= 12) {
+        std::memcpy(&magic, source.data.data(), sizeof(magic));
+    }
+    if (magic == GLB_MAGIC) {
+        // A 12 byte header, then chunks of a length, a type and the data; JSON first, then an optional binary chunk
+        jsonText = std::string_view();
+        for (size_t offset = 12; offset + 8 <= source.data.size();) {
+            uint32_t chunkHeader[2];
+            std::memcpy(chunkHeader, source.data.data() + offset, sizeof(chunkHeader));
+            const size_t chunkStart = offset + 8;
+            if (chunkStart + chunkHeader[0] > source.data.size()) {
+                LOG_WARN("glTF file {} is truncated.", path);
+                return false;
+            }
+            if (chunkHeader[1] == GLB_CHUNK_JSON && jsonText.empty()) {
+                jsonText = std::string_view(reinterpret_cast<const char*>(source.data.data() + chunkStart), chunkHeader[0]);
+            } else if (chunkHeader[1] == GLB_CHUNK_BIN && binaryChunk.empty()) {
+                binaryChunk = source.data.subspan(chunkStart, chunkHeader[0]);
+            }
+            offset = chunkStart + ((chunkHeader[0] + 3) & ~3u);
+        }
+    }
+
+    if (!JsonValue::parse(jsonText, document.json) || !document.json.isObject()) {
+        LOG_WARN("glTF file {} has invalid JSON.", path);
+        return false;
+    }
+    if (!loadBuffers) {
+        return true;
+    }
+    document.mappings.push_back(source);
+
+    const JsonValue& buffers = document.json["buffers"];
+    document.buffers.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        const JsonValue& buffer = buffers[i];
+        const std::string& uri = buffer["uri"].asString();
+        if (uri.empty()) {
+            // Only the first buffer of a .glb may leave out its URI, to refer to the binary chunk
+            document.buffers[i] = i == 0 ? binaryChunk : std::span<const uint8_t>();
+        } else if (uri.starts_with("data:")) {
+            const size_t dataStart = uri.find(";base64,");
+            std::vector<uint8_t>& decoded = document.decodedBuffers.emplace_back();
+            if (dataStart == std::string::npos || !decodeBase64(std::string_view(uri).substr(dataStart + 8), decoded)) {
+                LOG_WARN("glTF file {} has an unsupported embedded buffer.", path);
+                return false;
+            }
+            document.buffers[i] = decoded;
+        } else {
+            AssetBlob& external = document.mappings.emplace_back();
+            if (!VirtualFileSystem::get()->read(getGltfBufferPath(path, buffer), external)) {
+                LOG_WARN("glTF file {} refers to a missing buffer {}.", path, uri);
+                return false;
+            }
+            document.buffers[i] = external.data;
+        }
+
+        const size_t byteLength = getGltfSize(buffer["byteLength"]);
+        if (document.buffers[i].size() < byteLength) {
+            LOG_WARN("glTF file {} has a buffer shorter than its byteLength.", path);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a .gltf or .glb file and the buffers it refers to.
+ * @param path The path of the file.
+ * @param loadBuffers Whether to map and decode the buffers, or only parse the JSON.
+ * @param document Receives the document.
+ * @return true if the file and its buffers were read.
+ */
+static bool loadGltfDocument(const std::string& path, bool loadBuffers, GltfDocument& document) {
+    AssetBlob source;
+    return VirtualFileSystem::get()->read(path, source) && loadGltfDocument(source, path, loadBuffers, document);
+}
+
+/**
+ * @brief Gets the size in bytes of an accessor component type, or 0 if it is not a valid type.
+ */
+static uint32_t getGltfComponentSize(uint32_t componentType) {
+    switch (componentType) {
+        case GLTF_BYTE:
+        case GLTF_UNSIGNED_BYTE:
+            return 1;
+        case GLTF_SHORT:
+        case GLTF_UNSIGNED_SHORT:
+            return 2;
+        case GLTF_UNSIGNED_INT:
+        case GLTF_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Gets the number of components of an accessor type, or 0 for matrices and unknown types.
+ */
+static uint32_t getGltfComponentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+/**
+ * @brief Resolves an accessor into a view of its elements, checking that every element lies within its buffer.
+ * @param document The document.
+ * @param index The accessor index, as a JSON value.
+ * @param accessor Receives the view.
+ * @return true if the accessor is valid and supported.
+ */
+static bool getGltfAccessor(const GltfDocument& document, const JsonValue& index, GltfAccessor& accessor) {
+    const JsonValue& json = document.json["accessors"][getGltfIndex(index)];
+    const JsonValue& view = document.json["bufferViews"][getGltfIndex(json["bufferView"])];
+    if (!json.isObject() || !view.isObject() || json.contains("sparse")) {
+        return false;
+    }
+
+    const size_t bufferIndex = getGltfIndex(view["buffer"]);
+    if (bufferIndex >= document.buffers.size()) {
+        return false;
+    }
+    const std::span<const uint8_t> buffer = document.buffers[bufferIndex];
+
+    accessor.componentType = static_cast<uint32_t>(json["componentType"].asNumber());
+    accessor.componentCount = getGltfComponentCount(json["type"].asString());
+    accessor.normalized = json["normalized"].asBool();
+    accessor.count = getGltfSize(json["count"]);
+
+    const size_t elementSize = static_cast<size_t>(getGltfComponentSize(accessor.componentType)) * accessor.componentCount;
+    if (elementSize == 0) {
+        return false;
+    }
+    accessor.stride = view.contains("byteStride") ? getGltfSize(view["byteStride"]) : elementSize;
+    if (accessor.stride < elementSize) {
+        return false;
+    }
+
+    const size_t viewOffset = getGltfSize(view["byteOffset"]);
+    const size_t viewLength = getGltfSize(view["byteLength"]);
+    const size_t accessorOffset = getGltfSize(json["byteOffset"]);
+    const size_t accessorSize = accessor.count > 0 ? (accessor.count - 1) * accessor.stride + elementSize : 0;
+    if (viewOffset + viewLength > buffer.size() || accessorOffset + accessorSize > viewLength) {
+        return false;
+    }
+
+    accessor.data = buffer.data() + viewOffset + accessorOffset;
+    return true;
+}
+
+/**
+ * @brief Reads one component of an accessor element as a float, applying normalisation.
+ */
+static inline float readGltfComponent(const uint8_t* data, uint32_t componentType, bool normalized) {
+    switch (componentType) {
+        case GLTF_FLOAT: {
+            float value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+        case GLTF_UNSIGNED_BYTE:
+            return normalized ? *data / 255.0f : *data;
+        case GLTF_BYTE: {
+            const int8_t value = static_cast<int8_t>(*data);
+            return normalized ? std::max(value / 127.0f, -1.0f) : value;
+        }
+        case GLTF_UNSIGNED_SHORT: {
+            uint16_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return normalized ? value / 65535.0f : value;
+        }
+        case GLTF_SHORT: {
+            int16_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+        }
+        case GLTF_UNSIGNED_INT: {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return static_cast<float>(value);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+/**
+ * @brief Reads up to count components of an accessor element as floats. Components it lacks are left untouched.
+ */
+static inline void readGltfFloats(const GltfAccessor& accessor, size_t element, float* values, uint32_t count) {
+    const uint8_t* data = accessor.data + element * accessor.stride;
+    const uint32_t componentSize = getGltfComponentSize(accessor.componentType);
+    for (uint32_t c = 0; c < std::min(count, accessor.componentCount); ++c) {
+        values[c] = readGltfComponent(data + c * componentSize, accessor.componentType, accessor.normalized);
+    }
+}
+
+/**
+ * @brief Reads an element of an index accessor.
+ */
+static inline uint32_t readGltfIndex(const GltfAccessor& accessor, size_t element) {
+    const uint8_t* data = accessor.data + element * accessor.stride;
+    switch (accessor.componentType) {
+        case GLTF_UNSIGNED_BYTE:
+            return *data;
+        case GLTF_UNSIGNED_SHORT: {
+            uint16_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+    }
+}
+
+/**
+ * @brief Gets the local transform of a node, from its matrix or its translation, rotation and scale.
+ */
+static glm::mat4 getGltfNodeTransform(const JsonValue& node) {
+    const JsonValue& matrix = node["matrix"];
+    if (matrix.size() == 16) {
+        glm::mat4 transform;
+        for (int i = 0; i < 16; ++i) {
+            glm::value_ptr(transform)[i] = static_cast<float>(matrix[static_cast<size_t>(i)].asNumber());
+        }
+        return transform;
+    }
+
+    const JsonValue& t = node["translation"];
+    const JsonValue& r = node["rotation"];
+    const JsonValue& s = node["scale"];
+    const glm::vec3 translation(t[size_t(0)].asNumber(), t[size_t(1)].asNumber(), t[size_t(2)].asNumber());
+    const glm::quat rotation(static_cast<float>(r[size_t(3)].asNumber(1.0)), static_cast<float>(r[size_t(0)].asNumber()),
+        static_cast<float>(r[size_t(1)].asNumber()), static_cast<float>(r[size_t(2)].asNumber()));
+    const glm::vec3 scale(s[size_t(0)].asNumber(1.0), s[size_t(1)].asNumber(1.0), s[size_t(2)].asNumber(1.0));
+
+    glm::mat4 transform = glm::mat4_cast(rotation);
+    transform[0] *= scale.x;
+    transform[1] *= scale.y;
+    transform[2] *= scale.z;
+    transform[3] = glm::vec4(translation, 1.0f);
+    return transform;
+}
+
+/**
+ * @brief Adds the triangle primitives of a mesh to the draw list.
+ */
+static void addGltfMeshDraws(const GltfDocument& document, size_t meshIndex, const glm::mat4& transform,
+    std::vector<GltfDraw>& draws) {
+
+    const JsonValue& primitives = document.json["meshes"][meshIndex]["primitives"];
+    for (const JsonValue& primitive : primitives.getElements()) {
+        if (static_cast<uint32_t>(primitive["mode"].asNumber(GLTF_TRIANGLES)) == GLTF_TRIANGLES) {
+            draws.push_back(GltfDraw { .primitive = &primitive, .transform = transform });
+        }
+    }
+}
+
+/**
+ * @brief Adds the draws of a node and its descendants.
+ */
+static void gatherGltfDraws(const GltfDocument& document, size_t nodeIndex, const glm::mat4& parentTransform,
+    int depth, std::vector<GltfDraw>& draws) {
+
+    const JsonValue& node = document.json["nodes"][nodeIndex];
+    if (!node.isObject() || depth > GLTF_MAX_NODE_DEPTH) {
+        return;
+    }
+
+    const glm::mat4 transform = parentTransform * getGltfNodeTransform(node);
+    if (node.contains("mesh")) {
+        addGltfMeshDraws(document, getGltfIndex(node["mesh"]), transform, draws);
+    }
+    for (const JsonValue& child : node["children"].getElements()) {
+        gatherGltfDraws(document, getGltfIndex(child), transform, depth + 1, draws);
+    }
+}
+
+/**
+ * @brief Converts one primitive into its range of the output.
+ * @return true if the primitive's accessors are valid.
+ */
+static bool importGltfDraw(const GltfDocument& document, const GltfDraw& draw, ImportedVertex* vertices, uint32_t* indices) {
+    const JsonValue& attributes = (*draw.primitive)["attributes"];
+
+    GltfAccessor positions;
+    if (!getGltfAccessor(document, attributes["POSITION"], positions) || positions.componentCount != 3) {
+        return false;
+    }
+    GltfAccessor normals;
+    GltfAccessor texCoords;
+    GltfAccessor colors;
+    const bool hasNormals = getGltfAccessor(document, attributes["NORMAL"], normals) && normals.count == draw.vertexCount;
+    const bool hasTexCoords = getGltfAccessor(document, attributes["TEXCOORD_0"], texCoords) && texCoords.count == draw.vertexCount;
+    const bool hasColors = getGltfAccessor(document, attributes["COLOR_0"], colors) && colors.count == draw.vertexCount;
+
+    // Normals take the inverse transpose, so non-uniform scale doesn't skew them
+    const glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(draw.transform)));
+    for (size_t i = 0; i < draw.vertexCount; ++i) {
+        ImportedVertex& vertex = vertices[i];
+
+        float values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        readGltfFloats(positions, i, values, 3);
+        vertex.position = glm::vec3(draw.transform * glm::vec4(values[0], values[1], values[2], 1.0f));
+
+        vertex.color = glm::vec3(1.0f);
+        if (hasColors) {
+            readGltfFloats(colors, i, glm::value_ptr(vertex.color), 3);
+        }
+
+        // glTF puts the texture origin at the top left; textures are flipped on load to put it at the bottom left
+        vertex.texCoords = glm::vec2(0.0f);
+        if (hasTexCoords) {
+            readGltfFloats(texCoords, i, glm::value_ptr(vertex.texCoords), 2);
+            vertex.texCoords.y = 1.0f - vertex.texCoords.y;
+        }
+
+        vertex.normal = glm::vec3(0.0f);
+        if (hasNormals) {
+            readGltfFloats(normals, i, values, 3);
+            const glm::vec3 normal = normalTransform * glm::vec3(values[0], values[1], values[2]);
+            const float length = glm::length(normal);
+            vertex.normal = length > 0.0f ? normal / length : glm::vec3(0.0f);
+        }
+    }
+
+    const JsonValue& indexAccessor = (*draw.primitive)["indices"];
+    if (indexAccessor.isNull()) {
+        for (size_t i = 0; i < draw.indexCount; ++i) {
+            indices[i] = static_cast<uint32_t>(draw.vertexStart + i);
+        }
+    } else {
+        GltfAccessor source;
+        if (!getGltfAccessor(document, indexAccessor, source) || source.componentCount != 1) {
+            return false;
+        }
+        for (size_t i = 0; i < draw.indexCount; ++i) {
+            const uint32_t index = readGltfIndex(source, i);
+            if (index >= draw.vertexCount) {
+                return false;
+            }
+            indices[i] = static_cast<uint32_t>(draw.vertexStart) + index;
+        }
+    }
+
+    // Mirroring transforms turn triangles inside out, so their winding is reversed to keep them front facing
+    if (glm::determinant(glm::mat3(draw.transform)) < 0.0f) {
+        for (size_t i = 0; i + 2 < draw.indexCount; i += 3) {
+            std::swap(indices[i + 1], indices[i + 2]);
+        }
+    }
+
+    if (!hasNormals) {
+        // Indices are absolute, so normals are generated against the whole vertex array from this draw's start
+        std::vector<uint32_t> localIndices(indices, indices + draw.indexCount);
+        for (uint32_t& index : localIndices) {
+            index -= static_cast<uint32_t>(draw.vertexStart);
+        }
+        generateMissingNormals(vertices, draw.vertexCount, localIndices.data(), localIndices.size());
+    }
+    return true;
+}
+
+bool importGltfMesh(const std::string& path, MeshData& mesh) {
+    AssetBlob source;
+    if (!VirtualFileSystem::get()->read(path, source)) {
+        mesh = MeshData();
+        return false;
+    }
+    return importGltfMesh(source, path, mesh);
+}
+
+bool importGltfMesh(const AssetBlob& source, const std::string& path, MeshData& mesh) {
+    mesh = MeshData();
+
+    GltfDocument document;
+    if (!loadGltfDocument(source, path, true, document)) {
+        return false;
+    }
+
+    // Draw the default scene if there is one, otherwise every mesh once, untransformed
+    std::vector<GltfDraw> draws;
+    const JsonValue& scenes = document.json["scenes"];
+    if (scenes.size() > 0) {
+        const JsonValue& scene = scenes[document.json.contains("scene") ? getGltfIndex(document.json["scene"]) : 0];
+        for (const JsonValue& node : scene["nodes"].getElements()) {
+            gatherGltfDraws(document, getGltfIndex(node), glm::mat4(1.0f), 0, draws);
+        }
+    } else {
+        for (size_t i = 0; i < document.json["meshes"].size(); ++i) {
+            addGltfMeshDraws(document, i, glm::mat4(1.0f), draws);
+        }
+    }
+
+    // Size every draw from its accessor counts, so the output is allocated once and filled in parallel
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (GltfDraw& draw : draws) {
+        const JsonValue& attributes = (*draw.primitive)["attributes"];
+        const JsonValue& accessors = document.json["accessors"];
+        draw.vertexCount = getGltfSize(accessors[getGltfIndex(attributes["POSITION"])]["count"]);
+        const JsonValue& indices = (*draw.primitive)["indices"];
+        draw.indexCount = indices.isNull() ? draw.vertexCount
+            : getGltfSize(accessors[getGltfIndex(indices)]["count"]);
+        draw.indexCount -= draw.indexCount % 3;
+        draw.vertexStart = vertexCount;
+        draw.indexStart = indexCount;
+        vertexCount += draw.vertexCount;
+        indexCount += draw.indexCount;
+    }
+    if (indexCount == 0) {
+        LOG_WARN("glTF file {} has no triangles.", path);
+        return false;
+    }
+    if (vertexCount >= std::numeric_limits<uint32_t>::max()) {
+        LOG_WARN("glTF file {} is too large to import.", path);
+        return false;
+    }
+
+    ImportedVertex* vertices = allocateImportedVertices(mesh, vertexCount);
+    mesh.indices.resize(indexCount);
+
+    std::atomic<bool> failed = false;
+    ThreadPool::get()->parallelFor(draws.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const GltfDraw& draw = draws[i];
+            if (!importGltfDraw(document, draw, vertices + draw.vertexStart, mesh.indices.data() + draw.indexStart)) {
+                failed = true;
+            }
+        }
+    });
+    if (failed) {
+        LOG_WARN("glTF file {} has invalid or unsupported accessors.", path);
+        mesh = MeshData();
+        return false;
+    }
+
+    calculateMeshBounds(mesh);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool isImportableMesh(const std::string& path) {
+    const std::string extension = getLowerExtension(path);
+    return extension == ".obj" || extension == ".gltf" || extension == ".glb";
+}
+
+bool importMesh(const std::string& path, MeshData& mesh) {
+    if (!isImportableMesh(path)) {
+        LOG_WARN("Mesh file {} is not a format the importer reads.", path);
+        return false;
+    }
+
+    AssetBlob source;
+    return VirtualFileSystem::get()->read(path, source) && importMesh(source, path, mesh);
+}
+
+bool importMesh(const AssetBlob& source, const std::string& path, MeshData& mesh) {
+    const std::string extension = getLowerExtension(path);
+    if (extension == ".obj") {
+        return importObjMesh(source, path, mesh);
+    }
+    if (extension == ".gltf" || extension == ".glb") {
+        return importGltfMesh(source, path, mesh);
+    }
+
+    LOG_WARN("Mesh file {} is not a format the importer reads.", path);
+    return false;
+}
+
+std::vector<std::string> getMeshImportDependencies(const std::string& path) {
+    std::vector<std::string> dependencies;
+    const std::string extension = getLowerExtension(path);
+    if (extension != ".gltf" && extension != ".glb") {
+        return dependencies;
+    }
+
+    GltfDocument document;
+    if (loadGltfDocument(path, false, document)) {
+        for (const JsonValue& buffer : document.json["buffers"].getElements()) {
+            std::string bufferPath = getGltfBufferPath(path, buffer);
+            if (!bufferPath.empty()) {
+                dependencies.push_back(std::move(bufferPath));
+            }
+        }
+    }
+    return dependencies;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file MeshImporter.h
+ * @author Justin McKay
+ * @brief Imports Wavefront OBJ and glTF 2.0 (.gltf and .glb) meshes into MeshData.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "assets/AssetArchive.h"
+#include "rendering/MeshData.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks whether a file is a mesh source format the importer reads, by its extension.
+ * @param path The path of the file.
+ * @return true for .obj, .gltf and .glb files.
+ */
+bool isImportableMesh(const std::string& path);
+
+/**
+ * @brief Imports a mesh source file, choosing the format by extension.
+ *
+ * The result always has the layout pos (Float3), color (Float3), texCoords (Float2), normal (Float3), so the first
+ * three attributes line up with the engine's default shader inputs. Missing colors are white, missing texture
+ * coordinates zero, and missing normals are generated from the triangles. Bounds are measured.
+ *
+ * @param path The path of the .obj, .gltf or .glb file. Read from a mounted archive if it is packed in one.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importMesh(const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Imports a mesh source file already read into memory, as importMesh() does.
+ * @param source The contents of the file.
+ * @param path The path the file was read from, which chooses the format and resolves external glTF buffers.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importMesh(const AssetBlob& source, const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Imports a Wavefront OBJ file.
+ *
+ * The file is split into chunks at line boundaries that are counted, then parsed, in parallel on the engine thread
+ * pool. Counting first sizes every array exactly before anything is parsed, so nothing is reallocated as it grows.
+ * Faces are triangulated as fans, and v/vt/vn combinations are welded into shared vertices.
+ *
+ * @param path The path of the file.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importObjMesh(const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Imports a Wavefront OBJ file already read into memory.
+ * @param source The contents of the file.
+ * @param path The path the file was read from, for logging.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importObjMesh(const AssetBlob& source, const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Imports every triangle primitive of a glTF 2.0 file, in the default scene's node transforms, as one mesh.
+ *
+ * Supports .gltf with external or embedded base64 buffers and binary .glb files. Primitives are converted in parallel
+ * into ranges of the output sized up front.
+ *
+ * @param path The path of the file.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importGltfMesh(const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Imports a glTF 2.0 file already read into memory. External buffers are still read from their files.
+ * @param source The contents of the .gltf or .glb file.
+ * @param path The path the file was read from, which external buffers are relative to.
+ * @param mesh Receives the geometry.
+ * @return true if the file was imported.
+ */
+bool importGltfMesh(const AssetBlob& source, const std::string& path, MeshData& mesh);
+
+/**
+ * @brief Gets the other files a mesh source reads, such as the external buffers of a .gltf.
+ * @param path The path of the mesh source.
+ * @return std::vector<std::string> The paths of the files it depends on, not including itself.
+ */
+std::vector<std::string> getMeshImportDependencies(const std::string& path);
@@ -0,0 +1,302 @@
+#include "MeshOptimizer.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Size of the modelled post-transform cache. Larger than most hardware, which does no harm to the ordering.
+static constexpr int VERTEX_CACHE_SIZE = 32;
+
+static constexpr float CACHE_DECAY_POWER = 1.5f;
+static constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+/**
+ * @brief Scores a vertex by its position in the cache and the number of triangles still to use it.
+ * @param cachePosition The position of the vertex in the cache, or -1 if it is not cached.
+ * @param remainingTriangles The number of triangles using the vertex that have not been emitted.
+ */
+static float scoreVertex(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // The last triangle's vertices score a fixed amount, so the next one isn't biased towards any of them
+        if (cachePosition < 3) {
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scale = 1.0f / (VERTEX_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+        }
+    }
+
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+}
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Triangles using each vertex, as one flat list with an offset per vertex
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        ++remaining[index];
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+        adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remaining[vertex];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        for (int corner = 0; corner < 3; ++corner) {
+            adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+        vertexScores[vertex] = scoreVertex(-1, remaining[vertex]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    // Room for the current cache plus the three vertices pushed in ahead of it
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+    nextCache.reserve(VERTEX_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    int64_t bestTriangle = -1;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        // Nothing in the cache scored, so fall back to the next triangle in the original order
+        if (bestTriangle < 0) {
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            bestTriangle = static_cast<int64_t>(scanCursor);
+        }
+
+        const uint32_t* corners = &indices[bestTriangle * 3];
+        result.insert(result.end(), corners, corners + 3);
+        emitted[bestTriangle] = true;
+
+        // The triangle's vertices move to the front of the cache, and no longer count it as remaining
+        nextCache.assign(corners, corners + 3);
+        for (int corner = 0; corner < 3; ++corner) {
+            const uint32_t vertex = corners[corner];
+            const uint32_t begin = adjacencyOffsets[vertex];
+            const uint32_t end = begin + remaining[vertex];
+            std::swap(*std::find(adjacency.begin() + begin, adjacency.begin() + end, static_cast<uint32_t>(bestTriangle)),
+                adjacency[end - 1]);
+            --remaining[vertex];
+        }
+        for (uint32_t vertex : cache) {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        // Rescore every vertex that moved within or dropped out of the cache, and the triangles that use them
+        for (size_t position = 0; position < nextCache.size(); ++position) {
+            const uint32_t vertex = nextCache[position];
+            cachePositions[vertex] = position < VERTEX_CACHE_SIZE ? static_cast<int>(position) : -1;
+            vertexScores[vertex] = scoreVertex(cachePositions[vertex], remaining[vertex]);
+        }
+
+        float bestScore = -1.0f;
+        bestTriangle = -1;
+        for (uint32_t vertex : nextCache) {
+            const uint32_t begin = adjacencyOffsets[vertex];
+            for (uint32_t i = begin; i < begin + remaining[vertex]; ++i) {
+                const uint32_t triangle = adjacency[i];
+                const float score = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] +
+                    vertexScores[indices[triangle * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        if (nextCache.size() > VERTEX_CACHE_SIZE) {
+            nextCache.resize(VERTEX_CACHE_SIZE);
+        }
+        std::swap(cache, nextCache);
+    }
+
+    indices = std::move(result);
+}
+
+void optimizeVertexFetch(MeshData& mesh) {
+    const uint32_t stride = mesh.layout.getStride();
+    const uint32_t vertexCount = mesh.getVertexCount();
+
+    constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    std::vector<uint8_t> vertices(mesh.vertices.size());
+
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = nextVertex;
+            std::memcpy(&vertices[static_cast<size_t>(nextVertex) * stride], &mesh.vertices[static_cast<size_t>(index) * stride], stride);
+            ++nextVertex;
+        }
+        index = remap[index];
+    }
+
+    vertices.resize(static_cast<size_t>(nextVertex) * stride);
+    mesh.vertices = std::move(vertices);
+}
+
+void calculateMeshBounds(MeshData& mesh) {
+    mesh.bounds = MeshBounds();
+
+    const BufferElement* position = mesh.findAttribute(MESH_ATTRIBUTE_POSITION);
+    if (!position || position->dataType != ShaderDataType::Float3 || mesh.getVertexCount() == 0) {
+        return;
+    }
+
+    const uint32_t stride = mesh.layout.getStride();
+    auto readPosition = [&](uint32_t vertex) {
+        glm::vec3 value;
+        std::memcpy(&value, &mesh.vertices[static_cast<size_t>(vertex) * stride + position->offset], sizeof(value));
+        return value;
+    };
+
+    mesh.bounds.min = glm::vec3(std::numeric_limits<float>::max());
+    mesh.bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+    for (uint32_t vertex = 0; vertex < mesh.getVertexCount(); ++vertex) {
+        const glm::vec3 value = readPosition(vertex);
+        mesh.bounds.min = glm::min(mesh.bounds.min, value);
+        mesh.bounds.max = glm::max(mesh.bounds.max, value);
+        mesh.bounds.radius = std::max(mesh.bounds.radius, glm::length(value));
+    }
+
+    const BufferElement* texCoord = mesh.findAttribute(MESH_ATTRIBUTE_TEXCOORD);
+    if (!texCoord || texCoord->dataType != ShaderDataType::Float2) {
+        return;
+    }
+
+    auto readTexCoord = [&](uint32_t vertex) {
+        glm::vec2 value;
+        std::memcpy(&value, &mesh.vertices[static_cast<size_t>(vertex) * stride + texCoord->offset], sizeof(value));
+        return value;
+    };
+
+    // Ratio of total texture space area to total surface area, so large triangles weigh more than slivers
+    float surfaceArea = 0.0f;
+    float uvArea = 0.0f;
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const glm::vec3 p0 = readPosition(mesh.indices[i]);
+        const glm::vec2 t0 = readTexCoord(mesh.indices[i]);
+        const glm::vec3 edge1 = readPosition(mesh.indices[i + 1]) - p0;
+        const glm::vec3 edge2 = readPosition(mesh.indices[i + 2]) - p0;
+        const glm::vec2 uvEdge1 = readTexCoord(mesh.indices[i + 1]) - t0;
+        const glm::vec2 uvEdge2 = readTexCoord(mesh.indices[i + 2]) - t0;
+
+        surfaceArea += 0.5f * glm::length(glm::cross(edge1, edge2));
+        uvArea += 0.5f * std::abs(uvEdge1.x * uvEdge2.y - uvEdge1.y * uvEdge2.x);
+    }
+
+    mesh.bounds.uvDensity = surfaceArea > 0.0f ? std::sqrt(uvArea / surfaceArea) : 0.0f;
+}
+
+/**
+ * @brief Picks the compact format an attribute is stored in.
+ * @return BufferElement The quantized attribute, or a copy of the original if it stays as it is.
+ */
+static BufferElement quantizedElement(const BufferElement& element) {
+    if (element.name == MESH_ATTRIBUTE_NORMAL && element.dataType == ShaderDataType::Float3) {
+        return BufferElement(element.name, ShaderDataType::Short4, true);
+    }
+    if (element.name == MESH_ATTRIBUTE_COLOR &&
+        (element.dataType == ShaderDataType::Float3 || element.dataType == ShaderDataType::Float4)) {
+        return BufferElement(element.name, ShaderDataType::UByte4, true);
+    }
+    if (element.name == MESH_ATTRIBUTE_TEXCOORD && element.dataType == ShaderDataType::Float2) {
+        return BufferElement(element.name, ShaderDataType::Half2, false);
+    }
+    return BufferElement(element.name, element.dataType, element.normalised);
+}
+
+MeshData quantizeMesh(const MeshData& mesh) {
+    std::vector<BufferElement> elements;
+    elements.reserve(mesh.layout.getElements().size());
+    for (const BufferElement& element : mesh.layout) {
+        elements.push_back(quantizedElement(element));
+    }
+
+    MeshData result;
+    result.layout = BufferLayout(std::move(elements));
+    result.indices = mesh.indices;
+    result.bounds = mesh.bounds;
+
+    const uint32_t vertexCount = mesh.getVertexCount();
+    const uint32_t sourceStride = mesh.layout.getStride();
+    const uint32_t targetStride = result.layout.getStride();
+    result.vertices.resize(static_cast<size_t>(vertexCount) * targetStride);
+
+    const std::vector<BufferElement>& sourceElements = mesh.layout.getElements();
+    const std::vector<BufferElement>& targetElements = result.layout.getElements();
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+        const uint8_t* source = &mesh.vertices[static_cast<size_t>(vertex) * sourceStride];
+        uint8_t* target = &result.vertices[static_cast<size_t>(vertex) * targetStride];
+
+        for (size_t i = 0; i < sourceElements.size(); ++i) {
+            const BufferElement& from = sourceElements[i];
+            const BufferElement& to = targetElements[i];
+            if (from.dataType == to.dataType) {
+                std::memcpy(target + to.offset, source + from.offset, from.size);
+                continue;
+            }
+
+            float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+            std::memcpy(values, source + from.offset, from.size);
+
+            switch (to.dataType) {
+                case ShaderDataType::Short4: {
+                    int16_t packed[4] = {};
+                    for (int c = 0; c < 3; ++c) {
+                        packed[c] = static_cast<int16_t>(std::round(std::clamp(values[c], -1.0f, 1.0f) * 32767.0f));
+                    }
+                    std::memcpy(target + to.offset, packed, sizeof(packed));
+                    break;
+                }
+                case ShaderDataType::UByte4: {
+                    uint8_t packed[4];
+                    for (int c = 0; c < 4; ++c) {
+                        packed[c] = static_cast<uint8_t>(std::round(std::clamp(values[c], 0.0f, 1.0f) * 255.0f));
+                    }
+                    std::memcpy(target + to.offset, packed, sizeof(packed));
+                    break;
+                }
+                case ShaderDataType::Half2: {
+                    const uint16_t packed[2] = { glm::packHalf1x16(values[0]), glm::packHalf1x16(values[1]) };
+                    std::memcpy(target + to.offset, packed, sizeof(packed));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    return result;
+}
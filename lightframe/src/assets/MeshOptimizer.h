@@ -0,0 +1,50 @@
+/**
+ * @file MeshOptimizer.h
+ * @author Justin McKay
+ * @brief Cook-time mesh processing: vertex cache and fetch ordering, bounds measurement and attribute quantization.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include "rendering/MeshData.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Reorders triangles so vertices are reused while they are still in the post-transform cache.
+ *
+ * Uses Tom Forsyth's linear-speed algorithm: each step emits the triangle whose vertices score best, favouring
+ * vertices that are already cached and those with few triangles left to draw, so stragglers aren't stranded.
+ *
+ * @param indices The triangle list indices, reordered in place.
+ * @param vertexCount The number of vertices the indices refer to.
+ */
+void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+/**
+ * @brief Reorders vertices into the order the indices first use them and drops unreferenced vertices, so the
+ * vertex fetch walks memory forwards. Run after optimizeVertexCache.
+ * @param mesh The mesh to reorder.
+ */
+void optimizeVertexFetch(MeshData& mesh);
+
+/**
+ * @brief Measures the bounding box, bounding radius and texture density of a mesh.
+ * Positions must be Float3; texture density is measured from Float2 texture coordinates if there are any.
+ * @param mesh The mesh to measure. Its bounds are overwritten.
+ */
+void calculateMeshBounds(MeshData& mesh);
+
+/**
+ * @brief Converts attributes to compact formats, recognising them by their conventional names.
+ *
+ * Normals become normalised 16-bit integers, colors normalised 8-bit integers and texture coordinates 16-bit floats.
+ * Positions and unrecognised attributes keep their format. Shaders read every converted attribute as floats, so
+ * none need changing.
+ *
+ * @param mesh The mesh to quantize. Its bounds must already be measured.
+ * @return MeshData The quantized mesh.
+ */
+MeshData quantizeMesh(const MeshData& mesh);
@@ -0,0 +1,355 @@
+#include "TextureAtlas.h"
+
+#include "assets/VirtualFileSystem.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "rendering/MipGenerator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+static constexpr uint32_t ATLAS_TABLE_VERSION = 1;
+
+/**
+ * @brief Rounds a value up to a multiple of a power of two.
+ */
+static uint32_t alignUp(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static bool contains(const AtlasRect& outer, const AtlasRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+}
+
+/**
+ * @brief Copies the base level of an RGB8 or RGBA8 image into a new RGBA8 image, with opaque alpha for RGB8.
+ */
+static Image toRgba(const Image& image) {
+    if (image.format == ImageFormat::RGBA8) {
+        return Image::fromPixels(image.getMipData(0), image.width, image.height, 4, image.srgb);
+    }
+
+    const size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+    std::vector<uint8_t> pixels(pixelCount * 4);
+    const uint8_t* source = image.getMipData(0);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        pixels[i * 4 + 0] = source[i * 3 + 0];
+        pixels[i * 4 + 1] = source[i * 3 + 1];
+        pixels[i * 4 + 2] = source[i * 3 + 2];
+        pixels[i * 4 + 3] = 255;
+    }
+    return Image::fromPixels(pixels.data(), image.width, image.height, 4, image.srgb);
+}
+
+RectPacker::RectPacker(uint32_t width, uint32_t height)
+    : _width(width), _height(height) {
+    _freeRects.push_back(AtlasRect { .x = 0, .y = 0, .width = width, .height = height });
+}
+
+bool RectPacker::insert(uint32_t width, uint32_t height, AtlasRect& rect) {
+    const AtlasRect* best = nullptr;
+    uint32_t bestShortSide = UINT32_MAX;
+    uint32_t bestLongSide = UINT32_MAX;
+
+    // Best short side fit: the free rectangle that leaves the smallest leftover strip
+    for (const AtlasRect& freeRect : _freeRects) {
+        if (freeRect.width < width || freeRect.height < height) {
+            continue;
+        }
+
+        const uint32_t leftoverX = freeRect.width - width;
+        const uint32_t leftoverY = freeRect.height - height;
+        const uint32_t shortSide = std::min(leftoverX, leftoverY);
+        const uint32_t longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            best = &freeRect;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    if (!best) {
+        return false;
+    }
+
+    rect = AtlasRect { .x = best->x, .y = best->y, .width = width, .height = height };
+    splitFreeRects(rect);
+    pruneFreeRects();
+
+    _usedWidth = std::max(_usedWidth, rect.x + rect.width);
+    _usedHeight = std::max(_usedHeight, rect.y + rect.height);
+    return true;
+}
+
+void RectPacker::splitFreeRects(const AtlasRect& placed) {
+    std::vector<AtlasRect> freeRects;
+    freeRects.reserve(_freeRects.size() + 4);
+
+    for (const AtlasRect& freeRect : _freeRects) {
+        if (!overlaps(freeRect, placed)) {
+            freeRects.push_back(freeRect);
+            continue;
+        }
+
+        // Keep the full-height strips either side and the full-width strips above and below
+        const uint32_t freeRight = freeRect.x + freeRect.width;
+        const uint32_t freeTop = freeRect.y + freeRect.height;
+        const uint32_t placedRight = placed.x + placed.width;
+        const uint32_t placedTop = placed.y + placed.height;
+
+        if (placed.x > freeRect.x) {
+            freeRects.push_back(AtlasRect { freeRect.x, freeRect.y, placed.x - freeRect.x, freeRect.height });
+        }
+        if (placedRight < freeRight) {
+            freeRects.push_back(AtlasRect { placedRight, freeRect.y, freeRight - placedRight, freeRect.height });
+        }
+        if (placed.y > freeRect.y) {
+            freeRects.push_back(AtlasRect { freeRect.x, freeRect.y, freeRect.width, placed.y - freeRect.y });
+        }
+        if (placedTop < freeTop) {
+            freeRects.push_back(AtlasRect { freeRect.x, placedTop, freeRect.width, freeTop - placedTop });
+        }
+    }
+
+    _freeRects = std::move(freeRects);
+}
+
+void RectPacker::pruneFreeRects() {
+    std::vector<bool> removed(_freeRects.size(), false);
+
+    for (size_t i = 0; i < _freeRects.size(); ++i) {
+        for (size_t j = 0; j < _freeRects.size(); ++j) {
+            // Of two identical rectangles, the first is removed and the second kept
+            if (i != j && !removed[j] && contains(_freeRects[j], _freeRects[i])) {
+                removed[i] = true;
+                break;
+            }
+        }
+    }
+
+    size_t index = 0;
+    std::erase_if(_freeRects, [&](const AtlasRect&) { return removed[index++]; });
+}
+
+std::vector<Image> buildAtlases(const std::vector<AtlasSource>& sources, const AtlasSettings& settings,
+    std::vector<AtlasRegion>& regions) {
+
+    // Every region sits on a grid that stays whole down to the last level, with a gutter of at least one texel there
+    const uint32_t mipCount = std::max(settings.mipCount, 1u);
+    const uint32_t alignment = 1u << (mipCount - 1);
+    const uint32_t padding = alignUp(std::max(settings.padding, alignment), alignment);
+    const uint32_t maxSize = std::bit_floor(std::max(settings.maxSize, alignment));
+
+    struct Placement {
+        size_t source;
+        uint32_t atlas;
+        AtlasRect rect;
+    };
+
+    // Largest first packs tightest
+    std::vector<size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](size_t a, size_t b) {
+        const Image& imageA = sources[a].image;
+        const Image& imageB = sources[b].image;
+        const uint32_t sideA = std::max(imageA.width, imageA.height);
+        const uint32_t sideB = std::max(imageB.width, imageB.height);
+        if (sideA != sideB) {
+            return sideA > sideB;
+        }
+        return static_cast<uint64_t>(imageA.width) * imageA.height > static_cast<uint64_t>(imageB.width) * imageB.height;
+    });
+
+    std::vector<RectPacker> packers;
+    std::vector<Placement> placements;
+    placements.reserve(sources.size());
+
+    for (size_t sourceIndex : order) {
+        const AtlasSource& source = sources[sourceIndex];
+        if (source.image.format != ImageFormat::RGB8 && source.image.format != ImageFormat::RGBA8) {
+            LOG_WARN("Unable to atlas {}; only uncompressed RGB and RGBA images can be packed.", source.name);
+            continue;
+        }
+
+        const uint32_t width = alignUp(source.image.width + padding * 2, alignment);
+        const uint32_t height = alignUp(source.image.height + padding * 2, alignment);
+        if (width > maxSize || height > maxSize) {
+            LOG_WARN("Unable to atlas {}; it is too large for a {}x{} atlas.", source.name, maxSize, maxSize);
+            continue;
+        }
+
+        Placement placement = { .source = sourceIndex };
+        bool placed = false;
+        for (uint32_t atlas = 0; atlas < packers.size() && !placed; ++atlas) {
+            placed = packers[atlas].insert(width, height, placement.rect);
+            placement.atlas = atlas;
+        }
+        if (!placed) {
+            packers.emplace_back(maxSize, maxSize);
+            packers.back().insert(width, height, placement.rect);
+            placement.atlas = static_cast<uint32_t>(packers.size() - 1);
+        }
+        placements.push_back(placement);
+    }
+
+    // Shrink each atlas to the power of two that holds what was placed in it
+    std::vector<Image> atlases(packers.size());
+    for (size_t i = 0; i < atlases.size(); ++i) {
+        Image& atlas = atlases[i];
+        atlas.width = std::bit_ceil(std::max(packers[i].getUsedWidth(), alignment));
+        atlas.height = std::bit_ceil(std::max(packers[i].getUsedHeight(), alignment));
+        atlas.channels = 4;
+        atlas.format = ImageFormat::RGBA8;
+        atlas.srgb = settings.srgb;
+
+        size_t offset = 0;
+        const uint32_t levels = std::min(mipCount, Image::calcMipCount(atlas.width, atlas.height));
+        for (uint32_t level = 0; level < levels; ++level) {
+            const uint32_t levelWidth = std::max(1u, atlas.width >> level);
+            const uint32_t levelHeight = std::max(1u, atlas.height >> level);
+            const size_t size = static_cast<size_t>(levelWidth) * levelHeight * 4;
+            atlas.mips.push_back(ImageMip { .width = levelWidth, .height = levelHeight, .offset = offset, .size = size });
+            offset += size;
+        }
+        atlas.data.assign(offset, 0);
+    }
+
+    // Regions don't overlap, so sources are filtered and copied in parallel
+    ThreadPool::get()->parallelFor(placements.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Placement& placement = placements[i];
+            Image& atlas = atlases[placement.atlas];
+
+            Image image = toRgba(sources[placement.source].image);
+            image.srgb = settings.srgb;
+            if (atlas.getMipCount() > 1) {
+                generateMipChain(image, settings.mipFilter);
+            }
+
+            for (uint32_t level = 0; level < atlas.getMipCount(); ++level) {
+                const ImageMip& sourceMip = image.mips[std::min(level, image.getMipCount() - 1)];
+                const uint8_t* sourceData = image.data.data() + sourceMip.offset;
+                uint8_t* atlasData = atlas.getMipData(level);
+                const size_t atlasPitch = static_cast<size_t>(atlas.mips[level].width) * 4;
+
+                // Fill the whole padded rectangle, clamping to the source so the gutter repeats its edge texels
+                const int gutter = static_cast<int>(padding >> level);
+                const uint32_t rectX = placement.rect.x >> level;
+                const uint32_t rectY = placement.rect.y >> level;
+                const uint32_t rectWidth = placement.rect.width >> level;
+                const uint32_t rectHeight = placement.rect.height >> level;
+
+                for (uint32_t y = 0; y < rectHeight; ++y) {
+                    const int sourceY = std::clamp(static_cast<int>(y) - gutter, 0, static_cast<int>(sourceMip.height) - 1);
+                    const uint8_t* sourceRow = sourceData + static_cast<size_t>(sourceY) * sourceMip.width * 4;
+                    uint8_t* atlasRow = atlasData + (rectY + y) * atlasPitch + static_cast<size_t>(rectX) * 4;
+
+                    for (uint32_t x = 0; x < rectWidth; ++x) {
+                        const int sourceX = std::clamp(static_cast<int>(x) - gutter, 0, static_cast<int>(sourceMip.width) - 1);
+                        std::memcpy(atlasRow + x * 4, sourceRow + sourceX * 4, 4);
+                    }
+                }
+            }
+        }
+    });
+
+    // Report regions in the order the sources were given
+    std::ranges::sort(placements, {}, &Placement::source);
+    regions.clear();
+    regions.reserve(placements.size());
+    for (const Placement& placement : placements) {
+        const Image& source = sources[placement.source].image;
+        const Image& atlas = atlases[placement.atlas];
+        const float atlasWidth = static_cast<float>(atlas.width);
+        const float atlasHeight = static_cast<float>(atlas.height);
+
+        regions.push_back(AtlasRegion {
+            .name = sources[placement.source].name,
+            .atlasIndex = placement.atlas,
+            .uvTransform = glm::vec4(
+                static_cast<float>(source.width) / atlasWidth,
+                static_cast<float>(source.height) / atlasHeight,
+                static_cast<float>(placement.rect.x + padding) / atlasWidth,
+                static_cast<float>(placement.rect.y + padding) / atlasHeight)
+        });
+    }
+
+    LOG_INFO("Packed {} of {} textures into {} atlases.", placements.size(), sources.size(), atlases.size());
+    return atlases;
+}
+
+bool writeAtlasTable(const std::string& path, const TextureAtlasTable& table) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        LOG_WARN("Unable to open atlas table {} for writing.", path);
+        return false;
+    }
+
+    file << "# Lightframe texture atlas table\n";
+    file << std::format("version {}\n", ATLAS_TABLE_VERSION);
+    for (const std::string& atlasPath : table.atlasPaths) {
+        file << std::format("atlas {}\n", atlasPath);
+    }
+
+    // The name goes last, as it may contain spaces
+    for (const AtlasRegion& region : table.regions) {
+        file << std::format("region {} {} {} {} {} {}\n", region.atlasIndex, region.uvTransform.x, region.uvTransform.y,
+            region.uvTransform.z, region.uvTransform.w, region.name);
+    }
+    return file.good();
+}
+
+bool readAtlasTable(const std::string& path, TextureAtlasTable& table) {
+    AssetBlob blob;
+    if (!VirtualFileSystem::get()->read(path, blob)) {
+        return false;
+    }
+    std::istringstream file(std::string(reinterpret_cast<const char*>(blob.data.data()), blob.data.size()));
+
+    table = TextureAtlasTable();
+    uint32_t version = 0;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+
+        if (keyword == "version") {
+            stream >> version;
+        } else if (keyword == "atlas") {
+            std::string atlasPath;
+            std::getline(stream >> std::ws, atlasPath);
+            table.atlasPaths.push_back(atlasPath);
+        } else if (keyword == "region") {
+            AtlasRegion region;
+            stream >> region.atlasIndex >> region.uvTransform.x >> region.uvTransform.y >> region.uvTransform.z >> region.uvTransform.w;
+            std::getline(stream >> std::ws, region.name);
+            if (!stream || region.atlasIndex >= table.atlasPaths.size()) {
+                LOG_WARN("Atlas table {} has an invalid region: {}", path, line);
+                return false;
+            }
+            table.regions.push_back(std::move(region));
+        }
+    }
+
+    if (version != ATLAS_TABLE_VERSION) {
+        LOG_WARN("Atlas table {} is not a version {} table.", path, ATLAS_TABLE_VERSION);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file TextureAtlas.h
+ * @author Justin McKay
+ * @brief Cook-time packing of small textures into atlases, and the UV remap tables that map each source into them.
+ * @date 2026-03-15
+ */
+
+#pragma once
+
+#include "rendering/Image.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A rectangle within an atlas, in pixels of the base level.
+ */
+struct AtlasRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * @brief MaxRects rectangle packer using the best short side fit heuristic.
+ *
+ * Tracks the maximal free rectangles left in the bin and places each new rectangle in the free one it fills most
+ * tightly. Rectangles are never rotated, so UV remapping stays a scale and offset.
+ */
+class RectPacker {
+public:
+
+    /**
+     * @brief Creates an empty bin.
+     * @param width The width of the bin.
+     * @param height The height of the bin.
+     */
+    RectPacker(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Places a rectangle in the bin.
+     * @param width The width of the rectangle.
+     * @param height The height of the rectangle.
+     * @param rect Receives the placed rectangle.
+     * @return true if the rectangle fit.
+     */
+    bool insert(uint32_t width, uint32_t height, AtlasRect& rect);
+
+    /**
+     * @brief Gets the right edge of the rightmost placed rectangle.
+     */
+    uint32_t getUsedWidth() const { return _usedWidth; }
+
+    /**
+     * @brief Gets the top edge of the topmost placed rectangle.
+     */
+    uint32_t getUsedHeight() const { return _usedHeight; }
+
+private:
+    // Size of the bin
+    uint32_t _width;
+    uint32_t _height;
+
+    // Extent of the placed rectangles
+    uint32_t _usedWidth = 0;
+    uint32_t _usedHeight = 0;
+
+    // Maximal free rectangles; they overlap one another, but none contains another
+    std::vector<AtlasRect> _freeRects;
+
+    /**
+     * @brief Splits every free rectangle that overlaps a newly placed one into the parts left free around it.
+     */
+    void splitFreeRects(const AtlasRect& placed);
+
+    /**
+     * @brief Removes free rectangles contained in another free rectangle.
+     */
+    void pruneFreeRects();
+};
+
+/**
+ * @brief Options for building atlases.
+ */
+struct AtlasSettings {
+    uint32_t maxSize = 2048;                        ///< Largest width and height of an atlas
+    uint32_t padding = 8;                           ///< Gutter around each source at the base level, in pixels
+    uint32_t mipCount = 4;                          ///< Mip levels generated; each keeps a gutter of at least one texel
+    MipFilter mipFilter = MipFilter::Kaiser;        ///< Filter used to build the mips of each source
+    bool srgb = true;                               ///< Whether the sources are sRGB encoded
+};
+
+/**
+ * @brief A source image to pack.
+ */
+struct AtlasSource {
+    std::string name;       ///< Name the region is looked up by at runtime, usually the source path
+    Image image;            ///< Uncompressed RGB8 or RGBA8 base level
+};
+
+/**
+ * @brief Where a source ended up: which atlas, and the transform from its own UVs to the atlas's.
+ */
+struct AtlasRegion {
+    std::string name;                               ///< Name of the source
+    uint32_t atlasIndex = 0;                        ///< Index of the atlas holding the source
+    glm::vec4 uvTransform = glm::vec4(1, 1, 0, 0);  ///< Scale (xy) and offset (zw) applied to the source UVs
+};
+
+/**
+ * @brief UV remap table written alongside the atlases, mapping each packed source to its atlas and region.
+ */
+struct TextureAtlasTable {
+    std::vector<std::string> atlasPaths;            ///< Texture file of each atlas, relative to the table file
+    std::vector<AtlasRegion> regions;               ///< Region of every packed source
+};
+
+/**
+ * @brief Packs source images into as few atlases as possible.
+ *
+ * Sources are placed on a grid of 2^(mipCount - 1) pixels with at least `padding` pixels of gutter around them, so
+ * every region lands on whole texels at every generated level. Each source's mip chain is built on its own and the
+ * gutters are refilled from the region's edge texels at each level, so filtering never bleeds between neighbours.
+ * Sources too large to fit an atlas are left out of the result.
+ *
+ * @param sources The images to pack.
+ * @param settings The atlas options.
+ * @param regions Receives the region of each packed source.
+ * @return std::vector<Image> The RGBA8 atlases, with mipCount levels each.
+ */
+std::vector<Image> buildAtlases(const std::vector<AtlasSource>& sources, const AtlasSettings& settings,
+    std::vector<AtlasRegion>& regions);
+
+/**
+ * @brief Writes a UV remap table as text.
+ * @param path The path of the .lfatlas file to write.
+ * @param table The table to write.
+ * @return true if the file was written.
+ */
+bool writeAtlasTable(const std::string& path, const TextureAtlasTable& table);
+
+/**
+ * @brief Reads a UV remap table written by writeAtlasTable.
+ * @param path The path of the .lfatlas file to read.
+ * @param table Receives the table.
+ * @return true if the file was read and is valid.
+ */
+bool readAtlasTable(const std::string& path, TextureAtlasTable& table);
@@ -0,0 +1,169 @@
+#include "TextureFile.h"
+
+#include "assets/VirtualFileSystem.h"
+#include "core/Logger.h"
+
+#include <stb/stb_image.h>
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+// "LFTX" - Lightframe texture
+static constexpr uint32_t TEXTURE_FILE_MAGIC = 0x5854464C;
+static constexpr uint32_t TEXTURE_FILE_VERSION = 1;
+
+/**
+ * @brief Header written at the start of every cooked texture file, followed by a TextureFileMip per level and then
+ * the pixel data of every level.
+ */
+struct TextureFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t format;
+    uint32_t srgb;
+    uint32_t mipCount;
+    uint64_t dataSize;
+};
+
+/**
+ * @brief Location and dimensions of one level within the data of a cooked texture file.
+ */
+struct TextureFileMip {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+/**
+ * @brief Checks a texture file header and copies its description into an image.
+ * @param header The header read from the file.
+ * @param path The path of the file, for logging.
+ * @param image Receives the dimensions and format. Its levels and data are cleared.
+ * @return true if the header is valid.
+ */
+static bool readHeader(const TextureFileHeader& header, const std::string& path, Image& image) {
+    if (header.magic != TEXTURE_FILE_MAGIC || header.version != TEXTURE_FILE_VERSION ||
+        header.mipCount == 0 || header.format > static_cast<uint32_t>(ImageFormat::BC7)) {
+        LOG_WARN("Texture file {} is not a valid version {} texture.", path, TEXTURE_FILE_VERSION);
+        return false;
+    }
+
+    image = Image();
+    image.width = header.width;
+    image.height = header.height;
+    image.channels = header.channels;
+    image.format = static_cast<ImageFormat>(header.format);
+    image.srgb = header.srgb != 0;
+    image.mips.reserve(header.mipCount);
+    return true;
+}
+
+/**
+ * @brief Checks a level of a texture file's mip table and adds it to an image.
+ * @return true if the level lies within the pixel data.
+ */
+static bool readMip(const TextureFileMip& fileMip, const TextureFileHeader& header, const std::string& path, Image& image) {
+    if (fileMip.offset + fileMip.size > header.dataSize) {
+        LOG_WARN("Texture file {} has an invalid mip table.", path);
+        return false;
+    }
+    image.mips.push_back(ImageMip { .width = fileMip.width, .height = fileMip.height, .offset = fileMip.offset, .size = fileMip.size });
+    return true;
+}
+
+bool writeTextureFile(const std::string& path, const Image& image) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_WARN("Unable to open texture file {} for writing.", path);
+        return false;
+    }
+
+    const TextureFileHeader header = {
+        .magic = TEXTURE_FILE_MAGIC,
+        .version = TEXTURE_FILE_VERSION,
+        .width = image.width,
+        .height = image.height,
+        .channels = image.channels,
+        .format = static_cast<uint32_t>(image.format),
+        .srgb = image.srgb ? 1u : 0u,
+        .mipCount = image.getMipCount(),
+        .dataSize = image.getDataSize()
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const ImageMip& mip : image.mips) {
+        const TextureFileMip fileMip = { .width = mip.width, .height = mip.height, .offset = mip.offset, .size = mip.size };
+        file.write(reinterpret_cast<const char*>(&fileMip), sizeof(fileMip));
+    }
+
+    file.write(reinterpret_cast<const char*>(image.getData()), static_cast<std::streamsize>(image.getDataSize()));
+    return file.good();
+}
+
+bool readTextureFile(const std::string& path, Image& image) {
+    AssetBlob blob;
+    return VirtualFileSystem::get()->read(path, blob) && readTextureFile(blob, path, image);
+}
+
+bool readTextureFile(const AssetBlob& blob, const std::string& path, Image& image) {
+    TextureFileHeader header = {};
+    if (blob.data.size() < sizeof(header)) {
+        LOG_WARN("Texture file {} is truncated.", path);
+        return false;
+    }
+    std::memcpy(&header, blob.data.data(), sizeof(header));
+    if (!readHeader(header, path, image)) {
+        return false;
+    }
+
+    const size_t dataOffset = sizeof(header) + static_cast<size_t>(header.mipCount) * sizeof(TextureFileMip);
+    if (blob.data.size() < dataOffset + header.dataSize) {
+        LOG_WARN("Texture file {} is truncated.", path);
+        return false;
+    }
+
+    for (uint32_t level = 0; level < header.mipCount; ++level) {
+        TextureFileMip fileMip = {};
+        std::memcpy(&fileMip, blob.data.data() + sizeof(header) + level * sizeof(TextureFileMip), sizeof(fileMip));
+        if (!readMip(fileMip, header, path, image)) {
+            return false;
+        }
+    }
+
+    // The levels are laid out exactly as an image stores them, so they can be used in place
+    image.mappedData = blob.share(dataOffset);
+    image.mappedSize = header.dataSize;
+    return true;
+}
+
+bool readImageFile(const std::string& path, bool srgb, Image& image) {
+    AssetBlob blob;
+    return VirtualFileSystem::get()->read(path, blob) && readImageFile(blob, path, srgb, image);
+}
+
+bool readImageFile(const AssetBlob& blob, const std::string& path, bool srgb, Image& image) {
+    if (std::string_view(path).ends_with(".lftex")) {
+        return readTextureFile(blob, path, image);
+    }
+
+    // The flip flag is global unless set per thread, and other workers may be decoding at the same time
+    int width;
+    int height;
+    int channels;
+    stbi_set_flip_vertically_on_load_thread(1);
+    stbi_uc* pixels = stbi_load_from_memory(blob.data.data(), static_cast<int>(blob.data.size()), &width, &height, &channels, 0);
+
+    if (!pixels || (channels != 3 && channels != 4)) {
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    image = Image::fromPixels(pixels, width, height, channels, srgb);
+    stbi_image_free(pixels);
+    return true;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file TextureFile.h
+ * @author Justin McKay
+ * @brief Reading and writing of cooked .lftex textures, which store an image with its mip chain ready for upload.
+ * @date 2026-03-15
+ */
+
+#pragma once
+
+#include "assets/AssetArchive.h"
+#include "rendering/Image.h"
+
+#include <string>
+
+/**
+ * @brief Writes an image and all of its mip levels to a cooked texture file.
+ * @param path The path of the .lftex file to write.
+ * @param image The image to write, compressed or not.
+ * @return true if the file was written.
+ */
+bool writeTextureFile(const std::string& path, const Image& image);
+
+/**
+ * @brief Reads a cooked texture file through the virtual file system without copying its pixel data.
+ * @param path The path of the .lftex file to read.
+ * @param image Receives the image and its mip levels.
+ * @return true if the file was read and is valid.
+ */
+bool readTextureFile(const std::string& path, Image& image);
+
+/**
+ * @brief Reads a cooked texture that has already been read into memory, without copying its pixel data.
+ * The image borrows its levels from the blob, keeping its storage alive until the image is destroyed.
+ * @param blob The contents of the .lftex file.
+ * @param path The path the blob was read from, for reporting errors.
+ * @param image Receives the image and its mip levels.
+ * @return true if the blob is a valid texture file.
+ */
+bool readTextureFile(const AssetBlob& blob, const std::string& path, Image& image);
+
+/**
+ * @brief Reads an image through the virtual file system: a cooked .lftex file with its mip chain, or any 3 or 4
+ * channel file stb_image can decode, as a single level flipped so the first row is the bottom of the image. Cooked
+ * files are borrowed from their archive or file mapping rather than copied.
+ * @param path The path of the image file.
+ * @param srgb Whether the color channels of a decoded file are sRGB encoded. Cooked files record their own.
+ * @param image Receives the image.
+ * @return true if the file was read.
+ */
+bool readImageFile(const std::string& path, bool srgb, Image& image);
+
+/**
+ * @brief Reads an image that has already been read into memory, as readImageFile() does. Cooked files borrow their
+ * levels from the blob.
+ * @param blob The contents of the image file.
+ * @param path The path the blob was read from, which identifies cooked files.
+ * @param srgb Whether the color channels of a decoded file are sRGB encoded. Cooked files record their own.
+ * @param image Receives the image.
+ * @return true if the blob was read.
+ */
+bool readImageFile(const AssetBlob& blob, const std::string& path, bool srgb, Image& image);
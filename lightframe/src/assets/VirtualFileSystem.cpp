@@ -0,0 +1,232 @@
+#include "VirtualFileSystem.h"
+
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+
+VirtualFileSystem* VirtualFileSystem::get() {
+    static VirtualFileSystem fileSystem;
+    return &fileSystem;
+}
+
+VirtualFileSystem::VirtualFileSystem() : _reader(AsyncFileReader::create()) {}
+
+VirtualFileSystem::~VirtualFileSystem() = default;
+
+std::string VirtualFileSystem::normalisePath(const std::string& path) {
+    std::string normalised = std::filesystem::absolute(path).lexically_normal().generic_string();
+    if (normalised.size() > 1 && normalised.back() == '/') {
+        normalised.pop_back();
+    }
+    return normalised;
+}
+
+bool VirtualFileSystem::mountDirectory(const std::string& directory, const std::string& mountPoint) {
+    if (!std::filesystem::is_directory(directory)) {
+        LOG_WARN("Unable to mount directory {}.", directory);
+        return false;
+    }
+
+    std::unique_lock lock(_mountMutex);
+    _mounts.push_back(Mount { .type = MountType::Directory, .mountPoint = normalisePath(mountPoint), .directory = normalisePath(directory) });
+    return true;
+}
+
+bool VirtualFileSystem::mountArchive(const std::string& archivePath, const std::string& mountPoint) {
+    std::unique_ptr<AssetArchive> archive = AssetArchive::open(archivePath);
+    if (!archive) {
+        LOG_WARN("Unable to mount archive {}.", archivePath);
+        return false;
+    }
+
+    std::unique_lock lock(_mountMutex);
+    _mounts.push_back(Mount { .type = MountType::Archive, .mountPoint = normalisePath(mountPoint), .archive = std::move(archive) });
+    return true;
+}
+
+void VirtualFileSystem::mountMemory(std::unordered_map<std::string, std::vector<uint8_t>> files, const std::string& mountPoint) {
+    Mount mount { .type = MountType::Memory, .mountPoint = normalisePath(mountPoint) };
+    for (auto& [name, contents] : files) {
+        mount.files.emplace(name, std::make_shared<const std::vector<uint8_t>>(std::move(contents)));
+    }
+
+    std::unique_lock lock(_mountMutex);
+    _mounts.push_back(std::move(mount));
+}
+
+void VirtualFileSystem::unmountAll() {
+    std::unique_lock lock(_mountMutex);
+    _mounts.clear();
+}
+
+bool VirtualFileSystem::resolve(const std::string& filePath, ResolvedPath& resolved) const {
+    resolved.diskPath = filePath;
+    if (_mounts.empty()) {
+        return false;
+    }
+
+    const std::string normalised = normalisePath(filePath);
+    for (auto it = _mounts.rbegin(); it != _mounts.rend(); ++it) {
+        const std::string& mountPoint = it->mountPoint;
+        if (normalised.size() <= mountPoint.size() || !normalised.starts_with(mountPoint) ||
+            normalised[mountPoint.size()] != '/') {
+            continue;
+        }
+
+        const std::string_view name = std::string_view(normalised).substr(mountPoint.size() + 1);
+        switch (it->type) {
+            case MountType::Directory: {
+                // Later mounts shadow earlier ones only for the files they actually contain
+                std::string diskPath = it->directory + '/' + std::string(name);
+                std::error_code error;
+                if (std::filesystem::is_regular_file(diskPath, error)) {
+                    resolved.diskPath = std::move(diskPath);
+                    return false;
+                }
+                break;
+            }
+            case MountType::Archive:
+                if (it->archive->locate(name, resolved.archiveFile)) {
+                    resolved.archive = it->archive;
+                    return true;
+                }
+                break;
+            case MountType::Memory:
+                if (auto file = it->files.find(std::string(name)); file != it->files.end()) {
+                    resolved.blob.data = std::span<const uint8_t>(file->second->data(), file->second->size());
+                    resolved.blob.owner = file->second;
+                    return true;
+                }
+                break;
+        }
+    }
+    return false;
+}
+
+bool VirtualFileSystem::read(const std::string& filePath, AssetBlob& blob) const {
+    ResolvedPath resolved;
+    bool packed;
+    {
+        std::shared_lock lock(_mountMutex);
+        packed = resolve(filePath, resolved);
+    }
+
+    // The resolved path holds the archive, so decompressing doesn't need to hold up mounting
+    if (packed && resolved.archive) {
+        return resolved.archive->read(resolved.archiveFile, blob);
+    } else if (packed) {
+        blob = std::move(resolved.blob);
+        return true;
+    }
+
+    // Missing files are reported by the loader asking for them, which knows what they were for
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(resolved.diskPath, error)) {
+        return false;
+    }
+
+    // Empty files can't be mapped, but are still valid files
+    if (std::filesystem::file_size(resolved.diskPath, error) == 0) {
+        blob = AssetBlob();
+        return true;
+    }
+
+    std::shared_ptr<MappedFile> mapping = MappedFile::open(resolved.diskPath);
+    if (!mapping) {
+        return false;
+    }
+    blob.data = std::span<const uint8_t>(mapping->getData(), mapping->getSize());
+    blob.owner = std::move(mapping);
+    return true;
+}
+
+bool VirtualFileSystem::isPacked(const std::string& filePath) const {
+    ResolvedPath resolved;
+    std::shared_lock lock(_mountMutex);
+    return resolve(filePath, resolved);
+}
+
+std::future<std::optional<AssetBlob>> VirtualFileSystem::readAsync(const std::string& filePath) {
+    auto promise = std::make_shared<std::promise<std::optional<AssetBlob>>>();
+    std::future<std::optional<AssetBlob>> future = promise->get_future();
+
+    ResolvedPath resolved;
+    {
+        std::shared_lock lock(_mountMutex);
+        if (resolve(filePath, resolved)) {
+            if (resolved.archive && resolved.archiveFile.isCompressed()) {
+                // The task holds the archive, so it stays mapped even if it is unmounted meanwhile
+                ThreadPool::get()->enqueue([promise, archive = std::move(resolved.archive), file = resolved.archiveFile]() {
+                    AssetBlob blob;
+                    promise->set_value(archive->read(file, blob) ? std::optional<AssetBlob>(std::move(blob)) : std::nullopt);
+                });
+            } else if (resolved.archive) {
+                AssetBlob blob;
+                resolved.archive->read(resolved.archiveFile, blob);
+                promise->set_value(std::move(blob));
+            } else {
+                promise->set_value(std::move(resolved.blob));
+            }
+            return future;
+        }
+    }
+
+    _reader->read(resolved.diskPath, [promise](std::shared_ptr<std::vector<uint8_t>> contents) {
+        if (!contents) {
+            promise->set_value(std::nullopt);
+            return;
+        }
+
+        AssetBlob blob;
+        blob.data = std::span<const uint8_t>(contents->data(), contents->size());
+        blob.owner = std::move(contents);
+        promise->set_value(std::move(blob));
+    });
+    return future;
+}
+
+void VirtualFileSystem::prefetch(const std::vector<std::string>& filePaths) const {
+    /**
+     * @brief An archived file to prefetch, located within its archive's mapping.
+     */
+    struct PrefetchRange {
+        const MappedFile* mapping;
+        size_t offset;
+        size_t size;
+    };
+
+    // Holding the archives keeps them mapped until the reads have been requested
+    std::vector<std::shared_ptr<const AssetArchive>> archives;
+    std::vector<PrefetchRange> ranges;
+    {
+        std::shared_lock lock(_mountMutex);
+        for (const std::string& filePath : filePaths) {
+            ResolvedPath resolved;
+            if (resolve(filePath, resolved) && resolved.archive) {
+                const MappedFile* mapping = &resolved.archive->getMapping();
+                const std::span<const uint8_t> stored = resolved.archiveFile.stored;
+                ranges.push_back(PrefetchRange { mapping, static_cast<size_t>(stored.data() - mapping->getData()), stored.size() });
+                archives.push_back(std::move(resolved.archive));
+            }
+        }
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const PrefetchRange& a, const PrefetchRange& b) {
+        return a.mapping != b.mapping ? std::less<const MappedFile*>()(a.mapping, b.mapping) : a.offset < b.offset;
+    });
+
+    // Reading a small gap is cheaper than a separate request, so files close together are read as one
+    static constexpr size_t MAX_PREFETCH_GAP = 256 * 1024;
+    for (size_t i = 0; i < ranges.size();) {
+        PrefetchRange merged = ranges[i];
+        for (++i; i < ranges.size() && ranges[i].mapping == merged.mapping &&
+            ranges[i].offset <= merged.offset + merged.size + MAX_PREFETCH_GAP; ++i) {
+            merged.size = std::max(merged.size, ranges[i].offset + ranges[i].size - merged.offset);
+        }
+        merged.mapping->prefetch(merged.offset, merged.size);
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * @file VirtualFileSystem.h
+ * @author Justin McKay
+ * @brief Single point through which assets are read: directories, archives and in-memory files mounted into one tree.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "assets/AssetArchive.h"
+#include "platform/AsyncFileReader.h"
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Resolves asset paths against mount points and reads them, synchronously or asynchronously.
+ *
+ * A mount makes a directory on disk, a .lfpak archive, or a set of files held in memory appear beneath a mount
+ * point. Paths are resolved against the most recently mounted first, and paths no mount provides are read from disk
+ * as they are. Every loader reads through here, so assets can move between loose files and archives without any
+ * change to the code that loads them.
+ *
+ * Archived and in-memory files are returned without copying, unless an archived file is compressed, in which case its
+ * chunks are decompressed in parallel. Loose files are memory mapped when read synchronously, and read by the
+ * platform's asynchronous file reader (io_uring on Linux) when read asynchronously.
+ *
+ * All methods are safe to call from any thread.
+ */
+class VirtualFileSystem {
+public:
+
+    /**
+     * @brief Gets the virtual file system shared by the engine.
+     */
+    static VirtualFileSystem* get();
+
+    VirtualFileSystem();
+    ~VirtualFileSystem();
+
+    /**
+     * @brief Mounts a directory on disk, so files beneath the mount point are read from it.
+     * @param directory The directory to mount.
+     * @param mountPoint The directory its contents appear under.
+     * @return true if the directory exists and was mounted.
+     */
+    bool mountDirectory(const std::string& directory, const std::string& mountPoint);
+
+    /**
+     * @brief Mounts a packed asset archive, so files beneath the mount point are read from it.
+     * @param archivePath The path of the .lfpak file.
+     * @param mountPoint The directory the archive's contents appear under.
+     * @return true if the archive was mounted.
+     */
+    bool mountArchive(const std::string& archivePath, const std::string& mountPoint);
+
+    /**
+     * @brief Mounts files held in memory, such as generated or downloaded assets.
+     * @param files The contents of each file, keyed by path relative to the mount point using '/' separators.
+     * @param mountPoint The directory the files appear under.
+     */
+    void mountMemory(std::unordered_map<std::string, std::vector<uint8_t>> files, const std::string& mountPoint);
+
+    /**
+     * @brief Unmounts everything. Blobs already handed out stay valid.
+     */
+    void unmountAll();
+
+    /**
+     * @brief Reads a whole file, blocking until it is available.
+     * @param filePath The path of the file.
+     * @param blob Receives the contents of the file, valid for as long as the blob is held.
+     * @return true if the file was found and read.
+     */
+    bool read(const std::string& filePath, AssetBlob& blob) const;
+
+    /**
+     * @brief Checks whether a file is provided by an archive or in-memory mount, so reading it costs no disk access
+     * beyond paging in a mapping.
+     * @param filePath The path of the file.
+     */
+    bool isPacked(const std::string& filePath) const;
+
+    /**
+     * @brief Reads a whole file without blocking.
+     *
+     * In-memory and uncompressed archived files complete immediately, and compressed archived files are decompressed
+     * on the thread pool. Loose files are queued on the asynchronous file reader, which submits reads requested
+     * together as one batch.
+     *
+     * @param filePath The path of the file.
+     * @return std::future<std::optional<AssetBlob>> The contents, or nullopt if the file could not be read.
+     */
+    std::future<std::optional<AssetBlob>> readAsync(const std::string& filePath);
+
+    /**
+     * @brief Starts reading the archived files among a set of paths into memory, ahead of their use.
+     *
+     * Files are grouped by archive and sorted by offset, and neighbouring files are merged into one read, so a batch
+     * of loads from the same archive becomes a few large sequential reads rather than many scattered faults. Returns
+     * without waiting for the reads. Paths not in a mounted archive are ignored.
+     *
+     * @param filePaths The paths of the files.
+     */
+    void prefetch(const std::vector<std::string>& filePaths) const;
+
+    /**
+     * @brief Gets the throughput and queue depth of asynchronous reads from disk.
+     */
+    FileReadStats getReadStats() const { return _reader->getStats(); }
+
+    /**
+     * @brief Normalises a path, so it can be compared against mount points.
+     */
+    static std::string normalisePath(const std::string& path);
+
+private:
+
+    /**
+     * @brief The kinds of mount.
+     */
+    enum class MountType {
+        Directory,
+        Archive,
+        Memory
+    };
+
+    /**
+     * @brief A directory, archive or set of in-memory files, and the directory its contents appear under.
+     */
+    struct Mount {
+        MountType type;
+        std::string mountPoint;
+        std::string directory;
+        std::shared_ptr<AssetArchive> archive;
+        std::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>> files;
+    };
+
+    /**
+     * @brief Where a path resolved to: an archived file, an in-memory file, or a file on disk.
+     */
+    struct ResolvedPath {
+        std::shared_ptr<const AssetArchive> archive;    ///< Archive holding the file, if it is archived
+        AssetArchiveFile archiveFile;                   ///< Where the file is stored within the archive
+        AssetBlob blob;                                 ///< Contents of an in-memory file
+        std::string diskPath;                           ///< Path of a loose file on disk, if the file isn't packed
+    };
+
+    /**
+     * @brief Resolves a path against the mounts. The caller must hold the mount lock.
+     * @return true if the path resolved to a packed file, false if it is to be read from diskPath.
+     */
+    bool resolve(const std::string& filePath, ResolvedPath& resolved) const;
+
+    // Mounts, most recently mounted last
+    std::vector<Mount> _mounts;
+
+    // Guards the mounts, as loader threads read files while the render thread may mount more
+    mutable std::shared_mutex _mountMutex;
+
+    // Reads loose files asynchronously
+    std::unique_ptr<AsyncFileReader> _reader;
+};
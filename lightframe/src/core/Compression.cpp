@@ -0,0 +1,195 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Matches shorter than this cost more to encode than the literals they replace
+static constexpr size_t MIN_MATCH = 4;
+
+// Offsets are stored in two bytes
+static constexpr size_t MAX_OFFSET = 65535;
+
+// Size of the table of recent positions, indexed by a hash of the four bytes at each
+static constexpr uint32_t HASH_BITS = 14;
+
+// The literal and match lengths packed into a token saturate at this, with the rest following in extra bytes
+static constexpr size_t TOKEN_LENGTH_MAX = 15;
+
+static uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * @brief Appends compressed output, failing rather than writing past the end of the destination.
+ */
+struct BlockWriter {
+    uint8_t* out;
+    uint8_t* end;
+
+    bool put(uint8_t byte) {
+        if (out == end) {
+            return false;
+        }
+        *out++ = byte;
+        return true;
+    }
+
+    bool putLength(size_t length) {
+        for (; length >= 255; length -= 255) {
+            if (!put(255)) {
+                return false;
+            }
+        }
+        return put(static_cast<uint8_t>(length));
+    }
+
+    bool putBytes(const uint8_t* data, size_t size) {
+        if (static_cast<size_t>(end - out) < size) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(out, data, size);
+            out += size;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes a run of literals, followed by a match unless this is the last sequence of the block.
+     */
+    bool putSequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+        const uint8_t token = static_cast<uint8_t>((std::min(literalLength, TOKEN_LENGTH_MAX) << 4) | std::min(matchCode, TOKEN_LENGTH_MAX));
+        if (!put(token) || (literalLength >= TOKEN_LENGTH_MAX && !putLength(literalLength - TOKEN_LENGTH_MAX)) ||
+            !putBytes(literals, literalLength)) {
+            return false;
+        }
+        if (matchLength == 0) {
+            return true;
+        }
+        return put(static_cast<uint8_t>(offset)) && put(static_cast<uint8_t>(offset >> 8)) &&
+            (matchCode < TOKEN_LENGTH_MAX || putLength(matchCode - TOKEN_LENGTH_MAX));
+    }
+};
+
+size_t compressBlock(std::span<const uint8_t> source, std::span<uint8_t> destination) {
+    const uint8_t* data = source.data();
+    const size_t size = source.size();
+    BlockWriter writer { destination.data(), destination.data() + destination.size() };
+
+    // Positions are stored plus one, so zero marks an empty slot
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+
+    size_t anchor = 0;
+    size_t position = 0;
+    while (position + MIN_MATCH <= size) {
+        const uint32_t sequence = read32(data + position);
+        uint32_t& slot = table[hashSequence(sequence)];
+        const size_t candidate = slot;
+        slot = static_cast<uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(data + candidate - 1) != sequence) {
+            // Skip ahead faster the longer nothing has matched, so incompressible data passes through quickly
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        const size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (position + length < size && data[match + length] == data[position + length]) {
+            ++length;
+        }
+
+        if (!writer.putSequence(data + anchor, position - anchor, position - match, length)) {
+            return 0;
+        }
+        position += length;
+        anchor = position;
+    }
+
+    // The block always ends with a run of literals, which may be empty
+    if (!writer.putSequence(data + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(writer.out - destination.data());
+}
+
+/**
+ * @brief Reads the extra bytes of a saturated length.
+ */
+static bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in == end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool decompressBlock(std::span<const uint8_t> source, std::span<uint8_t> destination) {
+    const uint8_t* in = source.data();
+    const uint8_t* inEnd = in + source.size();
+    uint8_t* out = destination.data();
+    uint8_t* const outBegin = out;
+    uint8_t* const outEnd = out + destination.size();
+
+    while (in != inEnd) {
+        const uint8_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == TOKEN_LENGTH_MAX && !readLength(in, inEnd, literalLength)) {
+            return false;
+        }
+        if (static_cast<size_t>(inEnd - in) < literalLength || static_cast<size_t>(outEnd - out) < literalLength) {
+            return false;
+        }
+        // Empty runs are skipped, as either buffer may be empty and memcpy must not be given a null pointer
+        if (literalLength > 0) {
+            std::memcpy(out, in, literalLength);
+            in += literalLength;
+            out += literalLength;
+        }
+
+        // Only the last sequence ends without a match
+        if (in == inEnd) {
+            return out == outEnd;
+        }
+
+        if (inEnd - in < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 0xF;
+        if (matchLength == TOKEN_LENGTH_MAX && !readLength(in, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > static_cast<size_t>(out - outBegin) || static_cast<size_t>(outEnd - out) < matchLength) {
+            return false;
+        }
+
+        // Overlapping copies repeat the bytes just written, so they must go forwards a byte at a time
+        const uint8_t* match = out - offset;
+        if (offset >= matchLength) {
+            std::memcpy(out, match, matchLength);
+            out += matchLength;
+        } else {
+            for (size_t i = 0; i < matchLength; ++i) {
+                *out++ = *match++;
+            }
+        }
+    }
+    return false;
+}
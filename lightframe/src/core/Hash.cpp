@@ -0,0 +1,109 @@
+#include "Hash.h"
+
+#include <bit>
+#include <cstring>
+
+static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+static inline uint64_t read64(const uint8_t* ptr) {
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+static inline uint32_t read32(const uint8_t* ptr) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+static inline uint64_t round64(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = std::rotl(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline uint64_t mergeRound64(uint64_t acc, uint64_t value) {
+    acc ^= round64(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+uint64_t hash64(const void* data, size_t size, uint64_t seed) {
+    const auto* ptr = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = ptr + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        // Four independent lanes keep the multiplier pipelines busy on large inputs
+        const uint8_t* const limit = end - 32;
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+
+        do {
+            v1 = round64(v1, read64(ptr));
+            v2 = round64(v2, read64(ptr + 8));
+            v3 = round64(v3, read64(ptr + 16));
+            v4 = round64(v4, read64(ptr + 24));
+            ptr += 32;
+        } while (ptr <= limit);
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = mergeRound64(hash, v1);
+        hash = mergeRound64(hash, v2);
+        hash = mergeRound64(hash, v3);
+        hash = mergeRound64(hash, v4);
+    } else {
+        hash = seed + PRIME64_5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    while (ptr + 8 <= end) {
+        hash ^= round64(0, read64(ptr));
+        hash = std::rotl(hash, 27) * PRIME64_1 + PRIME64_4;
+        ptr += 8;
+    }
+
+    if (ptr + 4 <= end) {
+        hash ^= static_cast<uint64_t>(read32(ptr)) * PRIME64_1;
+        hash = std::rotl(hash, 23) * PRIME64_2 + PRIME64_3;
+        ptr += 4;
+    }
+
+    while (ptr < end) {
+        hash ^= (*ptr) * PRIME64_5;
+        hash = std::rotl(hash, 11) * PRIME64_1;
+        ptr++;
+    }
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+std::string hashToString(uint64_t hash) {
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    std::string str(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        str[i] = hexDigits[hash & 0xF];
+        hash >>= 4;
+    }
+    return str;
+}
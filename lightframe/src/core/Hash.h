@@ -0,0 +1,49 @@
+/**
+ * @file Hash.h
+ * @author Justin McKay
+ * @brief Fast non-cryptographic 64-bit hashing (XXH64) for content keys and caches.
+ * @date 2026-03-02
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Computes the XXH64 hash of a block of memory.
+ * @param data Pointer to the data to hash.
+ * @param size Size of the data in bytes.
+ * @param seed Optional seed used to derive independent hash families.
+ * @return The 64-bit hash of the data.
+ */
+uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+/**
+ * @brief Computes the XXH64 hash of a string.
+ * @param str The string to hash.
+ * @param seed Optional seed used to derive independent hash families.
+ * @return The 64-bit hash of the string.
+ */
+inline uint64_t hash64(std::string_view str, uint64_t seed = 0) {
+    return hash64(str.data(), str.size(), seed);
+}
+
+/**
+ * @brief Combines a value into an existing hash.
+ * @param seed The existing hash.
+ * @param value The value to mix into the hash.
+ * @return The combined hash.
+ */
+inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * @brief Formats a 64-bit hash as a fixed-width, lowercase hexadecimal string.
+ * @param hash The hash to format.
+ * @return The 16-character hexadecimal representation.
+ */
+std::string hashToString(uint64_t hash);
@@ -0,0 +1,281 @@
+#include "Json.h"
+
+#include <charconv>
+#include <cstdint>
+
+// Returned by lookups that find nothing
+static const JsonValue NULL_JSON_VALUE;
+
+// Deepest nesting accepted, so malformed input can't exhaust the stack
+static constexpr int MAX_JSON_DEPTH = 256;
+
+/**
+ * @brief Recursive descent parser building JsonValues.
+ */
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : _text(text) {}
+
+    /**
+     * @brief Parses the whole text as a single value.
+     */
+    bool parseDocument(JsonValue& value) {
+        if (!parseValue(value, 0)) {
+            return false;
+        }
+        skipWhitespace();
+        return _position == _text.size();
+    }
+
+private:
+    // Text being parsed
+    std::string_view _text;
+
+    // Offset of the next unread character
+    size_t _position = 0;
+
+    /**
+     * @brief Advances past spaces, tabs and line breaks.
+     */
+    void skipWhitespace() {
+        while (_position < _text.size() &&
+            (_text[_position] == ' ' || _text[_position] == '\t' || _text[_position] == '\n' || _text[_position] == '\r')) {
+            ++_position;
+        }
+    }
+
+    /**
+     * @brief Skips whitespace and consumes a character if it is next.
+     */
+    bool consume(char c) {
+        skipWhitespace();
+        if (_position < _text.size() && _text[_position] == c) {
+            ++_position;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Consumes a literal if it is next.
+     */
+    bool consumeLiteral(std::string_view literal) {
+        if (_text.substr(_position, literal.size()) != literal) {
+            return false;
+        }
+        _position += literal.size();
+        return true;
+    }
+
+    /**
+     * @brief Parses any value at the given nesting depth.
+     */
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > MAX_JSON_DEPTH) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (_position >= _text.size()) {
+            return false;
+        }
+
+        switch (_text[_position]) {
+            case '{':
+                return parseObject(value, depth);
+            case '[':
+                return parseArray(value, depth);
+            case '"':
+                value._type = JsonValue::Type::String;
+                return parseString(value._string);
+            case 't':
+                value._type = JsonValue::Type::Bool;
+                value._bool = true;
+                return consumeLiteral("true");
+            case 'f':
+                value._type = JsonValue::Type::Bool;
+                value._bool = false;
+                return consumeLiteral("false");
+            case 'n':
+                value._type = JsonValue::Type::Null;
+                return consumeLiteral("null");
+            default:
+                return parseNumber(value);
+        }
+    }
+
+    /**
+     * @brief Parses an object, starting at its opening brace.
+     */
+    bool parseObject(JsonValue& value, int depth) {
+        value._type = JsonValue::Type::Object;
+        ++_position;
+        if (consume('}')) {
+            return true;
+        }
+
+        do {
+            skipWhitespace();
+            std::string key;
+            if (!parseString(key) || !consume(':')) {
+                return false;
+            }
+            JsonValue member;
+            if (!parseValue(member, depth + 1)) {
+                return false;
+            }
+            value._members.emplace_back(std::move(key), std::move(member));
+        } while (consume(','));
+
+        return consume('}');
+    }
+
+    /**
+     * @brief Parses an array, starting at its opening bracket.
+     */
+    bool parseArray(JsonValue& value, int depth) {
+        value._type = JsonValue::Type::Array;
+        ++_position;
+        if (consume(']')) {
+            return true;
+        }
+
+        do {
+            JsonValue element;
+            if (!parseValue(element, depth + 1)) {
+                return false;
+            }
+            value._array.push_back(std::move(element));
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    /**
+     * @brief Parses a number.
+     */
+    bool parseNumber(JsonValue& value) {
+        value._type = JsonValue::Type::Number;
+        const char* begin = _text.data() + _position;
+        const char* end = _text.data() + _text.size();
+        const auto result = std::from_chars(begin, end, value._number);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        _position += static_cast<size_t>(result.ptr - begin);
+        return true;
+    }
+
+    /**
+     * @brief Parses the four hex digits of a \u escape.
+     */
+    bool parseHex4(uint32_t& codePoint) {
+        if (_position + 4 > _text.size()) {
+            return false;
+        }
+        const char* begin = _text.data() + _position;
+        const auto result = std::from_chars(begin, begin + 4, codePoint, 16);
+        if (result.ec != std::errc() || result.ptr != begin + 4) {
+            return false;
+        }
+        _position += 4;
+        return true;
+    }
+
+    /**
+     * @brief Appends a code point encoded as UTF-8.
+     */
+    static void appendUtf8(std::string& output, uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            output += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            output += static_cast<char>(0xC0 | (codePoint >> 6));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            output += static_cast<char>(0xE0 | (codePoint >> 12));
+            output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            output += static_cast<char>(0xF0 | (codePoint >> 18));
+            output += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    /**
+     * @brief Parses a string, starting at its opening quote, decoding escapes.
+     */
+    bool parseString(std::string& output) {
+        if (_position >= _text.size() || _text[_position] != '"') {
+            return false;
+        }
+        ++_position;
+
+        while (_position < _text.size()) {
+            // Copy runs without escapes in one go
+            const size_t runEnd = _text.find_first_of("\"\\", _position);
+            if (runEnd == std::string_view::npos) {
+                return false;
+            }
+            output.append(_text.substr(_position, runEnd - _position));
+            _position = runEnd + 1;
+            if (_text[runEnd] == '"') {
+                return true;
+            }
+
+            if (_position >= _text.size()) {
+                return false;
+            }
+            const char escape = _text[_position++];
+            switch (escape) {
+                case '"': output += '"'; break;
+                case '\\': output += '\\'; break;
+                case '/': output += '/'; break;
+                case 'b': output += '\b'; break;
+                case 'f': output += '\f'; break;
+                case 'n': output += '\n'; break;
+                case 'r': output += '\r'; break;
+                case 't': output += '\t'; break;
+                case 'u': {
+                    uint32_t codePoint;
+                    if (!parseHex4(codePoint)) {
+                        return false;
+                    }
+                    // Characters outside the basic plane are written as a surrogate pair
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && consumeLiteral("\\u")) {
+                        uint32_t low;
+                        if (!parseHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                            return false;
+                        }
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(output, codePoint);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+};
+
+bool JsonValue::parse(std::string_view text, JsonValue& value) {
+    value = JsonValue();
+    JsonParser parser(text);
+    return parser.parseDocument(value);
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const {
+    return _type == Type::Array && index < _array.size() ? _array[index] : NULL_JSON_VALUE;
+}
+
+const JsonValue& JsonValue::operator[](std::string_view key) const {
+    for (const auto& [name, member] : _members) {
+        if (name == key) {
+            return member;
+        }
+    }
+    return NULL_JSON_VALUE;
+}
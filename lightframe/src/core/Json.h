@@ -0,0 +1,113 @@
+/**
+ * @file Json.h
+ * @author Justin McKay
+ * @brief Minimal read-only JSON document model, enough for asset formats such as glTF.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A parsed JSON value: null, a boolean, a number, a string, an array or an object.
+ *
+ * Lookups never fail: indexing past the end of an array, or by a key an object doesn't have, gives a null value, so
+ * optional properties can be read with a fallback in one expression.
+ */
+class JsonValue {
+public:
+
+    /**
+     * @brief The kinds of JSON value.
+     */
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    /**
+     * @brief Parses a JSON document.
+     * @param text The document text, as UTF-8.
+     * @param value Receives the root value.
+     * @return true if the whole text is a single valid JSON value.
+     */
+    static bool parse(std::string_view text, JsonValue& value);
+
+    /**
+     * @brief Gets the kind of the value.
+     */
+    Type getType() const { return _type; }
+
+    bool isNull() const { return _type == Type::Null; }
+    bool isNumber() const { return _type == Type::Number; }
+    bool isString() const { return _type == Type::String; }
+    bool isArray() const { return _type == Type::Array; }
+    bool isObject() const { return _type == Type::Object; }
+
+    /**
+     * @brief Gets a boolean value.
+     * @param fallback Returned if the value is not a boolean.
+     */
+    bool asBool(bool fallback = false) const { return _type == Type::Bool ? _bool : fallback; }
+
+    /**
+     * @brief Gets a numeric value.
+     * @param fallback Returned if the value is not a number.
+     */
+    double asNumber(double fallback = 0.0) const { return _type == Type::Number ? _number : fallback; }
+
+    /**
+     * @brief Gets a string value, or an empty string if the value is not a string.
+     */
+    const std::string& asString() const { return _string; }
+
+    /**
+     * @brief Gets the number of elements of an array or members of an object, or 0 for other values.
+     */
+    size_t size() const { return _type == Type::Array ? _array.size() : _type == Type::Object ? _members.size() : 0; }
+
+    /**
+     * @brief Gets an array element, or a null value if this is not an array or the index is out of range.
+     */
+    const JsonValue& operator[](size_t index) const;
+
+    /**
+     * @brief Gets an object member, or a null value if this is not an object or has no member by that name.
+     */
+    const JsonValue& operator[](std::string_view key) const;
+
+    /**
+     * @brief Checks whether an object has a member.
+     */
+    bool contains(std::string_view key) const { return !(*this)[key].isNull(); }
+
+    /**
+     * @brief Gets the elements of an array, empty for other values.
+     */
+    const std::vector<JsonValue>& getElements() const { return _array; }
+
+    /**
+     * @brief Gets the members of an object in document order, empty for other values.
+     */
+    const std::vector<std::pair<std::string, JsonValue>>& getMembers() const { return _members; }
+
+private:
+    friend class JsonParser;
+
+    // Kind of the value; only the matching field below is used
+    Type _type = Type::Null;
+    bool _bool = false;
+    double _number = 0.0;
+    std::string _string;
+    std::vector<JsonValue> _array;
+    std::vector<std::pair<std::string, JsonValue>> _members;
+};
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 
@@ -14,6 +15,9 @@ void Logger::log(LogLevel level, const std::string& message) {
     ss << timestamp();
     ss << " [" << logLevelToString(level) << "] " << message;
 
+    // Messages may come from worker threads, so keep each one from interleaving with another
+    static std::mutex s_writeMutex;
+    std::lock_guard lock(s_writeMutex);
     Platform::get()->consoleWrite(level, ss.str());
 }
 
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <string>
 #include <algorithm>
 
@@ -44,7 +46,8 @@ static inline std::string& rTrim(std::string& str) {
 /**
  * @brief Trims whitespace from both sides of the string.
  * @param str The string to trim.
+ * @return The trimmed copy of the string.
  */
-static inline std::string& trim(std::string str) {
+static inline std::string trim(std::string str) {
     return lTrim(rTrim(str));
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "ThreadPool.h"
+
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+static std::unique_ptr<ThreadPool> s_Instance = nullptr;
+
+ThreadPool* ThreadPool::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<ThreadPool>();
+    }
+    return s_Instance.get();
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        const size_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = std::max<size_t>(1, hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+    }
+
+    _workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    LOG_DEBUG("Thread pool started with {} workers.", threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _taskAvailable.notify_all();
+
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _taskAvailable.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end)>& function) {
+    chunkSize = std::max<size_t>(1, chunkSize);
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount == 0) {
+        return;
+    }
+    if (chunkCount == 1) {
+        function(0, count);
+        return;
+    }
+
+    // Chunks are claimed from a shared counter by whichever thread gets there first
+    struct ParallelForState {
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<size_t> completedChunks = 0;
+        std::atomic<bool> failed = false;
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<ParallelForState>();
+
+    auto runChunks = [state, count, chunkSize, chunkCount, &function]() {
+        size_t chunk;
+        while ((chunk = state->nextChunk.fetch_add(1)) < chunkCount) {
+
+            // Once a chunk has thrown the rest are skipped, but still counted, so the caller always wakes up
+            if (!state->failed) {
+                try {
+                    const size_t begin = chunk * chunkSize;
+                    function(begin, std::min(begin + chunkSize, count));
+                } catch (...) {
+                    std::lock_guard lock(state->mutex);
+                    if (!state->exception) {
+                        state->exception = std::current_exception();
+                    }
+                    state->failed = true;
+                }
+            }
+
+            if (state->completedChunks.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    // Helpers that start after every chunk is claimed return straight away, so the function reference never outlives
+    // this call: it is only used while a claimed chunk is incomplete, and no chunk throws out of runChunks
+    const size_t helperCount = std::min(_workers.size(), chunkCount - 1);
+    try {
+        for (size_t i = 0; i < helperCount; ++i) {
+            enqueue(runChunks);
+        }
+    } catch (...) {
+        // Helpers already queued may be running, so this call can't unwind yet; it finishes with fewer of them
+    }
+    runChunks();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&state, chunkCount]() { return state->completedChunks == chunkCount; });
+
+    // The first exception thrown by any chunk is rethrown here, once every chunk has finished
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(_mutex);
+            _taskAvailable.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+            if (_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+
+        // An escaped exception would terminate the process, so contain it to the task
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Unhandled exception in thread pool task: {}", e.what());
+        }
+    }
+}
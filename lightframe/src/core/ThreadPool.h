@@ -0,0 +1,107 @@
+/**
+ * @file ThreadPool.h
+ * @author Justin McKay
+ * @brief Fixed-size pool of worker threads for running CPU work, such as asset decoding, off the render thread.
+ * @date 2026-03-11
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+public:
+
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount Number of workers to start. 0 uses one less than the hardware thread count, leaving a core
+     * for the render thread.
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Finishes any queued tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task to run on a worker thread.
+     * @param task The task to run.
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * @brief Queues a task to run on a worker thread and returns a future for its result.
+     * @tparam F The callable type.
+     * @param task The task to run.
+     * @return std::future The result of the task, or the exception it threw.
+     */
+    template<typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+
+        // std::function must be copyable, so the move-only packaged_task is shared
+        auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packagedTask->get_future();
+        enqueue([packagedTask]() { (*packagedTask)(); });
+        return result;
+    }
+
+    /**
+     * @brief Runs a function over the range [0, count) in chunks spread across the workers, and waits for them all.
+     *
+     * The calling thread works through chunks too, so this is safe to call from a task already running on the pool:
+     * it completes even if every other worker is busy. If the function throws, the chunks not yet started are
+     * skipped and the first exception is rethrown once every chunk in progress has finished.
+     *
+     * @param count The number of items.
+     * @param chunkSize The number of items handed out at a time.
+     * @param function Called with the [begin, end) range of each chunk.
+     */
+    void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end)>& function);
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return size_t The worker count.
+     */
+    size_t getThreadCount() const { return _workers.size(); }
+
+    /**
+     * @brief Singleton method to get the shared engine worker pool.
+     * @return ThreadPool* A pointer to the thread pool instance.
+     */
+    static ThreadPool* get();
+
+private:
+    // Worker threads, joined on destruction
+    std::vector<std::thread> _workers;
+
+    // Tasks waiting for a free worker
+    std::deque<std::function<void()>> _tasks;
+
+    // Guards the task queue and stop flag
+    std::mutex _mutex;
+
+    // Signalled when a task is queued or the pool is stopping
+    std::condition_variable _taskAvailable;
+
+    // Set when the pool is shutting down
+    bool _stopping = false;
+
+    /**
+     * @brief Runs queued tasks until the pool is stopped and the queue is empty.
+     */
+    void workerLoop();
+};
@@ -0,0 +1,59 @@
+#include "AsyncFileReader.h"
+
+#include "ThreadedFileReader.h"
+
+#ifdef LF_PLATFORM_LINUX
+#include "IoUringFileReader.h"
+#endif
+
+#include "core/Logger.h"
+
+#include <algorithm>
+
+std::unique_ptr<AsyncFileReader> AsyncFileReader::create() {
+#ifdef LF_PLATFORM_LINUX
+    // io_uring may be missing from older kernels or disabled by a sandbox
+    std::unique_ptr<IoUringFileReader> reader = std::make_unique<IoUringFileReader>();
+    if (reader->isValid()) {
+        return reader;
+    }
+    LOG_INFO("io_uring is unavailable; reading files on the thread pool instead.");
+#endif
+    return std::make_unique<ThreadedFileReader>();
+}
+
+FileReadStats AsyncFileReader::getStats() const {
+    std::lock_guard lock(_statsMutex);
+
+    Clock::duration busyTime = _busyTime;
+    if (_queueDepth > 0) {
+        busyTime += Clock::now() - _busyStart;
+    }
+
+    FileReadStats stats;
+    stats.readsCompleted = _readsCompleted.load(std::memory_order_relaxed);
+    stats.bytesRead = _bytesRead.load(std::memory_order_relaxed);
+    stats.queueDepth = _queueDepth;
+    stats.maxQueueDepth = _maxQueueDepth;
+    const double seconds = std::chrono::duration<double>(busyTime).count();
+    stats.bytesPerSecond = seconds > 0.0 ? static_cast<double>(stats.bytesRead) / seconds : 0.0;
+    return stats;
+}
+
+void AsyncFileReader::beginRead() {
+    std::lock_guard lock(_statsMutex);
+    if (_queueDepth++ == 0) {
+        _busyStart = Clock::now();
+    }
+    _maxQueueDepth = std::max(_maxQueueDepth, _queueDepth);
+}
+
+void AsyncFileReader::endRead(size_t bytes) {
+    _readsCompleted.fetch_add(1, std::memory_order_relaxed);
+    _bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+
+    std::lock_guard lock(_statsMutex);
+    if (--_queueDepth == 0) {
+        _busyTime += Clock::now() - _busyStart;
+    }
+}
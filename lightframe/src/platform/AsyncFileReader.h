@@ -0,0 +1,90 @@
+/**
+ * @file AsyncFileReader.h
+ * @author Justin McKay
+ * @brief An interface used by platform-specific implementations to read whole files without blocking the caller.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Called on a reader thread when a read completes, with the contents of the file, or nullptr if it could not
+ * be read.
+ */
+using FileReadCallback = std::function<void(std::shared_ptr<std::vector<uint8_t>> contents)>;
+
+/**
+ * @brief Throughput and queue depth of a file reader.
+ */
+struct FileReadStats {
+    uint64_t readsCompleted = 0;    ///< Files read, successfully or not
+    uint64_t bytesRead = 0;         ///< Bytes read from disk
+    double bytesPerSecond = 0.0;    ///< Bytes read per second of time with reads in flight
+    size_t queueDepth = 0;          ///< Reads requested and not yet completed
+    size_t maxQueueDepth = 0;       ///< Most reads ever in flight at once
+};
+
+class AsyncFileReader {
+public:
+    virtual ~AsyncFileReader() = default;
+
+    /**
+     * @brief Reads a whole file without blocking.
+     * @param filePath The path of the file on disk.
+     * @param callback Called on a reader thread once the read completes. Must not block for long.
+     */
+    virtual void read(const std::string& filePath, FileReadCallback callback) = 0;
+
+    /**
+     * @brief Gets the throughput and queue depth of the reader. Safe to call from any thread.
+     */
+    FileReadStats getStats() const;
+
+    /**
+     * @brief Creates the fastest file reader available: io_uring on Linux where the kernel allows it, otherwise
+     * reads on the thread pool.
+     * @return std::unique_ptr<AsyncFileReader> The file reader instance.
+     */
+    static std::unique_ptr<AsyncFileReader> create();
+
+protected:
+
+    /**
+     * @brief Records that a read was requested.
+     */
+    void beginRead();
+
+    /**
+     * @brief Records that a read completed.
+     * @param bytes The number of bytes read.
+     */
+    void endRead(size_t bytes);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Guards the queue depth and busy time, which change together
+    mutable std::mutex _statsMutex;
+
+    // Reads in flight, and the most there have ever been
+    size_t _queueDepth = 0;
+    size_t _maxQueueDepth = 0;
+
+    // Time spent with reads in flight, and when the current busy period started
+    Clock::duration _busyTime = Clock::duration::zero();
+    Clock::time_point _busyStart;
+
+    // Completed reads and the bytes they read
+    std::atomic<uint64_t> _readsCompleted = 0;
+    std::atomic<uint64_t> _bytesRead = 0;
+};
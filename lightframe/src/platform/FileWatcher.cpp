@@ -0,0 +1,17 @@
+#include "FileWatcher.h"
+
+#ifdef LF_PLATFORM_WINDOWS
+#include "PollingFileWatcher.h"
+#elifdef LF_PLATFORM_LINUX
+#include "LinuxFileWatcher.h"
+#else
+#error "Unsupported platform!"
+#endif
+
+std::unique_ptr<FileWatcher> FileWatcher::create() {
+#ifdef LF_PLATFORM_WINDOWS
+    return std::make_unique<PollingFileWatcher>();
+#elifdef LF_PLATFORM_LINUX
+    return std::make_unique<LinuxFileWatcher>();
+#endif
+}
@@ -0,0 +1,48 @@
+/**
+ * @file FileWatcher.h
+ * @author Justin McKay
+ * @brief An interface used by platform-specific implementations to report changes to files on disk.
+ * @date 2026-03-09
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class FileWatcher {
+public:
+    virtual ~FileWatcher() = default;
+
+    /**
+     * @brief Starts watching a file for modifications.
+     *
+     * Changes are detected whether the file is written in place or replaced by a rename, as many editors do on save.
+     *
+     * @param filePath The path of the file to watch.
+     * @return true if the file is now being watched, false otherwise.
+     */
+    virtual bool watch(const std::string& filePath) = 0;
+
+    /**
+     * @brief Stops watching a file.
+     * @param filePath The path of the file to stop watching.
+     */
+    virtual void unwatch(const std::string& filePath) = 0;
+
+    /**
+     * @brief Collects the files that have changed since the last poll, without blocking.
+     *
+     * Each changed file is reported once per poll, regardless of how many change events it produced.
+     *
+     * @param changedFiles Receives the normalised paths of the changed files.
+     */
+    virtual void poll(std::vector<std::string>& changedFiles) = 0;
+
+    /**
+     * @brief Creates a file watcher for the current platform.
+     * @return std::unique_ptr<FileWatcher> The file watcher instance.
+     */
+    static std::unique_ptr<FileWatcher> create();
+};
@@ -0,0 +1,321 @@
+#include "IoUringFileReader.h"
+
+#include "core/Logger.h"
+
+#ifdef LF_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Most reads in flight at once
+static constexpr uint32_t RING_ENTRIES = 64;
+
+// Registered staging buffer for small reads, as slots of a fixed size
+static constexpr size_t STAGING_SLOT_SIZE = 64 * 1024;
+static constexpr size_t STAGING_SLOT_COUNT = 32;
+
+// Largest single read; longer files are read in several
+static constexpr size_t MAX_READ_SIZE = 1u << 30;
+
+// The C library has no wrappers for the io_uring system calls
+static int ioUringSetup(uint32_t entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int ringFd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int ioUringRegister(int ringFd, uint32_t opcode, const void* arg, uint32_t count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+}
+
+IoUringFileReader::IoUringFileReader() {
+    io_uring_params params = {};
+    const int ringFd = ioUringSetup(RING_ENTRIES, &params);
+    if (ringFd < 0) {
+        return;
+    }
+
+    // Plain reads at an offset need Linux 5.6, which is also the first to report this feature
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        ::close(ringFd);
+        return;
+    }
+
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping) {
+        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    _cqRing = singleMapping ? _sqRing
+        : mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    void* sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+        LOG_WARN("Unable to map io_uring queues.");
+        if (_sqRing != MAP_FAILED) {
+            munmap(_sqRing, _sqRingSize);
+        }
+        if (!singleMapping && _cqRing != MAP_FAILED) {
+            munmap(_cqRing, _cqRingSize);
+        }
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, _sqesSize);
+        }
+        _sqRing = _cqRing = nullptr;
+        ::close(ringFd);
+        return;
+    }
+    _ringFd = ringFd;
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sqRing = static_cast<uint8_t*>(_sqRing);
+    _sqHead = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.head);
+    _sqTail = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.tail);
+    _sqMask = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<uint32_t*>(sqRing + params.sq_off.array);
+    _sqEntries = params.sq_entries;
+
+    auto* cqRing = static_cast<uint8_t*>(_cqRing);
+    _cqHead = reinterpret_cast<uint32_t*>(cqRing + params.cq_off.head);
+    _cqTail = reinterpret_cast<uint32_t*>(cqRing + params.cq_off.tail);
+    _cqMask = reinterpret_cast<uint32_t*>(cqRing + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+    // Registering locks the staging buffer in memory, which the memlock limit may not allow; small reads then go
+    // straight into their destination like large ones
+    const size_t stagingSize = STAGING_SLOT_SIZE * STAGING_SLOT_COUNT;
+    _staging = static_cast<uint8_t*>(std::aligned_alloc(4096, stagingSize));
+    const iovec stagingVector = { _staging, stagingSize };
+    if (_staging && ioUringRegister(_ringFd, IORING_REGISTER_BUFFERS, &stagingVector, 1) == 0) {
+        for (int slot = static_cast<int>(STAGING_SLOT_COUNT) - 1; slot >= 0; --slot) {
+            _freeStagingSlots.push_back(slot);
+        }
+    } else {
+        std::free(_staging);
+        _staging = nullptr;
+    }
+
+    _thread = std::thread(&IoUringFileReader::run, this);
+    LOG_INFO("Reading files through io_uring with {} entries{}.", _sqEntries, _staging ? " and registered staging buffers" : "");
+}
+
+IoUringFileReader::~IoUringFileReader() {
+    if (_thread.joinable()) {
+        {
+            std::lock_guard lock(_queueMutex);
+            _stopping = true;
+        }
+        _queueCondition.notify_one();
+        _thread.join();
+    }
+
+    if (_ringFd < 0) {
+        return;
+    }
+    munmap(_sqes, _sqesSize);
+    if (_cqRing != _sqRing) {
+        munmap(_cqRing, _cqRingSize);
+    }
+    munmap(_sqRing, _sqRingSize);
+
+    // Closing the ring also unregisters the staging buffer
+    ::close(_ringFd);
+    std::free(_staging);
+}
+
+void IoUringFileReader::read(const std::string& filePath, FileReadCallback callback) {
+    beginRead();
+
+    auto request = std::make_unique<ReadRequest>();
+    request->path = filePath;
+    request->callback = std::move(callback);
+    {
+        std::lock_guard lock(_queueMutex);
+        _queue.push_back(std::move(request));
+    }
+    _queueCondition.notify_one();
+}
+
+void IoUringFileReader::run() {
+    size_t inFlight = 0;
+    std::vector<std::unique_ptr<ReadRequest>> batch;
+    std::vector<ReadRequest*> continued;
+
+    while (true) {
+        {
+            // Only sleep here when nothing is in flight; otherwise the ring is waited on below
+            std::unique_lock lock(_queueMutex);
+            if (inFlight == 0) {
+                _queueCondition.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+            }
+            if (_stopping && _queue.empty() && inFlight == 0) {
+                break;
+            }
+
+            while (!_queue.empty() && inFlight + batch.size() < _sqEntries) {
+                batch.push_back(std::move(_queue.front()));
+                _queue.pop_front();
+            }
+        }
+
+        // Every queued file is opened and submitted in one io_uring_enter()
+        for (std::unique_ptr<ReadRequest>& request : batch) {
+            if (!startRequest(*request)) {
+                const bool succeeded = request->contents != nullptr;
+                finishRequest(std::move(request), succeeded);
+                continue;
+            }
+            prepareRead(*request.release());
+            ++inFlight;
+        }
+        batch.clear();
+
+        if (inFlight == 0) {
+            continue;
+        }
+
+        // Entries the kernel didn't take last time are still in the ring, so everything unconsumed is submitted
+        const uint32_t toSubmit = *_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        int result;
+        do {
+            result = ioUringEnter(_ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS);
+        } while (result < 0 && errno == EINTR);
+        if (result < 0) {
+            LOG_ERROR("io_uring_enter failed: {}", std::strerror(errno));
+        }
+
+        // Only this thread consumes completions, so the head needs no atomic read
+        uint32_t head = *_cqHead;
+        const uint32_t tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = _cqes[head & *_cqMask];
+            auto* request = reinterpret_cast<ReadRequest*>(static_cast<uintptr_t>(cqe.user_data));
+
+            if (cqe.res == -EAGAIN || cqe.res == -EINTR) {
+                continued.push_back(request);
+                continue;
+            }
+            if (cqe.res <= 0) {
+                // An error, or the file shrank while it was being read
+                --inFlight;
+                finishRequest(std::unique_ptr<ReadRequest>(request), false);
+                continue;
+            }
+
+            request->bytesDone += static_cast<size_t>(cqe.res);
+            if (request->bytesDone < request->contents->size()) {
+                continued.push_back(request);
+            } else {
+                --inFlight;
+                finishRequest(std::unique_ptr<ReadRequest>(request), true);
+            }
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+        // Short reads carry on from where they stopped, submitted along with the next batch
+        for (ReadRequest* request : continued) {
+            prepareRead(*request);
+        }
+        continued.clear();
+    }
+}
+
+bool IoUringFileReader::startRequest(ReadRequest& request) {
+    request.fd = ::open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (request.fd < 0) {
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(request.fd, &fileStat) != 0) {
+        return false;
+    }
+    request.contents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(fileStat.st_size));
+    if (request.contents->empty()) {
+        return false;
+    }
+
+    if (request.contents->size() <= STAGING_SLOT_SIZE && !_freeStagingSlots.empty()) {
+        request.stagingSlot = _freeStagingSlots.back();
+        _freeStagingSlots.pop_back();
+    }
+    return true;
+}
+
+void IoUringFileReader::prepareRead(ReadRequest& request) {
+    // Only this thread produces submissions, so the tail needs no atomic read
+    const uint32_t tail = *_sqTail;
+    const uint32_t index = tail & *_sqMask;
+    io_uring_sqe& sqe = _sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+
+    uint8_t* destination;
+    if (request.stagingSlot >= 0) {
+        sqe.opcode = IORING_OP_READ_FIXED;
+        sqe.buf_index = 0;
+        destination = _staging + static_cast<size_t>(request.stagingSlot) * STAGING_SLOT_SIZE;
+    } else {
+        sqe.opcode = IORING_OP_READ;
+        destination = request.contents->data();
+    }
+
+    sqe.fd = request.fd;
+    sqe.off = request.bytesDone;
+    sqe.addr = reinterpret_cast<uintptr_t>(destination + request.bytesDone);
+    sqe.len = static_cast<uint32_t>(std::min(request.contents->size() - request.bytesDone, MAX_READ_SIZE));
+    sqe.user_data = reinterpret_cast<uintptr_t>(&request);
+
+    _sqArray[index] = index;
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+void IoUringFileReader::finishRequest(std::unique_ptr<ReadRequest> request, bool succeeded) {
+    if (request->stagingSlot >= 0) {
+        if (succeeded) {
+            const uint8_t* staged = _staging + static_cast<size_t>(request->stagingSlot) * STAGING_SLOT_SIZE;
+            std::memcpy(request->contents->data(), staged, request->contents->size());
+        }
+        _freeStagingSlots.push_back(request->stagingSlot);
+    }
+    if (request->fd >= 0) {
+        ::close(request->fd);
+    }
+
+    endRead(request->bytesDone);
+    request->callback(succeeded ? std::move(request->contents) : nullptr);
+}
+
+#else
+
+IoUringFileReader::IoUringFileReader() = default;
+
+IoUringFileReader::~IoUringFileReader() = default;
+
+void IoUringFileReader::read(const std::string&, FileReadCallback callback) {
+    callback(nullptr);
+}
+
+void IoUringFileReader::run() {}
+
+bool IoUringFileReader::startRequest(ReadRequest&) { return false; }
+
+void IoUringFileReader::prepareRead(ReadRequest&) {}
+
+void IoUringFileReader::finishRequest(std::unique_ptr<ReadRequest>, bool) {}
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file IoUringFileReader.h
+ * @author Justin McKay
+ * @brief Reads files asynchronously through an io_uring instance, submitting queued reads in batches.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "AsyncFileReader.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/**
+ * @brief Reads files through io_uring on a dedicated thread.
+ *
+ * Requests queued while the ring is busy are opened and submitted together with a single io_uring_enter(), so many
+ * small reads cost one system call rather than one each. Files small enough to fit a staging slot are read into a
+ * buffer registered with the kernel up front, which saves pinning their pages on every read, and copied out on
+ * completion. Larger files are read straight into their destination.
+ */
+class IoUringFileReader final : public AsyncFileReader {
+public:
+    IoUringFileReader();
+    ~IoUringFileReader() override;
+
+    IoUringFileReader(const IoUringFileReader&) = delete;
+    IoUringFileReader& operator=(const IoUringFileReader&) = delete;
+
+    /**
+     * @brief Checks whether the ring was created. The kernel may not support io_uring, or a sandbox may forbid it.
+     */
+    bool isValid() const { return _ringFd >= 0; }
+
+    void read(const std::string& filePath, FileReadCallback callback) override;
+
+private:
+
+    /**
+     * @brief A file being read.
+     */
+    struct ReadRequest {
+        std::string path;
+        FileReadCallback callback;
+        int fd = -1;
+        std::shared_ptr<std::vector<uint8_t>> contents;
+        size_t bytesDone = 0;
+        int stagingSlot = -1;
+    };
+
+    /**
+     * @brief Submits queued reads and processes completions until the reader is destroyed.
+     */
+    void run();
+
+    /**
+     * @brief Opens a queued file and sizes its buffer.
+     * @return true if the file has data left to read; false if the request has already completed.
+     */
+    bool startRequest(ReadRequest& request);
+
+    /**
+     * @brief Fills the next free submission queue entry with a read of the rest of a file.
+     */
+    void prepareRead(ReadRequest& request);
+
+    /**
+     * @brief Completes a request, closing its file and handing its contents to the callback.
+     * @param request The request, which is destroyed.
+     * @param succeeded Whether the whole file was read.
+     */
+    void finishRequest(std::unique_ptr<ReadRequest> request, bool succeeded);
+
+    // Ring file descriptor, or -1 if the ring could not be created
+    int _ringFd = -1;
+
+    // Mapped submission and completion rings, and the submission queue entries
+    void* _sqRing = nullptr;
+    size_t _sqRingSize = 0;
+    void* _cqRing = nullptr;
+    size_t _cqRingSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+
+    // Pointers to the fields of the submission ring
+    uint32_t* _sqHead = nullptr;
+    uint32_t* _sqTail = nullptr;
+    uint32_t* _sqMask = nullptr;
+    uint32_t* _sqArray = nullptr;
+    uint32_t _sqEntries = 0;
+
+    // Pointers to the fields of the completion ring
+    uint32_t* _cqHead = nullptr;
+    uint32_t* _cqTail = nullptr;
+    uint32_t* _cqMask = nullptr;
+    io_uring_cqe* _cqes = nullptr;
+
+    // Buffer registered with the kernel, split into staging slots for small reads, and which slots are free
+    uint8_t* _staging = nullptr;
+    std::vector<int> _freeStagingSlots;
+
+    // Requests waiting to be submitted, guarded by the mutex and signalled by the condition
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<std::unique_ptr<ReadRequest>> _queue;
+    bool _stopping = false;
+
+    // Thread that submits reads and processes their completions
+    std::thread _thread;
+};
@@ -0,0 +1,123 @@
+#include "LinuxFileWatcher.h"
+
+#include "core/Logger.h"
+
+#ifdef LF_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Events that indicate a file's contents have been replaced. IN_CLOSE_WRITE rather than IN_MODIFY, so a file is
+// only reported once the writer has finished with it.
+static constexpr uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+LinuxFileWatcher::LinuxFileWatcher() {
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotifyFd < 0) {
+        LOG_WARN("Unable to initialise inotify: {}. File changes will not be detected.", std::strerror(errno));
+    }
+}
+
+LinuxFileWatcher::~LinuxFileWatcher() {
+    if (_inotifyFd >= 0) {
+        // Closing the instance removes all of its watches
+        close(_inotifyFd);
+    }
+}
+
+bool LinuxFileWatcher::watch(const std::string& filePath) {
+    if (_inotifyFd < 0) {
+        return false;
+    }
+
+    const std::filesystem::path path = std::filesystem::absolute(filePath).lexically_normal();
+    const std::string directory = path.parent_path().generic_string();
+
+    auto it = _directoryWatches.find(directory);
+    if (it == _directoryWatches.end()) {
+        const int watchDescriptor = inotify_add_watch(_inotifyFd, directory.c_str(), WATCH_EVENTS);
+        if (watchDescriptor < 0) {
+            LOG_WARN("Unable to watch directory {}: {}", directory, std::strerror(errno));
+            return false;
+        }
+        it = _directoryWatches.emplace(directory, watchDescriptor).first;
+        _directories[watchDescriptor].path = directory;
+    }
+
+    _directories[it->second].fileNames.insert(path.filename().string());
+    return true;
+}
+
+void LinuxFileWatcher::unwatch(const std::string& filePath) {
+    const std::filesystem::path path = std::filesystem::absolute(filePath).lexically_normal();
+    auto it = _directoryWatches.find(path.parent_path().generic_string());
+    if (it == _directoryWatches.end()) {
+        return;
+    }
+
+    WatchedDirectory& directory = _directories[it->second];
+    directory.fileNames.erase(path.filename().string());
+    if (directory.fileNames.empty()) {
+        inotify_rm_watch(_inotifyFd, it->second);
+        _directories.erase(it->second);
+        _directoryWatches.erase(it);
+    }
+}
+
+void LinuxFileWatcher::poll(std::vector<std::string>& changedFiles) {
+    if (_inotifyFd < 0) {
+        return;
+    }
+
+    const size_t firstChanged = changedFiles.size();
+
+    // Buffer aligned for inotify_event, large enough to drain a burst of events per read
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = read(_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN means the queue is empty
+            if (length < 0 && errno != EAGAIN && errno != EINTR) {
+                LOG_WARN("Failed to read inotify events: {}", std::strerror(errno));
+            }
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                LOG_WARN("inotify event queue overflowed; some file changes may have been missed.");
+                continue;
+            }
+
+            auto directory = _directories.find(event->wd);
+            if (event->len == 0 || directory == _directories.end() || !directory->second.fileNames.contains(event->name)) {
+                continue;
+            }
+
+            std::string changedPath = directory->second.path + "/" + event->name;
+
+            // Saves often produce several events for the same file, so only report each file once
+            if (std::find(changedFiles.begin() + firstChanged, changedFiles.end(), changedPath) == changedFiles.end()) {
+                changedFiles.push_back(std::move(changedPath));
+            }
+        }
+    }
+}
+
+#else
+
+LinuxFileWatcher::LinuxFileWatcher() {}
+LinuxFileWatcher::~LinuxFileWatcher() {}
+bool LinuxFileWatcher::watch(const std::string&) { return false; }
+void LinuxFileWatcher::unwatch(const std::string&) {}
+void LinuxFileWatcher::poll(std::vector<std::string>&) {}
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file LinuxFileWatcher.h
+ * @author Justin McKay
+ * @brief Watches files for changes using a non-blocking inotify instance.
+ * @date 2026-03-09
+ */
+
+#pragma once
+
+#include "FileWatcher.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class LinuxFileWatcher final : public FileWatcher {
+public:
+    LinuxFileWatcher();
+    ~LinuxFileWatcher() override;
+
+    LinuxFileWatcher(const LinuxFileWatcher&) = delete;
+    LinuxFileWatcher& operator=(const LinuxFileWatcher&) = delete;
+
+    /**
+     * @brief Starts watching a file for modifications.
+     *
+     * The file's parent directory is watched rather than the file itself, so that saves which replace the file
+     * (write to a temporary file, then rename over the original) are still detected.
+     *
+     * @param filePath The path of the file to watch.
+     * @return true if the file is now being watched, false otherwise.
+     */
+    bool watch(const std::string& filePath) override;
+
+    /**
+     * @brief Stops watching a file, removing the directory watch once no files in it are watched.
+     * @param filePath The path of the file to stop watching.
+     */
+    void unwatch(const std::string& filePath) override;
+
+    /**
+     * @brief Drains pending inotify events without blocking and reports the watched files they refer to.
+     * @param changedFiles Receives the normalised paths of the changed files.
+     */
+    void poll(std::vector<std::string>& changedFiles) override;
+
+private:
+
+    /**
+     * @brief A watched directory and the files within it that changes are reported for.
+     */
+    struct WatchedDirectory {
+        std::string path;
+        std::unordered_set<std::string> fileNames;
+    };
+
+    // The inotify instance file descriptor, or -1 if inotify is unavailable
+    int _inotifyFd = -1;
+
+    // Watched directories, keyed by inotify watch descriptor
+    std::unordered_map<int, WatchedDirectory> _directories;
+
+    // Maps directory paths to their watch descriptors
+    std::unordered_map<std::string, int> _directoryWatches;
+};
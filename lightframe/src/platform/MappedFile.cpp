@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+
+#include "core/Logger.h"
+
+#include <algorithm>
+
+#ifdef LF_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elifdef LF_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "Unsupported platform!"
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filePath) {
+    std::shared_ptr<MappedFile> mappedFile(new MappedFile());
+    mappedFile->_path = filePath;
+
+#ifdef LF_PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_WARN("Unable to open {} for mapping.", filePath);
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+
+    // The mapping holds its own reference to the file
+    CloseHandle(file);
+    if (!mapping) {
+        LOG_WARN("Unable to map {}.", filePath);
+        return nullptr;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        LOG_WARN("Unable to map {}.", filePath);
+        return nullptr;
+    }
+
+    mappedFile->_data = static_cast<const uint8_t*>(view);
+    mappedFile->_size = static_cast<size_t>(fileSize.QuadPart);
+    mappedFile->_mappingHandle = mapping;
+#elifdef LF_PLATFORM_LINUX
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARN("Unable to open {} for mapping.", filePath);
+        return nullptr;
+    }
+
+    struct stat fileStat = {};
+    void* view = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping holds its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        LOG_WARN("Unable to map {}.", filePath);
+        return nullptr;
+    }
+
+    mappedFile->_data = static_cast<const uint8_t*>(view);
+    mappedFile->_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return mappedFile;
+}
+
+MappedFile::~MappedFile() {
+    if (!_data) {
+        return;
+    }
+
+#ifdef LF_PLATFORM_WINDOWS
+    UnmapViewOfFile(_data);
+    CloseHandle(_mappingHandle);
+#elifdef LF_PLATFORM_LINUX
+    munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+}
+
+void MappedFile::prefetch(size_t offset, size_t size) const {
+    if (offset >= _size || size == 0) {
+        return;
+    }
+    size = std::min(size, _size - offset);
+
+#ifdef LF_PLATFORM_WINDOWS
+    WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t*>(_data + offset), size };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#elifdef LF_PLATFORM_LINUX
+    // madvise() requires a page aligned start
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = offset & ~(pageSize - 1);
+    madvise(const_cast<uint8_t*>(_data + alignedOffset), size + (offset - alignedOffset), MADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,74 @@
+/**
+ * @file MappedFile.h
+ * @author Justin McKay
+ * @brief Read-only memory mapping of a whole file.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Maps a file into the address space read-only for as long as the object lives.
+ *
+ * Pages are read from disk when first touched, so only the parts of the file that are used cost any I/O. Mappings are
+ * shared, so data handed out from one stays valid for as long as anything holds a reference to the mapping.
+ */
+class MappedFile {
+public:
+
+    /**
+     * @brief Maps a file.
+     * @param filePath The path of the file to map.
+     * @return std::shared_ptr<MappedFile> The mapping, or nullptr if the file could not be opened or is empty.
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& filePath);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Gets the start of the mapped file.
+     */
+    const uint8_t* getData() const { return _data; }
+
+    /**
+     * @brief Gets the size of the mapped file in bytes.
+     */
+    size_t getSize() const { return _size; }
+
+    /**
+     * @brief Gets the path of the mapped file.
+     */
+    const std::string& getPath() const { return _path; }
+
+    /**
+     * @brief Asks the OS to start reading a range of the file into memory, so later accesses don't fault on disk.
+     * Returns without waiting for the read.
+     * @param offset The offset of the range in bytes.
+     * @param size The size of the range in bytes.
+     */
+    void prefetch(size_t offset, size_t size) const;
+
+private:
+    MappedFile() = default;
+
+    // Start and size of the mapping
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+
+    // Path of the mapped file
+    std::string _path;
+
+    // Handle of the file mapping object, which must be closed along with the view (Windows only)
+    void* _mappingHandle = nullptr;
+};
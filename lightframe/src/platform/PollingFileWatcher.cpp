@@ -0,0 +1,40 @@
+#include "PollingFileWatcher.h"
+
+#include "platform/Platform.h"
+
+bool PollingFileWatcher::watch(const std::string& filePath) {
+    const std::string path = std::filesystem::absolute(filePath).lexically_normal().generic_string();
+
+    std::error_code error;
+    const auto lastWriteTime = std::filesystem::last_write_time(path, error);
+    if (error) {
+        LOG_WARN("Unable to watch file {}: {}", path, error.message());
+        return false;
+    }
+
+    _files[path] = lastWriteTime;
+    return true;
+}
+
+void PollingFileWatcher::unwatch(const std::string& filePath) {
+    _files.erase(std::filesystem::absolute(filePath).lexically_normal().generic_string());
+}
+
+void PollingFileWatcher::poll(std::vector<std::string>& changedFiles) {
+    const double now = Platform::get()->getRunningTime();
+    if (now - _lastPollTime < _pollInterval) {
+        return;
+    }
+    _lastPollTime = now;
+
+    for (auto& [path, lastWriteTime] : _files) {
+        std::error_code error;
+        const auto currentWriteTime = std::filesystem::last_write_time(path, error);
+
+        // A missing file is usually mid-save; it will be picked up on a later poll
+        if (!error && currentWriteTime != lastWriteTime) {
+            lastWriteTime = currentWriteTime;
+            changedFiles.push_back(path);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file PollingFileWatcher.h
+ * @author Justin McKay
+ * @brief Portable file watcher that detects changes by comparing last write times at a fixed interval.
+ * @date 2026-03-09
+ */
+
+#pragma once
+
+#include "FileWatcher.h"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class PollingFileWatcher final : public FileWatcher {
+public:
+
+    /**
+     * @brief Starts watching a file for modifications, recording its current last write time.
+     * @param filePath The path of the file to watch.
+     * @return true if the file is now being watched, false otherwise.
+     */
+    bool watch(const std::string& filePath) override;
+
+    /**
+     * @brief Stops watching a file.
+     * @param filePath The path of the file to stop watching.
+     */
+    void unwatch(const std::string& filePath) override;
+
+    /**
+     * @brief Checks the last write time of every watched file, at most once per poll interval.
+     * @param changedFiles Receives the normalised paths of the changed files.
+     */
+    void poll(std::vector<std::string>& changedFiles) override;
+
+    /**
+     * @brief Sets the minimum time between checks of the watched files.
+     * @param seconds The poll interval in seconds.
+     */
+    void setPollInterval(double seconds) { _pollInterval = seconds; }
+
+private:
+    // Last write time of each watched file, keyed by normalised path
+    std::unordered_map<std::string, std::filesystem::file_time_type> _files;
+
+    // Minimum time between checks, so the file system isn't queried every frame
+    double _pollInterval = 0.5;
+
+    // Running time of the last check
+    double _lastPollTime = 0.0;
+};
@@ -0,0 +1,24 @@
+#include "ThreadedFileReader.h"
+
+#include "core/ThreadPool.h"
+
+#include <fstream>
+
+void ThreadedFileReader::read(const std::string& filePath, FileReadCallback callback) {
+    beginRead();
+    ThreadPool::get()->submit([this, filePath, callback = std::move(callback)]() {
+        std::shared_ptr<std::vector<uint8_t>> contents;
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        if (file) {
+            contents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(contents->data()), static_cast<std::streamsize>(contents->size()));
+            if (!file) {
+                contents.reset();
+            }
+        }
+
+        endRead(contents ? contents->size() : 0);
+        callback(std::move(contents));
+    });
+}
@@ -0,0 +1,15 @@
+/**
+ * @file ThreadedFileReader.h
+ * @author Justin McKay
+ * @brief Reads files with blocking reads on the thread pool, for platforms without a native asynchronous file API.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "AsyncFileReader.h"
+
+class ThreadedFileReader final : public AsyncFileReader {
+public:
+    void read(const std::string& filePath, FileReadCallback callback) override;
+};
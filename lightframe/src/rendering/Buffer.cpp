@@ -11,6 +11,11 @@ BufferLayout::BufferLayout(std::initializer_list<BufferElement> elements)
     calcOffsetStride();
 }
 
+BufferLayout::BufferLayout(std::vector<BufferElement> elements)
+    : _elements(std::move(elements)) {
+    calcOffsetStride();
+}
+
 void BufferLayout::calcOffsetStride() {
     size_t offset = 0;
     _stride = 0;
@@ -31,14 +36,22 @@ std::unique_ptr<VertexBuffer> VertexBuffer::create() {
     return std::make_unique<OpenGLVertexBuffer>();
 }
 
-std::unique_ptr<VertexBuffer> VertexBuffer::create(float* vertices, uint32_t size) {
-    return std::make_unique<OpenGLVertexBuffer>(vertices, size);
+std::unique_ptr<VertexBuffer> VertexBuffer::create(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy) {
+    return std::make_unique<OpenGLVertexBuffer>(capacity, usage, growthPolicy);
+}
+
+std::unique_ptr<VertexBuffer> VertexBuffer::create(const void* vertices, uint32_t size, BufferUsage usage) {
+    return std::make_unique<OpenGLVertexBuffer>(vertices, size, usage);
 }
 
 /**
  * Index Buffer
  */
 
-std::unique_ptr<IndexBuffer> IndexBuffer::create(unsigned int* indices, uint32_t count) {
-    return std::make_unique<OpenGLIndexBuffer>(indices, count);
+std::unique_ptr<IndexBuffer> IndexBuffer::create(const unsigned int* indices, uint32_t count, BufferUsage usage) {
+    return std::make_unique<OpenGLIndexBuffer>(indices, count, usage);
+}
+
+std::unique_ptr<IndexBuffer> IndexBuffer::create(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy) {
+    return std::make_unique<OpenGLIndexBuffer>(capacity, usage, growthPolicy);
 }
\ No newline at end of file
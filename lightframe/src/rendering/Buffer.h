@@ -21,7 +21,11 @@ enum class ShaderDataType {
     Int2,
     Int3,
     Int4,
-    Bool
+    Bool,
+    Half2,      ///< Two 16-bit floats, read by the shader as a vec2
+    Half4,      ///< Four 16-bit floats, read by the shader as a vec4
+    Short4,     ///< Four 16-bit integers, read as a vec4 and usually normalised to [-1, 1]
+    UByte4      ///< Four 8-bit unsigned integers, read as a vec4 and usually normalised to [0, 1]
 };
 
 static uint32_t shaderDataTypeSize(ShaderDataType type) {
@@ -37,11 +41,32 @@ static uint32_t shaderDataTypeSize(ShaderDataType type) {
         case ShaderDataType::Int3:     return 4 * 3;
         case ShaderDataType::Int4:     return 4 * 4;
         case ShaderDataType::Bool:     return 1;
+        case ShaderDataType::Half2:    return 2 * 2;
+        case ShaderDataType::Half4:    return 2 * 4;
+        case ShaderDataType::Short4:   return 2 * 4;
+        case ShaderDataType::UByte4:   return 4;
     }
-    
+
     return 0;
 }
 
+/**
+ * @brief Hint describing how often the contents of a GPU buffer are expected to change.
+ */
+enum class BufferUsage {
+    Static = 1,     ///< Uploaded once and drawn many times
+    Dynamic,        ///< Updated occasionally and drawn many times
+    Stream          ///< Rewritten every frame and drawn a handful of times
+};
+
+/**
+ * @brief Controls how the capacity of a GPU buffer grows when new data no longer fits.
+ */
+enum class BufferGrowthPolicy {
+    Exact = 1,      ///< Reallocate to exactly the number of bytes required
+    Geometric       ///< Grow by at least 1.5x the current capacity to amortise repeated growth
+};
+
 /**
  * @brief Represents a single element in a vertex buffer layout.
  */
@@ -75,6 +100,10 @@ struct BufferElement {
             case ShaderDataType::Int3:     return 3;
             case ShaderDataType::Int4:     return 4;
             case ShaderDataType::Bool:     return 1;
+            case ShaderDataType::Half2:    return 2;
+            case ShaderDataType::Half4:    return 4;
+            case ShaderDataType::Short4:   return 4;
+            case ShaderDataType::UByte4:   return 4;
         }
     
         return 0;
@@ -97,6 +126,12 @@ public:
      * @param elements Initializer list of BufferElement objects defining the layout.
      */
     BufferLayout(std::initializer_list<BufferElement> elements);
+
+    /**
+     * @brief Constructs a buffer layout from elements built at runtime, such as those read from a mesh file.
+     * @param elements The BufferElement objects defining the layout, in vertex order.
+     */
+    explicit BufferLayout(std::vector<BufferElement> elements);
     
     /**
      * @brief Returns the total stride of the buffer layout.
@@ -143,10 +178,10 @@ private:
     // Collection of buffer elements defining the vertex layout
     std::vector<BufferElement> _elements;
     // Total byte stride between consecutive vertices
-    uint32_t _stride;
+    uint32_t _stride = 0;
 
     // The number of values per vertex, calculated from the buffer element and shader type sizes.
-    uint32_t _vertexLength;
+    uint32_t _vertexLength = 0;
     
     /**
      * @brief Calculates the offset and stride for the buffer layout.
@@ -158,19 +193,35 @@ private:
 class VertexBuffer {
 public:
 
+    /**
+     * @brief Virtual destructor for proper cleanup of derived vertex buffer classes.
+     */
+    virtual ~VertexBuffer() = default;
+
     /**
      * @brief Creates a new VertexBuffer instance.
      * @return std::unique_ptr<VertexBuffer> A new VertexBuffer object.
      */
     static std::unique_ptr<VertexBuffer> create();
 
+    /**
+     * @brief Creates a new, empty VertexBuffer with storage reserved up front.
+     * @param capacity Initial capacity of the buffer in bytes.
+     * @param usage Hint describing how often the buffer contents will change.
+     * @param growthPolicy How the buffer capacity grows when data no longer fits.
+     * @return std::unique_ptr<VertexBuffer> A new VertexBuffer object with the reserved capacity.
+     */
+    static std::unique_ptr<VertexBuffer> create(uint32_t capacity, BufferUsage usage,
+        BufferGrowthPolicy growthPolicy = BufferGrowthPolicy::Geometric);
+
     /**
      * @brief Creates a new VertexBuffer instance with vertex data.
-     * @param vertices Pointer to the vertex data.
+     * @param vertices Pointer to the interleaved vertex data.
      * @param size Size of the vertex data in bytes.
+     * @param usage Hint describing how often the buffer contents will change.
      * @return std::unique_ptr<VertexBuffer> A new VertexBuffer object with the provided data.
      */
-    static std::unique_ptr<VertexBuffer> create(float* vertices, uint32_t size);
+    static std::unique_ptr<VertexBuffer> create(const void* vertices, uint32_t size, BufferUsage usage = BufferUsage::Static);
     
     /**
      * @brief Gets the layout of this vertex buffer.
@@ -184,6 +235,23 @@ public:
      */
     virtual void setLayout(const BufferLayout& layout) = 0;
 
+    /**
+     * @brief Replaces the entire contents of this vertex buffer, growing the capacity if required.
+     * Dynamic and stream buffers orphan their previous storage so the upload never waits on in-flight draws.
+     * @param vertices Pointer to the vertex data.
+     * @param size Size of the vertex data in bytes.
+     */
+    virtual void setData(const void* vertices, uint32_t size) = 0;
+
+    /**
+     * @brief Updates a sub-range of this vertex buffer in place, preserving the data outside the range.
+     * The buffer grows if the range extends past the current capacity.
+     * @param offset Byte offset into the buffer at which to start writing.
+     * @param vertices Pointer to the vertex data.
+     * @param size Size of the vertex data in bytes.
+     */
+    virtual void updateRange(uint32_t offset, const void* vertices, uint32_t size) = 0;
+
     /**
      * @brief Binds this vertex buffer for use in rendering.
      */
@@ -205,18 +273,77 @@ public:
      * @return unsigned int The vertex count.
      */
     virtual unsigned int getVertexCount() const = 0;
+
+    /**
+     * @brief Gets the number of bytes of vertex data currently held by this buffer.
+     * @return uint32_t The used size in bytes.
+     */
+    virtual uint32_t getSize() const = 0;
+
+    /**
+     * @brief Gets the number of bytes of GPU storage allocated for this buffer.
+     * @return uint32_t The capacity in bytes.
+     */
+    virtual uint32_t getCapacity() const = 0;
+
+    /**
+     * @brief Gets the usage hint this buffer was created with.
+     * @return BufferUsage The usage hint.
+     */
+    virtual BufferUsage getUsage() const = 0;
+
+    /**
+     * @brief Checks whether data written on a thread other than the render thread has reached the GPU. Buffers only
+     * written on the render thread are always complete. Must be called on the render thread.
+     * @return bool True if there is no upload outstanding.
+     */
+    virtual bool isUploadComplete() const = 0;
     
 };
 
 class IndexBuffer {
 public:
+
+    /**
+     * @brief Virtual destructor for proper cleanup of derived index buffer classes.
+     */
+    virtual ~IndexBuffer() = default;
+
     /**
      * @brief Creates a new IndexBuffer instance with index data.
      * @param indices Pointer to the index data.
      * @param count Number of indices.
+     * @param usage Hint describing how often the buffer contents will change.
      * @return std::unique_ptr<IndexBuffer> A new IndexBuffer object with the provided data.
      */
-    static std::unique_ptr<IndexBuffer> create(unsigned int* indices, uint32_t count);
+    static std::unique_ptr<IndexBuffer> create(const unsigned int* indices, uint32_t count, BufferUsage usage = BufferUsage::Static);
+
+    /**
+     * @brief Creates a new, empty IndexBuffer with storage reserved up front.
+     * @param capacity Initial capacity of the buffer in indices.
+     * @param usage Hint describing how often the buffer contents will change.
+     * @param growthPolicy How the buffer capacity grows when data no longer fits.
+     * @return std::unique_ptr<IndexBuffer> A new IndexBuffer object with the reserved capacity.
+     */
+    static std::unique_ptr<IndexBuffer> create(uint32_t capacity, BufferUsage usage,
+        BufferGrowthPolicy growthPolicy = BufferGrowthPolicy::Geometric);
+
+    /**
+     * @brief Replaces the entire contents of this index buffer, growing the capacity if required.
+     * Dynamic and stream buffers orphan their previous storage so the upload never waits on in-flight draws.
+     * @param indices Pointer to the index data.
+     * @param count Number of indices.
+     */
+    virtual void setData(const unsigned int* indices, uint32_t count) = 0;
+
+    /**
+     * @brief Updates a sub-range of this index buffer in place, preserving the indices outside the range.
+     * The buffer grows if the range extends past the current capacity.
+     * @param firstIndex Index at which to start writing.
+     * @param indices Pointer to the index data.
+     * @param count Number of indices to write.
+     */
+    virtual void updateRange(uint32_t firstIndex, const unsigned int* indices, uint32_t count) = 0;
 
     /**
      * @brief Binds this index buffer for use in rendering.
@@ -239,4 +366,23 @@ public:
      * @return unsigned int The index count.
      */
     virtual unsigned int getIndexCount() const = 0;
+
+    /**
+     * @brief Gets the number of indices the GPU storage of this buffer can hold.
+     * @return uint32_t The capacity in indices.
+     */
+    virtual uint32_t getCapacity() const = 0;
+
+    /**
+     * @brief Gets the usage hint this buffer was created with.
+     * @return BufferUsage The usage hint.
+     */
+    virtual BufferUsage getUsage() const = 0;
+
+    /**
+     * @brief Checks whether data written on a thread other than the render thread has reached the GPU. Buffers only
+     * written on the render thread are always complete. Must be called on the render thread.
+     * @return bool True if there is no upload outstanding.
+     */
+    virtual bool isUploadComplete() const = 0;
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+Image Image::fromPixels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb) {
+    Image image;
+    image.width = width;
+    image.height = height;
+    image.channels = channels;
+    image.srgb = srgb;
+    image.format = channels == 4 ? ImageFormat::RGBA8 : channels == 3 ? ImageFormat::RGB8 : ImageFormat::None;
+
+    const size_t size = static_cast<size_t>(width) * height * channels;
+
+    // Leave room for a full mip chain (at most a third of the base level) so generating one doesn't reallocate
+    image.data.reserve(size + size / 3 + channels * 16);
+    image.data.assign(pixels, pixels + size);
+    image.mips.push_back(ImageMip { .width = width, .height = height, .offset = 0, .size = size });
+
+    return image;
+}
+
+void Image::ensureOwned() {
+    if (!mappedData) {
+        return;
+    }
+
+    data.assign(mappedData.get(), mappedData.get() + mappedSize);
+    mappedData.reset();
+    mappedSize = 0;
+}
+
+uint32_t Image::calcMipCount(uint32_t width, uint32_t height) {
+    return static_cast<uint32_t>(std::bit_width(std::max(std::max(width, height), 1u)));
+}
+
+size_t Image::getRowPitch(uint32_t level) const {
+    if (isCompressedFormat(format)) {
+        return static_cast<size_t>((mips[level].width + 3) / 4) * getBlockBytes(format);
+    }
+    return static_cast<size_t>(mips[level].width) * channels;
+}
+
+uint32_t Image::getRowCount(uint32_t level) const {
+    return isCompressedFormat(format) ? (mips[level].height + 3) / 4 : mips[level].height;
+}
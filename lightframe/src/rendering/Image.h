@@ -0,0 +1,146 @@
+/**
+ * @file Image.h
+ * @author Justin McKay
+ * @brief CPU-side image data with a table describing each mip level.
+ * @date 2026-03-12
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @enum ImageFormat
+ * @brief Enumeration of supported image color formats for textures.
+ */
+enum class ImageFormat {
+    None = 0,  ///< No format specified
+    RGB8,      ///< 8-bit RGB color format
+    RGBA8,     ///< 8-bit RGBA color format with alpha channel
+    BC1,       ///< Block-compressed RGB, 4 bits per pixel
+    BC3,       ///< Block-compressed RGBA with interpolated alpha, 8 bits per pixel
+    BC4,       ///< Block-compressed single channel, 4 bits per pixel
+    BC5,       ///< Block-compressed two channel (e.g. tangent-space normals), 8 bits per pixel
+    BC7        ///< High quality block-compressed RGBA, 8 bits per pixel
+};
+
+/**
+ * @brief Checks whether a format stores 4x4 pixel blocks rather than individual pixels.
+ */
+constexpr bool isCompressedFormat(ImageFormat format) {
+    return format >= ImageFormat::BC1;
+}
+
+/**
+ * @brief Gets the size in bytes of one 4x4 block of a compressed format.
+ */
+constexpr uint32_t getBlockBytes(ImageFormat format) {
+    return format == ImageFormat::BC1 || format == ImageFormat::BC4 ? 8 : 16;
+}
+
+/**
+ * @enum MipFilter
+ * @brief Filters used to downsample one mip level into the next.
+ */
+enum class MipFilter {
+    Box = 1,    ///< 2x2 average; fastest, slightly blurry
+    Kaiser      ///< Kaiser-windowed sinc; sharper minification with less aliasing
+};
+
+/**
+ * @struct ImageMip
+ * @brief Location and dimensions of a single mip level within an image's data.
+ */
+struct ImageMip {
+    uint32_t width;     ///< Level width in pixels
+    uint32_t height;    ///< Level height in pixels
+    size_t offset;      ///< Byte offset of the level within Image::data
+    size_t size;        ///< Size of the level in bytes
+};
+
+/**
+ * @struct Image
+ * @brief Image with an optional mip chain, stored as tightly packed rows, level after level.
+ *
+ * Uncompressed images hold 8 bits per channel. Compressed images hold rows of 4x4 blocks.
+ */
+struct Image {
+    uint32_t width = 0;             ///< Width of the base level in pixels
+    uint32_t height = 0;            ///< Height of the base level in pixels
+    uint32_t channels = 0;          ///< Channels per pixel (1-4) of the uncompressed source
+    ImageFormat format = ImageFormat::None; ///< Storage format of the pixel data
+    bool srgb = false;              ///< Whether the color channels are sRGB encoded
+    std::vector<ImageMip> mips;     ///< Mip levels, base level first
+    std::vector<uint8_t> data;      ///< Pixel data of every level
+    std::shared_ptr<const uint8_t> mappedData; ///< Pixel data borrowed from a memory-mapped file, used instead of data when set
+    size_t mappedSize = 0;          ///< Size of the borrowed pixel data in bytes
+
+    /**
+     * @brief Creates a single-level image from tightly packed pixels.
+     * @param pixels The pixel data, copied into the image.
+     * @param width The width in pixels.
+     * @param height The height in pixels.
+     * @param channels The number of channels per pixel.
+     * @param srgb Whether the color channels are sRGB encoded.
+     * @return Image The new image.
+     */
+    static Image fromPixels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels, bool srgb);
+
+    /**
+     * @brief Gets the number of levels in a full mip chain, down to 1x1.
+     * @param width The base level width.
+     * @param height The base level height.
+     * @return uint32_t The level count.
+     */
+    static uint32_t calcMipCount(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Gets the number of mip levels the image holds.
+     */
+    uint32_t getMipCount() const { return static_cast<uint32_t>(mips.size()); }
+
+    /**
+     * @brief Gets the number of bytes in one row of a level: a row of pixels, or of blocks for compressed formats.
+     * @param level The mip level.
+     */
+    size_t getRowPitch(uint32_t level) const;
+
+    /**
+     * @brief Gets the number of rows in a level: rows of pixels, or of blocks for compressed formats.
+     * @param level The mip level.
+     */
+    uint32_t getRowCount(uint32_t level) const;
+
+    /**
+     * @brief Gets the pixel data of every level, whether owned or borrowed.
+     */
+    const uint8_t* getData() const { return mappedData ? mappedData.get() : data.data(); }
+
+    /**
+     * @brief Gets the size of the pixel data of every level in bytes.
+     */
+    size_t getDataSize() const { return mappedData ? mappedSize : data.size(); }
+
+    /**
+     * @brief Copies borrowed pixel data into the image, so it can be modified and outlive the mapping.
+     */
+    void ensureOwned();
+
+    /**
+     * @brief Gets the pixel data of a mip level for writing. Borrowed data is copied into the image first.
+     * @param level The mip level.
+     */
+    uint8_t* getMipData(uint32_t level) {
+        ensureOwned();
+        return data.data() + mips[level].offset;
+    }
+
+    /**
+     * @brief Gets the pixel data of a mip level.
+     * @param level The mip level.
+     */
+    const uint8_t* getMipData(uint32_t level) const { return getData() + mips[level].offset; }
+};
@@ -1,17 +1,27 @@
 #include "Material.h"
 
 #include <unordered_map>
+#include <vector>
 
-void Material::addShader(RenderPass renderPass, ShaderHandle shaderHandle) {
-    if (shaderHandle > 0) {
-        _shaders.try_emplace(renderPass, shaderHandle);
+void Material::addShader(RenderPass renderPass, ResourceRef<Shader> shader) {
+    if (shader) {
+        _shaders.try_emplace(renderPass, std::move(shader));
     }
 }
 
 ShaderHandle Material::getShader(RenderPass renderPass) {
     // Check if map contains key. If not, return 0
     if (_shaders.contains(renderPass)) {
-        return _shaders[renderPass];
+        return _shaders[renderPass].getHandle();
     }
     return 0;
-}
\ No newline at end of file
+}
+
+std::vector<ShaderHandle> Material::getShaders() const {
+    std::vector<ShaderHandle> shaders;
+    shaders.reserve(_shaders.size());
+    for (const auto& [renderPass, shader] : _shaders) {
+        shaders.push_back(shader.getHandle());
+    }
+    return shaders;
+}
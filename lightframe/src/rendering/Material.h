@@ -1,19 +1,36 @@
 #pragma once
 
 #include "Renderer.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "resources/ResourceRef.h"
+
+#include <glm/glm.hpp>
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A texture, or a region of an atlas, along with the transform from a mesh's UVs to the texture's.
+ */
+struct TextureRegion {
+    // Counted reference to the texture, or to the atlas holding it
+    ResourceRef<Texture2D> texture;
+    // Scale (xy) and offset (zw) applied to texture coordinates; identity for a standalone texture
+    glm::vec4 uvTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+};
 
 class Material {
 public:
     Material() = default;
     
     /**
-     * @brief Adds a shader for a specific render pass.
+     * @brief Adds a shader for a specific render pass, keeping it loaded for as long as the material holds it.
      * @param renderPass The render pass for which to add the shader.
-     * @param shaderHandle The handle of the shader to add.
+     * @param shader A counted reference to the shader.
      */
-    void addShader(RenderPass renderPass, ShaderHandle shaderHandle);
+    void addShader(RenderPass renderPass, ResourceRef<Shader> shader);
     
     /**
      * @brief Retrieves the shader handle for a specific render pass.
@@ -21,22 +38,74 @@ public:
      * @return ShaderHandle The handle of the shader associated with the render pass.
      */
     ShaderHandle getShader(RenderPass renderPass);
+
+    /**
+     * @brief Retrieves the shader handles of every render pass the material is drawn in.
+     * @return std::vector<ShaderHandle> The handles of the material's shaders.
+     */
+    std::vector<ShaderHandle> getShaders() const;
     
     /**
-     * @brief Sets the diffuse map for the material.
-     * @param diffuseMapHandle The handle of the diffuse texture to set.
+     * @brief Sets the diffuse map for the material, keeping it loaded for as long as the material holds it.
+     * @param diffuseMap A counted reference to the diffuse texture.
+     * @param uvTransform Scale (xy) and offset (zw) into the texture, for a region of an atlas.
      */
-    void setDiffuseMap(TextureHandle diffuseMapHandle) { _diffuseMap = diffuseMapHandle; }
+    void setDiffuseMap(ResourceRef<Texture2D> diffuseMap, const glm::vec4& uvTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f)) {
+        _diffuseMap = std::move(diffuseMap);
+        _diffuseUvTransform = uvTransform;
+    }
+
+    /**
+     * @brief Sets the diffuse map for the material from a texture region, so atlased textures are sampled from
+     * their place in the atlas.
+     * @param diffuseMap The texture and UV transform of the diffuse map.
+     */
+    void setDiffuseMap(TextureRegion diffuseMap) {
+        _diffuseMap = std::move(diffuseMap.texture);
+        _diffuseUvTransform = diffuseMap.uvTransform;
+    }
     
     /**
      * @brief Retrieves the diffuse map handle for the material.
      * @return TextureHandle The handle of the diffuse texture associated with the material.
      */
-    const TextureHandle getDiffuseMap() const { return _diffuseMap; }
+    const TextureHandle getDiffuseMap() const { return _diffuseMap.getHandle(); }
+
+    /**
+     * @brief Retrieves the diffuse texture of the material.
+     * @return Texture2D* The diffuse texture, or nullptr if the material has none or it was unloaded explicitly.
+     */
+    Texture2D* getDiffuseTexture() const { return _diffuseMap.get(); }
+
+    /**
+     * @brief Retrieves the transform from mesh texture coordinates to those of the diffuse map.
+     * @return const glm::vec4& The scale (xy) and offset (zw) of the texture coordinates.
+     */
+    const glm::vec4& getDiffuseUvTransform() const { return _diffuseUvTransform; }
+
+    /**
+     * @brief Sets the shader features the material requires, selecting which shader permutation it is drawn with.
+     * @param features The bitmask of shader features.
+     */
+    void setShaderFeatures(ShaderFeatureMask features) { _shaderFeatures = features; }
+
+    /**
+     * @brief Retrieves the shader features the material requires.
+     * @return ShaderFeatureMask The bitmask of shader features.
+     */
+    ShaderFeatureMask getShaderFeatures() const { return _shaderFeatures; }
     
 private:
-    std::unordered_map<RenderPass, ShaderHandle> _shaders;
+    // Shader of each render pass
+    std::unordered_map<RenderPass, ResourceRef<Shader>> _shaders;
+
+    // Features used to select the shader permutation
+    ShaderFeatureMask _shaderFeatures = 0;
     
-    TextureHandle _diffuseMap;   
+    // Diffuse texture, or the atlas holding it
+    ResourceRef<Texture2D> _diffuseMap;
+
+    // Scale (xy) and offset (zw) of the diffuse map texture coordinates, for atlased textures
+    glm::vec4 _diffuseUvTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
     
 };
\ No newline at end of file
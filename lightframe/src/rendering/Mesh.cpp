@@ -1,11 +1,135 @@
 #include "Mesh.h"
+
+#include "assets/MeshFile.h"
+#include "assets/MeshImporter.h"
+#include "assets/VirtualFileSystem.h"
+#include "core/Logger.h"
+
 #include <cmath>
 
+#include <glm/glm.hpp>
+
+#include <algorithm>
 #include <memory>
 
 Mesh::Mesh(std::unique_ptr<VertexBuffer> vertexBuffer, std::unique_ptr<IndexBuffer> indexBuffer, 
     std::unique_ptr<VertexArray> vertexArray)
     : _vertexBuffer(std::move(vertexBuffer)), _indexBuffer(std::move(indexBuffer)), _vertexArray(std::move(vertexArray)) { }
+
+std::unique_ptr<Mesh> Mesh::create(const BufferLayout& layout, std::span<const uint8_t> vertices,
+    std::span<const uint32_t> indices, const MeshBounds& bounds) {
+
+    std::unique_ptr<VertexBuffer> vertexBuf = VertexBuffer::create(vertices.data(), static_cast<uint32_t>(vertices.size()));
+    vertexBuf->setLayout(layout);
+
+    std::unique_ptr<IndexBuffer> indexBuf = IndexBuffer::create(indices.data(), static_cast<uint32_t>(indices.size()));
+
+    return create(std::move(vertexBuf), std::move(indexBuf), bounds);
+}
+
+std::unique_ptr<Mesh> Mesh::create(std::unique_ptr<VertexBuffer> vertexBuffer, std::unique_ptr<IndexBuffer> indexBuffer,
+    const MeshBounds& bounds) {
+
+    std::unique_ptr<VertexArray> vertexArray = VertexArray::create();
+    vertexArray->addVertexBuffer(vertexBuffer.get());
+    vertexArray->setIndexBuffer(indexBuffer.get());
+
+    auto mesh = std::make_unique<Mesh>(std::move(vertexBuffer), std::move(indexBuffer), std::move(vertexArray));
+    mesh->_boundingRadius = bounds.radius;
+    mesh->_uvDensity = bounds.uvDensity;
+    return mesh;
+}
+
+std::unique_ptr<Mesh> Mesh::create(const MeshData& mesh) {
+    return create(mesh.layout, mesh.vertices, mesh.indices, mesh.bounds);
+}
+
+std::unique_ptr<Mesh> Mesh::create(const std::string& filePath) {
+    AssetBlob blob;
+    if (!VirtualFileSystem::get()->read(filePath, blob)) {
+        LOG_WARN("Failed to load mesh: {}", filePath);
+        return create(MeshData());
+    }
+    return create(filePath, blob);
+}
+
+std::unique_ptr<Mesh> Mesh::create(const std::string& filePath, const AssetBlob& content) {
+    // Source formats are imported on the spot; shipping content should be cooked to .lfmesh instead
+    if (isImportableMesh(filePath)) {
+        MeshData mesh;
+        if (importMesh(content, filePath, mesh)) {
+            return create(mesh);
+        }
+        LOG_WARN("Failed to load mesh: {}", filePath);
+        return create(MeshData());
+    }
+
+    // Cooked meshes are uploaded straight from the archive or file mapping
+    MeshFileView view;
+    if (readMeshFile(content.data, filePath, view)) {
+        return create(view.layout, view.vertices, view.indices, view.bounds);
+    }
+
+    LOG_WARN("Failed to load mesh: {}", filePath);
+    return create(MeshData());
+}
+
+bool Mesh::readData(const std::string& filePath, MeshData& mesh) {
+    if (isImportableMesh(filePath)) {
+        return importMesh(filePath, mesh);
+    }
+
+    return readMeshFile(filePath, mesh);
+}
+
+bool Mesh::readData(const std::string& filePath, const AssetBlob& content, MeshData& mesh) {
+    if (isImportableMesh(filePath)) {
+        return importMesh(content, filePath, mesh);
+    }
+
+    return readMeshFile(content.data, filePath, mesh);
+}
+
+size_t Mesh::getGpuMemoryUsage() const {
+    const size_t vertexBytes = _vertexBuffer ? _vertexBuffer->getCapacity() : 0;
+    const size_t indexBytes = _indexBuffer ? static_cast<size_t>(_indexBuffer->getCapacity()) * sizeof(uint32_t) : 0;
+    return vertexBytes + indexBytes;
+}
+
+void Mesh::calculateMetrics(const std::vector<float>& vertices, uint32_t vertexStride, uint32_t texCoordOffset,
+    const std::vector<unsigned int>& indices) {
+
+    auto position = [&](unsigned int index) {
+        const float* vertex = &vertices[index * vertexStride];
+        return glm::vec3(vertex[0], vertex[1], vertex[2]);
+    };
+    auto texCoord = [&](unsigned int index) {
+        const float* vertex = &vertices[index * vertexStride + texCoordOffset];
+        return glm::vec2(vertex[0], vertex[1]);
+    };
+
+    _boundingRadius = 0.0f;
+    for (size_t i = 0; i + vertexStride <= vertices.size(); i += vertexStride) {
+        _boundingRadius = std::max(_boundingRadius, glm::length(glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2])));
+    }
+
+    // Ratio of total texture space area to total surface area, so large triangles weigh more than slivers
+    float surfaceArea = 0.0f;
+    float uvArea = 0.0f;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3 p0 = position(indices[i]);
+        const glm::vec2 t0 = texCoord(indices[i]);
+        const glm::vec3 edge1 = position(indices[i + 1]) - p0;
+        const glm::vec3 edge2 = position(indices[i + 2]) - p0;
+        const glm::vec2 uvEdge1 = texCoord(indices[i + 1]) - t0;
+        const glm::vec2 uvEdge2 = texCoord(indices[i + 2]) - t0;
+
+        surfaceArea += 0.5f * glm::length(glm::cross(edge1, edge2));
+        uvArea += 0.5f * std::abs(uvEdge1.x * uvEdge2.y - uvEdge1.y * uvEdge2.x);
+    }
+
+    _uvDensity = surfaceArea > 0.0f ? std::sqrt(uvArea / surfaceArea) : 0.0f;
+}
     
 Mesh Mesh::createCubeMesh() {
     
@@ -65,13 +189,15 @@ Mesh Mesh::createCubeMesh() {
     std::unique_ptr<VertexBuffer> vertexBuf = VertexBuffer::create(cubeVertices.data(), cubeVertices.size() * sizeof(float));
     vertexBuf->setLayout(layout);
     
-    std::unique_ptr<IndexBuffer> indexBuf = IndexBuffer::create(cubeIndices.data(), cubeIndices.size() * sizeof(unsigned int)); 
+    std::unique_ptr<IndexBuffer> indexBuf = IndexBuffer::create(cubeIndices.data(), cubeIndices.size()); 
     
     std::unique_ptr<VertexArray> vertexArray = VertexArray::create();
     vertexArray->addVertexBuffer(vertexBuf.get());
     vertexArray->setIndexBuffer(indexBuf.get());
     
-    return Mesh(std::move(vertexBuf), std::move(indexBuf), std::move(vertexArray));
+    Mesh mesh(std::move(vertexBuf), std::move(indexBuf), std::move(vertexArray));
+    mesh.calculateMetrics(cubeVertices, 8, 6, cubeIndices);
+    return mesh;
     
 }
 
@@ -144,11 +270,13 @@ Mesh Mesh::createSphereMesh(int latitudeSegments, int longitudeSegments) {
     std::unique_ptr<VertexBuffer> vertexBuf = VertexBuffer::create(sphereVertices.data(), sphereVertices.size() * sizeof(float));
     vertexBuf->setLayout(layout);
 
-    std::unique_ptr<IndexBuffer> indexBuf = IndexBuffer::create(sphereIndices.data(), sphereIndices.size() * sizeof(unsigned int));
+    std::unique_ptr<IndexBuffer> indexBuf = IndexBuffer::create(sphereIndices.data(), sphereIndices.size());
 
     std::unique_ptr<VertexArray> vertexArray = VertexArray::create();
     vertexArray->addVertexBuffer(vertexBuf.get());
     vertexArray->setIndexBuffer(indexBuf.get());
 
-    return Mesh(std::move(vertexBuf), std::move(indexBuf), std::move(vertexArray));
+    Mesh mesh(std::move(vertexBuf), std::move(indexBuf), std::move(vertexArray));
+    mesh.calculateMetrics(sphereVertices, 8, 6, sphereIndices);
+    return mesh;
 }
\ No newline at end of file
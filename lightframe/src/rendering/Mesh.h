@@ -1,9 +1,16 @@
 #pragma once
 
 #include "rendering/Buffer.h"
+#include "rendering/MeshData.h"
 #include "rendering/VertexArray.h"
 
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+struct AssetBlob;
 
 /**
  * @brief Represents a mesh with vertex data, indices, and vertex array configuration.
@@ -37,7 +44,100 @@ public:
      * @return VertexArray* Raw pointer to the vertex array (mesh retains ownership).
      */
     VertexArray* getVertexArray() { return _vertexArray.get(); }
+
+    /**
+     * @brief Gets the radius of a sphere around the mesh origin that contains every vertex.
+     * @return float The bounding radius in model units.
+     */
+    float getBoundingRadius() const { return _boundingRadius; }
+
+    /**
+     * @brief Gets the average number of texture coordinate units per model unit across the mesh surface.
+     * Used with the projected size of the mesh to estimate how many texels land on each screen pixel.
+     * @return float The texture coordinate density, or 0 if the mesh has not been measured.
+     */
+    float getUvDensity() const { return _uvDensity; }
+
+    /**
+     * @brief Gets the video memory allocated for the mesh's vertex and index buffers.
+     * @return size_t The size of the buffers in bytes.
+     */
+    size_t getGpuMemoryUsage() const;
+
+    /**
+     * @brief Measures the bounding radius and texture coordinate density of the mesh from its CPU-side geometry.
+     * Positions are read from the first three floats of each vertex.
+     * @param vertices The interleaved vertex data.
+     * @param vertexStride The number of floats per vertex.
+     * @param texCoordOffset The offset, in floats, of the texture coordinates within a vertex.
+     * @param indices The triangle list indices.
+     */
+    void calculateMetrics(const std::vector<float>& vertices, uint32_t vertexStride, uint32_t texCoordOffset,
+        const std::vector<unsigned int>& indices);
     
+    /**
+     * @brief Creates a mesh from interleaved vertices and triangle indices, uploading them as they are.
+     * @param layout The attributes of each vertex.
+     * @param vertices The interleaved vertex data.
+     * @param indices The triangle list indices.
+     * @param bounds The bounds of the geometry.
+     * @return std::unique_ptr<Mesh> The new mesh.
+     */
+    static std::unique_ptr<Mesh> create(const BufferLayout& layout, std::span<const uint8_t> vertices,
+        std::span<const uint32_t> indices, const MeshBounds& bounds);
+
+    /**
+     * @brief Creates a mesh around buffers that are already filled, such as ones uploaded from a loader thread.
+     * Creates the vertex array, which isn't shared between GL contexts, so must be called on the render thread.
+     * @param vertexBuffer The vertex buffer, with its layout set.
+     * @param indexBuffer The index buffer.
+     * @param bounds The bounds of the geometry.
+     * @return std::unique_ptr<Mesh> The new mesh.
+     */
+    static std::unique_ptr<Mesh> create(std::unique_ptr<VertexBuffer> vertexBuffer, std::unique_ptr<IndexBuffer> indexBuffer,
+        const MeshBounds& bounds);
+
+    /**
+     * @brief Creates a mesh from CPU-side geometry.
+     * @param mesh The geometry to upload.
+     * @return std::unique_ptr<Mesh> The new mesh.
+     */
+    static std::unique_ptr<Mesh> create(const MeshData& mesh);
+
+    /**
+     * @brief Loads a cooked .lfmesh file, from a mounted archive without copying if it is packed in one, or imports
+     * an .obj, .gltf or .glb source file.
+     * @param filePath The path of the mesh file.
+     * @return std::unique_ptr<Mesh> The new mesh, empty if the file could not be read.
+     */
+    static std::unique_ptr<Mesh> create(const std::string& filePath);
+
+    /**
+     * @brief Creates a mesh from the contents of a mesh file that has already been read, as create() does.
+     * @param filePath The path the file was read from, which chooses the format.
+     * @param content The contents of the file.
+     * @return std::unique_ptr<Mesh> The new mesh, empty if the contents could not be read.
+     */
+    static std::unique_ptr<Mesh> create(const std::string& filePath, const AssetBlob& content);
+
+    /**
+     * @brief Reads a mesh file into CPU-side geometry without creating any GPU objects, so it can run on a worker.
+     * Meshes packed in a mounted archive are copied out of it.
+     * @param filePath The path of the .lfmesh, .obj, .gltf or .glb file.
+     * @param mesh Receives the geometry.
+     * @return true if the file was read.
+     */
+    static bool readData(const std::string& filePath, MeshData& mesh);
+
+    /**
+     * @brief Reads the contents of a mesh file that has already been read into CPU-side geometry, as readData() does.
+     * @param filePath The path the file was read from, which chooses the format.
+     * @param content The contents of the file.
+     * @param mesh Receives the geometry.
+     * @return true if the contents were read.
+     */
+    static bool readData(const std::string& filePath, const AssetBlob& content, MeshData& mesh);
+
     /**
      * @brief Creates a cube mesh with predefined vertex and index data.
      */
@@ -58,4 +158,8 @@ private:
     std::unique_ptr<IndexBuffer> _indexBuffer;
     // Vertex array object defining vertex attribute layout
     std::unique_ptr<VertexArray> _vertexArray;
+    // Radius of the bounding sphere around the mesh origin
+    float _boundingRadius = 0.0f;
+    // Texture coordinate units per model unit, averaged over the surface area
+    float _uvDensity = 0.0f;
 };
\ No newline at end of file
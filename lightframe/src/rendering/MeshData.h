@@ -0,0 +1,65 @@
+/**
+ * @file MeshData.h
+ * @author Justin McKay
+ * @brief CPU-side mesh geometry: interleaved vertices described by a buffer layout, triangle indices and bounds.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include "rendering/Buffer.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// Conventional attribute names. The cooker recognises attributes by these names to decide how to quantize them.
+constexpr std::string_view MESH_ATTRIBUTE_POSITION = "pos";
+constexpr std::string_view MESH_ATTRIBUTE_NORMAL = "normal";
+constexpr std::string_view MESH_ATTRIBUTE_COLOR = "color";
+constexpr std::string_view MESH_ATTRIBUTE_TEXCOORD = "texCoords";
+
+/**
+ * @brief Bounding volumes and texture density of a mesh, measured before it is quantized.
+ */
+struct MeshBounds {
+    glm::vec3 min = glm::vec3(0.0f);    ///< Minimum corner of the axis aligned bounding box
+    glm::vec3 max = glm::vec3(0.0f);    ///< Maximum corner of the axis aligned bounding box
+    float radius = 0.0f;                ///< Radius of a sphere around the mesh origin containing every vertex
+    float uvDensity = 0.0f;             ///< Texture coordinate units per model unit, averaged over the surface
+};
+
+/**
+ * @struct MeshData
+ * @brief Triangle list geometry with interleaved vertices, ready to be uploaded or cooked.
+ */
+struct MeshData {
+    BufferLayout layout;                ///< Attributes of each vertex
+    std::vector<uint8_t> vertices;      ///< Interleaved vertex data, layout.getStride() bytes per vertex
+    std::vector<uint32_t> indices;      ///< Triangle list indices
+    MeshBounds bounds;                  ///< Bounds of the geometry
+
+    /**
+     * @brief Gets the number of vertices.
+     */
+    uint32_t getVertexCount() const {
+        return layout.getStride() > 0 ? static_cast<uint32_t>(vertices.size() / layout.getStride()) : 0;
+    }
+
+    /**
+     * @brief Finds a vertex attribute by name.
+     * @param name The attribute name.
+     * @return const BufferElement* The attribute, or nullptr if the layout has none by that name.
+     */
+    const BufferElement* findAttribute(std::string_view name) const {
+        for (const BufferElement& element : layout) {
+            if (element.name == name) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+};
@@ -0,0 +1,311 @@
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LF_MIP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The separable kernel covers source pixels 2x-3 to 2x+4 for destination pixel x
+static constexpr int KERNEL_TAPS = 8;
+static constexpr int KERNEL_FIRST_TAP = -3;
+
+// Size of the linear to sRGB lookup table; fine enough to resolve every 8-bit value near black
+static constexpr int SRGB_ENCODE_SIZE = 16384;
+
+using Kernel = std::array<float, KERNEL_TAPS>;
+
+/**
+ * @brief Lookup tables for converting between 8-bit sRGB and linear values.
+ */
+struct SrgbTables {
+    std::array<float, 256> decode;
+    std::array<uint8_t, SRGB_ENCODE_SIZE> encode;
+};
+
+static const SrgbTables& getSrgbTables() {
+    static const SrgbTables tables = []() {
+        SrgbTables result;
+        for (int i = 0; i < 256; ++i) {
+            const double value = i / 255.0;
+            result.decode[i] = static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+        }
+        for (int i = 0; i < SRGB_ENCODE_SIZE; ++i) {
+            const double value = static_cast<double>(i) / (SRGB_ENCODE_SIZE - 1);
+            const double encoded = value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+            result.encode[i] = static_cast<uint8_t>(std::clamp(encoded * 255.0 + 0.5, 0.0, 255.0));
+        }
+        return result;
+    }();
+    return tables;
+}
+
+/**
+ * @brief Zeroth order modified Bessel function of the first kind, used by the Kaiser window.
+ */
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x * 0.5;
+    for (int k = 1; k < 32; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Builds the normalised weights of the 2:1 downsampling kernel for a filter.
+ */
+static Kernel makeKernel(MipFilter filter) {
+    Kernel kernel {};
+
+    if (filter == MipFilter::Box) {
+        // The two source pixels either side of the destination pixel centre
+        kernel[-KERNEL_FIRST_TAP] = 0.5f;
+        kernel[-KERNEL_FIRST_TAP + 1] = 0.5f;
+        return kernel;
+    }
+
+    // Kaiser-windowed sinc, radius 2 destination pixels, alpha 4
+    constexpr double radius = 2.0;
+    constexpr double alpha = 4.0;
+
+    double total = 0.0;
+    std::array<double, KERNEL_TAPS> weights {};
+    for (int k = 0; k < KERNEL_TAPS; ++k) {
+        // Distance from the destination pixel centre to the source pixel centre, in destination pixels
+        const double t = (KERNEL_FIRST_TAP + k - 0.5) * 0.5;
+        const double sinc = t == 0.0 ? 1.0 : std::sin(std::numbers::pi * t) / (std::numbers::pi * t);
+        const double window = besselI0(alpha * std::sqrt(std::max(0.0, 1.0 - (t / radius) * (t / radius)))) / besselI0(alpha);
+        weights[k] = sinc * window;
+        total += weights[k];
+    }
+    for (int k = 0; k < KERNEL_TAPS; ++k) {
+        kernel[k] = static_cast<float>(weights[k] / total);
+    }
+    return kernel;
+}
+
+/**
+ * @brief Checks whether a channel holds alpha, which is always filtered linearly.
+ */
+static bool isAlphaChannel(uint32_t channel, uint32_t channels) {
+    return (channels == 4 && channel == 3) || (channels == 2 && channel == 1);
+}
+
+/**
+ * @brief Converts a row of 8-bit pixels into linear floats, four lanes per pixel.
+ */
+static void decodeRow(const uint8_t* src, uint32_t width, uint32_t channels, bool srgb, float* dst) {
+    const SrgbTables& tables = getSrgbTables();
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            if (c >= channels) {
+                dst[x * 4 + c] = 0.0f;
+                continue;
+            }
+            const uint8_t value = src[x * channels + c];
+            dst[x * 4 + c] = srgb && !isAlphaChannel(c, channels) ? tables.decode[value] : value * (1.0f / 255.0f);
+        }
+    }
+}
+
+/**
+ * @brief Converts a row of linear float pixels back into 8-bit values, clamping the overshoot of sharp filters.
+ */
+static void encodeRow(const float* src, uint32_t width, uint32_t channels, bool srgb, uint8_t* dst) {
+    const SrgbTables& tables = getSrgbTables();
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            const float value = std::clamp(src[x * 4 + c], 0.0f, 1.0f);
+            dst[x * channels + c] = srgb && !isAlphaChannel(c, channels)
+                ? tables.encode[static_cast<int>(value * (SRGB_ENCODE_SIZE - 1) + 0.5f)]
+                : static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+    }
+}
+
+/**
+ * @brief Applies the kernel horizontally to a decoded row, halving its width.
+ */
+static void filterRow(const float* src, uint32_t srcWidth, float* dst, uint32_t dstWidth, const Kernel& kernel) {
+    const int lastPixel = static_cast<int>(srcWidth) - 1;
+
+    for (uint32_t x = 0; x < dstWidth; ++x) {
+        const int first = static_cast<int>(x) * 2 + KERNEL_FIRST_TAP;
+
+#ifdef LF_MIP_SSE2
+        __m128 sum = _mm_setzero_ps();
+        for (int k = 0; k < KERNEL_TAPS; ++k) {
+            if (kernel[k] == 0.0f) {
+                continue;
+            }
+            const int sx = std::clamp(first + k, 0, lastPixel);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel[k]), _mm_loadu_ps(src + sx * 4)));
+        }
+        _mm_storeu_ps(dst + x * 4, sum);
+#else
+        float sum[4] = {};
+        for (int k = 0; k < KERNEL_TAPS; ++k) {
+            const int sx = std::clamp(first + k, 0, lastPixel);
+            for (int c = 0; c < 4; ++c) {
+                sum[c] += kernel[k] * src[sx * 4 + c];
+            }
+        }
+        std::copy(sum, sum + 4, dst + x * 4);
+#endif
+    }
+}
+
+/**
+ * @brief Downsamples one level into the next with the separable kernel, in linear space.
+ *
+ * Horizontally filtered rows are kept in a small ring, since consecutive destination rows share most of their source
+ * rows, so memory use is independent of the image height.
+ */
+static void downsampleFiltered(const Image& image, const ImageMip& srcMip, const uint8_t* src,
+    const ImageMip& dstMip, uint8_t* dst, const Kernel& kernel) {
+
+    const uint32_t channels = image.channels;
+    const size_t rowFloats = static_cast<size_t>(dstMip.width) * 4;
+
+    std::vector<float> decodedRow(static_cast<size_t>(srcMip.width) * 4);
+    std::vector<float> filteredRows(rowFloats * KERNEL_TAPS);
+    std::vector<float> outputRow(rowFloats);
+    std::array<int, KERNEL_TAPS> cachedRows;
+    cachedRows.fill(-1);
+
+    const int lastRow = static_cast<int>(srcMip.height) - 1;
+
+    for (uint32_t y = 0; y < dstMip.height; ++y) {
+        std::fill(outputRow.begin(), outputRow.end(), 0.0f);
+        const int first = static_cast<int>(y) * 2 + KERNEL_FIRST_TAP;
+
+        for (int k = 0; k < KERNEL_TAPS; ++k) {
+            if (kernel[k] == 0.0f) {
+                continue;
+            }
+
+            // Source rows needed by one destination row span KERNEL_TAPS consecutive rows, so never share a slot
+            const int sy = std::clamp(first + k, 0, lastRow);
+            const int slot = sy % KERNEL_TAPS;
+            float* filtered = filteredRows.data() + slot * rowFloats;
+            if (cachedRows[slot] != sy) {
+                decodeRow(src + static_cast<size_t>(sy) * srcMip.width * channels, srcMip.width, channels, image.srgb,
+                    decodedRow.data());
+                filterRow(decodedRow.data(), srcMip.width, filtered, dstMip.width, kernel);
+                cachedRows[slot] = sy;
+            }
+
+#ifdef LF_MIP_SSE2
+            const __m128 weight = _mm_set1_ps(kernel[k]);
+            for (size_t i = 0; i < rowFloats; i += 4) {
+                const __m128 sum = _mm_add_ps(_mm_loadu_ps(outputRow.data() + i),
+                    _mm_mul_ps(weight, _mm_loadu_ps(filtered + i)));
+                _mm_storeu_ps(outputRow.data() + i, sum);
+            }
+#else
+            for (size_t i = 0; i < rowFloats; ++i) {
+                outputRow[i] += kernel[k] * filtered[i];
+            }
+#endif
+        }
+
+        encodeRow(outputRow.data(), dstMip.width, channels, image.srgb, dst + static_cast<size_t>(y) * dstMip.width * channels);
+    }
+}
+
+/**
+ * @brief Fast 2x2 box downsample of linear 4-channel images, in 8-bit integer arithmetic.
+ */
+static void downsampleBoxRgba(const ImageMip& srcMip, const uint8_t* src, const ImageMip& dstMip, uint8_t* dst) {
+    const size_t srcStride = static_cast<size_t>(srcMip.width) * 4;
+
+    for (uint32_t y = 0; y < dstMip.height; ++y) {
+        const uint8_t* row0 = src + std::min(y * 2, srcMip.height - 1) * srcStride;
+        const uint8_t* row1 = src + std::min(y * 2 + 1, srcMip.height - 1) * srcStride;
+        uint8_t* out = dst + static_cast<size_t>(y) * dstMip.width * 4;
+
+        uint32_t x = 0;
+
+#ifdef LF_MIP_SSE2
+        // Two destination pixels (four source pixels from each row) per iteration
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi16(2);
+        for (; x + 1 < dstMip.width && x * 2 + 3 < srcMip.width; x += 2) {
+            const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+            const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+
+            // Vertical sums of source pixels 0-1 and 2-3, widened to 16 bits
+            const __m128i left = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+            const __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+            // Add horizontally adjacent pixels, then round and divide by four
+            const __m128i sum = _mm_unpacklo_epi64(_mm_add_epi16(left, _mm_srli_si128(left, 8)),
+                _mm_add_epi16(right, _mm_srli_si128(right, 8)));
+            const __m128i average = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(average, zero));
+        }
+#endif
+
+        // Remaining pixels, and the clamped edge of odd-sized levels
+        for (; x < dstMip.width; ++x) {
+            const uint32_t x0 = std::min(x * 2, srcMip.width - 1) * 4;
+            const uint32_t x1 = std::min(x * 2 + 1, srcMip.width - 1) * 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                out[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+void generateMipChain(Image& image, MipFilter filter) {
+    // Compressed images must have their mips generated before encoding
+    if (image.mips.empty() || isCompressedFormat(image.format)) {
+        return;
+    }
+
+    // Lay out the full chain after the base level
+    image.ensureOwned();
+    image.mips.resize(1);
+    const uint32_t mipCount = Image::calcMipCount(image.width, image.height);
+    size_t offset = image.mips[0].size;
+    for (uint32_t level = 1; level < mipCount; ++level) {
+        const ImageMip& previous = image.mips[level - 1];
+        const uint32_t width = std::max(1u, previous.width / 2);
+        const uint32_t height = std::max(1u, previous.height / 2);
+        const size_t size = static_cast<size_t>(width) * height * image.channels;
+
+        image.mips.push_back(ImageMip { .width = width, .height = height, .offset = offset, .size = size });
+        offset += size;
+    }
+    image.data.resize(offset);
+
+    static const Kernel boxKernel = makeKernel(MipFilter::Box);
+    static const Kernel kaiserKernel = makeKernel(MipFilter::Kaiser);
+    const Kernel& kernel = filter == MipFilter::Box ? boxKernel : kaiserKernel;
+
+    // Linear RGBA box filtering never leaves 8-bit integers; everything else goes through linear floats
+    const bool integerBox = filter == MipFilter::Box && !image.srgb && image.channels == 4;
+
+    for (uint32_t level = 1; level < mipCount; ++level) {
+        const ImageMip& srcMip = image.mips[level - 1];
+        const ImageMip& dstMip = image.mips[level];
+
+        if (integerBox) {
+            downsampleBoxRgba(srcMip, image.getMipData(level - 1), dstMip, image.getMipData(level));
+        } else {
+            downsampleFiltered(image, srcMip, image.getMipData(level - 1), dstMip, image.getMipData(level), kernel);
+        }
+    }
+}
@@ -0,0 +1,22 @@
+/**
+ * @file MipGenerator.h
+ * @author Justin McKay
+ * @brief CPU mip chain generation with SIMD box and Kaiser filters, gamma-correct for sRGB images.
+ * @date 2026-03-12
+ */
+
+#pragma once
+
+#include "rendering/Image.h"
+
+/**
+ * @brief Generates every mip level below the base level of an image, replacing any existing levels.
+ *
+ * Each level is filtered from the one above it. sRGB images are filtered in linear space and re-encoded, so
+ * minified textures don't darken; alpha is always treated as linear. Intended to run at cook time or on a loader
+ * thread, never on the render thread.
+ *
+ * @param image The image to generate mips for. Its base level must be filled in.
+ * @param filter The downsampling filter.
+ */
+void generateMipChain(Image& image, MipFilter filter);
@@ -2,46 +2,64 @@
 
 #include "resources/ResourceManager.h"
 #include "rendering/opengl/OpenGLRenderer.h"
+#include "rendering/opengl/OpenGLUploadContext.h"
 #include "scenes/Scene.h"
 #include "scenes/components/MeshRenderer.h"
 
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 std::unique_ptr<Renderer> Renderer::create(ResourceManager& resourceManager) {
     return std::make_unique<OpenGLRenderer>(resourceManager);
 }
 
+bool Renderer::hasUploadThread() {
+    return OpenGLUploadContext::get()->isRunning();
+}
+
 void Renderer::renderScene(const Scene& scene) {
 
     beginFrame();
 
-    for (const auto& gameObject : scene.getGameObjects()) {
+    // World units covered by one pixel at unit distance from the camera
+    const PerspectiveCameraSettings& cameraSettings = scene.worldCamera.getSettings();
+    const float pixelAngle = 2.0f * std::tan(glm::radians(cameraSettings.fieldOfView) * 0.5f) / cameraSettings.viewHeight;
 
-        // try and cast to a GameObject3D type. If not able to cast, continue to next
-        const auto* gameObject3D = dynamic_cast<const GameObject3D*>(gameObject.get());
-        if (!gameObject3D) {
-            continue;
-        }
+    const glm::mat4 viewProjection = scene.worldCamera.buildViewProjectionMatrix();
+    const glm::vec3 cameraPosition = scene.worldCamera.transform.position;
 
-        const auto* meshRenderer = gameObject->getComponent<MeshRenderer>();
-        if (!meshRenderer) {
-            continue;
+    // Reads the transform and mesh renderer arrays of each chunk in order, rather than visiting objects one by one
+    scene.getWorld().forEach<Transform3D, MeshRenderer>([&](Entity, const Transform3D& transform, const MeshRenderer& meshRenderer) {
+        // A mesh or material unloaded explicitly no longer resolves, so there is nothing to draw
+        Mesh* mesh = meshRenderer.getMesh();
+        Material* material = meshRenderer.getMaterial();
+        if (!mesh || !material) {
+            return;
         }
 
         RenderState renderState;
         renderState.polygonMode = PolygonMode::Line;
         renderState.cullMode = CullMode::None;
 
+        // Estimate the screen-space texture density from the nearest point of the mesh bounding sphere
+        const float scale = std::max({ transform.scale.x, transform.scale.y, transform.scale.z });
+        const float distance = std::max(glm::length(transform.position - cameraPosition)
+            - mesh->getBoundingRadius() * scale, cameraSettings.nearPlane);
+        const float uvPerPixel = mesh->getUvDensity() / scale * distance * pixelAngle;
+
         RenderCommand command = {
-            .mesh = meshRenderer->getMesh(),
-            .material = meshRenderer->getMaterial(),
-            .transform = scene.worldCamera.buildViewProjectionMatrix() * gameObject3D->transform.createModelMatrix(),
+            .mesh = mesh,
+            .material = material,
+            .transform = viewProjection * transform.createModelMatrix(),
             .renderPass = RenderPass::Geometry,
-            .renderState = renderState
+            .renderState = renderState,
+            .uvPerPixel = uvPerPixel
         };
         submit(command);
-
-    }
+    });
 
     endFrame();
 }
\ No newline at end of file
@@ -85,6 +85,8 @@ struct RenderCommand {
     glm::mat4 transform;
     RenderPass renderPass;
     RenderState renderState;
+    // Texture coordinate units covered by one screen pixel, used to choose which mips to stream in
+    float uvPerPixel = 0.0f;
 };
 
 /**
@@ -119,6 +121,13 @@ public:
      */
     static std::unique_ptr<Renderer> create(ResourceManager& resourceManger);
 
+    /**
+     * @brief Checks whether buffers and textures can be created and filled on loader threads, through a GL context
+     * shared with the window's on a dedicated upload thread. When false, they must be created on the render thread.
+     * @return bool True if the upload thread is running.
+     */
+    static bool hasUploadThread();
+
 protected:
 
     /**
@@ -1,57 +1,46 @@
 #include "Shader.h"
 #include "opengl/OpenGLShader.h"
+#include "opengl/OpenGLProgramCache.h"
+#include "ShaderPreprocessor.h"
 #include "core/Logger.h"
 #include "core/Strings.h"
+#include "core/ThreadPool.h"
 
-#include <fstream>
-#include <sstream>
 #include <memory>
 
-std::unique_ptr<Shader> Shader::create(const std::string& shaderPath) {
+std::unique_ptr<Shader> Shader::create(const std::string& shaderPath, ShaderFeatureMask features) {
     // TODO: Platform detection/selection
-    return std::make_unique<OpenGLShader>(shaderPath);
+    return std::make_unique<OpenGLShader>(loadShaderSources(shaderPath, features), false);
 }
 
-std::unordered_map<ShaderType, std::string> Shader::loadShaderSources(const std::string& shaderPath) {
-    
-    std::ifstream file(shaderPath);
-    if (!file.is_open()) {
-        LOG_WARN("Failed to open shader file: {}", shaderPath);
-        return {};
-    }
-    
-    std::unordered_map<ShaderType, std::string> shaderSources;
-    
-    std::string line;
-    std::string currentSection;
-    std::stringstream currentSource;
-    
-    while (std::getline(file, line)) {
-        if (line.find("//:") == 0) {
-            
-            // If the current section is not empty, set the source from the previous section and start a new section
-            if (!currentSection.empty()) {
-                shaderSources[shaderTypeFromName(currentSection)] = currentSource.str();
-                
-                // Clear current source for next section
-                currentSource.str("");
-                currentSource.clear();
-            }
-            
-            currentSection = line.substr(3); // skip "//:"
-            
-        } else {
-            // We're in the main shader source section so add the line to the current source
-            currentSource << line << '\n';
-        }
-    }
-    
-    // Set the last source into the map
-    if (!currentSection.empty()) {
-        shaderSources[shaderTypeFromName(currentSection)] = currentSource.str();
-    }
-    
-    return shaderSources;
+std::unique_ptr<Shader> Shader::create(const std::string& shaderPath, const AssetBlob& content) {
+    return std::make_unique<OpenGLShader>(ShaderPreprocessor::get()->process(shaderPath, content).sources, false);
+}
+
+std::unique_ptr<Shader> Shader::create(const std::unordered_map<ShaderType, std::string>& shaderSources) {
+    return std::make_unique<OpenGLShader>(shaderSources, false);
+}
+
+std::unique_ptr<Shader> Shader::createAsync(const std::string& shaderPath, ShaderFeatureMask features) {
+    // The files are read and preprocessed on a worker; the compile is submitted once the sources arrive
+    return std::make_unique<OpenGLShader>(ThreadPool::get()->submit([shaderPath, features]() {
+        return loadShaderSources(shaderPath, features);
+    }));
+}
+
+std::unique_ptr<Shader> Shader::createAsync(const std::string& shaderPath, const AssetBlob& content) {
+    return std::make_unique<OpenGLShader>(ThreadPool::get()->submit([shaderPath, content]() {
+        return ShaderPreprocessor::get()->process(shaderPath, content).sources;
+    }));
+}
+
+std::unique_ptr<Shader> Shader::createAsync(const std::unordered_map<ShaderType, std::string>& shaderSources) {
+    return std::make_unique<OpenGLShader>(shaderSources, true);
+}
+
+std::unordered_map<ShaderType, std::string> Shader::loadShaderSources(const std::string& shaderPath,
+    ShaderFeatureMask features) {
+    return ShaderPreprocessor::get()->process(shaderPath, features).sources;
 }
 
 ShaderType Shader::shaderTypeFromName(std::string& name) {
@@ -69,4 +58,23 @@ ShaderType Shader::shaderTypeFromName(std::string& name) {
     
     // Unknown string, so return unknown
     return ShaderType::Unknown;
+}
+
+void Shader::setCacheDirectory(const std::string& directory) {
+    OpenGLProgramCache::get()->setDirectory(directory);
+}
+
+void Shader::setCacheEnabled(bool enabled) {
+    OpenGLProgramCache::get()->setEnabled(enabled);
+}
+
+const ShaderCacheStats& Shader::getCacheStats() {
+    return OpenGLProgramCache::get()->getStats();
+}
+
+void Shader::logCacheStats() {
+    const ShaderCacheStats& stats = getCacheStats();
+    LOG_INFO("Shader cache: hits = {}, misses = {}, hit rate = {:.1f}%, compile time = {:.1f}ms, poll latency = {:.1f}ms, time saved = {:.1f}ms",
+        stats.hits, stats.misses, stats.getHitRate() * 100.0f, stats.compileSeconds * 1000.0, stats.pollLatencySeconds * 1000.0,
+        stats.savedSeconds * 1000.0);
 }
\ No newline at end of file
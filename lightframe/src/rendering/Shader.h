@@ -2,25 +2,154 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
 
+struct AssetBlob;
+
 enum class ShaderType {
     Unknown = 0,
     Vertex,
     Fragment
 };
 
+/**
+ * @brief Optional shader features, each compiled in through a #define so materials get specialised programs
+ * instead of branching at runtime.
+ */
+enum class ShaderFeature : uint32_t {
+    Skinned   = 1 << 0,     ///< Defines SKINNED
+    Instanced = 1 << 1,     ///< Defines INSTANCED
+    AlphaTest = 1 << 2      ///< Defines ALPHA_TEST
+};
+
+/**
+ * @brief Bitmask of ShaderFeature values identifying a shader permutation.
+ */
+using ShaderFeatureMask = uint32_t;
+
+/**
+ * @brief Combines two shader features into a feature mask.
+ */
+constexpr ShaderFeatureMask operator|(ShaderFeature a, ShaderFeature b) {
+    return static_cast<ShaderFeatureMask>(a) | static_cast<ShaderFeatureMask>(b);
+}
+
+/**
+ * @brief Adds a shader feature to a feature mask.
+ */
+constexpr ShaderFeatureMask operator|(ShaderFeatureMask mask, ShaderFeature feature) {
+    return mask | static_cast<ShaderFeatureMask>(feature);
+}
+
+/**
+ * @brief Compilation state of a shader program.
+ */
+enum class ShaderStatus {
+    Pending = 0,    ///< Compile and link have been submitted but have not finished yet
+    Ready,          ///< The program linked successfully and can be used for rendering
+    Failed          ///< Compilation or linking failed; the program can never be used
+};
+
+/**
+ * @brief Statistics gathered by the on-disk shader program cache.
+ */
+struct ShaderCacheStats {
+    /** Number of programs loaded from a cached binary */
+    uint32_t hits = 0;
+    /** Number of programs that had to be compiled and linked from source */
+    uint32_t misses = 0;
+    /** Total time spent compiling and linking programs on a miss, in seconds */
+    double compileSeconds = 0.0;
+    /** Total time async programs spent finished but not yet polled, excluded from compileSeconds, in seconds */
+    double pollLatencySeconds = 0.0;
+    /** Total time spent loading cached binaries on a hit, in seconds */
+    double loadSeconds = 0.0;
+    /** Compile time avoided by cache hits, net of the time spent loading the binaries, in seconds */
+    double savedSeconds = 0.0;
+
+    /**
+     * @brief Gets the fraction of program creations that were served from the cache.
+     * @return The hit rate in the range [0, 1].
+     */
+    float getHitRate() const {
+        const uint32_t total = hits + misses;
+        return total > 0 ? static_cast<float>(hits) / static_cast<float>(total) : 0.0f;
+    }
+};
+
 class Shader {
 public:
 
+    /**
+     * @brief Virtual destructor for proper cleanup of derived shader classes.
+     */
+    virtual ~Shader() = default;
+
     /**
      * @brief Creates a new Shader instance.
      * @param shaderPath The file path to the shader source code.
+     * @param features The features to compile into this permutation of the shader.
+     * @return std::unique_ptr<Shader> A new Shader object.
+     */
+    static std::unique_ptr<Shader> create(const std::string& shaderPath, ShaderFeatureMask features = 0);
+
+    /**
+     * @brief Creates a new Shader instance from the contents of a .shader file that has already been read.
+     * @param shaderPath The file path the contents were read from, which includes are relative to.
+     * @param content The contents of the .shader file.
      * @return std::unique_ptr<Shader> A new Shader object.
      */
-    static std::unique_ptr<Shader> create(const std::string& shaderPath);
+    static std::unique_ptr<Shader> create(const std::string& shaderPath, const AssetBlob& content);
+
+    /**
+     * @brief Creates a new Shader instance from in-memory stage sources.
+     * @param shaderSources The source code of each shader stage.
+     * @return std::unique_ptr<Shader> A new Shader object.
+     */
+    static std::unique_ptr<Shader> create(const std::unordered_map<ShaderType, std::string>& shaderSources);
+
+    /**
+     * @brief Creates a new Shader instance without waiting for compilation to finish.
+     * The source files are read and preprocessed on a worker thread. Once they arrive, the next getStatus() poll
+     * submits every compile and link to the driver; the link result is only checked on later polls, so many shaders
+     * can compile in parallel. Render with a fallback until ready.
+     * @param shaderPath The file path to the shader source code.
+     * @param features The features to compile into this permutation of the shader.
+     * @return std::unique_ptr<Shader> A new Shader object whose program becomes ready later.
+     */
+    static std::unique_ptr<Shader> createAsync(const std::string& shaderPath, ShaderFeatureMask features = 0);
+
+    /**
+     * @brief Creates a new Shader instance from the contents of a .shader file that has already been read, without
+     * waiting for compilation to finish. The contents are preprocessed on a worker thread, as createAsync() does.
+     * @param shaderPath The file path the contents were read from, which includes are relative to.
+     * @param content The contents of the .shader file.
+     * @return std::unique_ptr<Shader> A new Shader object whose program becomes ready later.
+     */
+    static std::unique_ptr<Shader> createAsync(const std::string& shaderPath, const AssetBlob& content);
+
+    /**
+     * @brief Creates a new Shader instance from in-memory stage sources without waiting for compilation to finish.
+     * @param shaderSources The source code of each shader stage.
+     * @return std::unique_ptr<Shader> A new Shader object whose program becomes ready later.
+     */
+    static std::unique_ptr<Shader> createAsync(const std::unordered_map<ShaderType, std::string>& shaderSources);
+
+    /**
+     * @brief Polls the compilation state of this shader, finalising the program if the driver has finished with it.
+     * This never blocks when the driver supports parallel shader compilation.
+     * @return ShaderStatus The current compilation state.
+     */
+    virtual ShaderStatus getStatus() = 0;
+
+    /**
+     * @brief Checks whether this shader has finished compiling and linked successfully.
+     * @return true if the shader can be used for rendering, false otherwise.
+     */
+    bool isReady() { return getStatus() == ShaderStatus::Ready; }
 
     /**
      * @brief Activates this shader for rendering.
@@ -72,10 +201,13 @@ public:
     
     /**
      * @brief Loads shader source code from a file, separating different shader stages.
+     * Includes are expanded and feature defines injected by the ShaderPreprocessor.
      * @param shaderPath The file path to the shader source code.
+     * @param features The features to enable in the preprocessed source.
      * @return std::unordered_map<ShaderType, std::string> A map of shader stage types to their source code.
      */
-    static std::unordered_map<ShaderType, std::string> loadShaderSources(const std::string& shaderPath);
+    static std::unordered_map<ShaderType, std::string> loadShaderSources(const std::string& shaderPath,
+        ShaderFeatureMask features = 0);
     
     /**
      * @brief Converts a shader type name to its corresponding ShaderType enum value.
@@ -83,4 +215,27 @@ public:
      * @return ShaderType The corresponding ShaderType enum value.
      */
     static ShaderType shaderTypeFromName(std::string& name);
+
+    /**
+     * @brief Sets the directory compiled program binaries are cached in.
+     * @param directory The cache directory. It is created on first use.
+     */
+    static void setCacheDirectory(const std::string& directory);
+
+    /**
+     * @brief Enables or disables the on-disk program binary cache.
+     * @param enabled Whether program binaries should be read from and written to disk.
+     */
+    static void setCacheEnabled(bool enabled);
+
+    /**
+     * @brief Gets the statistics gathered by the program binary cache since startup.
+     * @return The shader cache statistics.
+     */
+    static const ShaderCacheStats& getCacheStats();
+
+    /**
+     * @brief Logs the hit rate and startup time saved by the program binary cache.
+     */
+    static void logCacheStats();
 };
\ No newline at end of file
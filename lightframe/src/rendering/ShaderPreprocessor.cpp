@@ -0,0 +1,275 @@
+#include "ShaderPreprocessor.h"
+
+#include "assets/VirtualFileSystem.h"
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <sstream>
+#include <string_view>
+
+/**
+ * @brief Normalises a path so the same file is always cached under the same key.
+ * @param path The path to normalise.
+ * @return The normalised path.
+ */
+static std::string normalisePath(const std::filesystem::path& path) {
+    return std::filesystem::absolute(path).lexically_normal().generic_string();
+}
+
+/**
+ * @brief Returns the line with leading whitespace removed.
+ */
+static std::string_view trimLeft(std::string_view line) {
+    const size_t start = line.find_first_not_of(" \t");
+    return start == std::string_view::npos ? std::string_view() : line.substr(start);
+}
+
+/**
+ * @brief Extracts the first whitespace-delimited token following a directive, e.g. the macro of "#ifndef MACRO".
+ */
+static std::string_view directiveArgument(std::string_view line, std::string_view directive) {
+    std::string_view rest = trimLeft(line.substr(directive.size()));
+    const size_t end = rest.find_first_of(" \t");
+    return end == std::string_view::npos ? rest : rest.substr(0, end);
+}
+
+/**
+ * @brief Works out which include guard a file uses, if any.
+ * @param lines The lines of the file.
+ * @return "#pragma once", the macro of a classic #ifndef/#define guard, or an empty string.
+ */
+static std::string detectIncludeGuard(const std::vector<std::string>& lines) {
+    std::string_view ifndefMacro;
+    for (const std::string& line : lines) {
+        const std::string_view trimmed = trimLeft(line);
+        if (trimmed.empty() || trimmed.starts_with("//")) {
+            continue;
+        }
+
+        if (ifndefMacro.empty()) {
+            if (trimmed.starts_with("#pragma once")) {
+                return "#pragma once";
+            }
+            if (!trimmed.starts_with("#ifndef")) {
+                return "";
+            }
+            ifndefMacro = directiveArgument(trimmed, "#ifndef");
+            continue;
+        }
+
+        // The line after the #ifndef must define the same macro for it to be a guard
+        if (trimmed.starts_with("#define") && directiveArgument(trimmed, "#define") == ifndefMacro) {
+            return std::string(ifndefMacro);
+        }
+        return "";
+    }
+    return "";
+}
+
+/**
+ * @brief Finds the index of a file in the dependency list, adding it if it is not present.
+ */
+static size_t dependencyIndex(std::vector<std::string>& dependencies, const std::string& filePath) {
+    auto it = std::find(dependencies.begin(), dependencies.end(), filePath);
+    if (it != dependencies.end()) {
+        return std::distance(dependencies.begin(), it);
+    }
+    dependencies.push_back(filePath);
+    return dependencies.size() - 1;
+}
+
+ShaderPreprocessor* ShaderPreprocessor::get() {
+    // Shaders are preprocessed on workers, so the first use may come from several threads at once
+    static ShaderPreprocessor preprocessor;
+    return &preprocessor;
+}
+
+const char* ShaderPreprocessor::featureDefine(ShaderFeature feature) {
+    switch (feature) {
+        case ShaderFeature::Skinned:    return "SKINNED";
+        case ShaderFeature::Instanced:  return "INSTANCED";
+        case ShaderFeature::AlphaTest:  return "ALPHA_TEST";
+    }
+    return "";
+}
+
+PreprocessedShader ShaderPreprocessor::process(const std::string& shaderPath, ShaderFeatureMask features) {
+    return processFile(shaderPath, nullptr, features);
+}
+
+PreprocessedShader ShaderPreprocessor::process(const std::string& shaderPath, const AssetBlob& content,
+    ShaderFeatureMask features) {
+    return processFile(shaderPath, &content, features);
+}
+
+PreprocessedShader ShaderPreprocessor::processFile(const std::string& shaderPath, const AssetBlob* content,
+    ShaderFeatureMask features) {
+
+    PreprocessedShader result;
+
+    const std::string filePath = normalisePath(shaderPath);
+    CachedFile file;
+    if (!readFile(filePath, file, content)) {
+        LOG_WARN("Failed to open shader file: {}", shaderPath);
+        return result;
+    }
+    result.dependencies.push_back(filePath);
+
+    // Build the defines once; they are shared by every stage of the permutation
+    std::string defines;
+    for (ShaderFeature feature : { ShaderFeature::Skinned, ShaderFeature::Instanced, ShaderFeature::AlphaTest }) {
+        if (features & static_cast<ShaderFeatureMask>(feature)) {
+            defines += std::format("#define {} 1\n", featureDefine(feature));
+        }
+    }
+
+    // Split the file into stage sections on "//:" markers
+    std::string currentSection;
+    size_t sectionStart = 0;
+    auto flushSection = [&](size_t sectionEnd) {
+        if (currentSection.empty()) {
+            return;
+        }
+
+        const std::vector<std::string> sectionLines(file.lines.begin() + sectionStart, file.lines.begin() + sectionEnd);
+
+        StageContext context;
+        context.includeStack.push_back(filePath);
+        context.defines = defines;
+
+        std::string source;
+        expandLines(sectionLines, sectionStart + 1, filePath, context, result.dependencies, source);
+
+        // No #version line to insert after, so the defines go first
+        if (!context.definesEmitted) {
+            source.insert(0, defines);
+        }
+
+        result.sources[Shader::shaderTypeFromName(currentSection)] = std::move(source);
+    };
+
+    for (size_t i = 0; i < file.lines.size(); ++i) {
+        if (file.lines[i].find("//:") == 0) {
+            flushSection(i);
+            currentSection = file.lines[i].substr(3); // skip "//:"
+            sectionStart = i + 1;
+        }
+    }
+    flushSection(file.lines.size());
+
+    return result;
+}
+
+void ShaderPreprocessor::invalidate(const std::string& filePath) {
+    std::lock_guard lock(_cacheMutex);
+    _fileCache.erase(normalisePath(filePath));
+}
+
+void ShaderPreprocessor::clearCache() {
+    std::lock_guard lock(_cacheMutex);
+    _fileCache.clear();
+}
+
+bool ShaderPreprocessor::readFile(const std::string& filePath, CachedFile& file, const AssetBlob* content) {
+    std::lock_guard lock(_cacheMutex);
+
+    auto it = _fileCache.find(filePath);
+    if (it != _fileCache.end()) {
+        file = it->second;
+        return true;
+    }
+
+    AssetBlob blob;
+    if (content) {
+        blob = *content;
+    } else if (!VirtualFileSystem::get()->read(filePath, blob)) {
+        return false;
+    }
+
+    std::istringstream stream(std::string(reinterpret_cast<const char*>(blob.data.data()), blob.data.size()));
+    CachedFile cachedFile;
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        cachedFile.lines.push_back(std::move(line));
+    }
+    cachedFile.includeGuard = detectIncludeGuard(cachedFile.lines);
+
+    file = cachedFile;
+    _fileCache.emplace(filePath, std::move(cachedFile));
+    return true;
+}
+
+void ShaderPreprocessor::expandLines(const std::vector<std::string>& lines, size_t firstLine, const std::string& filePath,
+    StageContext& context, std::vector<std::string>& dependencies, std::string& output) {
+
+    const size_t fileIndex = dependencyIndex(dependencies, filePath);
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const std::string& line = lines[i];
+        const std::string_view trimmed = trimLeft(line);
+        const size_t lineNumber = firstLine + i;
+
+        if (trimmed.starts_with("#include")) {
+            // Accept both #include "file" and #include <file>, resolved relative to the including file
+            const size_t open = trimmed.find_first_of("\"<");
+            const size_t close = open == std::string_view::npos ? open : trimmed.find_first_of("\">", open + 1);
+            if (close == std::string_view::npos) {
+                LOG_WARN("Malformed #include in {}:{}", filePath, lineNumber);
+                output += '\n';
+                continue;
+            }
+
+            const std::string includeName(trimmed.substr(open + 1, close - open - 1));
+            const std::string includePath = normalisePath(std::filesystem::path(filePath).parent_path() / includeName);
+
+            CachedFile includeFile;
+            if (context.includedOnce.contains(includePath)) {
+                // Already expanded into this stage and guarded, so there is nothing to add
+                output += '\n';
+                continue;
+            }
+            if (std::find(context.includeStack.begin(), context.includeStack.end(), includePath) != context.includeStack.end()) {
+                LOG_WARN("Recursive #include of {} in {}:{}", includePath, filePath, lineNumber);
+                output += '\n';
+                continue;
+            }
+            if (!readFile(includePath, includeFile)) {
+                LOG_WARN("Unable to open #include {} in {}:{}", includePath, filePath, lineNumber);
+                output += '\n';
+                continue;
+            }
+
+            if (!includeFile.includeGuard.empty()) {
+                context.includedOnce.insert(includePath);
+            }
+
+            // #line keeps compiler errors pointing at the right file (by dependency index) and line
+            output += std::format("#line 1 {}\n", dependencyIndex(dependencies, includePath));
+            context.includeStack.push_back(includePath);
+            expandLines(includeFile.lines, 1, includePath, context, dependencies, output);
+            context.includeStack.pop_back();
+            output += std::format("#line {} {}\n", lineNumber + 1, fileIndex);
+            continue;
+        }
+
+        if (trimmed.starts_with("#pragma once")) {
+            output += '\n';
+            continue;
+        }
+
+        output += line;
+        output += '\n';
+
+        // Feature defines must come after #version, which has to be the first directive in a GLSL stage
+        if (!context.definesEmitted && trimmed.starts_with("#version")) {
+            context.definesEmitted = true;
+            output += context.defines;
+            output += std::format("#line {} {}\n", lineNumber + 1, fileIndex);
+        }
+    }
+}
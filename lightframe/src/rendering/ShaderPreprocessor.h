@@ -0,0 +1,141 @@
+/**
+ * @file ShaderPreprocessor.h
+ * @author Justin McKay
+ * @brief Expands #include directives and injects feature #defines into .shader files before compilation.
+ * @date 2026-03-06
+ */
+
+#pragma once
+
+#include "assets/AssetArchive.h"
+#include "rendering/Shader.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief The result of preprocessing a .shader file.
+ */
+struct PreprocessedShader {
+    /** Fully expanded source of each shader stage */
+    std::unordered_map<ShaderType, std::string> sources;
+    /**
+     * The shader file followed by every file it includes, directly or indirectly, as absolute normalised paths.
+     * Index i is #line source string i.
+     */
+    std::vector<std::string> dependencies;
+};
+
+class ShaderPreprocessor {
+public:
+
+    /**
+     * @brief Preprocesses a .shader file into the source of each stage.
+     *
+     * The file is split into stages on "//:<stage>" markers. Within each stage, #include "file" directives are
+     * expanded recursively (paths are relative to the including file), and a #define for every feature in the mask
+     * is inserted directly after the #version line. Included files that use #pragma once or a classic
+     * #ifndef/#define guard are only expanded once per stage.
+     *
+     * @param shaderPath The file path of the .shader file.
+     * @param features The features to enable for this permutation.
+     * @return PreprocessedShader The stage sources and the list of files they were built from.
+     */
+    PreprocessedShader process(const std::string& shaderPath, ShaderFeatureMask features = 0);
+
+    /**
+     * @brief Preprocesses a .shader file whose contents have already been read, as process() does. The files it
+     * includes are still read through the cache.
+     * @param shaderPath The file path of the .shader file, which includes are relative to.
+     * @param content The contents of the .shader file.
+     * @param features The features to enable for this permutation.
+     * @return PreprocessedShader The stage sources and the list of files they were built from.
+     */
+    PreprocessedShader process(const std::string& shaderPath, const AssetBlob& content, ShaderFeatureMask features = 0);
+
+    /**
+     * @brief Drops the cached contents of a file so the next process() call reads it from disk again.
+     * @param filePath The path of the file to invalidate.
+     */
+    void invalidate(const std::string& filePath);
+
+    /**
+     * @brief Drops the cached contents of every file.
+     */
+    void clearCache();
+
+    /**
+     * @brief Gets the name of the preprocessor define for a shader feature.
+     * @param feature The shader feature.
+     * @return const char* The define name, e.g. "ALPHA_TEST".
+     */
+    static const char* featureDefine(ShaderFeature feature);
+
+    /**
+     * @brief Singleton method to get the shared preprocessor, so every shader load shares one file cache. Safe to
+     * call from any thread.
+     * @return ShaderPreprocessor* A pointer to the preprocessor instance.
+     */
+    static ShaderPreprocessor* get();
+
+private:
+
+    /**
+     * @brief Contents of a source file, along with the include guard it uses, if any.
+     */
+    struct CachedFile {
+        std::vector<std::string> lines;
+        // Macro of a classic #ifndef/#define include guard, or "#pragma once", or empty if the file is unguarded
+        std::string includeGuard;
+    };
+
+    /**
+     * @brief State carried through the expansion of a single stage.
+     */
+    struct StageContext {
+        // Files already expanded into this stage that must not be expanded again
+        std::unordered_set<std::string> includedOnce;
+        // Files currently being expanded, used to detect include cycles
+        std::vector<std::string> includeStack;
+        // Feature defines to insert after the #version line
+        std::string defines;
+        // Whether the defines have been written yet
+        bool definesEmitted = false;
+    };
+
+    // Cache of file contents, keyed by normalised path, shared across stages and permutations
+    std::unordered_map<std::string, CachedFile> _fileCache;
+
+    // Guards the file cache, as shaders may be preprocessed on loader threads
+    std::mutex _cacheMutex;
+
+    /**
+     * @brief Reads a file through the cache.
+     * @param filePath The normalised path of the file.
+     * @param file Receives the cached file contents.
+     * @param content The contents of the file if they have already been read, used if it is not cached.
+     * @return true if the file could be read, false otherwise.
+     */
+    bool readFile(const std::string& filePath, CachedFile& file, const AssetBlob* content = nullptr);
+
+    /**
+     * @brief Preprocesses a .shader file, reading it through the cache unless its contents are given.
+     */
+    PreprocessedShader processFile(const std::string& shaderPath, const AssetBlob* content, ShaderFeatureMask features);
+
+    /**
+     * @brief Recursively expands the includes of a block of lines into the output stream.
+     * @param lines The lines to expand.
+     * @param firstLine Line number of the first line within its file (1-based).
+     * @param filePath The normalised path of the file the lines come from.
+     * @param context The state of the stage being expanded.
+     * @param dependencies The list of dependencies, extended with any newly encountered includes.
+     * @param output Receives the expanded source.
+     */
+    void expandLines(const std::vector<std::string>& lines, size_t firstLine, const std::string& filePath,
+        StageContext& context, std::vector<std::string>& dependencies, std::string& output);
+};
@@ -0,0 +1,60 @@
+#include "ShaderVariantCache.h"
+
+#include "core/Logger.h"
+
+void ShaderVariantCache::registerShader(uint32_t shaderId, const std::string& shaderPath) {
+    _shaderPaths[shaderId] = shaderPath;
+}
+
+void ShaderVariantCache::unregisterShader(uint32_t shaderId) {
+    _shaderPaths.erase(shaderId);
+    std::erase_if(_variants, [shaderId](const auto& entry) {
+        return static_cast<uint32_t>(entry.first >> 32) == shaderId;
+    });
+}
+
+Shader* ShaderVariantCache::getVariant(uint32_t shaderId, ShaderFeatureMask features) {
+    const uint64_t key = makeKey(shaderId, features);
+
+    auto it = _variants.find(key);
+    if (it != _variants.end()) {
+        return it->second.get();
+    }
+
+    auto pathIt = _shaderPaths.find(shaderId);
+    if (pathIt == _shaderPaths.end()) {
+        LOG_WARN("Unable to create variant {:#x} of unregistered shader {}.", features, shaderId);
+        return nullptr;
+    }
+
+    // Compile lazily and asynchronously; the renderer draws with its fallback until the variant is ready
+    LOG_DEBUG("Compiling variant {:#x} of shader {}.", features, pathIt->second);
+    auto [inserted, _] = _variants.emplace(key, Shader::createAsync(pathIt->second, features));
+    return inserted->second.get();
+}
+
+void ShaderVariantCache::prewarm(uint32_t shaderId, const std::vector<ShaderFeatureMask>& permutations) {
+    for (ShaderFeatureMask features : permutations) {
+        getVariant(shaderId, features);
+    }
+}
+
+void ShaderVariantCache::replaceVariant(uint32_t shaderId, ShaderFeatureMask features, std::unique_ptr<Shader> shader) {
+    _variants[makeKey(shaderId, features)] = std::move(shader);
+}
+
+std::vector<ShaderFeatureMask> ShaderVariantCache::getVariantFeatures(uint32_t shaderId) const {
+    std::vector<ShaderFeatureMask> features;
+    for (const auto& [key, _] : _variants) {
+        if (static_cast<uint32_t>(key >> 32) == shaderId) {
+            features.push_back(static_cast<ShaderFeatureMask>(key));
+        }
+    }
+    return features;
+}
+
+const std::string& ShaderVariantCache::getShaderPath(uint32_t shaderId) const {
+    static const std::string emptyPath;
+    auto it = _shaderPaths.find(shaderId);
+    return it != _shaderPaths.end() ? it->second : emptyPath;
+}
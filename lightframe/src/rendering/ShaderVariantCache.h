@@ -0,0 +1,97 @@
+/**
+ * @file ShaderVariantCache.h
+ * @author Justin McKay
+ * @brief Lazily compiled cache of shader permutations, keyed by base shader and feature bitmask.
+ * @date 2026-03-06
+ */
+
+#pragma once
+
+#include "rendering/Shader.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShaderVariantCache {
+public:
+
+    /**
+     * @brief Registers the source file of a base shader so its permutations can be compiled on demand.
+     * @param shaderId Identifier of the base shader (its resource handle).
+     * @param shaderPath The file path of the .shader file.
+     */
+    void registerShader(uint32_t shaderId, const std::string& shaderPath);
+
+    /**
+     * @brief Forgets a base shader and destroys every permutation compiled from it.
+     * @param shaderId Identifier of the base shader.
+     */
+    void unregisterShader(uint32_t shaderId);
+
+    /**
+     * @brief Gets a permutation of a shader, submitting it for asynchronous compilation on first use.
+     * The returned shader may still be pending; callers should check Shader::isReady() and fall back if needed.
+     * @param shaderId Identifier of the registered base shader.
+     * @param features The feature bitmask of the permutation.
+     * @return Shader* The permutation, or nullptr if the base shader was never registered.
+     */
+    Shader* getVariant(uint32_t shaderId, ShaderFeatureMask features);
+
+    /**
+     * @brief Submits permutations for compilation ahead of time, so they are ready before first use.
+     * @param shaderId Identifier of the registered base shader.
+     * @param permutations The feature bitmasks to compile.
+     */
+    void prewarm(uint32_t shaderId, const std::vector<ShaderFeatureMask>& permutations);
+
+    /**
+     * @brief Replaces a permutation with a newly compiled shader, e.g. after its source has been reloaded.
+     * @param shaderId Identifier of the registered base shader.
+     * @param features The feature bitmask of the permutation.
+     * @param shader The shader to take ownership of. The previous permutation is destroyed.
+     */
+    void replaceVariant(uint32_t shaderId, ShaderFeatureMask features, std::unique_ptr<Shader> shader);
+
+    /**
+     * @brief Gets the feature bitmasks of every permutation created for a base shader.
+     * @param shaderId Identifier of the base shader.
+     * @return std::vector<ShaderFeatureMask> The feature bitmasks.
+     */
+    std::vector<ShaderFeatureMask> getVariantFeatures(uint32_t shaderId) const;
+
+    /**
+     * @brief Gets the source file of every registered base shader.
+     * @return The source paths, keyed by shader identifier.
+     */
+    const std::unordered_map<uint32_t, std::string>& getShaderPaths() const { return _shaderPaths; }
+
+    /**
+     * @brief Gets the source file a base shader was registered with.
+     * @param shaderId Identifier of the base shader.
+     * @return The file path, or an empty string if the shader is not registered.
+     */
+    const std::string& getShaderPath(uint32_t shaderId) const;
+
+    /**
+     * @brief Gets the number of permutations created so far.
+     * @return size_t The variant count.
+     */
+    size_t getVariantCount() const { return _variants.size(); }
+
+private:
+    // Source file of each registered base shader
+    std::unordered_map<uint32_t, std::string> _shaderPaths;
+
+    // Compiled permutations, keyed by makeKey(shaderId, features)
+    std::unordered_map<uint64_t, std::unique_ptr<Shader>> _variants;
+
+    /**
+     * @brief Packs a shader identifier and feature bitmask into a single cache key.
+     */
+    static constexpr uint64_t makeKey(uint32_t shaderId, ShaderFeatureMask features) {
+        return (static_cast<uint64_t>(shaderId) << 32) | features;
+    }
+};
@@ -1,7 +1,11 @@
 #include "Texture.h"
 
 #include "rendering/opengl/OpenGLTexture.h"
+#include "rendering/opengl/OpenGLTextureStreamer.h"
+#include "rendering/opengl/OpenGLTextureUploader.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -10,5 +14,31 @@ std::unique_ptr<Texture2D> Texture2D::create(const TextureProps& textureProps) {
 }
 
 std::unique_ptr<Texture2D> Texture2D::create(const std::string path) {
-    return std::make_unique<OpenGLTexture2D>(path);
+    return std::make_unique<OpenGLTexture2D>(path, TextureProps());
+}
+
+std::unique_ptr<Texture2D> Texture2D::create(const std::string path, const AssetBlob& content) {
+    return std::make_unique<OpenGLTexture2D>(path, TextureProps(), content);
+}
+
+std::unique_ptr<Texture2D> Texture2D::create(const std::string path, const TextureProps& textureProps) {
+    return std::make_unique<OpenGLTexture2D>(path, textureProps);
+}
+
+void Texture2D::setUploadBudget(size_t bytesPerFrame) {
+    OpenGLTextureUploader::get()->setUploadBudget(bytesPerFrame);
+}
+
+void Texture2D::setStreamingBudget(size_t bytes) {
+    OpenGLTextureStreamer::get()->setBudget(bytes);
+}
+
+uint32_t Texture2D::calcRequiredMip(float uvPerPixel) const {
+    const float texelsPerPixel = uvPerPixel * static_cast<float>(std::max(getWidth(), getHeight()));
+    if (texelsPerPixel <= 1.0f || getMipCount() <= 1) {
+        return 0;
+    }
+
+    // Each level halves the texel density, so the level is the log of the texels landing on a pixel
+    return std::min(static_cast<uint32_t>(std::log2(texelsPerPixel)), getMipCount() - 1);
 }
\ No newline at end of file
@@ -1,27 +1,27 @@
 #pragma once
 
+#include "rendering/Image.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
-/**
- * @enum ImageFormat
- * @brief Enumeration of supported image color formats for textures.
- */
-enum class ImageFormat {
-    None = 0,  ///< No format specified
-    RGB8,      ///< 8-bit RGB color format
-    RGBA8      ///< 8-bit RGBA color format with alpha channel
-};
+struct AssetBlob;
 
 /**
  * @struct TextureProps
  * @brief Properties and configuration for texture creation.
  */
 struct TextureProps {
-    unsigned int width;              ///< Texture width in pixels
-    unsigned int height;             ///< Texture height in pixels
-    ImageFormat imageFormat;         ///< Color format of the texture
-    bool generateMips = true;        ///< Whether to generate mipmaps for the texture
+    unsigned int width = 0;                       ///< Texture width in pixels
+    unsigned int height = 0;                      ///< Texture height in pixels
+    ImageFormat imageFormat = ImageFormat::None;  ///< Color format of the texture
+    bool generateMips = true;                     ///< Whether to generate mipmaps for the texture
+    bool srgb = false;                            ///< Whether the color channels are sRGB encoded (e.g. albedo maps)
+    MipFilter mipFilter = MipFilter::Kaiser;      ///< Filter used to generate the mip chain on the CPU
+    ImageFormat compression = ImageFormat::None;  ///< Block-compressed format to encode file loads to, or None
+    bool streaming = true;                        ///< Whether file loads start with only the low mips and stream finer ones on demand
 };
 
 /**
@@ -80,6 +80,18 @@ public:
      * @return True if the texture is loaded and ready for use, false otherwise
      */
     virtual bool isLoaded() const = 0;
+
+    /**
+     * @brief Checks if the texture file could not be loaded, in which case the placeholder is bound for good.
+     * @return True if loading failed, false while loading or once loaded
+     */
+    virtual bool hasLoadFailed() const = 0;
+
+    /**
+     * @brief Gets the video memory allocated for the texture's storage.
+     * @return Size of the storage in bytes, or 0 before it is allocated
+     */
+    virtual size_t getGpuMemoryUsage() const = 0;
 };
 
 /**
@@ -105,8 +117,74 @@ public:
     /**
      * @brief Creates a 2D texture from a file.
      * 
+     * Returns immediately. The image is decoded on a worker thread and streamed to the GPU over the following
+     * frames; until then the texture binds a placeholder and isLoaded() returns false.
+     * 
      * @param path File path to the texture image
      * @return Unique pointer to the created Texture2D instance loaded from file
      */
     static std::unique_ptr<Texture2D> create(const std::string path);
+
+    /**
+     * @brief Creates a 2D texture from the contents of an image file that has already been read, as create() does.
+     * The contents are decoded on a worker thread without reading the file again.
+     * 
+     * @param path File path the contents were read from
+     * @param content Contents of the image file
+     * @return Unique pointer to the created Texture2D instance
+     */
+    static std::unique_ptr<Texture2D> create(const std::string path, const AssetBlob& content);
+
+    /**
+     * @brief Creates a 2D texture from a file, with options for how it is loaded.
+     * 
+     * The dimensions and format are taken from the file; generateMips, srgb and mipFilter are honoured.
+     * The full mip chain is generated on the loader thread, so no mip generation runs on the GPU.
+     * 
+     * @param path File path to the texture image
+     * @param textureProps Load options for the texture
+     * @return Unique pointer to the created Texture2D instance loaded from file
+     */
+    static std::unique_ptr<Texture2D> create(const std::string path, const TextureProps& textureProps);
+
+    /**
+     * @brief Sets the maximum number of bytes of streamed texture data uploaded per frame.
+     * 
+     * @param bytesPerFrame The per-frame upload budget in bytes
+     */
+    static void setUploadBudget(size_t bytesPerFrame);
+
+    /**
+     * @brief Sets the video memory budget shared by all streamed textures.
+     * 
+     * When streaming in finer mips would exceed the budget, the finest mips of the least recently used textures
+     * are evicted first.
+     * 
+     * @param bytes The budget in bytes
+     */
+    static void setStreamingBudget(size_t bytes);
+
+    /**
+     * @brief Gets the number of mip levels in the full mip chain, resident or not.
+     * @return Mip level count
+     */
+    virtual uint32_t getMipCount() const = 0;
+
+    /**
+     * @brief Records that the texture is drawn this frame and needs mips down to the given level.
+     * 
+     * Streamed textures have the level brought in over the following frames, within the streaming budget.
+     * Has no effect on textures that are not streamed.
+     * 
+     * @param level The finest mip level needed
+     */
+    virtual void requestMip(uint32_t level) = 0;
+
+    /**
+     * @brief Calculates the finest mip level worth sampling at a given screen-space texture density.
+     * 
+     * @param uvPerPixel Texture coordinate units covered by one screen pixel
+     * @return The mip level at which one texel covers about one pixel
+     */
+    uint32_t calcRequiredMip(float uvPerPixel) const;
 };
\ No newline at end of file
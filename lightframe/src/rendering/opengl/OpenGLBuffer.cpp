@@ -1,36 +1,151 @@
 #include "OpenGLBuffer.h"
 
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLUploadContext.h"
+
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <cstdint>
 
+/***
+ * BUFFER HELPERS
+ ***/
+
+static GLenum bufferUsageToGlUsage(BufferUsage usage) {
+    switch (usage) {
+        case BufferUsage::Static:   return GL_STATIC_DRAW;
+        case BufferUsage::Dynamic:  return GL_DYNAMIC_DRAW;
+        case BufferUsage::Stream:   return GL_STREAM_DRAW;
+    }
+
+    return GL_STATIC_DRAW;
+}
+
+/**
+ * @brief Calculates the new capacity of a buffer that must hold at least the required number of bytes.
+ * @param policy The growth policy of the buffer.
+ * @param capacity The current capacity in bytes.
+ * @param required The number of bytes that must fit.
+ * @return The new capacity in bytes.
+ */
+static uint32_t calcGrownCapacity(BufferGrowthPolicy policy, uint32_t capacity, uint32_t required) {
+    if (policy == BufferGrowthPolicy::Exact) {
+        return required;
+    }
+    return std::max(required, capacity + capacity / 2);
+}
+
+/**
+ * @brief Reallocates the storage of a buffer while keeping its name, so vertex array bindings remain valid.
+ * @param bufferId The buffer to reallocate.
+ * @param newCapacity The new capacity in bytes.
+ * @param usage The OpenGL usage hint for the new storage.
+ * @param preserveBytes Number of bytes from the start of the old storage to carry over into the new storage.
+ */
+static void reallocateBuffer(GLuint bufferId, uint32_t newCapacity, GLenum usage, uint32_t preserveBytes) {
+    if (preserveBytes == 0) {
+        glNamedBufferData(bufferId, newCapacity, nullptr, usage);
+        return;
+    }
+
+    // Copy the live contents aside on the GPU, re-specify the storage, then copy them back
+    GLuint scratchId = 0;
+    glCreateBuffers(1, &scratchId);
+    glNamedBufferData(scratchId, preserveBytes, nullptr, GL_STREAM_COPY);
+    glCopyNamedBufferSubData(bufferId, scratchId, 0, 0, preserveBytes);
+
+    glNamedBufferData(bufferId, newCapacity, nullptr, usage);
+    glCopyNamedBufferSubData(scratchId, bufferId, 0, 0, preserveBytes);
+    glDeleteBuffers(1, &scratchId);
+}
+
+/**
+ * @brief Replaces the contents of a buffer, orphaning the previous storage for dynamic and stream buffers.
+ * @param bufferId The buffer to write to.
+ * @param capacity The capacity of the buffer in bytes (already large enough for the data).
+ * @param usage The usage hint of the buffer.
+ * @param data The data to upload.
+ * @param size The size of the data in bytes.
+ */
+static void replaceBufferData(GLuint bufferId, uint32_t capacity, BufferUsage usage, const void* data, uint32_t size) {
+    if (usage != BufferUsage::Static) {
+        // Orphan the old storage so the driver can hand back fresh memory instead of waiting on in-flight draws
+        glNamedBufferData(bufferId, capacity, nullptr, bufferUsageToGlUsage(usage));
+    }
+    if (size > 0) {
+        glNamedBufferSubData(bufferId, 0, size, data);
+    }
+}
+
 /***
  * VERTEX BUFFERS
  ***/
 
-OpenGLVertexBuffer::OpenGLVertexBuffer() : _vertexElementCount(0) {
-    glGenBuffers(1, &_rendererId);
-    glBindBuffer(GL_ARRAY_BUFFER, _rendererId);
+OpenGLVertexBuffer::OpenGLVertexBuffer() {
+    OpenGLUploadContext::get()->submit([this]() {
+        glCreateBuffers(1, &_rendererId);
+    }, _uploadFence);
 }
 
-OpenGLVertexBuffer::OpenGLVertexBuffer(const float* vertices, uint32_t size) {
-    glGenBuffers(1, &_rendererId);
-    glBindBuffer(GL_ARRAY_BUFFER, _rendererId);
-    // Upload vertex data to GPU
-    glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy)
+    : _capacity(capacity), _usage(usage), _growthPolicy(growthPolicy) {
+    OpenGLUploadContext::get()->submit([this]() {
+        glCreateBuffers(1, &_rendererId);
+        glNamedBufferData(_rendererId, _capacity, nullptr, bufferUsageToGlUsage(_usage));
+    }, _uploadFence);
+}
 
-    _vertexElementCount = size / sizeof(float);
-    
+OpenGLVertexBuffer::OpenGLVertexBuffer(const void* vertices, uint32_t size, BufferUsage usage)
+    : _size(size), _capacity(size), _usage(usage) {
+    OpenGLUploadContext::get()->submit([&]() {
+        glCreateBuffers(1, &_rendererId);
+        // Upload vertex data to GPU
+        glNamedBufferData(_rendererId, size, vertices, bufferUsageToGlUsage(_usage));
+    }, _uploadFence);
 }
 
 OpenGLVertexBuffer::~OpenGLVertexBuffer() {
-    if (_rendererId > 0) {
-        glDeleteBuffers(1, &_rendererId);
+    // Frames still in flight may draw from the buffer, so it is deleted once they have finished
+    OpenGLUploadContext::get()->release([this]() {
+        OpenGLDeletionQueue::get()->retire(GLObjectType::Buffer, _rendererId);
         _rendererId = 0;
-    }
+    }, _uploadFence);
+}
+
+void OpenGLVertexBuffer::setData(const void* vertices, uint32_t size) {
+    OpenGLUploadContext::get()->submit([&]() {
+        if (size > _capacity) {
+            _capacity = calcGrownCapacity(_growthPolicy, _capacity, size);
+            reallocateBuffer(_rendererId, _capacity, bufferUsageToGlUsage(_usage), 0);
+            glNamedBufferSubData(_rendererId, 0, size, vertices);
+        } else {
+            replaceBufferData(_rendererId, _capacity, _usage, vertices, size);
+        }
+    }, _uploadFence);
+    _size = size;
+}
+
+void OpenGLVertexBuffer::updateRange(uint32_t offset, const void* vertices, uint32_t size) {
+    const uint32_t end = offset + size;
+    OpenGLUploadContext::get()->submit([&]() {
+        if (end > _capacity) {
+            _capacity = calcGrownCapacity(_growthPolicy, _capacity, end);
+            reallocateBuffer(_rendererId, _capacity, bufferUsageToGlUsage(_usage), _size);
+        }
+        if (size > 0) {
+            glNamedBufferSubData(_rendererId, offset, size, vertices);
+        }
+    }, _uploadFence);
+    _size = std::max(_size, end);
+}
+
+bool OpenGLVertexBuffer::isUploadComplete() const {
+    return OpenGLUploadContext::isUploadComplete(_uploadFence);
 }
 
 void OpenGLVertexBuffer::bind() const {
+    OpenGLUploadContext::waitForUpload(_uploadFence);
     glBindBuffer(GL_ARRAY_BUFFER, _rendererId);
 }
 
@@ -42,25 +157,69 @@ void OpenGLVertexBuffer::unbind() const {
  * INDEX BUFFERS
  ***/
 
-OpenGLIndexBuffer::OpenGLIndexBuffer(unsigned int* indices, uint32_t size)
-    : _size(size) {
-    glGenBuffers(1, &_rendererId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _rendererId);
-    // Upload vertex data to GPU
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+OpenGLIndexBuffer::OpenGLIndexBuffer(const unsigned int* indices, uint32_t count, BufferUsage usage)
+    : _count(count), _capacity(count), _usage(usage) {
+    OpenGLUploadContext::get()->submit([&]() {
+        // DSA creation avoids touching GL_ELEMENT_ARRAY_BUFFER, which would rebind the index buffer of whichever VAO is bound
+        glCreateBuffers(1, &_rendererId);
+        // Upload index data to GPU
+        glNamedBufferData(_rendererId, count * sizeof(unsigned int), indices, bufferUsageToGlUsage(_usage));
+    }, _uploadFence);
 }
- 
+
+OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy)
+    : _capacity(capacity), _usage(usage), _growthPolicy(growthPolicy) {
+    OpenGLUploadContext::get()->submit([this]() {
+        glCreateBuffers(1, &_rendererId);
+        glNamedBufferData(_rendererId, _capacity * sizeof(unsigned int), nullptr, bufferUsageToGlUsage(_usage));
+    }, _uploadFence);
+}
+
 OpenGLIndexBuffer::~OpenGLIndexBuffer() {
-    if (_rendererId > 0) {
-        glDeleteBuffers(1, &_rendererId);
+    // Frames still in flight may draw from the buffer, so it is deleted once they have finished
+    OpenGLUploadContext::get()->release([this]() {
+        OpenGLDeletionQueue::get()->retire(GLObjectType::Buffer, _rendererId);
         _rendererId = 0;
-    }
+    }, _uploadFence);
+}
+
+void OpenGLIndexBuffer::setData(const unsigned int* indices, uint32_t count) {
+    OpenGLUploadContext::get()->submit([&]() {
+        if (count > _capacity) {
+            _capacity = calcGrownCapacity(_growthPolicy, _capacity, count);
+            reallocateBuffer(_rendererId, _capacity * sizeof(unsigned int), bufferUsageToGlUsage(_usage), 0);
+            glNamedBufferSubData(_rendererId, 0, count * sizeof(unsigned int), indices);
+        } else {
+            replaceBufferData(_rendererId, _capacity * sizeof(unsigned int), _usage, indices, count * sizeof(unsigned int));
+        }
+    }, _uploadFence);
+    _count = count;
+}
+
+void OpenGLIndexBuffer::updateRange(uint32_t firstIndex, const unsigned int* indices, uint32_t count) {
+    const uint32_t end = firstIndex + count;
+    OpenGLUploadContext::get()->submit([&]() {
+        if (end > _capacity) {
+            _capacity = calcGrownCapacity(_growthPolicy, _capacity, end);
+            reallocateBuffer(_rendererId, _capacity * sizeof(unsigned int), bufferUsageToGlUsage(_usage),
+                _count * sizeof(unsigned int));
+        }
+        if (count > 0) {
+            glNamedBufferSubData(_rendererId, firstIndex * sizeof(unsigned int), count * sizeof(unsigned int), indices);
+        }
+    }, _uploadFence);
+    _count = std::max(_count, end);
+}
+
+bool OpenGLIndexBuffer::isUploadComplete() const {
+    return OpenGLUploadContext::isUploadComplete(_uploadFence);
 }
 
 void OpenGLIndexBuffer::bind() const {
+    OpenGLUploadContext::waitForUpload(_uploadFence);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _rendererId);
 }
 
 void OpenGLIndexBuffer::unbind() const {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
\ No newline at end of file
+}
@@ -21,30 +21,54 @@ public:
      */
     OpenGLVertexBuffer();
 
+    /**
+     * @brief Constructs an empty OpenGL vertex buffer with storage reserved up front.
+     * @param capacity Initial capacity of the buffer in bytes.
+     * @param usage Hint describing how often the buffer contents will change.
+     * @param growthPolicy How the buffer capacity grows when data no longer fits.
+     */
+    OpenGLVertexBuffer(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy);
+
     /**
      * @brief Constructs an OpenGL vertex buffer with initial data.
      * @param vertices Pointer to vertex data.
      * @param size Size of the vertex data in bytes.
+     * @param usage Hint describing how often the buffer contents will change.
      */
-    OpenGLVertexBuffer(const float* vertices, uint32_t size);
-    
+    OpenGLVertexBuffer(const void* vertices, uint32_t size, BufferUsage usage = BufferUsage::Static);
+
     /**
      * @brief Deconstructs the OpenGL vertex buffer, releasing any allocated resources.
      */
     ~OpenGLVertexBuffer();
-    
+
     /**
      * @brief Gets the layout of this vertex buffer.
      * @return const BufferLayout& The buffer layout.
      */
     const BufferLayout& getLayout() const override { return _layout; };
-    
+
     /**
      * @brief Sets the layout of this vertex buffer.
      * @param layout The buffer layout to set.
      */
     void setLayout(const BufferLayout& layout) override { _layout = layout; };
 
+    /**
+     * @brief Replaces the entire contents of this vertex buffer, growing the capacity if required.
+     * @param vertices Pointer to the vertex data.
+     * @param size Size of the vertex data in bytes.
+     */
+    void setData(const void* vertices, uint32_t size) override;
+
+    /**
+     * @brief Updates a sub-range of this vertex buffer in place.
+     * @param offset Byte offset into the buffer at which to start writing.
+     * @param vertices Pointer to the vertex data.
+     * @param size Size of the vertex data in bytes.
+     */
+    void updateRange(uint32_t offset, const void* vertices, uint32_t size) override;
+
     /**
      * @brief Binds this vertex buffer to the OpenGL context.
      */
@@ -65,13 +89,49 @@ public:
      * @brief Gets the number of vertices in this vertex buffer.
      * @return unsigned int The vertex count.
      */
-    unsigned int getVertexCount() const override { return _vertexElementCount / _layout.getVertexLength(); }
-    
+    unsigned int getVertexCount() const override {
+        return _layout.getStride() > 0 ? _size / _layout.getStride() : 0;
+    }
+
+    /**
+     * @brief Gets the number of bytes of vertex data currently held by this buffer.
+     * @return uint32_t The used size in bytes.
+     */
+    uint32_t getSize() const override { return _size; }
+
+    /**
+     * @brief Gets the number of bytes of GPU storage allocated for this buffer.
+     * @return uint32_t The capacity in bytes.
+     */
+    uint32_t getCapacity() const override { return _capacity; }
+
+    /**
+     * @brief Gets the usage hint this buffer was created with.
+     * @return BufferUsage The usage hint.
+     */
+    BufferUsage getUsage() const override { return _usage; }
+
+    /**
+     * @brief Checks whether data written from another thread has reached the GPU. Must be called on the render thread.
+     * @return bool True if there is no upload outstanding.
+     */
+    bool isUploadComplete() const override;
+
 private:
     // OpenGL-generated buffer identifier.
-    GLuint _rendererId;
+    GLuint _rendererId = 0;
+
+    // Signals once commands submitted through the upload context have completed, null if none are outstanding
+    mutable GLsync _uploadFence = nullptr;
     BufferLayout _layout;
-    uint32_t _vertexElementCount;
+
+    // Number of bytes of vertex data currently in the buffer.
+    uint32_t _size = 0;
+    // Number of bytes of GPU storage allocated for the buffer.
+    uint32_t _capacity = 0;
+
+    BufferUsage _usage = BufferUsage::Static;
+    BufferGrowthPolicy _growthPolicy = BufferGrowthPolicy::Geometric;
 };
 
 class OpenGLIndexBuffer final : public IndexBuffer {
@@ -80,15 +140,39 @@ public:
     /**
      * @brief Constructs an OpenGL index buffer with index data.
      * @param indices Pointer to index data.
-     * @param size Number of indices contained in the buffer.
+     * @param count Number of indices contained in the buffer.
+     * @param usage Hint describing how often the buffer contents will change.
      */
-    OpenGLIndexBuffer(unsigned int* indices, uint32_t size);
-    
+    OpenGLIndexBuffer(const unsigned int* indices, uint32_t count, BufferUsage usage = BufferUsage::Static);
+
+    /**
+     * @brief Constructs an empty OpenGL index buffer with storage reserved up front.
+     * @param capacity Initial capacity of the buffer in indices.
+     * @param usage Hint describing how often the buffer contents will change.
+     * @param growthPolicy How the buffer capacity grows when data no longer fits.
+     */
+    OpenGLIndexBuffer(uint32_t capacity, BufferUsage usage, BufferGrowthPolicy growthPolicy);
+
     /**
      * @brief Deconstructs the OpenGL index buffer, releasing any allocated resources.
      */
     ~OpenGLIndexBuffer();
 
+    /**
+     * @brief Replaces the entire contents of this index buffer, growing the capacity if required.
+     * @param indices Pointer to the index data.
+     * @param count Number of indices.
+     */
+    void setData(const unsigned int* indices, uint32_t count) override;
+
+    /**
+     * @brief Updates a sub-range of this index buffer in place.
+     * @param firstIndex Index at which to start writing.
+     * @param indices Pointer to the index data.
+     * @param count Number of indices to write.
+     */
+    void updateRange(uint32_t firstIndex, const unsigned int* indices, uint32_t count) override;
+
     /**
      * @brief Binds this index buffer to the OpenGL context.
      */
@@ -104,15 +188,43 @@ public:
      * @return unsigned int Renderer ID issued by OpenGL.
      */
     unsigned int getRendererId() const override { return _rendererId; };
-    
+
     /**
      * @brief Gets the number of indices in this index buffer.
      * @return unsigned int The index count.
      */
-    unsigned int getIndexCount() const override { return _size; }
-    
+    unsigned int getIndexCount() const override { return _count; }
+
+    /**
+     * @brief Gets the number of indices the GPU storage of this buffer can hold.
+     * @return uint32_t The capacity in indices.
+     */
+    uint32_t getCapacity() const override { return _capacity; }
+
+    /**
+     * @brief Gets the usage hint this buffer was created with.
+     * @return BufferUsage The usage hint.
+     */
+    BufferUsage getUsage() const override { return _usage; }
+
+    /**
+     * @brief Checks whether data written from another thread has reached the GPU. Must be called on the render thread.
+     * @return bool True if there is no upload outstanding.
+     */
+    bool isUploadComplete() const override;
+
 private:
     // OpenGL-generated buffer identifier.
-    GLuint _rendererId;
-    uint32_t _size;
-};
\ No newline at end of file
+    GLuint _rendererId = 0;
+
+    // Signals once commands submitted through the upload context have completed, null if none are outstanding
+    mutable GLsync _uploadFence = nullptr;
+
+    // Number of indices currently in the buffer.
+    uint32_t _count = 0;
+    // Number of indices the GPU storage can hold.
+    uint32_t _capacity = 0;
+
+    BufferUsage _usage = BufferUsage::Static;
+    BufferGrowthPolicy _growthPolicy = BufferGrowthPolicy::Geometric;
+};
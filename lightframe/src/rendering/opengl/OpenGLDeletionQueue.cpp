@@ -0,0 +1,141 @@
+#include "OpenGLDeletionQueue.h"
+
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <memory>
+
+static std::unique_ptr<OpenGLDeletionQueue> s_Instance = nullptr;
+
+OpenGLDeletionQueue* OpenGLDeletionQueue::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<OpenGLDeletionQueue>();
+    }
+    return s_Instance.get();
+}
+
+OpenGLDeletionQueue::~OpenGLDeletionQueue() = default;
+
+void OpenGLDeletionQueue::retire(GLObjectType type, GLuint name) {
+    if (name == 0) {
+        return;
+    }
+
+    std::lock_guard lock(_retiredMutex);
+    _retired[static_cast<size_t>(type)].push_back(name);
+}
+
+void OpenGLDeletionQueue::update() {
+    while (!_frames.empty()) {
+        FrameBatch& frame = _frames.front();
+
+        const GLenum result = glClientWaitSync(frame.fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+        if (result == GL_WAIT_FAILED) {
+            LOG_WARN("Deletion fence wait failed; deleting its objects.");
+        }
+
+        glDeleteSync(frame.fence);
+        for (size_t type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+            _completed[type].insert(_completed[type].end(), frame.names[type].begin(), frame.names[type].end());
+        }
+        _frames.pop_front();
+    }
+
+    _stats.deletedLastFrame = deleteCompleted(_deletionBudget);
+    _stats.totalDeleted += _stats.deletedLastFrame;
+}
+
+void OpenGLDeletionQueue::endFrame() {
+    FrameBatch frame {};
+    {
+        std::lock_guard lock(_retiredMutex);
+        const bool empty = std::all_of(_retired.begin(), _retired.end(), [](const std::vector<GLuint>& names) {
+            return names.empty();
+        });
+        if (empty) {
+            return;
+        }
+        frame.names.swap(_retired);
+    }
+
+    // Fenced after this frame's draws, which come after those of every earlier frame that could use the names
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _frames.push_back(std::move(frame));
+}
+
+void OpenGLDeletionQueue::flush() {
+    {
+        std::lock_guard lock(_retiredMutex);
+        for (size_t type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+            _completed[type].insert(_completed[type].end(), _retired[type].begin(), _retired[type].end());
+            _retired[type].clear();
+        }
+    }
+    for (FrameBatch& frame : _frames) {
+        glDeleteSync(frame.fence);
+        for (size_t type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+            _completed[type].insert(_completed[type].end(), frame.names[type].begin(), frame.names[type].end());
+        }
+    }
+    _frames.clear();
+
+    _stats.totalDeleted += deleteCompleted(SIZE_MAX);
+}
+
+DeletionStats OpenGLDeletionQueue::getStats() {
+    size_t pending = 0;
+    {
+        std::lock_guard lock(_retiredMutex);
+        for (const std::vector<GLuint>& names : _retired) {
+            pending += names.size();
+        }
+    }
+    for (const FrameBatch& frame : _frames) {
+        for (const std::vector<GLuint>& names : frame.names) {
+            pending += names.size();
+        }
+    }
+    for (const std::vector<GLuint>& names : _completed) {
+        pending += names.size();
+    }
+
+    _stats.pendingObjects = pending;
+    return _stats;
+}
+
+size_t OpenGLDeletionQueue::deleteCompleted(size_t budget) {
+    size_t deleted = 0;
+    for (size_t type = 0; type < OBJECT_TYPE_COUNT && deleted < budget; ++type) {
+        std::vector<GLuint>& names = _completed[type];
+        if (names.empty()) {
+            continue;
+        }
+
+        // The most recently retired are deleted first, so the vector only ever shrinks from the back
+        const size_t count = std::min(names.size(), budget - deleted);
+        const GLuint* first = names.data() + names.size() - count;
+        const GLsizei batchSize = static_cast<GLsizei>(count);
+        switch (static_cast<GLObjectType>(type)) {
+            case GLObjectType::Buffer:      glDeleteBuffers(batchSize, first); break;
+            case GLObjectType::Texture:     glDeleteTextures(batchSize, first); break;
+            case GLObjectType::VertexArray: glDeleteVertexArrays(batchSize, first); break;
+            case GLObjectType::Program:
+                // Programs and shaders have no batched delete
+                for (size_t i = 0; i < count; ++i) {
+                    glDeleteProgram(first[i]);
+                }
+                break;
+            case GLObjectType::Shader:
+                for (size_t i = 0; i < count; ++i) {
+                    glDeleteShader(first[i]);
+                }
+                break;
+        }
+        names.resize(names.size() - count);
+        deleted += count;
+    }
+    return deleted;
+}
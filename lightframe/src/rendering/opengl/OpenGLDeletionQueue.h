@@ -0,0 +1,138 @@
+/**
+ * @file OpenGLDeletionQueue.h
+ * @author Justin McKay
+ * @brief Defers deleting GL objects until the frames that may still reference them have finished on the GPU.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief The kinds of GL object the deletion queue can retire, one per glDelete* call.
+ */
+enum class GLObjectType : uint8_t {
+    Buffer,
+    Texture,
+    VertexArray,
+    Program,
+    Shader
+};
+
+/**
+ * @brief Counters describing deferred deletion.
+ */
+struct DeletionStats {
+    /** Objects retired but not yet deleted */
+    size_t pendingObjects = 0;
+    /** Objects deleted during the last update */
+    size_t deletedLastFrame = 0;
+    /** Objects deleted since startup */
+    size_t totalDeleted = 0;
+};
+
+/**
+ * @brief Holds retired GL names until the fence of the last frame that could reference them signals.
+ *
+ * Deleting an object the GPU is still reading from makes the driver either stall until it is done or track the
+ * object's lifetime itself, both of which cost time on the render thread. Destructors retire their names here
+ * instead. Names retired during a frame are fenced together at the end of it, and once the fence signals they are
+ * deleted with one glDelete* call per object type, at most the deletion budget each frame, so unloading a level
+ * spreads its deletes over a few frames rather than stalling one.
+ *
+ * retire() may be called from any thread; update() and endFrame() must be called on the render thread.
+ */
+class OpenGLDeletionQueue {
+public:
+
+    /**
+     * @brief Gets the deletion queue shared by the engine.
+     */
+    static OpenGLDeletionQueue* get();
+
+    ~OpenGLDeletionQueue();
+
+    /**
+     * @brief Queues a GL object for deletion once the GPU has finished every frame submitted so far.
+     * @param type The kind of object.
+     * @param name The object's name. Zero is ignored.
+     */
+    void retire(GLObjectType type, GLuint name);
+
+    /**
+     * @brief Deletes the objects whose frames have completed on the GPU, within the deletion budget. Must be called
+     * once per frame on the render thread.
+     */
+    void update();
+
+    /**
+     * @brief Fences the objects retired since the last call, which may be referenced by this frame's commands. Must
+     * be called on the render thread after the frame's last draw.
+     */
+    void endFrame();
+
+    /**
+     * @brief Deletes every retired object at once, whether or not the GPU has finished with it. Used at shutdown,
+     * while the context still exists.
+     */
+    void flush();
+
+    /**
+     * @brief Sets the maximum number of objects deleted each frame.
+     * @param objectsPerFrame The per-frame deletion budget.
+     */
+    void setDeletionBudget(size_t objectsPerFrame) { _deletionBudget = objectsPerFrame; }
+
+    /**
+     * @brief Gets counters describing deferred deletion.
+     */
+    DeletionStats getStats();
+
+private:
+
+    static constexpr size_t OBJECT_TYPE_COUNT = 5;
+
+    /**
+     * @brief Names retired in the same frame, grouped by type for batched deletion.
+     */
+    using RetiredNames = std::array<std::vector<GLuint>, OBJECT_TYPE_COUNT>;
+
+    /**
+     * @brief Names that can be deleted once the fence of the frame they were retired in signals.
+     */
+    struct FrameBatch {
+        GLsync fence;
+        RetiredNames names;
+    };
+
+    /**
+     * @brief Deletes up to a number of the names that are safe to delete.
+     * @return size_t The number of names deleted.
+     */
+    size_t deleteCompleted(size_t budget);
+
+    // Names retired since the last endFrame(), filled from any thread
+    RetiredNames _retired;
+
+    // Guards _retired
+    std::mutex _retiredMutex;
+
+    // Fenced batches, oldest first
+    std::deque<FrameBatch> _frames;
+
+    // Names whose frames have completed but that haven't been deleted within the budget yet
+    RetiredNames _completed;
+
+    // Maximum number of names deleted each frame
+    size_t _deletionBudget = 4096;
+
+    DeletionStats _stats;
+};
@@ -0,0 +1,40 @@
+#include "OpenGLExtensions.h"
+
+#include "core/Logger.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+void OpenGLExtensions::load(GLADloadproc loader) {
+
+    // Parallel shader compile. KHR and ARB variants share the same tokens and semantics.
+    const bool hasKhr = isSupported("GL_KHR_parallel_shader_compile");
+    if (hasKhr || isSupported("GL_ARB_parallel_shader_compile")) {
+        auto maxShaderCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(
+            loader(hasKhr ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB"));
+
+        if (maxShaderCompilerThreads) {
+            // Let the driver pick as many compiler threads as it sees fit
+            maxShaderCompilerThreads(0xFFFFFFFF);
+            s_parallelShaderCompile = true;
+        }
+    }
+
+    LOG_DEBUG("OpenGL parallel shader compile: {}", s_parallelShaderCompile ? "enabled" : "unavailable");
+
+    s_textureCompressionS3tc = isSupported("GL_EXT_texture_compression_s3tc");
+    LOG_DEBUG("OpenGL S3TC texture compression: {}", s_textureCompressionS3tc ? "available" : "unavailable");
+}
+
+bool OpenGLExtensions::isSupported(const char* name) {
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i) {
+        const auto* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file OpenGLExtensions.h
+ * @author Justin McKay
+ * @brief Detection and loading of optional OpenGL extensions that are not part of the GL 4.5 core loader.
+ * @date 2026-03-04
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+// EXT_texture_compression_s3tc / EXT_texture_sRGB (BC1 and BC3; BC4, BC5 and BC7 are core)
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+class OpenGLExtensions {
+public:
+
+    /**
+     * @brief Detects the optional extensions supported by the current context and loads their entry points.
+     * Must be called once, after the core GL functions have been loaded.
+     * @param loader The function used to resolve GL entry points (e.g. glfwGetProcAddress).
+     */
+    static void load(GLADloadproc loader);
+
+    /**
+     * @brief Returns true if the driver can compile and link shaders on its own threads,
+     * and report completion through GL_COMPLETION_STATUS_KHR without blocking.
+     */
+    static bool hasParallelShaderCompile() { return s_parallelShaderCompile; }
+
+    /**
+     * @brief Returns true if BC1 and BC3 (S3TC) textures can be uploaded.
+     */
+    static bool hasTextureCompressionS3tc() { return s_textureCompressionS3tc; }
+
+    /**
+     * @brief Checks whether the current context advertises the named extension.
+     * @param name The extension name (e.g. "GL_KHR_parallel_shader_compile").
+     * @return true if the extension is supported, false otherwise.
+     */
+    static bool isSupported(const char* name);
+
+private:
+    // Whether KHR/ARB_parallel_shader_compile is available.
+    static inline bool s_parallelShaderCompile = false;
+
+    // Whether EXT_texture_compression_s3tc is available.
+    static inline bool s_textureCompressionS3tc = false;
+};
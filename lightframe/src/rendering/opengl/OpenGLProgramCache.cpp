@@ -0,0 +1,193 @@
+#include "OpenGLProgramCache.h"
+
+#include "core/Hash.h"
+#include "core/Logger.h"
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+// "LFPB" - Lightframe program binary
+static constexpr uint32_t PROGRAM_BINARY_MAGIC = 0x4250464C;
+static constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+/**
+ * @brief Header written at the start of every cached program binary file.
+ */
+struct ProgramBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+    // Time it originally took to compile and link the program, used to report the time saved on a hit.
+    double compileSeconds;
+};
+
+static std::unique_ptr<OpenGLProgramCache> s_Instance = nullptr;
+
+OpenGLProgramCache* OpenGLProgramCache::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<OpenGLProgramCache>();
+    }
+    return s_Instance.get();
+}
+
+bool OpenGLProgramCache::isEnabled() {
+    if (!_enabled) {
+        return false;
+    }
+
+    if (_driverSupported < 0) {
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        _driverSupported = formatCount > 0 ? 1 : 0;
+        if (!_driverSupported) {
+            LOG_INFO("Driver does not support program binaries, shader cache disabled.");
+        }
+    }
+    return _driverSupported == 1;
+}
+
+uint64_t OpenGLProgramCache::computeKey(const std::unordered_map<ShaderType, std::string>& shaderSources) {
+    if (_driverIdentity.empty()) {
+        auto glString = [](GLenum name) {
+            const auto* str = reinterpret_cast<const char*>(glGetString(name));
+            return std::string(str ? str : "");
+        };
+        _driverIdentity = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+    }
+
+    uint64_t key = hash64(_driverIdentity);
+
+    // Combine stages in a fixed order, as unordered_map iteration order is unspecified
+    for (ShaderType type : { ShaderType::Vertex, ShaderType::Fragment }) {
+        auto it = shaderSources.find(type);
+        if (it != shaderSources.end()) {
+            key = hashCombine(key, static_cast<uint64_t>(type));
+            key = hashCombine(key, hash64(it->second));
+        }
+    }
+    return key;
+}
+
+GLuint OpenGLProgramCache::load(uint64_t key) {
+    if (!isEnabled()) {
+        return 0;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const std::filesystem::path path = pathForKey(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    ProgramBinaryHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION || header.key != key) {
+        LOG_DEBUG("Ignoring malformed program binary: {}", path.string());
+        return 0;
+    }
+
+    // The length is read from disk, so check it against the file before allocating for it
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec || header.binaryLength == 0 || header.binaryLength > fileSize - sizeof(header)) {
+        LOG_DEBUG("Ignoring truncated program binary: {}", path.string());
+        return 0;
+    }
+
+    std::vector<char> binary(header.binaryLength);
+    file.read(binary.data(), binary.size());
+    if (!file) {
+        LOG_DEBUG("Ignoring truncated program binary: {}", path.string());
+        return 0;
+    }
+
+    GLuint programId = glCreateProgram();
+    glProgramBinary(programId, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // The driver rejects binaries produced by a different build, even when the version strings match
+    GLint linkSuccess = GL_FALSE;
+    glGetProgramiv(programId, GL_LINK_STATUS, &linkSuccess);
+    if (!linkSuccess) {
+        glDeleteProgram(programId);
+        std::filesystem::remove(path, ec);
+        LOG_DEBUG("Driver rejected cached program binary {}, recompiling.", path.filename().string());
+        return 0;
+    }
+
+    const double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    _stats.hits++;
+    _stats.loadSeconds += loadSeconds;
+    _stats.savedSeconds += header.compileSeconds - loadSeconds;
+
+    return programId;
+}
+
+void OpenGLProgramCache::store(uint64_t key, GLuint programId, double compileSeconds) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    GLint binaryLength = 0;
+    glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(binaryLength);
+    GLenum binaryFormat = GL_NONE;
+    glGetProgramBinary(programId, binaryLength, nullptr, &binaryFormat, binary.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(_directory, ec);
+    if (ec) {
+        LOG_WARN("Unable to create shader cache directory {}: {}", _directory.string(), ec.message());
+        return;
+    }
+
+    // Write to a temporary file and rename, so a crash mid-write never leaves a truncated binary behind
+    const std::filesystem::path path = pathForKey(key);
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARN("Unable to write program binary: {}", tempPath.string());
+            return;
+        }
+
+        const ProgramBinaryHeader header = {
+            .magic = PROGRAM_BINARY_MAGIC,
+            .version = PROGRAM_BINARY_VERSION,
+            .key = key,
+            .binaryFormat = binaryFormat,
+            .binaryLength = static_cast<uint32_t>(binaryLength),
+            .compileSeconds = compileSeconds
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), binary.size());
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        LOG_WARN("Unable to write program binary {}: {}", path.string(), ec.message());
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+void OpenGLProgramCache::recordMiss(double compileSeconds, double pollLatencySeconds) {
+    _stats.misses++;
+    _stats.compileSeconds += compileSeconds;
+    _stats.pollLatencySeconds += pollLatencySeconds;
+}
+
+std::filesystem::path OpenGLProgramCache::pathForKey(uint64_t key) const {
+    return _directory / (hashToString(key) + ".bin");
+}
@@ -0,0 +1,105 @@
+/**
+ * @file OpenGLProgramCache.h
+ * @author Justin McKay
+ * @brief On-disk cache of linked OpenGL program binaries, keyed by shader source and driver identity.
+ * @date 2026-03-02
+ */
+
+#pragma once
+
+#include "rendering/Shader.h"
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+class OpenGLProgramCache {
+public:
+
+    /**
+     * @brief Computes the cache key for a set of shader stage sources.
+     * The key covers the preprocessed source of every stage as well as the GL vendor, renderer and version,
+     * so binaries are never offered to a different driver.
+     * @param shaderSources The preprocessed source of each shader stage.
+     * @return The 64-bit cache key.
+     */
+    uint64_t computeKey(const std::unordered_map<ShaderType, std::string>& shaderSources);
+
+    /**
+     * @brief Attempts to create a linked program from a cached binary.
+     * @param key The cache key of the program.
+     * @return The linked program ID, or 0 if there is no usable binary for the key.
+     */
+    GLuint load(uint64_t key);
+
+    /**
+     * @brief Stores the binary of a freshly linked program in the cache.
+     * The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+     * @param key The cache key of the program.
+     * @param programId The linked program to store.
+     * @param compileSeconds The time it took to compile and link the program, recorded so later hits can report the time saved.
+     */
+    void store(uint64_t key, GLuint programId, double compileSeconds);
+
+    /**
+     * @brief Records a cache miss along with the time spent compiling and linking.
+     * @param compileSeconds The time it took to compile and link the program.
+     * @param pollLatencySeconds The time between the last poll that found the program pending and the poll that found
+     * it finished, which the compile time excludes.
+     */
+    void recordMiss(double compileSeconds, double pollLatencySeconds);
+
+    /**
+     * @brief Returns true if program binaries are supported by the driver and caching has not been disabled.
+     */
+    bool isEnabled();
+
+    /**
+     * @brief Enables or disables the cache.
+     * @param enabled Whether program binaries should be read from and written to disk.
+     */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+
+    /**
+     * @brief Sets the directory program binaries are stored in. The directory is created on first store.
+     * @param directory The cache directory.
+     */
+    void setDirectory(const std::filesystem::path& directory) { _directory = directory; }
+
+    /**
+     * @brief Gets the hit/miss and timing statistics gathered since startup.
+     * @return The cache statistics.
+     */
+    const ShaderCacheStats& getStats() const { return _stats; }
+
+    /**
+     * @brief Singleton method to get the program cache instance.
+     * @return OpenGLProgramCache* A pointer to the program cache.
+     */
+    static OpenGLProgramCache* get();
+
+private:
+    // Directory the program binaries are stored in.
+    std::filesystem::path _directory = "cache/shaders";
+
+    // Whether caching has been enabled by the application.
+    bool _enabled = true;
+
+    // Lazily determined driver support for program binaries (-1 = unknown).
+    int _driverSupported = -1;
+
+    // Vendor, renderer and version of the current driver, mixed into every key.
+    std::string _driverIdentity;
+
+    ShaderCacheStats _stats;
+
+    /**
+     * @brief Builds the path of the cache file for a key.
+     * @param key The cache key.
+     * @return The full path of the cache file.
+     */
+    std::filesystem::path pathForKey(uint64_t key) const;
+};
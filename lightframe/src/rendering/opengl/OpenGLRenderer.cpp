@@ -1,4 +1,7 @@
 #include "OpenGLRenderer.h"
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLTextureStreamer.h"
+#include "OpenGLTextureUploader.h"
 
 #include "core/Logger.h"
 
@@ -8,11 +11,53 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
+
+/**
+ * @brief Source for the fallback shader, which draws geometry with its vertex colours while the material shader compiles.
+ */
+static const std::unordered_map<ShaderType, std::string> FALLBACK_SHADER_SOURCES = {
+    { ShaderType::Vertex, R"(#version 450 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+
+out vec3 vColor;
+
+uniform mat4 uTransform;
+
+void main() {
+    vColor = color;
+    gl_Position = uTransform * vec4(position, 1.0);
+}
+)" },
+    { ShaderType::Fragment, R"(#version 450 core
+in vec3 vColor;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(vColor, 1.0);
+}
+)" }
+};
+
 OpenGLRenderer::OpenGLRenderer(ResourceManager& resourceManager)
-        : _resourceManager(resourceManager) {}
+        : _resourceManager(resourceManager), _fallbackShader(Shader::create(FALLBACK_SHADER_SOURCES)) {}
 
 void OpenGLRenderer::beginFrame() {
     _renderQueue.clear();
+
+    // Swap in any reloaded resources before this frame's commands reference them
+    _resourceManager.update();
+
+    // Stream decoded textures within this frame's upload budget
+    OpenGLTextureUploader::get()->update();
+
+    // Stream in the mips last frame's draws asked for, evicting unused ones to stay within the budget
+    OpenGLTextureStreamer::get()->update();
+
+    // Delete the objects released during frames the GPU has since finished
+    OpenGLDeletionQueue::get()->update();
     
     // reset stats
     _renderStats = RenderStats();
@@ -26,7 +71,9 @@ void OpenGLRenderer::endFrame() {
     
     // Execute the render passes
     executeGeometryPass();
-    
+
+    // Objects released up to now may be used by this frame, so they wait for its fence
+    OpenGLDeletionQueue::get()->endFrame();
 }
 
 void OpenGLRenderer::applyRenderState(const RenderState &renderState) {
@@ -67,16 +114,32 @@ void OpenGLRenderer::executeGeometryPass() {
     
     // Iterate through the render commands and draw
     for (auto command : _renderQueue.getCommands()) {
+
+        // The material's reference keeps its texture loaded, unless the texture was unloaded explicitly
+        Texture2D* texture = command.material->getDiffuseTexture();
+        if (!texture) {
+            continue;
+        }
         
-        auto& shader = _resourceManager.get<Shader>(command.material->getShader(RenderPass::Geometry));
+        // Draw with the fallback shader until the material shader has finished compiling
+        Shader* shader = &_resourceManager.getShaderVariant(command.material->getShader(RenderPass::Geometry),
+            command.material->getShaderFeatures());
+        if (!shader->isReady()) {
+            shader = _fallbackShader.get();
+        }
         
-        shader.use();
-        shader.setMat4("uTransform", command.transform);
-        shader.setInt("uTexture1", 0);
+        shader->use();
+        shader->setMat4("uTransform", command.transform);
+        shader->setInt("uTexture1", 0);
         //shader->setInt("uTexture1", 1);
+
+        // Remaps mesh UVs into the material's region of an atlas
+        const glm::vec4& uvTransform = command.material->getDiffuseUvTransform();
+        shader->setFloat4("uUvTransform", uvTransform.x, uvTransform.y, uvTransform.z, uvTransform.w);
         
-        auto& texture = _resourceManager.get<Texture2D>(command.material->getDiffuseMap());
-        texture.bind();
+        // An atlas region spans only part of the texture, so its density is scaled by the region's size
+        texture->requestMip(texture->calcRequiredMip(command.uvPerPixel * std::max(uvTransform.x, uvTransform.y)));
+        texture->bind();
 
         // Bind the VAO
         command.mesh->getVertexArray()->bind();
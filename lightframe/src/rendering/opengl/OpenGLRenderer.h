@@ -3,6 +3,9 @@
 #include "resources/ResourceManager.h"
 #include "rendering/Renderer.h"
 #include "rendering/RenderQueue.h"
+#include "rendering/Shader.h"
+
+#include <memory>
 
 class OpenGLRenderer final : public Renderer {
 public:
@@ -42,6 +45,9 @@ private:
 
     // Stats for the current frame (number of draw calls, vertices rendered, etc.)
     RenderStats _renderStats;
+
+    // Shader used in place of any material shader that is still compiling
+    std::unique_ptr<Shader> _fallbackShader;
     
     /**
      * @brief Executes the geometry rendering pass.
@@ -1,4 +1,7 @@
 #include "OpenGLShader.h"
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLExtensions.h"
+#include "OpenGLProgramCache.h"
 
 #include <core/Logger.h>
 
@@ -8,44 +11,99 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <chrono>
 #include <string>
 #include <iostream>
 
-OpenGLShader::OpenGLShader(const std::string& shaderPath) {
+OpenGLShader::OpenGLShader(const std::unordered_map<ShaderType, std::string>& shaderSources, bool async) {
+    submitProgram(shaderSources, async);
+}
+
+OpenGLShader::OpenGLShader(std::future<std::unordered_map<ShaderType, std::string>> shaderSources)
+        : _pendingSources(std::move(shaderSources)) {}
+
+OpenGLShader::~OpenGLShader() {
+    releasePending();
+    if (_shaderId > 0) {
+        OpenGLDeletionQueue::get()->retire(GLObjectType::Program, _shaderId);
+        _shaderId = 0;
+    }
+}
+
+ShaderStatus OpenGLShader::getStatus() {
+    if (_status != ShaderStatus::Pending) {
+        return _status;
+    }
     
-    std::unordered_map shaderSources = loadShaderSources(shaderPath);
+    // The sources are still being read, so there is nothing for the driver to work on yet
+    if (_pendingSources.valid()) {
+        if (_pendingSources.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return ShaderStatus::Pending;
+        }
+        
+        submitProgram(_pendingSources.get(), true);
+        if (_status != ShaderStatus::Pending) {
+            return _status;
+        }
+    }
+    
+    // Without parallel compile support there is no non-blocking query, so the link status query
+    // below waits for the driver. Compiles were still all submitted up front.
+    if (OpenGLExtensions::hasParallelShaderCompile()) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(_pendingShaderId, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) {
+            _lastPendingTime = std::chrono::steady_clock::now();
+            return ShaderStatus::Pending;
+        }
+    }
+    
+    finaliseProgram();
+    return _status;
+}
+
+void OpenGLShader::submitProgram(const std::unordered_map<ShaderType, std::string>& shaderSources, bool async) {
     
     // At a minimum, we need a vertex and fragment shader
     if (!shaderSources.contains(ShaderType::Vertex) || !shaderSources.contains(ShaderType::Fragment)) {
         LOG_WARN("Shaders must contain at least a vertex and fragment shader section.");
+        _status = ShaderStatus::Failed;
         return;
     }
     
-    GLuint vertShaderId = compileShader(shaderSources[ShaderType::Vertex], GL_VERTEX_SHADER);
-    GLuint fragShaderId = compileShader(shaderSources[ShaderType::Fragment], GL_FRAGMENT_SHADER);
-    
-    if (vertShaderId == 0 || fragShaderId == 0) {
-        return;
+    // Try the program binary cache first, so we only pay for compilation the first time a shader is seen
+    OpenGLProgramCache* programCache = OpenGLProgramCache::get();
+    _cacheEnabled = programCache->isEnabled();
+    if (_cacheEnabled) {
+        _cacheKey = programCache->computeKey(shaderSources);
+        _shaderId = programCache->load(_cacheKey);
+        if (_shaderId > 0) {
+            _status = ShaderStatus::Ready;
+            return;
+        }
     }
     
-    GLuint shaderId = glCreateProgram();
-    glAttachShader(shaderId, vertShaderId);
-    glAttachShader(shaderId, fragShaderId);
+    _submitTime = std::chrono::steady_clock::now();
+    _lastPendingTime = _submitTime;
     
-    GLint shaderSuccess;
-    glLinkProgram(shaderId);
-    glGetProgramiv(shaderId, GL_LINK_STATUS, &shaderSuccess);
-    if (!shaderSuccess) {
-        char infoLog[512];
-        glGetProgramInfoLog(shaderId, 512, nullptr, infoLog);
-        LOG_WARN("Error linking shading program: {}", infoLog);
-        return;
+    // Submit both stages and the link without querying any status in between, so the driver is free
+    // to compile them on its own threads while we carry on
+    _vertShaderId = compileShader(shaderSources.at(ShaderType::Vertex), GL_VERTEX_SHADER);
+    _fragShaderId = compileShader(shaderSources.at(ShaderType::Fragment), GL_FRAGMENT_SHADER);
+    
+    _pendingShaderId = glCreateProgram();
+    glAttachShader(_pendingShaderId, _vertShaderId);
+    glAttachShader(_pendingShaderId, _fragShaderId);
+    
+    if (_cacheEnabled) {
+        glProgramParameteri(_pendingShaderId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
     
-    glDeleteShader(vertShaderId);
-    glDeleteShader(fragShaderId);
+    glLinkProgram(_pendingShaderId);
     
-    _shaderId = shaderId;
+    if (!async) {
+        finaliseProgram();
+    }
 }
 
 void OpenGLShader::use() const { 
@@ -57,12 +115,16 @@ void OpenGLShader::use() const {
 }
 
 void OpenGLShader::destroy() {
+    _pendingSources = {};
+    releasePending();
     if (_shaderId <= 0) {
         LOG_TRACE("Attempted to delete shader with invalid program id.");
         return;
     }
-    glDeleteProgram(_shaderId);
+    // Frames still in flight may draw with the program, so it is deleted once they have finished
+    OpenGLDeletionQueue::get()->retire(GLObjectType::Program, _shaderId);
     _shaderId = 0;
+    _status = ShaderStatus::Failed;
 }
 
 void OpenGLShader::setInt(std::string name, int value) {
@@ -105,22 +167,73 @@ void OpenGLShader::setMat4(std::string name, glm::mat4 matrix) {
     glUniformMatrix4fv(uniformLoc, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
-GLuint OpenGLShader::compileShader(std::string& src, GLenum type) {
+GLuint OpenGLShader::compileShader(const std::string& src, GLenum type) {
     
     GLuint shader = glCreateShader(type);
     const char* srcPtr = src.c_str();
     glShaderSource(shader, 1, &srcPtr, nullptr);
     glCompileShader(shader);
     
+    // Compile status is deliberately not queried here, as doing so would wait for the compiler.
+    // Errors are reported by finaliseProgram once the link has completed.
+    return shader;
+}
+
+void OpenGLShader::finaliseProgram() {
+    
+    // Without parallel compile support the link status query waits for the compile, so time spent in it counts
+    const auto queryTime = std::chrono::steady_clock::now();
     GLint shaderSuccess;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &shaderSuccess);
+    glGetProgramiv(_pendingShaderId, GL_LINK_STATUS, &shaderSuccess);
+    const auto completedTime = std::chrono::steady_clock::now();
     if (!shaderSuccess) {
+        logCompileErrors(_vertShaderId);
+        logCompileErrors(_fragShaderId);
+        
         char infoLog[512];
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        LOG_WARN("Shader compiliation failed. Error: {}", infoLog);
+        glGetProgramInfoLog(_pendingShaderId, 512, nullptr, infoLog);
+        LOG_WARN("Error linking shading program: {}", infoLog);
+        
+        releasePending();
+        _status = ShaderStatus::Failed;
+        return;
     }
     
-    return shader;
+    // The program finished somewhere between the last poll that found it pending and this one. Only the time up to
+    // that poll is counted as compiling, so a program polled late doesn't inflate the time cache hits report saving
+    using Seconds = std::chrono::duration<double>;
+    const double compileSeconds = Seconds(_lastPendingTime - _submitTime).count() + Seconds(completedTime - queryTime).count();
+    const double pollLatencySeconds = Seconds(queryTime - _lastPendingTime).count();
+    OpenGLProgramCache* programCache = OpenGLProgramCache::get();
+    programCache->recordMiss(compileSeconds, pollLatencySeconds);
+    if (_cacheEnabled) {
+        programCache->store(_cacheKey, _pendingShaderId, compileSeconds);
+    }
+    
+    _shaderId = _pendingShaderId;
+    _pendingShaderId = 0;
+    releasePending();
+    _status = ShaderStatus::Ready;
+}
+
+void OpenGLShader::logCompileErrors(GLuint shaderStageId) {
+    GLint shaderSuccess;
+    glGetShaderiv(shaderStageId, GL_COMPILE_STATUS, &shaderSuccess);
+    if (!shaderSuccess) {
+        char infoLog[512];
+        glGetShaderInfoLog(shaderStageId, 512, nullptr, infoLog);
+        LOG_WARN("Shader compiliation failed. Error: {}", infoLog);
+    }
+}
+
+void OpenGLShader::releasePending() {
+    OpenGLDeletionQueue* deletionQueue = OpenGLDeletionQueue::get();
+    deletionQueue->retire(GLObjectType::Shader, _vertShaderId);
+    deletionQueue->retire(GLObjectType::Shader, _fragShaderId);
+    deletionQueue->retire(GLObjectType::Program, _pendingShaderId);
+    _vertShaderId = 0;
+    _fragShaderId = 0;
+    _pendingShaderId = 0;
 }
 
 GLint OpenGLShader::getUniformLoc(std::string& name) {
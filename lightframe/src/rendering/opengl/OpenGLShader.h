@@ -10,17 +10,38 @@
 
 #include <rendering/Shader.h>
 #include <glad/glad.h>
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <map>
 
 class OpenGLShader final : public Shader {
 public:
     
     /**
-     * @brief Creates a new Shader instance.
-     * @param shaderPath The file path to the shader source code.
-     * @return std::unique_ptr<Shader> A new Shader object.
+     * @brief Creates a new Shader instance from the source of each stage.
+     * @param shaderSources The source code of each shader stage.
+     * @param async If true, returns as soon as the compile and link are submitted; poll getStatus() for completion.
      */
-    OpenGLShader(const std::string& shaderPath);
+    OpenGLShader(const std::unordered_map<ShaderType, std::string>& shaderSources, bool async);
+
+    /**
+     * @brief Creates a new Shader instance whose stage sources are still being read on a worker thread.
+     * The compile and link are submitted by the first getStatus() poll after the sources arrive.
+     * @param shaderSources Future for the source code of each shader stage.
+     */
+    explicit OpenGLShader(std::future<std::unordered_map<ShaderType, std::string>> shaderSources);
+
+    /**
+     * @brief Deletes the program and any stage objects still pending.
+     */
+    ~OpenGLShader() override;
+
+    /**
+     * @brief Polls the compilation state, finalising the program once the driver has finished linking it.
+     * @return ShaderStatus The current compilation state.
+     */
+    ShaderStatus getStatus() override;
 
     /**
      * @brief Binds the shader program for subsequent draw calls.
@@ -71,16 +92,60 @@ public:
     void setMat4(std::string name, glm::mat4 matrix) override;
     
 private:
-    GLuint _shaderId;
+    GLuint _shaderId = 0;
     std::map<std::string, GLint> _uniformLocCache;
     
+    ShaderStatus _status = ShaderStatus::Pending;
+    
+    // Stage sources still being read and preprocessed on a worker, valid until they have been submitted
+    std::future<std::unordered_map<ShaderType, std::string>> _pendingSources;
+    
+    // Program and stage objects submitted to the driver but not yet checked.
+    GLuint _pendingShaderId = 0;
+    GLuint _vertShaderId = 0;
+    GLuint _fragShaderId = 0;
+    
+    // Time the compile was submitted, used to report compile time to the program cache.
+    std::chrono::steady_clock::time_point _submitTime;
+    
+    // Time of the last poll that found the compile still running, or the submit time if none has.
+    std::chrono::steady_clock::time_point _lastPendingTime;
+    
+    // Program binary cache key, valid when the cache is enabled.
+    uint64_t _cacheKey = 0;
+    bool _cacheEnabled = false;
+    
+    /**
+     * @brief Submits the program for compilation, or loads it from the program binary cache.
+     * @param shaderSources The source code of each shader stage.
+     * @param async If true, returns as soon as the compile and link are submitted.
+     */
+    void submitProgram(const std::unordered_map<ShaderType, std::string>& shaderSources, bool async);
+    
     /**
-     * @brief Compiles an individual shader stage from source.
+     * @brief Submits an individual shader stage for compilation without waiting for the result.
      * @param src The shader source code.
      * @param type The OpenGL shader stage type.
-     * @return The compiled shader object ID.
+     * @return The shader object ID.
+     */
+    GLuint compileShader(const std::string& src, GLenum type);
+    
+    /**
+     * @brief Checks the link result of the pending program, logging any errors and storing the binary in the cache.
+     * Blocks until the driver has finished linking.
+     */
+    void finaliseProgram();
+    
+    /**
+     * @brief Logs the info log of a shader stage if it failed to compile.
+     * @param shaderStageId The shader stage object to check.
+     */
+    void logCompileErrors(GLuint shaderStageId);
+    
+    /**
+     * @brief Retires the stage objects and any program that has not been finalised to the deletion queue.
      */
-    GLuint compileShader(std::string& src, GLenum type);
+    void releasePending();
 
     /**
      * @brief Gets and caches the uniform location for the given name.
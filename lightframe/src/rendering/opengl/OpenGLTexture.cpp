@@ -2,25 +2,41 @@
 
 #include <debug/Assertions.h>
 
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLExtensions.h"
+#include "OpenGLTextureStreamer.h"
+#include "OpenGLTextureUploader.h"
+#include "OpenGLUploadContext.h"
+
 #include <glad/glad.h>
-#include <stb/stb_image.h>
+
+#include "rendering/MipGenerator.h"
+
+#include <algorithm>
 
 static GLenum LfImageFormatToGlDataFormat(ImageFormat format) {
     switch (format) 
     {
         case ImageFormat::RGB8:     return GL_RGB;
         case ImageFormat::RGBA8:    return GL_RGBA;    
+        default:                    break;
     }
     
     LF_ASSERT_MSG(false, "Unkown image format used for OpenGLTexture2D");
     return GL_NONE;
 }
 
-static GLenum LfImageFormatToGlInternalFormat(ImageFormat format) {
+static GLenum LfImageFormatToGlInternalFormat(ImageFormat format, bool srgb) {
     switch (format) 
     {
-        case ImageFormat::RGB8:     return GL_RGB8;
-        case ImageFormat::RGBA8:    return GL_RGBA8;    
+        case ImageFormat::RGB8:     return srgb ? GL_SRGB8 : GL_RGB8;
+        case ImageFormat::RGBA8:    return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;    
+        case ImageFormat::BC1:      return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case ImageFormat::BC3:      return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case ImageFormat::BC4:      return GL_COMPRESSED_RED_RGTC1;
+        case ImageFormat::BC5:      return GL_COMPRESSED_RG_RGTC2;
+        case ImageFormat::BC7:      return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default:                    break;
     }
     
     LF_ASSERT_MSG(false, "Unkown image format used for OpenGLTexture2D");
@@ -29,85 +45,187 @@ static GLenum LfImageFormatToGlInternalFormat(ImageFormat format) {
 }
 
 OpenGLTexture2D::OpenGLTexture2D(const TextureProps& textureProps)
-    : _textureProps(textureProps), _width(textureProps.width), _height(textureProps.height) { 
+    : _width(textureProps.width), _height(textureProps.height), _textureProps(textureProps) { 
         
-    _internalFormat = LfImageFormatToGlInternalFormat(textureProps.imageFormat);
-    _dataFormat = LfImageFormatToGlDataFormat(textureProps.imageFormat);
-    
-    glCreateTextures(GL_TEXTURE_2D, 1, &_textureId);
-    glTextureStorage2D(_textureId, 1, _internalFormat, _width, _height);
+    _internalFormat = LfImageFormatToGlInternalFormat(textureProps.imageFormat, textureProps.srgb);
+    _dataFormat = isCompressedFormat(textureProps.imageFormat) ? GL_NONE : LfImageFormatToGlDataFormat(textureProps.imageFormat);
+    _mipCount = textureProps.generateMips ? Image::calcMipCount(_width, _height) : 1;
     
-    glTextureParameteri(_textureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTextureParameteri(_textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    glTextureParameteri(_textureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTextureParameteri(_textureId, GL_TEXTURE_WRAP_T, GL_REPEAT);    
+    OpenGLUploadContext::get()->submit([this]() {
+        glCreateTextures(GL_TEXTURE_2D, 1, &_textureId);
+        glTextureStorage2D(_textureId, _mipCount, _internalFormat, _width, _height);
+        applySamplerState();
+    }, _uploadFence);
     
+    _isLoaded = true;
 }
 
-OpenGLTexture2D::OpenGLTexture2D(const std::string path)
-    : _path(path) {
-        
-    int width;
-    int height;
-    int channels;
-    
-    stbi_set_flip_vertically_on_load(1);
-    stbi_uc* imgData = stbi_load(_path.c_str(), &width, &height, &channels, 0);
-    
-    if (imgData) {
-        _isLoaded = true;
-        
-        _width = width;
-        _height = height;
-        
-        GLenum internalFormat;
-        GLenum dataFormat;
-        
-        if (channels == 4) {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
-        } else if (channels == 3) {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
-        }
-        
-        _internalFormat = internalFormat;
-        _dataFormat = dataFormat;
-        
-        LF_ASSERT_MSG(internalFormat & dataFormat, "Image format not supported for OpenGLTexture2D");
-        
-        
-        glCreateTextures(GL_TEXTURE_2D, 1, &_textureId);
-        glTextureStorage2D(_textureId, 1, _internalFormat, _width, _height);
-        
-        glTextureParameteri(_textureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(_textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        glTextureParameteri(_textureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(_textureId, GL_TEXTURE_WRAP_T, GL_REPEAT); 
-        
-        glTextureSubImage2D(_textureId, 0, 0, 0, _width, _height, _dataFormat, GL_UNSIGNED_BYTE, imgData);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        
-        stbi_image_free(imgData);
-    }
+OpenGLTexture2D::OpenGLTexture2D(const std::string path, const TextureProps& textureProps, std::optional<AssetBlob> content)
+    : _width(0), _height(0), _textureProps(textureProps), _path(path) {
+
+    _textureProps.width = 0;
+    _textureProps.height = 0;
+    _textureProps.imageFormat = ImageFormat::None;
+
+    OpenGLTextureUploader::get()->requestLoad(this, _path, _textureProps, std::move(content));
 }
 
 OpenGLTexture2D::~OpenGLTexture2D() {
-    glDeleteTextures(1, &_textureId);
+    if (!_path.empty()) {
+        // Finer levels may still be streaming in after the initial load has finished
+        if (!_isLoaded || _isStreamingIn) {
+            OpenGLTextureUploader::get()->cancel(this);
+        }
+        if (_isLoaded && _textureProps.streaming) {
+            OpenGLTextureStreamer::get()->unregisterTexture(this);
+        }
+    }
+    // Frames still in flight may sample the texture, so it is deleted once they have finished
+    OpenGLUploadContext::get()->release([this]() {
+        OpenGLDeletionQueue::get()->retire(GLObjectType::Texture, _textureId);
+    }, _uploadFence);
 }
 
 void OpenGLTexture2D::setData(void* data, unsigned int size) {
+    LF_ASSERT_MSG(!isCompressedFormat(_textureProps.imageFormat), "setData only supports uncompressed formats.");
+    
     unsigned int bytesPerPixel = _dataFormat == GL_RGBA ? 4 : 3;
     
     LF_ASSERT_MSG(size == _width * _height * bytesPerPixel, "Data must be entire texture.");
     
-    glTextureSubImage2D(_textureId, 0, 0, 0, _width, _height, _dataFormat, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // Build the mips on the CPU, as streamed textures do, and upload every level
+    Image image = Image::fromPixels(static_cast<const uint8_t*>(data), _width, _height, bytesPerPixel, _textureProps.srgb);
+    if (_mipCount > 1) {
+        generateMipChain(image, _textureProps.mipFilter);
+    }
+    
+    OpenGLUploadContext::get()->submit([&]() {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t level = 0; level < image.getMipCount(); ++level) {
+            const ImageMip& mip = image.mips[level];
+            glTextureSubImage2D(_textureId, level, 0, 0, mip.width, mip.height, _dataFormat, GL_UNSIGNED_BYTE, image.getMipData(level));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }, _uploadFence);
 }
 
 void OpenGLTexture2D::bind(unsigned int slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, _textureId);
+    OpenGLUploadContext::waitForUpload(_uploadFence);
+    // Stand in for textures that are still streaming
+    glBindTextureUnit(slot, _isLoaded ? _textureId : OpenGLTextureUploader::get()->getPlaceholderTexture());
+}
+
+void OpenGLTexture2D::requestMip(uint32_t level) {
+    if (_isLoaded && _textureProps.streaming && !_path.empty()) {
+        OpenGLTextureStreamer::get()->requestMip(this, level);
+    }
+}
+
+size_t OpenGLTexture2D::calcStorageBytes(uint32_t firstLevel) const {
+    const bool compressed = isCompressedFormat(_textureProps.imageFormat);
+    const size_t bytesPerPixel = _dataFormat == GL_RGBA ? 4 : 3;
+
+    size_t bytes = 0;
+    for (uint32_t level = firstLevel; level < _mipCount; ++level) {
+        const size_t levelWidth = std::max(1u, _width >> level);
+        const size_t levelHeight = std::max(1u, _height >> level);
+        bytes += compressed
+            ? ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * getBlockBytes(_textureProps.imageFormat)
+            : levelWidth * levelHeight * bytesPerPixel;
+    }
+    return bytes;
+}
+
+void OpenGLTexture2D::allocateStorage(const Image& image, uint32_t firstLevel) {
+    _width = image.width;
+    _height = image.height;
+    _mipCount = image.getMipCount();
+
+    // Nothing is resident until the uploader calls setResidentLevel
+    _storageLevel = firstLevel;
+    _residentLevel = _mipCount;
+
+    _textureProps.width = image.width;
+    _textureProps.height = image.height;
+    _textureProps.imageFormat = image.format;
+    _textureProps.srgb = image.srgb;
+
+    _internalFormat = LfImageFormatToGlInternalFormat(_textureProps.imageFormat, _textureProps.srgb);
+    _dataFormat = isCompressedFormat(image.format) ? GL_NONE : LfImageFormatToGlDataFormat(image.format);
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &_textureId);
+    glTextureStorage2D(_textureId, _mipCount - _storageLevel, _internalFormat,
+        std::max(1u, _width >> _storageLevel), std::max(1u, _height >> _storageLevel));
+    applySamplerState();
+}
+
+void OpenGLTexture2D::reallocateStorage(uint32_t firstLevel) {
+    // Levels coarser than both the new first level and the resident level hold valid texels worth keeping
+    const uint32_t copyLevel = std::max(firstLevel, _residentLevel);
+
+    GLuint textureId = 0;
+    glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
+    glTextureStorage2D(textureId, _mipCount - firstLevel, _internalFormat,
+        std::max(1u, _width >> firstLevel), std::max(1u, _height >> firstLevel));
+
+    // Copied on the GPU, so resident levels never travel back across the bus
+    for (uint32_t level = copyLevel; level < _mipCount; ++level) {
+        const GLsizei levelWidth = static_cast<GLsizei>(std::max(1u, _width >> level));
+        const GLsizei levelHeight = static_cast<GLsizei>(std::max(1u, _height >> level));
+        glCopyImageSubData(_textureId, GL_TEXTURE_2D, static_cast<GLint>(level - _storageLevel), 0, 0, 0,
+            textureId, GL_TEXTURE_2D, static_cast<GLint>(level - firstLevel), 0, 0, 0, levelWidth, levelHeight, 1);
+    }
+
+    OpenGLDeletionQueue::get()->retire(GLObjectType::Texture, _textureId);
+    _textureId = textureId;
+    _storageLevel = firstLevel;
+    _residentLevel = copyLevel;
+    applySamplerState();
+}
+
+void OpenGLTexture2D::setResidentLevel(uint32_t level) {
+    _residentLevel = level;
+    glTextureParameteri(_textureId, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(_residentLevel - _storageLevel));
+}
+
+void OpenGLTexture2D::setSubImage(uint32_t level, unsigned int firstRow, unsigned int rowCount, const void* data, size_t size) {
+    const unsigned int levelWidth = std::max(1u, _width >> level);
+    const GLint storageLevel = static_cast<GLint>(level - _storageLevel);
+
+    if (isCompressedFormat(_textureProps.imageFormat)) {
+        // Rows are rows of 4x4 blocks; the last band may overhang the level, so clamp it to the level height
+        const unsigned int levelHeight = std::max(1u, _height >> level);
+        const unsigned int firstPixelRow = firstRow * 4;
+        const unsigned int pixelRows = std::min(rowCount * 4, levelHeight - firstPixelRow);
+        glCompressedTextureSubImage2D(_textureId, storageLevel, 0, firstPixelRow, levelWidth, pixelRows, _internalFormat,
+            static_cast<GLsizei>(size), data);
+        return;
+    }
+
+    glTextureSubImage2D(_textureId, storageLevel, 0, firstRow, levelWidth, rowCount, _dataFormat, GL_UNSIGNED_BYTE, data);
+}
+
+void OpenGLTexture2D::onUploadComplete() {
+    const bool firstLoad = !_isLoaded;
+    _isLoaded = true;
+    _isStreamingIn = false;
+
+    // Only the low mips were loaded; the streamer brings in finer ones once the texture is drawn close up
+    if (firstLoad && _textureProps.streaming && _storageLevel > 0) {
+        OpenGLTextureStreamer::get()->registerTexture(this);
+    }
+}
+
+void OpenGLTexture2D::applySamplerState() {
+    // Trilinear filtering whenever there is a mip chain to filter between
+    glTextureParameteri(_textureId, GL_TEXTURE_MIN_FILTER, _mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTextureParameteri(_textureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Levels are relative to the storage, which starts at _storageLevel; sampling stops at the finest resident one
+    const uint32_t storageLevels = _mipCount - _storageLevel;
+    const uint32_t baseLevel = std::min(_residentLevel, _mipCount - 1) - _storageLevel;
+    glTextureParameteri(_textureId, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(baseLevel));
+    glTextureParameteri(_textureId, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(storageLevels) - 1);
+
+    glTextureParameteri(_textureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTextureParameteri(_textureId, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
\ No newline at end of file
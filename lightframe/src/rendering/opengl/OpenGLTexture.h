@@ -1,9 +1,14 @@
 #pragma once
 
+#include "assets/AssetArchive.h"
+#include "rendering/Image.h"
 #include "rendering/Texture.h"
 
 #include <glad/glad.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 /**
@@ -19,13 +24,20 @@ public:
 
     /**
      * @brief Constructs an OpenGLTexture2D with specified texture properties.
+     *
+     * May be called on a loader thread, along with setData(), in which case the storage is created and filled by the
+     * upload context, and the first bind on the render thread waits on the GPU for the upload to finish.
      */
     OpenGLTexture2D(const TextureProps& textureSpec);
     
     /**
      * @brief Constructs an OpenGLTexture2D by loading from a file path.
+     *
+     * Returns immediately; the image is decoded on a worker thread and streamed in by the OpenGLTextureUploader.
+     * Until then the texture binds a placeholder and isLoaded() returns false.
+     * If the contents of the file have already been read, they are decoded rather than the file being read again.
      */
-    OpenGLTexture2D(const std::string path);
+    OpenGLTexture2D(const std::string path, const TextureProps& textureProps, std::optional<AssetBlob> content = std::nullopt);
 
     /// Virtual destructor for proper cleanup of OpenGL resources.
     virtual ~OpenGLTexture2D();
@@ -78,10 +90,59 @@ public:
      * @return True if the texture is initialized and ready, false otherwise
      */
     bool isLoaded() const override { return _isLoaded; }
+
+    /**
+     * @brief Checks if the texture file could not be decoded.
+     * @return True if loading failed, false otherwise
+     */
+    bool hasLoadFailed() const override { return _loadFailed; }
+
+    /**
+     * @brief Gets the video memory allocated for the texture's storage.
+     * @return Size of the storage in bytes, or 0 before it is allocated
+     */
+    size_t getGpuMemoryUsage() const override { return _textureId != 0 ? getResidentBytes() : 0; }
+
+    /**
+     * @brief Gets the number of mip levels in the full mip chain, resident or not.
+     * @return Mip level count
+     */
+    uint32_t getMipCount() const override { return _mipCount; }
+
+    /**
+     * @brief Records that the texture is drawn this frame and needs mips down to the given level.
+     * @param level The finest mip level needed
+     */
+    void requestMip(uint32_t level) override;
+
+    /**
+     * @brief Gets the finest mip level that has been uploaded and can be sampled.
+     * @return The resident mip level
+     */
+    uint32_t getResidentLevel() const { return _residentLevel; }
+
+    /**
+     * @brief Gets the video memory held by the texture storage, including levels still streaming in.
+     * @return size_t The storage size in bytes
+     */
+    size_t getResidentBytes() const { return calcStorageBytes(_storageLevel); }
+
+    /**
+     * @brief Calculates the size of texture storage that holds the mip chain from a given level down.
+     * @param firstLevel The finest level held by the storage.
+     * @return size_t The storage size in bytes
+     */
+    size_t calcStorageBytes(uint32_t firstLevel) const;
     
 private:
+    friend class OpenGLTextureUploader;
+    friend class OpenGLTextureStreamer;
+
     // OpenGL texture handle
-    GLuint _textureId;
+    GLuint _textureId = 0;
+
+    // Signals once storage created or data written off the render thread has reached the GPU
+    mutable GLsync _uploadFence = nullptr;
     
     // Texture dimensions
     unsigned int _width;
@@ -98,4 +159,60 @@ private:
     std::string _path;
     
     bool _isLoaded = false;
+
+    // Whether the file could not be decoded, so the texture will never load
+    bool _loadFailed = false;
+
+    // Number of mip levels in the full mip chain
+    uint32_t _mipCount = 1;
+
+    // Mip level held by level 0 of the texture storage; finer levels are not allocated
+    uint32_t _storageLevel = 0;
+
+    // Finest mip level that has been uploaded, which GL_TEXTURE_BASE_LEVEL exposes to sampling
+    uint32_t _residentLevel = 0;
+
+    // Whether finer levels are being decoded or uploaded
+    bool _isStreamingIn = false;
+
+    /**
+     * @brief Creates the texture storage for a decoded image, with a level for each of its mips from firstLevel down.
+     * @param image The decoded image.
+     * @param firstLevel The finest mip level to allocate.
+     */
+    void allocateStorage(const Image& image, uint32_t firstLevel);
+
+    /**
+     * @brief Replaces the texture storage with one that holds the mip chain from firstLevel down, copying across the
+     * resident levels it still covers. Used both to make room for finer levels and to evict them.
+     * @param firstLevel The finest mip level of the new storage.
+     */
+    void reallocateStorage(uint32_t firstLevel);
+
+    /**
+     * @brief Exposes a newly uploaded level, and every coarser one, to sampling.
+     * @param level The finest uploaded mip level.
+     */
+    void setResidentLevel(uint32_t level);
+
+    /**
+     * @brief Uploads a band of rows to a mip level. Reads from the bound pixel unpack buffer if there is one.
+     * For compressed formats, rows are rows of 4x4 blocks.
+     * @param level The mip level to write.
+     * @param firstRow The first row to write.
+     * @param rowCount The number of rows to write.
+     * @param data The pixel data, or an offset into the bound pixel unpack buffer.
+     * @param size The size of the data in bytes.
+     */
+    void setSubImage(uint32_t level, unsigned int firstRow, unsigned int rowCount, const void* data, size_t size);
+
+    /**
+     * @brief Finishes a streamed load, or the streaming in of finer levels, once every level has reached the GPU.
+     */
+    void onUploadComplete();
+
+    /**
+     * @brief Sets trilinear filtering, the mip range and wrapping on the texture object.
+     */
+    void applySamplerState();
 };
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "OpenGLTextureStreamer.h"
+
+#include "OpenGLTexture.h"
+#include "OpenGLTextureUploader.h"
+
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+static std::unique_ptr<OpenGLTextureStreamer> s_Instance = nullptr;
+
+OpenGLTextureStreamer* OpenGLTextureStreamer::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<OpenGLTextureStreamer>();
+    }
+    return s_Instance.get();
+}
+
+void OpenGLTextureStreamer::registerTexture(OpenGLTexture2D* texture) {
+    if (_entries.contains(texture)) {
+        return;
+    }
+
+    // New textures count as least recently used until they are drawn
+    _lru.push_back(StreamedTexture { .texture = texture });
+    _entries[texture] = std::prev(_lru.end());
+}
+
+void OpenGLTextureStreamer::unregisterTexture(OpenGLTexture2D* texture) {
+    auto it = _entries.find(texture);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    _lru.erase(it->second);
+    _entries.erase(it);
+}
+
+void OpenGLTextureStreamer::requestMip(OpenGLTexture2D* texture, uint32_t level) {
+    auto it = _entries.find(texture);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    StreamedTexture& entry = *it->second;
+    if (entry.lastUsedFrame == _frameIndex) {
+        entry.requestedLevel = std::min(entry.requestedLevel, level);
+        return;
+    }
+
+    entry.lastUsedFrame = _frameIndex;
+    entry.requestedLevel = level;
+    _lru.splice(_lru.begin(), _lru, it->second);
+}
+
+void OpenGLTextureStreamer::update() {
+
+    size_t committedBytes = 0;
+    uint32_t pendingStreamIns = 0;
+    for (const StreamedTexture& entry : _lru) {
+        committedBytes += getCommittedBytes(entry);
+        pendingStreamIns += entry.texture->_isStreamingIn ? 1 : 0;
+    }
+
+    // Honour a budget that has been lowered since the last frame
+    if (committedBytes > _budget) {
+        committedBytes -= evict(committedBytes - _budget, nullptr);
+    }
+
+    // Textures drawn last frame are at the front of the list
+    for (StreamedTexture& entry : _lru) {
+        if (entry.lastUsedFrame != _frameIndex || pendingStreamIns >= _maxPendingStreamIns) {
+            break;
+        }
+
+        OpenGLTexture2D* texture = entry.texture;
+        if (texture->_isStreamingIn || entry.requestedLevel >= texture->getResidentLevel()) {
+            continue;
+        }
+
+        // Make room by evicting older textures, then settle for the finest level that fits
+        uint32_t level = entry.requestedLevel;
+        size_t requiredBytes = texture->calcStorageBytes(level) - texture->getResidentBytes();
+        if (committedBytes + requiredBytes > _budget) {
+            committedBytes -= evict(committedBytes + requiredBytes - _budget, texture);
+        }
+        while (level < texture->getResidentLevel() && committedBytes + requiredBytes > _budget) {
+            ++level;
+            requiredBytes = texture->calcStorageBytes(level) - texture->getResidentBytes();
+        }
+        if (level >= texture->getResidentLevel()) {
+            continue;
+        }
+
+        entry.streamingLevel = level;
+        OpenGLTextureUploader::get()->requestStreamIn(texture, level);
+
+        committedBytes += requiredBytes;
+        ++pendingStreamIns;
+        ++_stats.streamIns;
+    }
+
+    _stats.residentBytes = committedBytes;
+    _stats.streamedTextures = static_cast<uint32_t>(_lru.size());
+    _stats.pendingStreamIns = pendingStreamIns;
+
+    // Start collecting the next frame's requests
+    ++_frameIndex;
+}
+
+uint32_t OpenGLTextureStreamer::calcInitialLevel(uint32_t width, uint32_t height, uint32_t mipCount) const {
+    uint32_t level = 0;
+    while (level + 1 < mipCount && std::max(width >> level, height >> level) > _initialSize) {
+        ++level;
+    }
+    return level;
+}
+
+size_t OpenGLTextureStreamer::getCommittedBytes(const StreamedTexture& entry) const {
+    const OpenGLTexture2D* texture = entry.texture;
+
+    // A pending stream in allocates its storage once the file has been decoded again
+    if (texture->_isStreamingIn) {
+        return texture->calcStorageBytes(std::min(entry.streamingLevel, texture->_storageLevel));
+    }
+    return texture->getResidentBytes();
+}
+
+size_t OpenGLTextureStreamer::evict(size_t bytes, const OpenGLTexture2D* keep) {
+    size_t freedBytes = 0;
+
+    for (auto it = _lru.rbegin(); it != _lru.rend() && freedBytes < bytes; ++it) {
+        OpenGLTexture2D* texture = it->texture;
+        if (texture == keep || texture->_isStreamingIn) {
+            continue;
+        }
+
+        // Textures still being drawn keep what they asked for; the rest fall back to their initial low mips
+        const uint32_t level = it->lastUsedFrame == _frameIndex
+            ? std::min(it->requestedLevel, texture->getMipCount() - 1)
+            : calcInitialLevel(texture->getWidth(), texture->getHeight(), texture->getMipCount());
+        if (level <= texture->_storageLevel) {
+            continue;
+        }
+
+        const size_t residentBytes = texture->getResidentBytes();
+        texture->reallocateStorage(level);
+        freedBytes += residentBytes - texture->getResidentBytes();
+        ++_stats.evictions;
+
+        LOG_DEBUG("Evicted texture {} down to mip {}.", texture->_path, level);
+    }
+
+    return freedBytes;
+}
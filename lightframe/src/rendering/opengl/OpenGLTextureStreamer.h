@@ -0,0 +1,144 @@
+/**
+ * @file OpenGLTextureStreamer.h
+ * @author Justin McKay
+ * @brief Keeps the mips that visible textures need resident within a video memory budget, evicting the least recently used.
+ * @date 2026-03-14
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+class OpenGLTexture2D;
+
+/**
+ * @brief Counters describing texture residency.
+ */
+struct TextureStreamingStats {
+    /** Video memory held by streamed textures, including levels still streaming in */
+    size_t residentBytes = 0;
+    /** Textures managed by the streamer */
+    uint32_t streamedTextures = 0;
+    /** Textures with finer levels being decoded or uploaded */
+    uint32_t pendingStreamIns = 0;
+    /** Finer level requests started since startup */
+    uint32_t streamIns = 0;
+    /** Textures whose finest levels were evicted since startup */
+    uint32_t evictions = 0;
+};
+
+class OpenGLTextureStreamer {
+public:
+
+    /**
+     * @brief Starts managing the residency of a texture whose low mips have finished loading.
+     * @param texture The loaded texture.
+     */
+    void registerTexture(OpenGLTexture2D* texture);
+
+    /**
+     * @brief Stops managing a texture, e.g. because it is being destroyed.
+     * @param texture The texture to forget.
+     */
+    void unregisterTexture(OpenGLTexture2D* texture);
+
+    /**
+     * @brief Records that a texture is drawn this frame and needs mips down to the given level.
+     * Called during extraction; the finest level requested in a frame wins.
+     * @param texture The texture being drawn.
+     * @param level The finest mip level needed.
+     */
+    void requestMip(OpenGLTexture2D* texture, uint32_t level);
+
+    /**
+     * @brief Acts on the mip requests of the last frame. Must be called once per frame on the render thread.
+     *
+     * Textures drawn last frame that need finer levels than they hold are streamed in, most recently used first.
+     * When that would exceed the budget, the least recently used textures give up their finest levels: those no
+     * longer drawn drop back to their initial low mips, and those still drawn to the level they last requested.
+     */
+    void update();
+
+    /**
+     * @brief Sets the video memory budget shared by all streamed textures.
+     * @param bytes The budget in bytes.
+     */
+    void setBudget(size_t bytes) { _budget = bytes; }
+
+    /**
+     * @brief Gets the video memory budget shared by all streamed textures.
+     * @return size_t The budget in bytes.
+     */
+    size_t getBudget() const { return _budget; }
+
+    /**
+     * @brief Calculates the mip level a streamed texture starts with: the largest no bigger than the initial size.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @param mipCount The number of levels in the mip chain.
+     * @return uint32_t The initial mip level.
+     */
+    uint32_t calcInitialLevel(uint32_t width, uint32_t height, uint32_t mipCount) const;
+
+    /**
+     * @brief Gets the residency counters.
+     * @return const TextureStreamingStats& The streaming statistics.
+     */
+    const TextureStreamingStats& getStats() const { return _stats; }
+
+    /**
+     * @brief Singleton method to get the texture streamer.
+     * @return OpenGLTextureStreamer* A pointer to the streamer instance.
+     */
+    static OpenGLTextureStreamer* get();
+
+private:
+
+    /**
+     * @brief Residency state of one streamed texture.
+     */
+    struct StreamedTexture {
+        OpenGLTexture2D* texture;
+        // Frame in which the texture was last drawn, and the finest level requested in that frame
+        uint64_t lastUsedFrame = 0;
+        uint32_t requestedLevel = 0;
+        // Finest level being streamed in, while a stream in is pending
+        uint32_t streamingLevel = 0;
+    };
+
+    // Streamed textures, most recently used first
+    std::list<StreamedTexture> _lru;
+
+    // Position of each texture in the LRU list
+    std::unordered_map<OpenGLTexture2D*, std::list<StreamedTexture>::iterator> _entries;
+
+    // Video memory budget shared by all streamed textures
+    size_t _budget = 512 * 1024 * 1024;
+
+    // Largest dimension of the mip level a streamed texture starts with
+    uint32_t _initialSize = 64;
+
+    // Maximum number of textures streaming in at once, so decodes don't starve other loads
+    uint32_t _maxPendingStreamIns = 4;
+
+    // Index of the frame whose mip requests are being collected
+    uint64_t _frameIndex = 1;
+
+    TextureStreamingStats _stats;
+
+    /**
+     * @brief Gets the video memory a texture holds or is about to hold once its pending levels arrive.
+     */
+    size_t getCommittedBytes(const StreamedTexture& entry) const;
+
+    /**
+     * @brief Evicts the finest levels of the least recently used textures until enough memory has been freed.
+     * @param bytes The number of bytes to free.
+     * @param keep A texture that must not be evicted, or nullptr.
+     * @return size_t The number of bytes freed, which may be less than requested.
+     */
+    size_t evict(size_t bytes, const OpenGLTexture2D* keep);
+};
@@ -0,0 +1,337 @@
+#include "OpenGLTextureUploader.h"
+
+#include "OpenGLExtensions.h"
+#include "OpenGLTexture.h"
+#include "OpenGLTextureStreamer.h"
+
+#include "assets/BlockCompressor.h"
+#include "assets/TextureFile.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "debug/Assertions.h"
+#include "rendering/MipGenerator.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Alignment of each staging allocation within the ring
+static constexpr size_t STAGING_ALIGNMENT = 16;
+
+static std::unique_ptr<OpenGLTextureUploader> s_Instance = nullptr;
+
+OpenGLTextureUploader* OpenGLTextureUploader::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<OpenGLTextureUploader>();
+    }
+    return s_Instance.get();
+}
+
+OpenGLTextureUploader::~OpenGLTextureUploader() {
+    // Stop workers from decoding images nobody will upload
+    for (PendingUpload& upload : _pendingUploads) {
+        upload.job->cancelled = true;
+    }
+}
+
+void OpenGLTextureUploader::requestLoad(OpenGLTexture2D* texture, const std::string& path, const TextureProps& textureProps,
+    std::optional<AssetBlob> content) {
+    enqueueDecode(PendingUpload { .texture = texture }, path, textureProps, std::move(content));
+}
+
+void OpenGLTextureUploader::requestStreamIn(OpenGLTexture2D* texture, uint32_t firstLevel) {
+    LF_ASSERT_MSG(texture->isLoaded() && firstLevel < texture->getResidentLevel(), "Only finer levels than those resident can be streamed in.");
+
+    // Until cooked assets store their levels separately, the whole file is decoded again and only the new levels kept
+    texture->_isStreamingIn = true;
+    enqueueDecode(PendingUpload { .texture = texture, .streamIn = true, .targetLevel = firstLevel }, texture->_path, texture->_textureProps,
+        std::nullopt);
+}
+
+void OpenGLTextureUploader::enqueueDecode(PendingUpload upload, const std::string& path, const TextureProps& textureProps,
+    std::optional<AssetBlob> content) {
+    auto job = std::make_shared<DecodeJob>();
+    job->path = path;
+    job->textureProps = textureProps;
+    job->content = std::move(content);
+
+    upload.job = job;
+    _pendingUploads.push_back(std::move(upload));
+
+    ThreadPool::get()->enqueue([job]() {
+        if (job->cancelled) {
+            return;
+        }
+
+        const bool read = job->content
+            ? readImageFile(*job->content, job->path, job->textureProps.srgb, job->image)
+            : readImageFile(job->path, job->textureProps.srgb, job->image);
+        job->content.reset();
+        if (!read) {
+            job->state = DecodeJob::State::Failed;
+            return;
+        }
+
+        // Mips are built here, on the worker, so neither the render thread nor the GPU spends time on them.
+        // Cooked textures arrive with their chain already built.
+        if (job->textureProps.generateMips && job->image.getMipCount() == 1 && !job->cancelled) {
+            generateMipChain(job->image, job->textureProps.mipFilter);
+        }
+
+        ImageFormat compression = job->textureProps.compression;
+        if (compression != ImageFormat::None && !isCompressedFormat(job->image.format) && !job->cancelled) {
+            // BC1 and BC3 need S3TC; BC7 is core and covers both
+            if ((compression == ImageFormat::BC1 || compression == ImageFormat::BC3) && !OpenGLExtensions::hasTextureCompressionS3tc()) {
+                compression = ImageFormat::BC7;
+            }
+
+            Image compressed = compressImage(job->image, compression);
+            if (!compressed.data.empty()) {
+                job->image = std::move(compressed);
+            }
+        }
+
+        job->state = DecodeJob::State::Decoded;
+    });
+}
+
+void OpenGLTextureUploader::cancel(OpenGLTexture2D* texture) {
+    std::erase_if(_pendingUploads, [texture](PendingUpload& upload) {
+        if (upload.texture != texture) {
+            return false;
+        }
+        upload.job->cancelled = true;
+        return true;
+    });
+}
+
+void OpenGLTextureUploader::update() {
+
+    ++_frameIndex;
+    _stats.bytesUploadedLastFrame = 0;
+
+    if (_pendingUploads.empty() && _frameFences.empty()) {
+        return;
+    }
+
+    if (!_stagingBuffer) {
+        createStagingBuffer();
+    }
+
+    retireCompletedFrames();
+
+    size_t budget = _uploadBudget;
+    size_t frameStagingBytes = _stagingUsed;
+
+    for (auto it = _pendingUploads.begin(); it != _pendingUploads.end();) {
+        PendingUpload& upload = *it;
+
+        // Every row has been issued; the texture is complete once the fence of its final frame signals
+        if (upload.finalFrame != 0) {
+            if (_completedFrame >= upload.finalFrame) {
+                upload.texture->onUploadComplete();
+                ++_stats.texturesCompleted;
+                it = _pendingUploads.erase(it);
+            } else {
+                ++it;
+            }
+            continue;
+        }
+
+        const DecodeJob::State state = upload.job->state;
+        if (state == DecodeJob::State::Failed) {
+            LOG_WARN("Failed to load texture: {}", upload.job->path);
+            upload.texture->_isStreamingIn = false;
+            upload.texture->_loadFailed = !upload.streamIn;
+            it = _pendingUploads.erase(it);
+            continue;
+        }
+
+        // The file changed since the resident levels were loaded, so the new levels wouldn't line up with them
+        if (state == DecodeJob::State::Decoded && upload.streamIn && !upload.storageAllocated) {
+            const Image& image = upload.job->image;
+            if (image.width != upload.texture->_width || image.height != upload.texture->_height ||
+                image.format != upload.texture->_textureProps.imageFormat || image.getMipCount() != upload.texture->_mipCount) {
+                LOG_WARN("Texture {} no longer matches its resident mips; not streaming in finer levels.", upload.job->path);
+                upload.texture->_isStreamingIn = false;
+                it = _pendingUploads.erase(it);
+                continue;
+            }
+        }
+
+        // Images still decoding don't hold up ones that are ready behind them
+        if (state == DecodeJob::State::Queued || budget == 0) {
+            ++it;
+            continue;
+        }
+
+        if (uploadRows(upload, budget)) {
+            upload.finalFrame = _frameIndex;
+
+            // Every row is in the staging ring or on the GPU, so the decoded image is no longer needed
+            upload.job.reset();
+        }
+        ++it;
+    }
+
+    // Fence any frame that issued uploads, including direct uploads that bypassed the ring
+    frameStagingBytes = _stagingUsed - frameStagingBytes;
+    if (frameStagingBytes > 0 || budget != _uploadBudget) {
+        _frameFences.push_back(FrameFence {
+            .fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+            .frame = _frameIndex,
+            .bytes = frameStagingBytes
+        });
+    }
+
+    _stats.bytesUploadedLastFrame = _uploadBudget - budget;
+    _stats.totalBytesUploaded += _stats.bytesUploadedLastFrame;
+    _stats.pendingTextures = static_cast<uint32_t>(_pendingUploads.size());
+}
+
+GLuint OpenGLTextureUploader::getPlaceholderTexture() {
+    if (!_placeholderTexture) {
+        // Neutral grey, so loading surfaces read as unlit rather than as missing
+        const uint8_t pixel[4] = { 128, 128, 128, 255 };
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &_placeholderTexture);
+        glTextureStorage2D(_placeholderTexture, 1, GL_RGBA8, 1, 1);
+        glTextureSubImage2D(_placeholderTexture, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    }
+    return _placeholderTexture;
+}
+
+void OpenGLTextureUploader::createStagingBuffer() {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &_stagingBuffer);
+    glNamedBufferStorage(_stagingBuffer, static_cast<GLsizeiptr>(_stagingCapacity), nullptr, flags);
+    _stagingMemory = static_cast<unsigned char*>(
+        glMapNamedBufferRange(_stagingBuffer, 0, static_cast<GLsizeiptr>(_stagingCapacity), flags));
+
+    LF_ASSERT_MSG(_stagingMemory, "Unable to map the texture staging buffer.");
+}
+
+void OpenGLTextureUploader::retireCompletedFrames() {
+    while (!_frameFences.empty()) {
+        FrameFence& frameFence = _frameFences.front();
+
+        const GLenum result = glClientWaitSync(frameFence.fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+        if (result == GL_WAIT_FAILED) {
+            LOG_WARN("Texture staging fence wait failed; releasing its memory.");
+        }
+
+        glDeleteSync(frameFence.fence);
+        _stagingUsed -= frameFence.bytes;
+        _completedFrame = frameFence.frame;
+        _frameFences.pop_front();
+    }
+
+    // With nothing in flight, start again from the beginning so allocations don't wrap needlessly
+    if (_frameFences.empty()) {
+        _stagingHead = 0;
+        _stagingUsed = 0;
+    }
+}
+
+bool OpenGLTextureUploader::allocateStaging(size_t size, size_t& offset) {
+    size_t start = (_stagingHead + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+    size_t padding = start - _stagingHead;
+
+    // Not enough room before the end of the ring, so skip the remainder and wrap to the start
+    if (start + size > _stagingCapacity) {
+        padding = _stagingCapacity - _stagingHead;
+        start = 0;
+    }
+
+    if (_stagingUsed + padding + size > _stagingCapacity) {
+        return false;
+    }
+
+    _stagingUsed += padding + size;
+    _stagingHead = start + size;
+    offset = start;
+    return true;
+}
+
+bool OpenGLTextureUploader::uploadRows(PendingUpload& upload, size_t& budget) {
+    const Image& image = upload.job->image;
+
+    if (!upload.storageAllocated) {
+        if (upload.streamIn) {
+            // Grow the storage down to the target level; the resident levels are copied across on the GPU
+            upload.texture->reallocateStorage(upload.targetLevel);
+            upload.uploadedLevel = upload.texture->_residentLevel;
+        } else {
+            // Streamed textures start with only their low mips
+            upload.targetLevel = upload.job->textureProps.streaming
+                ? OpenGLTextureStreamer::get()->calcInitialLevel(image.width, image.height, image.getMipCount())
+                : 0;
+            upload.texture->allocateStorage(image, upload.targetLevel);
+            upload.uploadedLevel = image.getMipCount();
+        }
+        upload.storageAllocated = true;
+    }
+
+    // Rows of RGB images and of small mip levels are not 4-byte aligned (ignored for compressed uploads)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBuffer);
+
+    while (budget > 0 && upload.uploadedLevel > upload.targetLevel) {
+        const uint32_t level = upload.uploadedLevel - 1;
+        const ImageMip& mip = image.mips[level];
+        const size_t rowBytes = image.getRowPitch(level);
+        const uint32_t rowCount = image.getRowCount(level);
+        const uint8_t* levelData = image.getMipData(level);
+
+        // A single row larger than the whole ring can't be staged, so upload the level directly
+        if (rowBytes > _stagingCapacity) {
+            LOG_WARN("Texture {} is too wide to stream; uploading level {} directly.", upload.job->path, level);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            upload.texture->setSubImage(level, 0, rowCount, levelData, mip.size);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBuffer);
+            budget = mip.size > budget ? 0 : budget - mip.size;
+            upload.texture->setResidentLevel(level);
+            --upload.uploadedLevel;
+            upload.nextRow = 0;
+            continue;
+        }
+
+        uint32_t rows = std::min<uint32_t>(rowCount - upload.nextRow, static_cast<uint32_t>(budget / rowBytes));
+
+        // Always make progress on a fresh budget, even if one row exceeds it
+        if (rows == 0 && budget == _uploadBudget) {
+            rows = 1;
+        }
+
+        size_t offset = 0;
+        while (rows > 0 && !allocateStaging(rows * rowBytes, offset)) {
+            rows /= 2;
+        }
+
+        if (rows == 0) {
+            // Out of budget, or the ring is full of data the GPU hasn't consumed yet; continue next frame
+            budget = 0;
+            break;
+        }
+
+        const size_t bytes = rows * rowBytes;
+        std::memcpy(_stagingMemory + offset, levelData + upload.nextRow * rowBytes, bytes);
+        upload.texture->setSubImage(level, upload.nextRow, rows, reinterpret_cast<const void*>(offset), bytes);
+
+        budget = bytes > budget ? 0 : budget - bytes;
+        upload.nextRow += rows;
+        if (upload.nextRow == rowCount) {
+            // Draws issued after this point are ordered after the upload, so the level can be sampled straight away
+            upload.texture->setResidentLevel(level);
+            --upload.uploadedLevel;
+            upload.nextRow = 0;
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return upload.uploadedLevel == upload.targetLevel;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file OpenGLTextureUploader.h
+ * @author Justin McKay
+ * @brief Decodes texture files on worker threads and streams them to the GPU through a pixel buffer object ring.
+ * @date 2026-03-11
+ */
+
+#pragma once
+
+#include "assets/AssetArchive.h"
+#include "rendering/Image.h"
+#include "rendering/Texture.h"
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class OpenGLTexture2D;
+
+/**
+ * @brief Counters describing texture streaming activity.
+ */
+struct TextureUploadStats {
+    /** Textures decoded or decoding but not yet fully uploaded */
+    uint32_t pendingTextures = 0;
+    /** Bytes copied into the staging ring during the last update */
+    size_t bytesUploadedLastFrame = 0;
+    /** Bytes copied into the staging ring since startup */
+    size_t totalBytesUploaded = 0;
+    /** Textures that have completed their upload since startup */
+    uint32_t texturesCompleted = 0;
+};
+
+class OpenGLTextureUploader {
+public:
+    ~OpenGLTextureUploader();
+
+    /**
+     * @brief Starts decoding a texture file on the worker pool. The texture is uploaded by later update() calls.
+     * @param texture The texture that receives the image. Must call cancel() if destroyed before completion.
+     * @param path The path of the image file.
+     * @param textureProps Load options; controls mip generation and sRGB handling.
+     * @param content The contents of the file if they have already been read, so the worker decodes them rather than
+     * reading the file again.
+     */
+    void requestLoad(OpenGLTexture2D* texture, const std::string& path, const TextureProps& textureProps,
+        std::optional<AssetBlob> content = std::nullopt);
+
+    /**
+     * @brief Decodes a texture file again and uploads the mip levels finer than those already resident.
+     * The texture storage is grown to hold the new levels, and each one becomes visible as soon as it is issued.
+     * @param texture The loaded texture that receives the levels.
+     * @param firstLevel The finest mip level to upload.
+     */
+    void requestStreamIn(OpenGLTexture2D* texture, uint32_t firstLevel);
+
+    /**
+     * @brief Abandons any decode or upload in progress for a texture.
+     * @param texture The texture being destroyed.
+     */
+    void cancel(OpenGLTexture2D* texture);
+
+    /**
+     * @brief Advances texture streaming by one frame. Must be called once per frame on the render thread.
+     *
+     * Retires staging memory whose fence has signalled and marks textures whose final rows have reached the GPU as
+     * loaded. It then copies decoded rows into the staging ring and issues the texture uploads, stopping once the
+     * per-frame byte budget is spent, so a large texture is spread over several frames instead of causing a spike.
+     */
+    void update();
+
+    /**
+     * @brief Sets the maximum number of bytes copied into the staging ring each frame.
+     * @param bytesPerFrame The per-frame upload budget in bytes.
+     */
+    void setUploadBudget(size_t bytesPerFrame) { _uploadBudget = bytesPerFrame; }
+
+    /**
+     * @brief Gets the texture bound in place of textures that have not finished loading.
+     * @return GLuint The placeholder texture ID.
+     */
+    GLuint getPlaceholderTexture();
+
+    /**
+     * @brief Gets the texture streaming counters.
+     * @return const TextureUploadStats& The upload statistics.
+     */
+    const TextureUploadStats& getStats() const { return _stats; }
+
+    /**
+     * @brief Singleton method to get the texture uploader.
+     * @return OpenGLTextureUploader* A pointer to the uploader instance.
+     */
+    static OpenGLTextureUploader* get();
+
+private:
+
+    /**
+     * @brief Progress of decoding an image file, shared between the render thread and a worker.
+     */
+    struct DecodeJob {
+        enum class State : uint8_t { Queued = 0, Decoded, Failed };
+
+        std::string path;
+        TextureProps textureProps;
+        // Contents of the file if they were read before the job was queued, dropped once decoded
+        std::optional<AssetBlob> content;
+        std::atomic<State> state = State::Queued;
+        // Set by the render thread when the texture no longer wants the image
+        std::atomic<bool> cancelled = false;
+
+        // Decoded image and its mip chain, written by the worker before state becomes Decoded
+        Image image;
+    };
+
+    /**
+     * @brief A texture waiting on its decode or part way through its upload.
+     */
+    struct PendingUpload {
+        OpenGLTexture2D* texture;
+        std::shared_ptr<DecodeJob> job;
+        // Whether the texture already has resident levels and is gaining finer ones
+        bool streamIn = false;
+        // Finest mip level to upload; for initial loads it is chosen once the image size is known
+        uint32_t targetLevel = 0;
+        // Levels are uploaded coarsest first; every level from this one down has been issued
+        uint32_t uploadedLevel = 0;
+        // Next row of the level being uploaded to copy into the staging ring
+        uint32_t nextRow = 0;
+        // Whether the texture storage has been created for the decoded dimensions
+        bool storageAllocated = false;
+        // Frame whose fence covers the last rows of the image, once they have all been issued
+        uint64_t finalFrame = 0;
+    };
+
+    /**
+     * @brief Staging memory used by one frame, released when the frame's fence signals.
+     */
+    struct FrameFence {
+        GLsync fence;
+        uint64_t frame;
+        size_t bytes;
+    };
+
+    // Textures in the order they were requested
+    std::deque<PendingUpload> _pendingUploads;
+
+    // Fences of frames whose staging memory is still in use by the GPU, oldest first
+    std::deque<FrameFence> _frameFences;
+
+    // Persistently mapped pixel unpack buffer used as the staging ring
+    GLuint _stagingBuffer = 0;
+    unsigned char* _stagingMemory = nullptr;
+    size_t _stagingCapacity = 16 * 1024 * 1024;
+
+    // Ring write position and bytes not yet released by a fence
+    size_t _stagingHead = 0;
+    size_t _stagingUsed = 0;
+
+    // Maximum bytes copied into the ring each frame
+    size_t _uploadBudget = 4 * 1024 * 1024;
+
+    // Index of the current frame; frame fences complete in increasing order
+    uint64_t _frameIndex = 0;
+
+    // Newest frame whose fence has signalled
+    uint64_t _completedFrame = 0;
+
+    // 1x1 texture bound while a texture is loading
+    GLuint _placeholderTexture = 0;
+
+    TextureUploadStats _stats;
+
+    /**
+     * @brief Queues a decode job on the worker pool and the upload that waits on it.
+     */
+    void enqueueDecode(PendingUpload upload, const std::string& path, const TextureProps& textureProps,
+        std::optional<AssetBlob> content);
+
+    /**
+     * @brief Creates and maps the staging ring on first use.
+     */
+    void createStagingBuffer();
+
+    /**
+     * @brief Releases the staging memory of every frame whose fence has signalled.
+     */
+    void retireCompletedFrames();
+
+    /**
+     * @brief Reserves contiguous space in the staging ring.
+     * @param size The number of bytes required.
+     * @param offset Receives the offset of the reserved space.
+     * @return true if the space was reserved, false if the ring is too full.
+     */
+    bool allocateStaging(size_t size, size_t& offset);
+
+    /**
+     * @brief Copies as many rows of an upload as the remaining budget and ring space allow, and issues them.
+     * Levels are uploaded coarsest first, each in bands of rows, so a streamed texture sharpens as they arrive.
+     * @param upload The upload to advance.
+     * @param budget The remaining byte budget for this frame, reduced by the bytes copied.
+     * @return true if every row of every requested mip level has now been issued.
+     */
+    bool uploadRows(PendingUpload& upload, size_t& budget);
+};
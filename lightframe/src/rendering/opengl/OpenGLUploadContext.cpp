@@ -0,0 +1,137 @@
+#include "OpenGLUploadContext.h"
+
+#include "core/Logger.h"
+#include "debug/Assertions.h"
+
+#include <memory>
+
+static std::unique_ptr<OpenGLUploadContext> s_Instance = nullptr;
+
+OpenGLUploadContext* OpenGLUploadContext::get() {
+    if (!s_Instance) {
+        s_Instance = std::make_unique<OpenGLUploadContext>();
+    }
+    return s_Instance.get();
+}
+
+OpenGLUploadContext::~OpenGLUploadContext() {
+    shutdown();
+}
+
+void OpenGLUploadContext::start(std::function<void()> makeCurrent, std::function<void()> releaseCurrent) {
+    LF_ASSERT_MSG(!_thread.joinable(), "The upload context has already been started.");
+
+    _renderThreadId = std::this_thread::get_id();
+    _stopping = false;
+    _thread = std::thread(&OpenGLUploadContext::threadMain, this, std::move(makeCurrent), std::move(releaseCurrent));
+    _running.store(true, std::memory_order_release);
+}
+
+void OpenGLUploadContext::shutdown() {
+    if (!_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+    _running.store(false, std::memory_order_release);
+}
+
+void OpenGLUploadContext::submit(const std::function<void()>& commands, GLsync& fence) {
+    if (isRenderThread()) {
+        waitForUpload(fence);
+        commands();
+        return;
+    }
+    runOnUploadThread(commands, fence, true);
+}
+
+void OpenGLUploadContext::release(const std::function<void()>& commands, GLsync& fence) {
+    if (isRenderThread()) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        commands();
+        return;
+    }
+    runOnUploadThread(commands, fence, false);
+}
+
+bool OpenGLUploadContext::isUploadComplete(GLsync& fence) {
+    if (!fence) {
+        return true;
+    }
+
+    const GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+    return true;
+}
+
+void OpenGLUploadContext::waitForFence(GLsync& fence) {
+    glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void OpenGLUploadContext::runOnUploadThread(const std::function<void()>& commands, GLsync& fence, bool fenced) {
+    UploadTask task { &commands, &fence, fenced };
+    std::future<void> done = task.done.get_future();
+    {
+        std::lock_guard lock(_mutex);
+        if (_stopping) {
+            // With no context left to run them on, creating fails outright and deleting leaks until the process exits
+            LF_ASSERT_MSG(!fenced, "GL objects can't be created off the render thread once the upload context has shut down.");
+            LOG_WARN("GL object released off the render thread after the upload context shut down.");
+            return;
+        }
+        _queue.push_back(&task);
+    }
+    _condition.notify_one();
+    done.wait();
+}
+
+void OpenGLUploadContext::threadMain(std::function<void()> makeCurrent, std::function<void()> releaseCurrent) {
+    makeCurrent();
+
+    std::vector<UploadTask*> batch;
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                break;
+            }
+            batch.swap(_queue);
+        }
+
+        for (UploadTask* task : batch) {
+            // The previous fence belongs to this context's share group, so it is safe to delete here
+            if (*task->fence) {
+                glDeleteSync(*task->fence);
+                *task->fence = nullptr;
+            }
+            (*task->commands)();
+            if (task->fenced) {
+                *task->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+        }
+
+        // One flush sends the whole batch, and guarantees the fences reach the GPU for the render thread to wait on
+        glFlush();
+        for (UploadTask* task : batch) {
+            task->done.set_value();
+        }
+        batch.clear();
+    }
+
+    releaseCurrent();
+}
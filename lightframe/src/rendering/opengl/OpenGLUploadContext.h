@@ -0,0 +1,142 @@
+/**
+ * @file OpenGLUploadContext.h
+ * @author Justin McKay
+ * @brief Background thread owning a second GL context, shared with the window's, for creating and filling buffers
+ * and textures off the render thread.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs GL commands issued by threads other than the render thread on a context of its own.
+ *
+ * The window creates a hidden context sharing objects with its own and hands it to start(). From then on, buffers
+ * and textures created or written on a loader thread submit their GL commands here instead of calling GL directly,
+ * which would fail on a thread with no context. Each submission is followed by a fence, which the object keeps until
+ * the render thread first uses it: isUploadComplete() polls the fence without blocking, and waitForUpload() makes the
+ * render context's command stream wait on it, so the data is never read before the upload has finished.
+ *
+ * Vertex arrays and framebuffers are not shared between contexts, so they must still be created on the render
+ * thread. Until start() is called, or if the window could not create a shared context, every thread is treated as
+ * the render thread and commands run where they are issued.
+ */
+class OpenGLUploadContext {
+public:
+
+    /**
+     * @brief Gets the upload context shared by the engine.
+     */
+    static OpenGLUploadContext* get();
+
+    ~OpenGLUploadContext();
+
+    /**
+     * @brief Starts the upload thread. The calling thread becomes the render thread.
+     * @param makeCurrent Makes the shared context current on the calling thread.
+     * @param releaseCurrent Detaches the shared context from the calling thread.
+     */
+    void start(std::function<void()> makeCurrent, std::function<void()> releaseCurrent);
+
+    /**
+     * @brief Finishes any queued commands and joins the upload thread. Must be called before the shared context is
+     * destroyed.
+     */
+    void shutdown();
+
+    /**
+     * @brief Checks whether the upload thread is running.
+     */
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Checks whether GL may be called directly on the calling thread.
+     */
+    bool isRenderThread() const { return !isRunning() || std::this_thread::get_id() == _renderThreadId; }
+
+    /**
+     * @brief Runs commands that create or write an object, on the render thread if called from it and otherwise on
+     * the upload thread, blocking until they have been issued and flushed.
+     *
+     * On the render thread, any upload still outstanding on the object is waited on first, so writes land in order.
+     *
+     * @param commands The GL commands.
+     * @param fence The object's upload fence, replaced with one that signals once the commands have completed.
+     */
+    void submit(const std::function<void()>& commands, GLsync& fence);
+
+    /**
+     * @brief Runs commands that delete an object, on whichever thread may call GL, and deletes its upload fence.
+     * @param commands The GL commands.
+     * @param fence The object's upload fence, deleted and cleared.
+     */
+    void release(const std::function<void()>& commands, GLsync& fence);
+
+    /**
+     * @brief Checks, without blocking, whether an object's upload has completed, deleting the fence if so. Must be
+     * called on the render thread.
+     * @param fence The object's upload fence, or null if it has none.
+     * @return true if there is no upload outstanding.
+     */
+    static bool isUploadComplete(GLsync& fence);
+
+    /**
+     * @brief Makes the render context wait on the GPU for an object's upload before using it. Must be called on the
+     * render thread; returns without stalling the CPU.
+     * @param fence The object's upload fence, or null if it has none.
+     */
+    static void waitForUpload(GLsync& fence) {
+        if (fence) {
+            waitForFence(fence);
+        }
+    }
+
+private:
+
+    /**
+     * @brief Commands queued for the upload thread, and the thread waiting on them.
+     */
+    struct UploadTask {
+        const std::function<void()>* commands;
+        GLsync* fence;
+        bool fenced;
+        std::promise<void> done;
+    };
+
+    /**
+     * @brief Queues commands for the upload thread and blocks until they have been issued and flushed.
+     */
+    void runOnUploadThread(const std::function<void()>& commands, GLsync& fence, bool fenced);
+
+    /**
+     * @brief Runs queued commands until shutdown, flushing once per batch.
+     */
+    void threadMain(std::function<void()> makeCurrent, std::function<void()> releaseCurrent);
+
+    static void waitForFence(GLsync& fence);
+
+    // Thread that owns the shared context
+    std::thread _thread;
+
+    // Thread that owns the window's context, which may call GL directly
+    std::thread::id _renderThreadId;
+
+    // Whether the upload thread is accepting commands
+    std::atomic<bool> _running = false;
+
+    // Guards the queue and the stop flag
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<UploadTask*> _queue;
+    bool _stopping = false;
+};
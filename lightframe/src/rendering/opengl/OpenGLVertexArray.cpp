@@ -1,5 +1,8 @@
 #include "OpenGLVertexArray.h"
 
+#include "OpenGLDeletionQueue.h"
+#include "OpenGLUploadContext.h"
+
 #include "debug/Assertions.h"
 #include "rendering/Buffer.h"
 
@@ -21,21 +24,27 @@ static GLenum shaderDataTypeToGlType(ShaderDataType dataType) {
             return GL_INT;
         case ShaderDataType::Bool:
             return GL_BOOL;
+        case ShaderDataType::Half2:
+        case ShaderDataType::Half4:
+            return GL_HALF_FLOAT;
+        case ShaderDataType::Short4:
+            return GL_SHORT;
+        case ShaderDataType::UByte4:
+            return GL_UNSIGNED_BYTE;
     }
     
     return 0;
 }
 
 OpenGLVertexArray::OpenGLVertexArray() {
+    LF_ASSERT_MSG(OpenGLUploadContext::get()->isRenderThread(), "Vertex arrays aren't shared between contexts, so must be created on the render thread.");
     glGenVertexArrays(1, &_rendererId);
     glBindVertexArray(_rendererId);
 }
 
 OpenGLVertexArray::~OpenGLVertexArray() {
-    if (_rendererId >= 0) {
-        glDeleteVertexArrays(1, &_rendererId);
-        _rendererId = 0;
-    }
+    OpenGLDeletionQueue::get()->retire(GLObjectType::VertexArray, _rendererId);
+    _rendererId = 0;
 }
 
 void OpenGLVertexArray::addVertexBuffer(VertexBuffer* vertexBuffer) {
@@ -66,7 +75,12 @@ void OpenGLVertexArray::addVertexBuffer(VertexBuffer* vertexBuffer) {
             case ShaderDataType::Float2:
             case ShaderDataType::Float3:
             case ShaderDataType::Float4:
+            case ShaderDataType::Half2:
+            case ShaderDataType::Half4:
+            case ShaderDataType::Short4:
+            case ShaderDataType::UByte4:
             {
+                // Quantized types are converted to floats as they are fetched, normalised if requested
                 glEnableVertexAttribArray(_vertexBufferIndex);
                 glVertexAttribPointer(
                     _vertexBufferIndex,
@@ -1 +1,762 @@
-#include "ResourceManager.h"
\ No newline at end of file
+#include "ResourceManager.h"
+
+#include "assets/MeshImporter.h"
+#include "assets/TextureAtlas.h"
+#include "assets/VirtualFileSystem.h"
+#include "core/Hash.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "resources/ResourceManifest.h"
+#include "resources/ShaderHotReloader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Hashes the content of a file, never returning 0.
+ */
+static uint64_t hashContent(std::span<const uint8_t> content) {
+    const uint64_t hash = hash64(content.data(), content.size());
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * @brief Reads a file through the virtual file system and hashes its content.
+ * @param path The normalised path of the file.
+ * @return uint64_t The hash, or 0 if the file could not be read.
+ */
+static uint64_t hashFileContent(const std::string& path) {
+    AssetBlob blob;
+    return VirtualFileSystem::get()->read(path, blob) ? hashContent(blob.data) : 0;
+}
+
+/**
+ * @brief A resource in a dependency graph being loaded by ResourceManager::loadGraph().
+ */
+struct ResourceGraphNode {
+    std::string path;                   // Normalised path of the file
+    size_t typeIndex = 0;               // Index of the resource type
+    ResourceHandle handle = 0;          // The resource, once loaded or if it already was
+    uint64_t contentKey = 0;            // Content key of the file, once hashed
+    bool parsed = false;                // Whether the manifest of a material or prefab was read
+
+    // Material manifests: the manifest, its shader nodes in manifest order, and its diffuse map node
+    MaterialManifest material;
+    std::vector<size_t> shaderNodes;
+    std::optional<size_t> diffuseNode;
+    glm::vec4 diffuseUvTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+
+    // Prefab manifests: the manifest, and the mesh and material nodes of each part
+    PrefabManifest prefab;
+    std::vector<std::pair<size_t, size_t>> partNodes;
+
+    // Textures, shaders and meshes the resource depends on, directly or through its materials
+    std::vector<ResourceHandle> textures;
+    std::vector<ResourceHandle> shaders;
+    std::vector<ResourceHandle> meshes;
+};
+
+/**
+ * @brief A material or prefab graph read by ResourceManager::readGraph(), with reads started for the files it loads.
+ */
+struct ResourceGraph {
+    std::vector<ResourceGraphNode> nodes;                       // Every file in the graph, the root manifest first
+    std::vector<size_t> leaves;                                 // Nodes of the textures, shaders and meshes not loaded
+    std::vector<std::future<std::optional<AssetBlob>>> reads;   // Contents of each leaf, in the order of leaves
+};
+
+ResourceManager::ResourceManager() = default;
+
+ResourceManager::~ResourceManager() {
+    for (const std::shared_future<std::shared_ptr<ResourceGraph>>& graphRead : _graphReads) {
+        graphRead.wait();
+    }
+}
+
+bool ResourceManager::mountArchive(const std::string& archivePath, const std::string& mountPoint) {
+    return VirtualFileSystem::get()->mountArchive(archivePath, mountPoint);
+}
+
+bool ResourceManager::mountDirectory(const std::string& directory, const std::string& mountPoint) {
+    return VirtualFileSystem::get()->mountDirectory(directory, mountPoint);
+}
+
+bool ResourceManager::loadAtlasTable(const std::string& tablePath) {
+    TextureAtlasTable table;
+    if (!readAtlasTable(tablePath, table)) {
+        LOG_WARN("Unable to load atlas table {}.", tablePath);
+        return false;
+    }
+
+    const std::filesystem::path tableDirectory = std::filesystem::path(tablePath).parent_path();
+    auto atlasLocations = std::make_shared<AtlasLocationMap>(*_atlasLocations);
+    for (const AtlasRegion& region : table.regions) {
+        const std::filesystem::path atlasPath = table.atlasPaths[region.atlasIndex];
+        (*atlasLocations)[region.name] = AtlasLocation {
+            .atlasPath = (atlasPath.is_absolute() ? atlasPath : tableDirectory / atlasPath).generic_string(),
+            .uvTransform = region.uvTransform
+        };
+    }
+    _atlasLocations = std::move(atlasLocations);
+
+    LOG_INFO("Loaded atlas table {} with {} textures in {} atlases.", tablePath, table.regions.size(), table.atlasPaths.size());
+    return true;
+}
+
+TextureRegion ResourceManager::loadTextureRegion(const std::string& filePath, const std::string& resourceName) {
+    auto it = _atlasLocations->find(filePath);
+    if (it == _atlasLocations->end()) {
+        return TextureRegion { .texture = acquire<Texture2D>(load<Texture2D>(filePath, resourceName)) };
+    }
+
+    // The atlas is loaded once, by whichever of its textures is requested first, and again if it has been unloaded
+    auto [atlasIt, inserted] = _atlasTextures.try_emplace(it->second.atlasPath, 0);
+    if (inserted || !_textures.contains(atlasIt->second)) {
+        atlasIt->second = load<Texture2D>(it->second.atlasPath, it->second.atlasPath);
+    }
+    return TextureRegion { .texture = acquire<Texture2D>(atlasIt->second), .uvTransform = it->second.uvTransform };
+}
+
+Shader& ResourceManager::getShaderVariant(ShaderHandle handle, ShaderFeatureMask features) {
+    if (features == 0) {
+        return get<Shader>(handle);
+    }
+
+    // Drawing a permutation counts as using the base shader
+    _shaders.touch(handle);
+    Shader* variant = _shaderVariants.getVariant(handle, features);
+    LF_ASSERT_MSG(variant, std::format("No shader variant {:#x} available for handle {}.", features, handle));
+    return *variant;
+}
+
+void ResourceManager::prewarmShaderVariants(ShaderHandle handle, const std::vector<ShaderFeatureMask>& permutations) {
+    _shaderVariants.prewarm(handle, permutations);
+}
+
+std::vector<ShaderFeatureMask> ResourceManager::getShaderVariantFeatures(ShaderHandle handle) const {
+    std::vector<ShaderFeatureMask> features = { 0 };
+    std::vector<ShaderFeatureMask> variantFeatures = _shaderVariants.getVariantFeatures(handle);
+    features.insert(features.end(), variantFeatures.begin(), variantFeatures.end());
+    return features;
+}
+
+void ResourceManager::replaceShader(ShaderHandle handle, ShaderFeatureMask features, std::unique_ptr<Shader> shader) {
+    if (features == 0) {
+        const bool replaced = _shaders.replace(handle, std::move(shader));
+        LF_ASSERT_MSG(replaced, std::format("No shader found for handle {:#x}; it is invalid or has been unloaded.", handle));
+    } else {
+        _shaderVariants.replaceVariant(handle, features, std::move(shader));
+    }
+}
+
+void ResourceManager::setShaderHotReloadEnabled(bool enabled) {
+    if (!enabled) {
+        _shaderHotReloader.reset();
+        return;
+    }
+
+    if (!_shaderHotReloader) {
+        _shaderHotReloader = std::make_unique<ShaderHotReloader>(*this);
+        for (const auto& [handle, shaderPath] : _shaderVariants.getShaderPaths()) {
+            _shaderHotReloader->watchShader(handle, shaderPath);
+        }
+    }
+}
+
+void ResourceManager::update() {
+    // Resources unloaded or replaced during the last frame may still have been in use by workers until now
+    _textures.reclaim();
+    _shaders.reclaim();
+    _meshes.reclaim();
+    _materials.reclaim();
+    _prefabs.reclaim();
+
+    updatePendingLoads();
+    updateMemoryBudgets();
+
+    std::erase_if(_graphReads, [](const std::shared_future<std::shared_ptr<ResourceGraph>>& graphRead) {
+        return graphRead.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+
+    if (_shaderHotReloader) {
+        _shaderHotReloader->update();
+    }
+}
+
+ResourceManager::PendingLoad* ResourceManager::findPendingLoad(uint64_t key) {
+    if (!_pendingLoadKeys.contains(key)) {
+        return nullptr;
+    }
+
+    auto it = std::find_if(_pendingLoads.begin(), _pendingLoads.end(),
+        [key](const PendingLoad& pendingLoad) { return pendingLoad.key == key; });
+    return it != _pendingLoads.end() ? &*it : nullptr;
+}
+
+void ResourceManager::addPendingLoad(PendingLoad pendingLoad) {
+    pendingLoad.future = pendingLoad.promise.get_future().share();
+    _pendingLoadKeys.insert(pendingLoad.key);
+    _pendingLoads.push_back(std::move(pendingLoad));
+}
+
+void ResourceManager::updatePendingLoads() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now() +
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(_loadBudgetMs));
+
+    // Completed loads are taken out before any callback runs, as callbacks may start further loads. Polls may start
+    // them too, as graphs do, so the queue is walked by index and only grows while a poll runs.
+    std::vector<std::pair<PendingLoad, bool>> completed;
+    for (size_t i = 0; i < _pendingLoads.size() && Clock::now() < deadline;) {
+        const ResourceState state = _pendingLoads[i].poll();
+        if (state == ResourceState::Loading) {
+            ++i;
+            continue;
+        }
+
+        _pendingLoadKeys.erase(_pendingLoads[i].key);
+        completed.emplace_back(std::move(_pendingLoads[i]), state == ResourceState::Ready);
+        _pendingLoads.erase(_pendingLoads.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    for (auto& [pendingLoad, loaded] : completed) {
+        pendingLoad.promise.set_value(loaded);
+        for (ResourceLoadCallback& callback : pendingLoad.callbacks) {
+            callback(pendingLoad.handle, loaded);
+        }
+    }
+}
+
+void ResourceManager::updateMemoryBudgets() {
+    _textures.advanceClock();
+    _shaders.advanceClock();
+    _meshes.advanceClock();
+    _materials.advanceClock();
+    _prefabs.advanceClock();
+
+    // Prefabs and materials go first, as destroying them releases the resources they hold. That happens when they
+    // are reclaimed by the next update(), so what they held can be unloaded from the frame after.
+    enforceMemoryBudget<Prefab>();
+    enforceMemoryBudget<Material>();
+    enforceMemoryBudget<Mesh>();
+    enforceMemoryBudget<Texture2D>();
+    enforceMemoryBudget<Shader>();
+}
+
+std::string ResourceManager::normaliseResourcePath(const std::string& filePath) {
+    return std::filesystem::absolute(filePath).lexically_normal().generic_string();
+}
+
+uint64_t ResourceManager::hashResourceContent(size_t typeIndex, const std::string& path) {
+    AssetBlob blob;
+    return VirtualFileSystem::get()->read(path, blob) ? hashResourceContent(typeIndex, path, blob.data) : 0;
+}
+
+uint64_t ResourceManager::hashResourceContent(size_t typeIndex, const std::string& path, std::span<const uint8_t> content) {
+    uint64_t key = hashContent(content);
+    if (typeIndex == getTypeIndex<Shader>()) {
+        // Includes resolve against the shader's directory, so identical sources elsewhere may include other files
+        if (std::string_view(reinterpret_cast<const char*>(content.data()), content.size()).find("#include") != std::string_view::npos) {
+            key = hashCombine(key, hash64(std::filesystem::path(path).parent_path().generic_string()));
+        }
+    } else if (typeIndex == getTypeIndex<Material>() || typeIndex == getTypeIndex<Prefab>()) {
+        // Manifests name files relative to their directory, so identical manifests elsewhere name other files
+        key = hashCombine(key, hash64(std::filesystem::path(path).parent_path().generic_string()));
+    } else if (typeIndex == getTypeIndex<Mesh>()) {
+        // External glTF buffers are part of the mesh, so meshes only match if their buffers do too
+        for (const std::string& dependency : getMeshImportDependencies(path)) {
+            const uint64_t dependencyKey = hashFileContent(normaliseResourcePath(dependency));
+            if (dependencyKey == 0) {
+                return 0;
+            }
+            key = hashCombine(key, dependencyKey);
+        }
+    }
+    return key;
+}
+
+ResourceHandle ResourceManager::findLoadedPath(size_t typeIndex, const std::string& path) {
+    std::shared_lock lock(_registryMutex);
+    const DeduplicationTable& table = _deduplication[typeIndex];
+    auto it = table.paths.find(path);
+    if (it == table.paths.end()) {
+        return 0;
+    }
+
+    bool loaded = false;
+    switch (typeIndex) {
+        case getTypeIndex<Texture2D>(): loaded = _textures.contains(it->second); break;
+        case getTypeIndex<Shader>():    loaded = _shaders.contains(it->second); break;
+        case getTypeIndex<Mesh>():      loaded = _meshes.contains(it->second); break;
+        case getTypeIndex<Material>():  loaded = _materials.contains(it->second); break;
+        case getTypeIndex<Prefab>():    loaded = _prefabs.contains(it->second); break;
+    }
+    return loaded ? it->second : 0;
+}
+
+std::function<ResourceState()> ResourceManager::startMeshLoad(ResourceHandle handle, const std::string& filePath,
+    std::optional<AssetBlob> content) {
+    /**
+     * @brief Geometry read by a worker, already in GPU buffers if they could be uploaded from the worker.
+     */
+    struct LoadedMesh {
+        MeshData data;
+        std::unique_ptr<VertexBuffer> vertexBuffer;
+        std::unique_ptr<IndexBuffer> indexBuffer;
+    };
+
+    const bool uploadOnWorker = Renderer::hasUploadThread();
+    auto geometry = std::make_shared<std::shared_future<std::shared_ptr<LoadedMesh>>>(ThreadPool::get()->submit(
+        [filePath, content = std::move(content), uploadOnWorker]() -> std::shared_ptr<LoadedMesh> {
+            auto mesh = std::make_shared<LoadedMesh>();
+            const bool read = content ? Mesh::readData(filePath, *content, mesh->data) : Mesh::readData(filePath, mesh->data);
+            if (!read) {
+                LOG_WARN("Failed to load mesh: {}", filePath);
+                return nullptr;
+            }
+            if (uploadOnWorker) {
+                // Uploaded through the shared context, so the render thread only has to create the vertex array
+                const MeshData& data = mesh->data;
+                mesh->vertexBuffer = VertexBuffer::create(data.vertices.data(), static_cast<uint32_t>(data.vertices.size()));
+                mesh->vertexBuffer->setLayout(data.layout);
+                mesh->indexBuffer = IndexBuffer::create(data.indices.data(), static_cast<uint32_t>(data.indices.size()));
+                mesh->data.vertices = {};
+                mesh->data.indices = {};
+            }
+            return mesh;
+        }).share());
+
+    return [this, handle, geometry]() {
+        if (geometry->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return ResourceState::Loading;
+        }
+
+        // The mesh may have been unloaded while its geometry was read
+        const std::shared_ptr<LoadedMesh>& mesh = geometry->get();
+        if (!mesh || !_meshes.contains(handle)) {
+            return ResourceState::Failed;
+        }
+        if (!mesh->vertexBuffer) {
+            _meshes.replace(handle, Mesh::create(mesh->data));
+            return ResourceState::Ready;
+        }
+
+        // Swapped in only once the upload thread's fences have signalled, so drawing it never waits on the GPU
+        if (!mesh->vertexBuffer->isUploadComplete() || !mesh->indexBuffer->isUploadComplete()) {
+            return ResourceState::Loading;
+        }
+        _meshes.replace(handle, Mesh::create(std::move(mesh->vertexBuffer), std::move(mesh->indexBuffer), mesh->data.bounds));
+        return ResourceState::Ready;
+    };
+}
+
+ResourceHandle ResourceManager::loadGraph(const std::string& filePath, const std::string& resourceName, size_t typeIndex,
+    bool async) {
+
+    ResourceSource rootSource;
+    const ResourceHandle duplicate = typeIndex == getTypeIndex<Material>()
+        ? findDuplicate<Material>(filePath, resourceName, rootSource, !async)
+        : findDuplicate<Prefab>(filePath, resourceName, rootSource, !async);
+    if (duplicate) {
+        return duplicate;
+    }
+
+    if (!async) {
+        std::shared_ptr<ResourceGraph> graph = readGraph(filePath, typeIndex, rootSource.contentKey, _atlasLocations);
+        if (!graph->nodes.front().parsed) {
+            return 0;
+        }
+
+        // Waited for here rather than on the workers, as the reads may themselves be running on the thread pool
+        std::vector<std::optional<AssetBlob>> contents;
+        contents.reserve(graph->reads.size());
+        for (std::future<std::optional<AssetBlob>>& read : graph->reads) {
+            contents.push_back(read.get());
+        }
+
+        ThreadPool::get()->parallelFor(graph->leaves.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ResourceGraphNode& node = graph->nodes[graph->leaves[i]];
+                node.contentKey = contents[i] ? hashResourceContent(node.typeIndex, node.path, contents[i]->data) : 0;
+            }
+        });
+
+        // Loaded from the contents already read, rather than reading each file again
+        for (size_t i = 0; i < graph->leaves.size(); ++i) {
+            loadGraphLeaf(graph->nodes[graph->leaves[i]], false, contents[i] ? &*contents[i] : nullptr);
+        }
+        return buildGraph(*graph, resourceName, 0, false);
+    }
+
+    // The root stands empty until the graph has been read and built, so its handle can be returned straight away
+    ResourceHandle handle;
+    if (typeIndex == getTypeIndex<Material>()) {
+        handle = addResource(std::make_unique<Material>(), resourceName);
+        registerSource<Material>(handle, std::move(rootSource));
+    } else {
+        handle = addResource(std::make_unique<Prefab>(), resourceName);
+        registerSource<Prefab>(handle, std::move(rootSource));
+    }
+
+    /**
+     * @brief An asynchronous graph load, advanced by each poll of its pending load.
+     */
+    struct GraphLoad {
+        std::shared_future<std::shared_ptr<ResourceGraph>> read;    // The graph, once its manifests have been read
+        std::shared_ptr<ResourceGraph> graph;                       // The graph, once the read has completed
+        std::vector<std::optional<AssetBlob>> contents;             // Contents of each leaf, from its read until it loads
+        std::vector<std::future<uint64_t>> hashes;                  // Content key of each leaf, once it has been read
+        std::function<ResourceState()> dependencies;                // Polls the root's dependencies, once it is built
+    };
+
+    auto load = std::make_shared<GraphLoad>();
+    load->read = ThreadPool::get()->submit(
+        [this, filePath, typeIndex, atlasLocations = _atlasLocations]() {
+            return readGraph(filePath, typeIndex, 0, atlasLocations);
+        }).share();
+    _graphReads.push_back(load->read);
+
+    PendingLoad pendingLoad;
+    pendingLoad.key = typeIndex == getTypeIndex<Material>() ? getLoadKey<Material>(handle) : getLoadKey<Prefab>(handle);
+    pendingLoad.handle = handle;
+    pendingLoad.poll = [this, handle, typeIndex, resourceName, load]() {
+        using namespace std::chrono_literals;
+        if (load->dependencies) {
+            return load->dependencies();
+        }
+
+        if (!load->graph) {
+            if (load->read.wait_for(0s) != std::future_status::ready) {
+                return ResourceState::Loading;
+            }
+            load->graph = load->read.get();
+            if (!load->graph->nodes.front().parsed) {
+                return ResourceState::Failed;
+            }
+            load->contents.resize(load->graph->leaves.size());
+            load->hashes.resize(load->graph->leaves.size());
+        }
+
+        // Each leaf is hashed on a worker as soon as it has been read, and its load started once it has been hashed
+        ResourceGraph& graph = *load->graph;
+        bool leavesPending = false;
+        for (size_t i = 0; i < graph.leaves.size(); ++i) {
+            ResourceGraphNode& node = graph.nodes[graph.leaves[i]];
+            if (node.handle != 0) {
+                continue;
+            }
+
+            if (!load->hashes[i].valid()) {
+                if (graph.reads[i].wait_for(0s) != std::future_status::ready) {
+                    leavesPending = true;
+                    continue;
+                }
+                load->contents[i] = graph.reads[i].get();
+                load->hashes[i] = ThreadPool::get()->submit(
+                    [nodeType = node.typeIndex, path = node.path, content = load->contents[i]]() -> uint64_t {
+                        return content ? hashResourceContent(nodeType, path, content->data) : 0;
+                    });
+            }
+            if (load->hashes[i].wait_for(0s) != std::future_status::ready) {
+                leavesPending = true;
+                continue;
+            }
+
+            // The leaf is loaded from the contents already read, which are dropped once its load has them
+            node.contentKey = load->hashes[i].get();
+            loadGraphLeaf(node, true, load->contents[i] ? &*load->contents[i] : nullptr);
+            load->contents[i].reset();
+        }
+        if (leavesPending) {
+            return ResourceState::Loading;
+        }
+
+        // The root may have been unloaded while its graph was read
+        const bool rootLoaded = typeIndex == getTypeIndex<Material>() ? _materials.contains(handle) : _prefabs.contains(handle);
+        if (!rootLoaded) {
+            return ResourceState::Failed;
+        }
+        buildGraph(graph, resourceName, handle, true);
+        load->dependencies = pollGraphDependencies(graph.nodes.front());
+        return load->dependencies();
+    };
+    addPendingLoad(std::move(pendingLoad));
+    return handle;
+}
+
+std::shared_ptr<ResourceGraph> ResourceManager::readGraph(const std::string& filePath, size_t typeIndex, uint64_t contentKey,
+    std::shared_ptr<const AtlasLocationMap> atlasLocations) {
+
+    auto graph = std::make_shared<ResourceGraph>();
+    std::vector<ResourceGraphNode>& nodes = graph->nodes;
+    std::array<std::unordered_map<std::string, size_t>, RESOURCE_TYPE_COUNT> nodeIndices;
+    std::vector<size_t> frontier;
+
+    // Adds each file to the graph once. Manifests not already loaded are queued to be read.
+    auto addNode = [&](size_t nodeType, const std::string& path) {
+        std::string normalised = normaliseResourcePath(path);
+        auto [it, inserted] = nodeIndices[nodeType].try_emplace(normalised, nodes.size());
+        if (!inserted) {
+            return it->second;
+        }
+
+        ResourceGraphNode& node = nodes.emplace_back();
+        node.path = std::move(normalised);
+        node.typeIndex = nodeType;
+        const bool manifest = nodeType == getTypeIndex<Material>() || nodeType == getTypeIndex<Prefab>();
+        if (manifest && !findLoadedPath(nodeType, node.path)) {
+            frontier.push_back(it->second);
+        }
+        return it->second;
+    };
+
+    // The root is always read, even when an asynchronous load has already registered it under its path
+    addNode(typeIndex, filePath);
+    nodes[0].contentKey = contentKey;
+    frontier.assign(1, 0);
+
+    // Manifests are read a level of the graph at a time, every manifest of a level in parallel
+    while (!frontier.empty()) {
+        const std::vector<size_t> level = std::move(frontier);
+        frontier.clear();
+
+        ThreadPool::get()->parallelFor(level.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ResourceGraphNode& node = nodes[level[i]];
+                node.parsed = node.typeIndex == getTypeIndex<Material>()
+                    ? readMaterialManifest(node.path, node.material)
+                    : readPrefabManifest(node.path, node.prefab);
+                if (node.contentKey == 0) {
+                    node.contentKey = hashResourceContent(node.typeIndex, node.path);
+                }
+            }
+        });
+
+        for (size_t index : level) {
+            if (!nodes[index].parsed) {
+                LOG_WARN("Unable to read manifest {}.", nodes[index].path);
+                if (index == 0) {
+                    return graph;
+                }
+                continue;
+            }
+
+            if (nodes[index].typeIndex == getTypeIndex<Material>()) {
+                const MaterialManifest manifest = nodes[index].material;
+                for (const auto& [renderPass, shaderPath] : manifest.shaders) {
+                    const size_t shaderNode = addNode(getTypeIndex<Shader>(), shaderPath);
+                    nodes[index].shaderNodes.push_back(shaderNode);
+                }
+
+                if (!manifest.diffuseMap.empty()) {
+                    // Textures packed into an atlas are drawn from the atlas
+                    auto atlasIt = atlasLocations->find(manifest.diffuseMap);
+                    const bool atlased = atlasIt != atlasLocations->end();
+                    const size_t diffuseNode = addNode(getTypeIndex<Texture2D>(), atlased ? atlasIt->second.atlasPath : manifest.diffuseMap);
+                    nodes[index].diffuseNode = diffuseNode;
+                    if (atlased) {
+                        nodes[index].diffuseUvTransform = atlasIt->second.uvTransform;
+                    }
+                }
+            } else {
+                const PrefabManifest manifest = nodes[index].prefab;
+                for (const PrefabPartManifest& part : manifest.parts) {
+                    const size_t meshNode = addNode(getTypeIndex<Mesh>(), part.mesh);
+                    const size_t materialNode = addNode(getTypeIndex<Material>(), part.material);
+                    nodes[index].partNodes.emplace_back(meshNode, materialNode);
+                }
+            }
+        }
+    }
+
+    // Every file the graph reads is requested up front, so loose files are submitted to the disk as one batch and
+    // archived ones are paged in with a few large reads
+    VirtualFileSystem* fileSystem = VirtualFileSystem::get();
+    std::vector<std::string> leafPaths;
+    for (size_t index = 0; index < nodes.size(); ++index) {
+        const size_t nodeType = nodes[index].typeIndex;
+        if (nodeType != getTypeIndex<Material>() && nodeType != getTypeIndex<Prefab>() && !findLoadedPath(nodeType, nodes[index].path)) {
+            graph->leaves.push_back(index);
+            leafPaths.push_back(nodes[index].path);
+        }
+    }
+    fileSystem->prefetch(leafPaths);
+
+    graph->reads.reserve(leafPaths.size());
+    for (const std::string& leafPath : leafPaths) {
+        graph->reads.push_back(fileSystem->readAsync(leafPath));
+    }
+    return graph;
+}
+
+void ResourceManager::loadGraphLeaf(ResourceGraphNode& node, bool async, const AssetBlob* content) {
+    const ResourceSource source { .path = std::string(), .contentKey = node.contentKey };
+    if (node.typeIndex == getTypeIndex<Texture2D>()) {
+        node.handle = loadFile<Texture2D>(node.path, node.path, source, async, content);
+    } else if (node.typeIndex == getTypeIndex<Shader>()) {
+        node.handle = loadFile<Shader>(node.path, node.path, source, async, content);
+    } else if (node.typeIndex == getTypeIndex<Mesh>()) {
+        node.handle = loadFile<Mesh>(node.path, node.path, source, async, content);
+    }
+}
+
+ResourceHandle ResourceManager::buildGraph(ResourceGraph& graph, const std::string& resourceName, ResourceHandle rootHandle,
+    bool async) {
+
+    // Files already loaded when the graph was read are shared now, as are any unloaded since
+    std::vector<ResourceGraphNode>& nodes = graph.nodes;
+    for (ResourceGraphNode& node : nodes) {
+        const bool manifest = node.typeIndex == getTypeIndex<Material>() || node.typeIndex == getTypeIndex<Prefab>();
+        if (!manifest && node.handle == 0) {
+            loadGraphLeaf(node, async, nullptr);
+        }
+    }
+
+    // Adds a pending load that completes once everything a material or prefab depends on has loaded
+    auto addDependencyLoad = [this](uint64_t key, const ResourceGraphNode& node) {
+        PendingLoad pendingLoad;
+        pendingLoad.key = key;
+        pendingLoad.handle = node.handle;
+        pendingLoad.poll = pollGraphDependencies(node);
+        addPendingLoad(std::move(pendingLoad));
+    };
+
+    // Materials are built before the prefabs that use them
+    for (ResourceGraphNode& node : nodes) {
+        if (node.typeIndex != getTypeIndex<Material>()) {
+            continue;
+        }
+
+        const bool root = &node == &nodes.front();
+        const std::string& name = root ? resourceName : node.path;
+        ResourceSource source { .path = node.path, .contentKey = node.contentKey };
+        if (!(root && rootHandle) && (node.handle = findDuplicate<Material>(node.path, name, source, !async))) {
+            // A shared material was built by an earlier load, so what it depends on is read back from it
+            if (const Material* material = _materials.get(node.handle)) {
+                if (const TextureHandle texture = material->getDiffuseMap()) {
+                    node.textures.push_back(texture);
+                }
+                node.shaders = material->getShaders();
+            }
+            continue;
+        }
+
+        auto material = std::make_unique<Material>();
+        for (size_t i = 0; i < node.shaderNodes.size(); ++i) {
+            const ResourceHandle shader = nodes[node.shaderNodes[i]].handle;
+            material->addShader(node.material.shaders[i].first, acquire<Shader>(shader));
+            node.shaders.push_back(shader);
+        }
+        if (node.diffuseNode) {
+            const ResourceHandle texture = nodes[*node.diffuseNode].handle;
+            material->setDiffuseMap(acquire<Texture2D>(texture), node.diffuseUvTransform);
+            node.textures.push_back(texture);
+        }
+        material->setShaderFeatures(node.material.features);
+
+        if (root && rootHandle) {
+            node.handle = rootHandle;
+            _materials.replace(rootHandle, std::move(material));
+        } else {
+            node.handle = addResource(std::move(material), name);
+        }
+        registerSource<Material>(node.handle, std::move(source));
+        if (async && !root) {
+            addDependencyLoad(getLoadKey<Material>(node.handle), node);
+        }
+    }
+
+    for (ResourceGraphNode& node : nodes) {
+        if (node.typeIndex != getTypeIndex<Prefab>()) {
+            continue;
+        }
+
+        const bool root = &node == &nodes.front();
+        const std::string& name = root ? resourceName : node.path;
+        ResourceSource source { .path = node.path, .contentKey = node.contentKey };
+        if (!(root && rootHandle) && (node.handle = findDuplicate<Prefab>(node.path, name, source, !async))) {
+            continue;
+        }
+
+        auto prefab = std::make_unique<Prefab>();
+        for (size_t i = 0; i < node.partNodes.size(); ++i) {
+            const auto [meshNode, materialNode] = node.partNodes[i];
+            const PrefabPartManifest& part = node.prefab.parts[i];
+            prefab->addPart(PrefabPart {
+                .mesh = acquire<Mesh>(nodes[meshNode].handle),
+                .material = acquire<Material>(nodes[materialNode].handle),
+                .transform = Transform3D { .position = part.position, .rotation = part.rotation, .scale = part.scale }
+            });
+
+            node.meshes.push_back(nodes[meshNode].handle);
+            const ResourceGraphNode& material = nodes[materialNode];
+            node.textures.insert(node.textures.end(), material.textures.begin(), material.textures.end());
+            node.shaders.insert(node.shaders.end(), material.shaders.begin(), material.shaders.end());
+        }
+
+        if (root && rootHandle) {
+            node.handle = rootHandle;
+            _prefabs.replace(rootHandle, std::move(prefab));
+        } else {
+            node.handle = addResource(std::move(prefab), name);
+        }
+        registerSource<Prefab>(node.handle, std::move(source));
+        if (async && !root) {
+            addDependencyLoad(getLoadKey<Prefab>(node.handle), node);
+        }
+    }
+
+    LOG_DEBUG("Loaded {} with {} dependencies.", nodes.front().path, nodes.size() - 1);
+    return nodes.front().handle;
+}
+
+std::function<ResourceState()> ResourceManager::pollGraphDependencies(const ResourceGraphNode& node) {
+    return [this, parsed = node.parsed, textures = node.textures, shaders = node.shaders, meshes = node.meshes]() {
+        bool loading = false;
+        bool failed = !parsed;
+        auto combine = [&loading, &failed](ResourceState state) {
+            loading |= state == ResourceState::Loading;
+            failed |= state == ResourceState::Failed;
+        };
+        for (ResourceHandle texture : textures) {
+            combine(getState<Texture2D>(texture));
+        }
+        for (ResourceHandle shader : shaders) {
+            combine(getState<Shader>(shader));
+        }
+        for (ResourceHandle mesh : meshes) {
+            combine(getState<Mesh>(mesh));
+        }
+
+        if (loading) {
+            return ResourceState::Loading;
+        }
+        return failed ? ResourceState::Failed : ResourceState::Ready;
+    };
+}
+
+void ResourceManager::unregisterSource(size_t typeIndex, ResourceHandle handle) {
+    DeduplicationTable& table = _deduplication[typeIndex];
+    std::erase_if(table.paths, [handle](const auto& entry) { return entry.second == handle; });
+    std::erase_if(table.contents, [handle](const auto& entry) { return entry.second == handle; });
+    table.duplicates.erase(handle);
+}
+
+void ResourceManager::registerShader(ShaderHandle handle, const std::string& filePath) {
+    _shaderVariants.registerShader(handle, filePath);
+    if (_shaderHotReloader) {
+        _shaderHotReloader->watchShader(handle, filePath);
+    }
+}
+
+
+void ResourceManager::unregisterShader(ShaderHandle handle) {
+    _shaderVariants.unregisterShader(handle);
+    if (_shaderHotReloader) {
+        _shaderHotReloader->unwatchShader(handle);
+    }
+}
\ No newline at end of file
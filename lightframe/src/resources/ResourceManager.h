@@ -7,65 +7,1005 @@
 
 #pragma once
 
+#include "assets/AssetArchive.h"
 #include "debug/Assertions.h"
 
 // Resource types
 #include "rendering/Material.h"
 #include "rendering/Mesh.h"
 #include "rendering/Shader.h"
+#include "rendering/ShaderVariantCache.h"
 #include "rendering/Texture.h"
+#include "resources/ResourcePool.h"
+#include "resources/ResourceRef.h"
+#include "scenes/Prefab.h"
 
-#include <variant>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
-using ResourceVariant = std::variant<
-    std::unique_ptr<Texture2D>,
-    std::unique_ptr<Shader>,
-    std::unique_ptr<Mesh>,
-    std::unique_ptr<Material>
->;
+class ShaderHotReloader;
+struct ResourceGraph;
+struct ResourceGraphNode;
 
-using ResourceHandle = uint32_t;
+/**
+ * @brief Loading state of a resource.
+ */
+enum class ResourceState {
+    Loading = 0,    ///< Still being read, decoded or created; a placeholder is used in its place
+    Ready,          ///< Fully loaded and usable
+    Failed          ///< Could not be loaded, or was unloaded before it finished; the placeholder is kept
+};
+
+/**
+ * @brief Called on the render thread when an asynchronous load completes.
+ * Receives the handle of the resource and whether it loaded successfully.
+ */
+using ResourceLoadCallback = std::function<void(ResourceHandle handle, bool loaded)>;
+
+/**
+ * @brief Memory held by resources, split by where it lives.
+ */
+struct ResourceMemoryUsage {
+    size_t cpuBytes = 0;    ///< System memory
+    size_t gpuBytes = 0;    ///< Video memory
+};
+
+/**
+ * @brief How often loads of one resource type resolved to a resource that was already loaded.
+ */
+struct ResourceDeduplicationStats {
+    size_t pathHits = 0;        ///< Loads of a path that was already loaded
+    size_t contentHits = 0;     ///< Loads of a different path holding byte-identical content
+    size_t bytesSaved = 0;      ///< Memory the duplicates would hold had they been loaded separately
+};
+
+/**
+ * @brief Memory limits for the resources of one type. Both are unlimited by default.
+ */
+struct ResourceMemoryBudget {
+    size_t cpuBytes = std::numeric_limits<size_t>::max();  ///< Most system memory the resources may hold
+    size_t gpuBytes = std::numeric_limits<size_t>::max();  ///< Most video memory the resources may hold
+};
 
+/**
+ * @brief Loads, owns and shares the resources a game uses, addressed by generational handles.
+ *
+ * Resolving handles is wait-free and safe from any thread, so extraction, culling and streaming workers can look
+ * resources up while others are added or unloaded: get(), acquire(), isValid() and getRefCount() take no global
+ * lock. find() takes the name registry's lock shared, so it only waits while resources are being added or unloaded.
+ * add() and unload() are safe from loader threads too, except that shaders must be unloaded on the render thread,
+ * as their variants are. Unloaded and replaced resources are destroyed by the next update(), so a reference returned
+ * by get() stays valid for the rest of the frame even if the resource is unloaded meanwhile.
+ *
+ * Loading, update() and shader variants belong to the render thread.
+ */
 class ResourceManager {
 public:
+    ResourceManager();
+    ~ResourceManager();
 
 
+    /**
+     * @brief Loads a resource from a file, blocking until it is read.
+     *
+     * If the file is already loaded, under this path or another path to byte-identical content, the handle of the
+     * loaded resource is returned instead and the resource is shared. It stays loaded until every load sharing it has
+     * been unloaded.
+     *
+     * Materials (.lfmat) and prefabs (.lfprefab) are loaded from manifests along with everything they depend on, as
+     * described by loadAsync().
+     *
+     * @tparam T The resource type to load.
+     * @param filePath The path of the file to load the resource from.
+     * @param resourceName The name to register the resource under.
+     * @return ResourceHandle The handle of the resource, or 0 if the manifest of a material or prefab could not be
+     * read.
+     */
     template<typename T>
     ResourceHandle load(const std::string& filePath, const std::string& resourceName) {
+        if constexpr (std::is_same_v<T, Material> || std::is_same_v<T, Prefab>) {
+            return loadGraph(filePath, resourceName, getTypeIndex<T>(), false);
+        } else {
+            return loadFile<T>(filePath, resourceName, ResourceSource(), false);
+        }
+    }
+
+    /**
+     * @brief Loads a resource without blocking the calling thread.
+     *
+     * The handle is valid immediately. File reads and decoding run on worker threads, and the GPU object is created
+     * on the render thread during update(). Until then the engine defaults stand in: textures bind a placeholder,
+     * the renderer substitutes a fallback for shaders that are not ready, and meshes are empty. Poll getState(), or
+     * register a callback with onLoaded(), to learn when the resource is ready.
+     *
+     * Files already loaded, or loading, under the same path are shared as with load(). Finding byte-identical content
+     * under another path means reading the whole file, so it is only done for the files of a material or prefab,
+     * which are hashed on a worker; a texture, shader or mesh loaded on its own is never read on the calling thread.
+     *
+     * Materials and prefabs are loaded from manifests. A worker reads their manifests, and those they name, a level
+     * of the dependency graph at a time, then starts reading every texture, shader and mesh in the graph, with reads
+     * from the same archive merged. Each file is hashed on a worker as soon as it has been read, and update() starts
+     * its load. Once every load has started, update() builds the materials and prefabs of the graph; until then the
+     * root is an empty material or prefab. A material or prefab is ready once everything it depends on is.
+     *
+     * @tparam T The resource type to load. Texture2D, Shader, Mesh, Material and Prefab are supported.
+     * @param filePath The path of the file to load the resource from.
+     * @param resourceName The name to register the resource under.
+     * @return ResourceHandle The handle of the resource.
+     */
+    template<typename T>
+    ResourceHandle loadAsync(const std::string& filePath, const std::string& resourceName) {
+        if constexpr (std::is_same_v<T, Material> || std::is_same_v<T, Prefab>) {
+            return loadGraph(filePath, resourceName, getTypeIndex<T>(), true);
+        } else {
+            return loadFile<T>(filePath, resourceName, ResourceSource(), true);
+        }
+    }
+
+    /**
+     * @brief Gets the loading state of a resource.
+     * Polling a shader may submit its compile, so this must be called on the render thread.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @return ResourceState The loading state. Invalid and stale handles report Failed.
+     */
+    template<typename T>
+    ResourceState getState(ResourceHandle handle) {
+        T* resource = getPool<T>().get(handle);
+        if (!resource) {
+            return ResourceState::Failed;
+        }
 
-        ResourceVariant resource;
         if constexpr (std::is_same_v<T, Texture2D>) {
-            resource = Texture2D::create(filePath);
+            if (resource->isLoaded()) {
+                return ResourceState::Ready;
+            }
+            return resource->hasLoadFailed() ? ResourceState::Failed : ResourceState::Loading;
         } else if constexpr (std::is_same_v<T, Shader>) {
-            resource = Shader::create(filePath);
+            switch (resource->getStatus()) {
+                case ShaderStatus::Pending: return ResourceState::Loading;
+                case ShaderStatus::Ready:   return ResourceState::Ready;
+                case ShaderStatus::Failed:  return ResourceState::Failed;
+            }
+            return ResourceState::Failed;
         } else {
-            LF_ASSERT_MSG(false, "Unable to load unknown resource type.");
+            return _pendingLoadKeys.contains(getLoadKey<T>(handle)) ? ResourceState::Loading : ResourceState::Ready;
         }
+    }
+
+    /**
+     * @brief Checks whether a resource has finished loading successfully.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @return true if the resource is ready to use.
+     */
+    template<typename T>
+    bool isReady(ResourceHandle handle) {
+        return getState<T>(handle) == ResourceState::Ready;
+    }
 
-        ResourceHandle newHandle = ++_lastHandle;
+    /**
+     * @brief Registers a callback to run on the render thread once an asynchronous load completes.
+     * If the resource is not loading asynchronously, the callback runs immediately.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @param callback Called with the handle and whether the resource loaded successfully.
+     */
+    template<typename T>
+    void onLoaded(ResourceHandle handle, ResourceLoadCallback callback) {
+        if (PendingLoad* pendingLoad = findPendingLoad(getLoadKey<T>(handle))) {
+            pendingLoad->callbacks.push_back(std::move(callback));
+            return;
+        }
+        callback(handle, isReady<T>(handle));
+    }
 
-        _resourceNameMap.try_emplace(resourceName, newHandle);
-        _resources.try_emplace(newHandle, std::move(resource));
-        return newHandle;
+    /**
+     * @brief Gets a future that becomes ready when an asynchronous load completes, for waiting on other threads.
+     * The future is fulfilled by update(), so the render thread must never wait on it.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @return std::shared_future<bool> Holds whether the resource loaded successfully.
+     */
+    template<typename T>
+    std::shared_future<bool> getLoadFuture(ResourceHandle handle) {
+        if (PendingLoad* pendingLoad = findPendingLoad(getLoadKey<T>(handle))) {
+            return pendingLoad->future;
+        }
+
+        std::promise<bool> promise;
+        promise.set_value(isReady<T>(handle));
+        return promise.get_future().share();
     }
 
+    /**
+     * @brief Sets how long update() may spend finishing asynchronous loads each frame.
+     * Loads left over when the budget runs out are finished on later frames.
+     * @param milliseconds The per-frame time budget.
+     */
+    void setLoadBudget(double milliseconds) { _loadBudgetMs = milliseconds; }
+
+    /**
+     * @brief Gets the number of asynchronous loads that have not completed yet.
+     */
+    size_t getPendingLoadCount() const { return _pendingLoads.size(); }
+
+    /**
+     * @brief Takes ownership of a resource created outside the manager, such as a generated mesh or a material.
+     * @tparam T The resource type.
+     * @param resource The resource to add.
+     * @param resourceName The name to register the resource under.
+     * @return ResourceHandle The handle of the resource.
+     */
+    template<typename T>
+    ResourceHandle add(std::unique_ptr<T> resource, const std::string& resourceName) {
+        return addResource(std::move(resource), resourceName);
+    }
 
+    /**
+     * @brief Gets a resource. Wait-free and safe from any thread.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource, which must be valid.
+     * @return T& The resource, valid until the next update().
+     */
     template<typename T>
     T& get(ResourceHandle handle) {
-        LF_ASSERT_MSG(_resources.contains(handle), std::format("No resource handle {} found.", handle));
+        ResourcePool<T>& pool = getPool<T>();
+        T* resource = pool.get(handle);
+        LF_ASSERT_MSG(resource, std::format("No resource found for handle {:#x}; it is invalid or has been unloaded.", handle));
+
+        pool.touch(handle);
+        return *resource;
+    }
 
-        return *std::get<std::unique_ptr<T>>(_resources[handle]);
+    /**
+     * @brief Gets a counted reference to a resource, which keeps it from being unloaded to meet a memory budget
+     * for as long as it is held.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @return ResourceRef<T> The reference, or an empty one if the handle is invalid or stale.
+     */
+    template<typename T>
+    ResourceRef<T> acquire(ResourceHandle handle) {
+        if (!getPool<T>().contains(handle)) {
+            return ResourceRef<T>();
+        }
+        return ResourceRef<T>(getPool<T>(), handle);
     }
 
+    /**
+     * @brief Gets the number of counted references held to a resource.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @return uint32_t The reference count, or 0 if the handle is invalid or stale.
+     */
+    template<typename T>
+    uint32_t getRefCount(ResourceHandle handle) const {
+        return const_cast<ResourceManager*>(this)->getPool<T>().getRefCount(handle);
+    }
+
+    /**
+     * @brief Measures the memory held by every loaded resource of a type.
+     *
+     * Textures count the video memory of their allocated mip levels and meshes that of their buffers. Materials
+     * count their own size in system memory. Shader programs are owned by the driver, which doesn't report their
+     * size, so shaders count nothing.
+     *
+     * @tparam T The resource type.
+     * @return ResourceMemoryUsage The memory held.
+     */
+    template<typename T>
+    ResourceMemoryUsage getMemoryUsage() {
+        ResourceMemoryUsage usage;
+        getPool<T>().forEach([&usage](ResourceHandle, const T& resource) {
+            const ResourceMemoryUsage resourceUsage = measureResource(resource);
+            usage.cpuBytes += resourceUsage.cpuBytes;
+            usage.gpuBytes += resourceUsage.gpuBytes;
+        });
+        return usage;
+    }
+
+    /**
+     * @brief Limits the memory the resources of a type may hold.
+     *
+     * While a budget is exceeded, update() unloads resources of the type that no ResourceRef holds, least recently
+     * used first, until it is met. Resources still loading, and those used only through bare handles, are never
+     * counted as unused by a reference, so anything used through a bare handle must be acquired to stay loaded.
+     *
+     * @tparam T The resource type.
+     * @param budget The limits.
+     */
+    template<typename T>
+    void setMemoryBudget(const ResourceMemoryBudget& budget) { _memoryBudgets[getTypeIndex<T>()] = budget; }
+
+    /**
+     * @brief Gets the memory limits of a resource type.
+     * @tparam T The resource type.
+     */
+    template<typename T>
+    const ResourceMemoryBudget& getMemoryBudget() const { return _memoryBudgets[getTypeIndex<T>()]; }
+
+    /**
+     * @brief Checks whether a handle refers to a loaded resource of the given type.
+     * @tparam T The resource type.
+     * @param handle The handle to check.
+     * @return true if the resource is loaded; false if the handle is invalid or stale.
+     */
+    template<typename T>
+    bool isValid(ResourceHandle handle) {
+        return getPool<T>().contains(handle);
+    }
+
+    /**
+     * @brief Finds a resource by the name it was registered under. Safe from any thread, though it waits while
+     * resources are being added or unloaded.
+     * @tparam T The resource type.
+     * @param resourceName The name of the resource.
+     * @return ResourceHandle The handle of the resource, or 0 if no loaded resource has the name.
+     */
+    template<typename T>
+    ResourceHandle find(const std::string& resourceName) const {
+        std::shared_lock lock(_registryMutex);
+        const auto& names = _resourceNames[getTypeIndex<T>()];
+        auto it = names.find(resourceName);
+        return it != names.end() ? it->second : 0;
+    }
+
+    /**
+     * @brief Reports how many loads of a resource type were shared with an already loaded resource, and the memory
+     * that saved. Memory is measured as by getMemoryUsage(), so it grows as shared asynchronous loads complete.
+     * @tparam T The resource type.
+     * @return ResourceDeduplicationStats The statistics.
+     */
+    template<typename T>
+    ResourceDeduplicationStats getDeduplicationStats() {
+        std::shared_lock lock(_registryMutex);
+        const DeduplicationTable& table = _deduplication[getTypeIndex<T>()];
+        ResourceDeduplicationStats stats { .pathHits = table.pathHits, .contentHits = table.contentHits };
+        for (const auto& [handle, duplicates] : table.duplicates) {
+            if (const T* resource = getPool<T>().get(handle)) {
+                const ResourceMemoryUsage usage = measureResource(*resource);
+                stats.bytesSaved += (usage.cpuBytes + usage.gpuBytes) * duplicates;
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Unloads a resource. Handles to it become stale and no longer resolve, even once its slot is reused.
+     * References still held to it become stale too, and resolve to nothing. The resource itself is destroyed by the
+     * next update().
+     *
+     * A resource shared by several loads is only unloaded once each of them has been unloaded, so unloading it for
+     * one loader leaves it in place for the others.
+     *
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     */
+    template<typename T>
+    void unload(ResourceHandle handle) {
+        {
+            std::unique_lock lock(_registryMutex);
+            auto& duplicates = _deduplication[getTypeIndex<T>()].duplicates;
+            auto it = duplicates.find(handle);
+            if (it != duplicates.end() && getPool<T>().contains(handle)) {
+                if (--it->second == 0) {
+                    duplicates.erase(it);
+                }
+                return;
+            }
+        }
+        removeResource<T>(handle);
+    }
+
+    /**
+     * @brief Mounts a packed asset archive, so files beneath the mount point load from it instead of from disk.
+     * @param archivePath The path of the .lfpak file.
+     * @param mountPoint The directory the archive's contents appear under.
+     * @return true if the archive was mounted.
+     */
+    bool mountArchive(const std::string& archivePath, const std::string& mountPoint);
+
+    /**
+     * @brief Mounts a directory, so files beneath the mount point load from it when it contains them.
+     * @param directory The directory to mount.
+     * @param mountPoint The directory its contents appear under.
+     * @return true if the directory was mounted.
+     */
+    bool mountDirectory(const std::string& directory, const std::string& mountPoint);
+
+    /**
+     * @brief Loads a UV remap table written by the atlas packer, so the textures it lists are drawn from their atlases.
+     * @param tablePath The path of the .lfatlas file. Atlas paths in it are relative to its directory.
+     * @return true if the table was loaded.
+     */
+    bool loadAtlasTable(const std::string& tablePath);
+
+    /**
+     * @brief Loads a texture for use by a material, resolving it to its atlas region if it was packed into one.
+     * Every region of an atlas shares the atlas texture, so materials using them draw without rebinding.
+     * @param filePath The path of the source texture, as named in the atlas table.
+     * @param resourceName The name to register a standalone texture under.
+     * @return TextureRegion A counted reference to the texture, and the UV transform into its region of the atlas.
+     */
+    TextureRegion loadTextureRegion(const std::string& filePath, const std::string& resourceName);
+
+    /**
+     * @brief Gets the permutation of a shader compiled with the given features.
+     * Permutations are compiled asynchronously on first request, so the returned shader may not be ready yet.
+     * @param handle The handle of the base shader.
+     * @param features The features of the permutation. A mask of 0 returns the base shader itself.
+     * @return Shader& The shader permutation.
+     */
+    Shader& getShaderVariant(ShaderHandle handle, ShaderFeatureMask features);
+
+    /**
+     * @brief Submits shader permutations for compilation ahead of their first use.
+     * @param handle The handle of the base shader.
+     * @param permutations The feature masks of the permutations to compile.
+     */
+    void prewarmShaderVariants(ShaderHandle handle, const std::vector<ShaderFeatureMask>& permutations);
+
+    /**
+     * @brief Gets the feature masks of every compiled permutation of a shader, including 0 for the base shader.
+     * @param handle The handle of the base shader.
+     * @return std::vector<ShaderFeatureMask> The feature masks.
+     */
+    std::vector<ShaderFeatureMask> getShaderVariantFeatures(ShaderHandle handle) const;
+
+    /**
+     * @brief Gets the source file a shader was loaded from.
+     * @param handle The handle of the shader.
+     * @return The file path, or an empty string if the shader was not loaded from a file.
+     */
+    const std::string& getShaderPath(ShaderHandle handle) const { return _shaderVariants.getShaderPath(handle); }
+
+    /**
+     * @brief Replaces a shader, or one of its permutations, with a newly compiled program.
+     * Handles held by materials stay valid and pick up the new program on their next draw.
+     * @param handle The handle of the base shader.
+     * @param features The features of the permutation to replace, or 0 for the base shader.
+     * @param shader The shader to take ownership of. The previous program is destroyed.
+     */
+    void replaceShader(ShaderHandle handle, ShaderFeatureMask features, std::unique_ptr<Shader> shader);
+
+    /**
+     * @brief Enables or disables recompiling shaders when their source files change on disk.
+     * @param enabled True to watch loaded shaders and their includes for changes.
+     */
+    void setShaderHotReloadEnabled(bool enabled);
+
+    /**
+     * @brief Performs per-frame resource work, such as destroying resources unloaded during the last frame,
+     * finishing asynchronous loads, swapping in hot-reloaded shaders and unloading unused resources over their
+     * memory budget. Completion callbacks run from here. Must be called on the render thread before any resources
+     * are used for the frame, while no other thread holds a reference returned by get().
+     */
+    void update();
+
 private:
-    // Maps resource names to their handles
-    std::unordered_map<std::string, ResourceHandle> _resourceNameMap = {};
 
-    // Map of resource handles to resource type instances
-    std::unordered_map<ResourceHandle, ResourceVariant> _resources = {};
+    /**
+     * @brief Identifies the file a resource is loaded from, so later loads of it can be shared.
+     */
+    struct ResourceSource {
+        std::string path;           ///< Normalised path of the file
+        uint64_t contentKey = 0;    ///< Hash of the file and everything it depends on, or 0 if not computed
+    };
+
+    /**
+     * @brief Paths and contents already loaded for one resource type, and how often they were shared.
+     */
+    struct DeduplicationTable {
+        std::unordered_map<std::string, ResourceHandle> paths;
+        std::unordered_map<uint64_t, ResourceHandle> contents;
+        std::unordered_map<ResourceHandle, uint32_t> duplicates;
+        size_t pathHits = 0;
+        size_t contentHits = 0;
+    };
+
+    /**
+     * @brief Where an atlased texture lives: the atlas file, and the transform into its region.
+     */
+    struct AtlasLocation {
+        std::string atlasPath;
+        glm::vec4 uvTransform;
+    };
+
+    // Atlas locations of packed textures, keyed by source path
+    using AtlasLocationMap = std::unordered_map<std::string, AtlasLocation>;
+
+    /**
+     * @brief Loads a texture, shader or mesh from a file, sharing it if it is already loaded.
+     * @tparam T The resource type.
+     * @param filePath The path of the file.
+     * @param resourceName The name to register the resource under.
+     * @param source The content key of the file if it has already been hashed, otherwise empty.
+     * @param async True to read the file on a worker and finish the load during update().
+     * @param content The contents of the file if they have already been read, so it is not read again.
+     * @return ResourceHandle The handle of the resource.
+     */
+    template<typename T>
+    ResourceHandle loadFile(const std::string& filePath, const std::string& resourceName, ResourceSource source, bool async,
+        const AssetBlob* content = nullptr) {
+        if (ResourceHandle duplicate = findDuplicate<T>(filePath, resourceName, source, !async)) {
+            return duplicate;
+        }
+
+        std::unique_ptr<T> resource;
+        if constexpr (std::is_same_v<T, Texture2D>) {
+            resource = content ? Texture2D::create(filePath, *content) : Texture2D::create(filePath);
+        } else if constexpr (std::is_same_v<T, Shader>) {
+            if (content) {
+                resource = async ? Shader::createAsync(filePath, *content) : Shader::create(filePath, *content);
+            } else {
+                resource = async ? Shader::createAsync(filePath) : Shader::create(filePath);
+            }
+        } else if constexpr (std::is_same_v<T, Mesh>) {
+            // Asynchronous meshes are empty until their geometry has been read
+            if (async) {
+                resource = Mesh::create(MeshData());
+            } else {
+                resource = content ? Mesh::create(filePath, *content) : Mesh::create(filePath);
+            }
+        } else {
+            LF_ASSERT_MSG(false, "Unable to load unknown resource type.");
+        }
+
+        ResourceHandle handle = addResource(std::move(resource), resourceName);
+        if constexpr (std::is_same_v<T, Shader>) {
+            registerShader(handle, filePath);
+        }
+        registerSource<T>(handle, std::move(source));
+
+        if (async) {
+            PendingLoad pendingLoad;
+            pendingLoad.key = getLoadKey<T>(handle);
+            pendingLoad.handle = handle;
+            if constexpr (std::is_same_v<T, Mesh>) {
+                pendingLoad.poll = startMeshLoad(handle, filePath, content ? std::optional(*content) : std::nullopt);
+            } else {
+                pendingLoad.poll = [this, handle]() { return getState<T>(handle); };
+            }
+            addPendingLoad(std::move(pendingLoad));
+        }
+        return handle;
+    }
+
+    /**
+     * @brief Reads a mesh's geometry on a worker, which also uploads it if the renderer has an upload thread.
+     * @param handle The handle of the placeholder mesh to replace once the geometry has been read.
+     * @param filePath The path of the mesh file.
+     * @param content The contents of the file if they have already been read, so the worker doesn't read it again.
+     * @return std::function<ResourceState()> Polls the read, then the upload, creating the mesh on the render thread
+     * when both are done.
+     */
+    std::function<ResourceState()> startMeshLoad(ResourceHandle handle, const std::string& filePath,
+        std::optional<AssetBlob> content);
+
+    /**
+     * @brief Loads a material or prefab manifest and everything it depends on, as described by loadAsync().
+     * @param filePath The path of the manifest.
+     * @param resourceName The name to register the root resource under.
+     * @param typeIndex The index of the root resource type.
+     * @param async True to read and build the graph without blocking, finishing it during update().
+     * @return ResourceHandle The handle of the root resource, or 0 if a synchronous load could not read its manifest.
+     */
+    ResourceHandle loadGraph(const std::string& filePath, const std::string& resourceName, size_t typeIndex, bool async);
+
+    /**
+     * @brief Reads the manifests of a material or prefab graph, and those they name, then starts reading every
+     * texture, shader and mesh in the graph that is not already loaded. Safe to call from any thread.
+     * @param filePath The path of the root manifest.
+     * @param typeIndex The index of the root resource type.
+     * @param contentKey The content key of the root manifest if it has already been hashed, otherwise 0.
+     * @param atlasLocations The atlas table to resolve diffuse maps against.
+     * @return std::shared_ptr<ResourceGraph> The graph. Nothing else is read if its root manifest could not be.
+     */
+    std::shared_ptr<ResourceGraph> readGraph(const std::string& filePath, size_t typeIndex, uint64_t contentKey,
+        std::shared_ptr<const AtlasLocationMap> atlasLocations);
+
+    /**
+     * @brief Loads a texture, shader or mesh of a graph, sharing it if it is already loaded.
+     * @param node The node of the file, whose content key is used if it has been hashed.
+     * @param async True to finish the load during update().
+     * @param content The contents of the file if they were read with the graph, otherwise nullptr.
+     */
+    void loadGraphLeaf(ResourceGraphNode& node, bool async, const AssetBlob* content);
+
+    /**
+     * @brief Builds the materials and prefabs of a graph, loading any of its textures, shaders and meshes not yet
+     * started.
+     * @param graph The graph.
+     * @param resourceName The name to register the root resource under.
+     * @param rootHandle The handle of the empty root resource to fill in, or 0 to add the root.
+     * @param async True to add a pending load for each material and prefab built, other than the root.
+     * @return ResourceHandle The handle of the root resource.
+     */
+    ResourceHandle buildGraph(ResourceGraph& graph, const std::string& resourceName, ResourceHandle rootHandle, bool async);
+
+    /**
+     * @brief Polls the textures, shaders and meshes a material or prefab of a graph depends on.
+     * @param node The node of the material or prefab.
+     * @return std::function<ResourceState()> Reports Loading until all of them have loaded, then whether any failed.
+     */
+    std::function<ResourceState()> pollGraphDependencies(const ResourceGraphNode& node);
+
+    /**
+     * @brief Looks for an already loaded resource with the same path or content as a file about to be loaded.
+     * @tparam T The resource type.
+     * @param filePath The path of the file.
+     * @param resourceName The name to register a shared resource under.
+     * @param source Receives the normalised path and content key, for registering the resource if it is loaded. A
+     * content key already set is used rather than hashing the file again.
+     * @param readContent True to read and hash the file if no content key is set. Asynchronous loads pass false, so
+     * the calling thread doesn't block on the read, and only share resources loaded from the same path.
+     * @return ResourceHandle The handle of the loaded resource to share, or 0 if the file must be loaded.
+     */
+    template<typename T>
+    ResourceHandle findDuplicate(const std::string& filePath, const std::string& resourceName, ResourceSource& source,
+        bool readContent) {
+        constexpr size_t typeIndex = getTypeIndex<T>();
+        DeduplicationTable& table = _deduplication[typeIndex];
+        source.path = normaliseResourcePath(filePath);
+
+        ResourceHandle duplicate = findLoadedPath(typeIndex, source.path);
+        if (duplicate == 0) {
+            // Shader sources edited while hot reloading would otherwise stop being identical
+            if (std::is_same_v<T, Shader> && _shaderHotReloader) {
+                return 0;
+            }
+
+            // Hashed outside the lock, as it reads the whole file
+            if (source.contentKey == 0 && readContent) {
+                source.contentKey = hashResourceContent(typeIndex, source.path);
+            }
+            if (source.contentKey == 0) {
+                return 0;
+            }
+        }
+
+        std::unique_lock lock(_registryMutex);
+        if (duplicate != 0) {
+            ++table.pathHits;
+        } else {
+            auto contentIt = table.contents.find(source.contentKey);
+            if (contentIt == table.contents.end() || !getPool<T>().contains(contentIt->second)) {
+                return 0;
+            }
+            duplicate = contentIt->second;
+            table.paths[source.path] = duplicate;
+            ++table.contentHits;
+        }
+
+        ++table.duplicates[duplicate];
+        _resourceNames[typeIndex].try_emplace(resourceName, duplicate);
+        LOG_DEBUG("Sharing already loaded {} with {}.", source.path, resourceName);
+        return duplicate;
+    }
+
+    /**
+     * @brief Records the path and content of a newly loaded resource, so later loads of them are shared.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     * @param source The path and content key found by findDuplicate().
+     */
+    template<typename T>
+    void registerSource(ResourceHandle handle, ResourceSource source) {
+        std::unique_lock lock(_registryMutex);
+        DeduplicationTable& table = _deduplication[getTypeIndex<T>()];
+        if (source.contentKey != 0) {
+            table.contents[source.contentKey] = handle;
+        }
+        table.paths[std::move(source.path)] = handle;
+    }
+
+    /**
+     * @brief Finds the resource loaded from a path, without hashing or counting a shared load.
+     * @param typeIndex The index of the resource type.
+     * @param path The normalised path of the file.
+     * @return ResourceHandle The handle of the resource, or 0 if the path is not loaded.
+     */
+    ResourceHandle findLoadedPath(size_t typeIndex, const std::string& path);
+
+    /**
+     * @brief Forgets the paths and content of an unloaded resource. The caller must hold the registry lock.
+     * @param typeIndex The index of the resource type.
+     * @param handle The handle of the resource.
+     */
+    void unregisterSource(size_t typeIndex, ResourceHandle handle);
+
+    /**
+     * @brief Normalises a path, so every spelling of the same file maps to the same resource.
+     */
+    static std::string normaliseResourcePath(const std::string& filePath);
+
+    /**
+     * @brief Hashes the content of a resource file, along with any files it reads while loading.
+     * @param typeIndex The index of the resource type, which decides what else the file reads.
+     * @param path The normalised path of the file.
+     * @return uint64_t The content key, or 0 if the file could not be read.
+     */
+    static uint64_t hashResourceContent(size_t typeIndex, const std::string& path);
+
+    /**
+     * @brief Hashes the content of a resource file that has already been read, along with any files it reads while
+     * loading.
+     * @param typeIndex The index of the resource type, which decides what else the file reads.
+     * @param path The normalised path of the file.
+     * @param content The contents of the file.
+     * @return uint64_t The content key, or 0 if a file it reads could not be.
+     */
+    static uint64_t hashResourceContent(size_t typeIndex, const std::string& path, std::span<const uint8_t> content);
+
+    /**
+     * @brief Unloads a resource however many loads share it, as unload() does once the last of them is unloaded.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     */
+    template<typename T>
+    void removeResource(ResourceHandle handle) {
+        if constexpr (std::is_same_v<T, Shader>) {
+            unregisterShader(handle);
+        }
+
+        if (getPool<T>().remove(handle)) {
+            std::unique_lock lock(_registryMutex);
+            std::erase_if(_resourceNames[getTypeIndex<T>()], [handle](const auto& entry) { return entry.second == handle; });
+            unregisterSource(getTypeIndex<T>(), handle);
+        }
+    }
+
+    /**
+     * @brief Registers a newly created resource and assigns it a handle.
+     * @param resource The resource to take ownership of.
+     * @param resourceName The name to register the resource under.
+     * @return ResourceHandle The handle assigned to the resource.
+     */
+    template<typename T>
+    ResourceHandle addResource(std::unique_ptr<T> resource, const std::string& resourceName) {
+        ResourceHandle newHandle = getPool<T>().add(std::move(resource));
+
+        std::unique_lock lock(_registryMutex);
+        _resourceNames[getTypeIndex<T>()].try_emplace(resourceName, newHandle);
+        return newHandle;
+    }
+
+    /**
+     * @brief Gets the pool holding resources of a type.
+     * @tparam T The resource type.
+     */
+    template<typename T>
+    ResourcePool<T>& getPool() {
+        if constexpr (std::is_same_v<T, Texture2D>) {
+            return _textures;
+        } else if constexpr (std::is_same_v<T, Shader>) {
+            return _shaders;
+        } else if constexpr (std::is_same_v<T, Mesh>) {
+            return _meshes;
+        } else if constexpr (std::is_same_v<T, Material>) {
+            return _materials;
+        } else {
+            static_assert(std::is_same_v<T, Prefab>, "Unknown resource type.");
+            return _prefabs;
+        }
+    }
+
+    /**
+     * @brief An asynchronous load that has not completed, and who to tell when it does.
+     */
+    struct PendingLoad {
+        uint64_t key = 0;
+        ResourceHandle handle = 0;
+        std::function<ResourceState()> poll;
+        std::vector<ResourceLoadCallback> callbacks;
+        std::promise<bool> promise;
+        std::shared_future<bool> future;
+    };
+
+    /**
+     * @brief Gets the index of a resource type, for per-type tables.
+     * @tparam T The resource type.
+     */
+    template<typename T>
+    static constexpr size_t getTypeIndex() {
+        if constexpr (std::is_same_v<T, Texture2D>) {
+            return 0;
+        } else if constexpr (std::is_same_v<T, Shader>) {
+            return 1;
+        } else if constexpr (std::is_same_v<T, Mesh>) {
+            return 2;
+        } else if constexpr (std::is_same_v<T, Material>) {
+            return 3;
+        } else {
+            static_assert(std::is_same_v<T, Prefab>, "Unknown resource type.");
+            return 4;
+        }
+    }
+
+    // Number of resource types
+    static constexpr size_t RESOURCE_TYPE_COUNT = 5;
+
+    /**
+     * @brief Gets the key identifying a pending load, as handles to resources of different types can be equal.
+     * @tparam T The resource type.
+     * @param handle The handle of the resource.
+     */
+    template<typename T>
+    static uint64_t getLoadKey(ResourceHandle handle) {
+        return (static_cast<uint64_t>(getTypeIndex<T>()) << 32) | handle;
+    }
+
+    /**
+     * @brief Measures the memory held by a single resource.
+     */
+    template<typename T>
+    static ResourceMemoryUsage measureResource(const T& resource) {
+        if constexpr (std::is_same_v<T, Texture2D> || std::is_same_v<T, Mesh>) {
+            return ResourceMemoryUsage { .cpuBytes = 0, .gpuBytes = resource.getGpuMemoryUsage() };
+        } else if constexpr (std::is_same_v<T, Material>) {
+            return ResourceMemoryUsage { .cpuBytes = sizeof(Material), .gpuBytes = 0 };
+        } else if constexpr (std::is_same_v<T, Prefab>) {
+            return ResourceMemoryUsage { .cpuBytes = sizeof(Prefab) + resource.getParts().size() * sizeof(PrefabPart), .gpuBytes = 0 };
+        } else {
+            return ResourceMemoryUsage();
+        }
+    }
+
+    /**
+     * @brief Unloads unreferenced resources of a type, least recently used first, until its budget is met.
+     * @tparam T The resource type.
+     */
+    template<typename T>
+    void enforceMemoryBudget() {
+        const ResourceMemoryBudget& budget = _memoryBudgets[getTypeIndex<T>()];
+        if (budget.cpuBytes == std::numeric_limits<size_t>::max() && budget.gpuBytes == std::numeric_limits<size_t>::max()) {
+            return;
+        }
+
+        ResourceMemoryUsage usage = getMemoryUsage<T>();
+        auto withinBudget = [&]() { return usage.cpuBytes <= budget.cpuBytes && usage.gpuBytes <= budget.gpuBytes; };
+        if (withinBudget()) {
+            return;
+        }
+
+        /**
+         * @brief A resource that may be unloaded, and what unloading it frees.
+         */
+        struct EvictionCandidate {
+            ResourceHandle handle;
+            uint64_t lastUsed;
+            ResourceMemoryUsage usage;
+        };
+
+        ResourcePool<T>& pool = getPool<T>();
+        std::vector<EvictionCandidate> candidates;
+        pool.forEach([&](ResourceHandle handle, const T& resource) {
+            if (pool.getRefCount(handle) == 0 && !_pendingLoadKeys.contains(getLoadKey<T>(handle))) {
+                candidates.push_back(EvictionCandidate { handle, pool.getLastUsed(handle), measureResource(resource) });
+            }
+        });
+        std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) { return a.lastUsed < b.lastUsed; });
+
+        size_t unloaded = 0;
+        for (const EvictionCandidate& candidate : candidates) {
+            if (withinBudget()) {
+                break;
+            }
+            // Only resources that free something are worth losing
+            if (candidate.usage.cpuBytes == 0 && candidate.usage.gpuBytes == 0) {
+                continue;
+            }
+            // Nothing references it, so it goes however many loads share it
+            removeResource<T>(candidate.handle);
+            usage.cpuBytes -= candidate.usage.cpuBytes;
+            usage.gpuBytes -= candidate.usage.gpuBytes;
+            ++unloaded;
+        }
+
+        if (!withinBudget()) {
+            LOG_WARN("Resources of type {} exceed their memory budget but are all referenced; using {} CPU and {} GPU bytes.",
+                getTypeIndex<T>(), usage.cpuBytes, usage.gpuBytes);
+        } else if (unloaded > 0) {
+            LOG_DEBUG("Unloaded {} unused resources of type {} to meet their memory budget.", unloaded, getTypeIndex<T>());
+        }
+    }
+
+    /**
+     * @brief Advances the usage clock of every pool and enforces the memory budgets of every type.
+     */
+    void updateMemoryBudgets();
+
+    /**
+     * @brief Finds the pending load with a key.
+     * @return PendingLoad* The pending load, or nullptr if the resource is not loading asynchronously.
+     */
+    PendingLoad* findPendingLoad(uint64_t key);
+
+    /**
+     * @brief Queues an asynchronous load to be polled by update(), creating the future it fulfils.
+     * @param pendingLoad The load, with its key, handle and poll set.
+     */
+    void addPendingLoad(PendingLoad pendingLoad);
+
+    /**
+     * @brief Polls the pending loads in request order until the frame's budget is spent, completing those that
+     * have finished.
+     */
+    void updatePendingLoads();
+
+    /**
+     * @brief Registers a shader loaded from a file for permutations and hot reloading.
+     * @param handle The handle of the shader.
+     * @param filePath The path of the file the shader was loaded from.
+     */
+    void registerShader(ShaderHandle handle, const std::string& filePath);
+
+    /**
+     * @brief Drops the permutations and hot reload watches of a shader that is being unloaded.
+     * @param handle The handle of the shader.
+     */
+    void unregisterShader(ShaderHandle handle);
+
+    // Maps resource names to their handles, by type index
+    std::array<std::unordered_map<std::string, ResourceHandle>, RESOURCE_TYPE_COUNT> _resourceNames = {};
+
+    // Guards the names and deduplication tables, which loader threads may change while others read them
+    mutable std::shared_mutex _registryMutex;
+
+    // Loaded paths and contents of each resource type, by type index
+    std::array<DeduplicationTable, RESOURCE_TYPE_COUNT> _deduplication = {};
+
+    // Resources of each type, indexed by handle. Resources holding references to others are declared after them, so
+    // they are destroyed first and release their references while the pools they point into still exist
+    ResourcePool<Texture2D> _textures;
+    ResourcePool<Shader> _shaders;
+    ResourcePool<Mesh> _meshes;
+    ResourcePool<Material> _materials;
+    ResourcePool<Prefab> _prefabs;
+
+    // Location of every texture packed into an atlas, keyed by source path. Replaced rather than changed when a
+    // table is loaded, so graphs being read on workers keep the table they started with
+    std::shared_ptr<const AtlasLocationMap> _atlasLocations = std::make_shared<AtlasLocationMap>();
+
+    // Handles of the atlas textures loaded so far, keyed by path
+    std::unordered_map<std::string, TextureHandle> _atlasTextures = {};
+
+    // Asynchronous loads that have not completed, in the order they were requested. A deque, so loads started while
+    // another is polled don't move it
+    std::deque<PendingLoad> _pendingLoads = {};
+
+    // Keys of the pending loads, so checking whether a resource is still loading doesn't search them
+    std::unordered_set<uint64_t> _pendingLoadKeys = {};
+
+    // Graphs being read on workers, which must finish before the manager they use is destroyed
+    std::vector<std::shared_future<std::shared_ptr<ResourceGraph>>> _graphReads = {};
+
+    // Time update() may spend finishing asynchronous loads each frame, in milliseconds
+    double _loadBudgetMs = 2.0;
+
+    // Memory budget of each resource type, by type index
+    std::array<ResourceMemoryBudget, RESOURCE_TYPE_COUNT> _memoryBudgets = {};
+
+    // Feature permutations of the loaded shaders
+    ShaderVariantCache _shaderVariants;
 
-    // Last assigned texture handle
-    ResourceHandle _lastHandle = 0;
+    // Watches shader sources for changes when hot reload is enabled
+    std::unique_ptr<ShaderHotReloader> _shaderHotReloader;
 
 };
\ No newline at end of file
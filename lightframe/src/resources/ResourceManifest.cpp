@@ -0,0 +1,111 @@
+#include "ResourceManifest.h"
+
+#include "assets/VirtualFileSystem.h"
+#include "core/Json.h"
+#include "core/Logger.h"
+#include "core/Strings.h"
+
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @brief Reads and parses a manifest through the virtual file system.
+ * @param path The path of the manifest.
+ * @param document Receives the parsed document.
+ * @return true if the manifest was read and is a JSON object.
+ */
+static bool readManifestDocument(const std::string& path, JsonValue& document) {
+    AssetBlob blob;
+    if (!VirtualFileSystem::get()->read(path, blob)) {
+        LOG_WARN("Unable to read manifest {}.", path);
+        return false;
+    }
+
+    const std::string_view text(reinterpret_cast<const char*>(blob.data.data()), blob.data.size());
+    if (!JsonValue::parse(text, document) || !document.isObject()) {
+        LOG_WARN("Manifest {} is not a valid JSON object.", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Resolves a path named in a manifest against the manifest's directory.
+ * @return std::string The resolved path, or an empty string if the value is not a non-empty string.
+ */
+static std::string resolveManifestPath(const std::string& manifestPath, const JsonValue& value) {
+    if (value.asString().empty()) {
+        return std::string();
+    }
+    const std::filesystem::path path = value.asString();
+    return path.is_absolute() ? path.generic_string() : (std::filesystem::path(manifestPath).parent_path() / path).generic_string();
+}
+
+/**
+ * @brief Reads a three component vector from a JSON array, keeping the fallback for missing components.
+ */
+static glm::vec3 readVector(const JsonValue& value, const glm::vec3& fallback) {
+    glm::vec3 vector = fallback;
+    for (size_t i = 0; i < 3 && i < value.size(); ++i) {
+        vector[static_cast<glm::length_t>(i)] = static_cast<float>(value[i].asNumber(fallback[static_cast<glm::length_t>(i)]));
+    }
+    return vector;
+}
+
+bool isMaterialManifest(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".lfmat";
+}
+
+bool isPrefabManifest(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".lfprefab";
+}
+
+bool readMaterialManifest(const std::string& path, MaterialManifest& manifest) {
+    JsonValue document;
+    if (!readManifestDocument(path, document)) {
+        return false;
+    }
+
+    manifest = MaterialManifest();
+    for (const auto& [passName, shaderPath] : document["shaders"].getMembers()) {
+        RenderPass renderPass;
+        if (strEqualsCi(passName, "shadow")) {
+            renderPass = RenderPass::Shadow;
+        } else if (strEqualsCi(passName, "geometry")) {
+            renderPass = RenderPass::Geometry;
+        } else if (strEqualsCi(passName, "ui")) {
+            renderPass = RenderPass::UI;
+        } else {
+            LOG_WARN("Material {} names unknown render pass {}.", path, passName);
+            continue;
+        }
+        manifest.shaders.emplace_back(renderPass, resolveManifestPath(path, shaderPath));
+    }
+
+    manifest.diffuseMap = resolveManifestPath(path, document["diffuseMap"]);
+    manifest.features = static_cast<ShaderFeatureMask>(document["features"].asNumber(0));
+    return true;
+}
+
+bool readPrefabManifest(const std::string& path, PrefabManifest& manifest) {
+    JsonValue document;
+    if (!readManifestDocument(path, document)) {
+        return false;
+    }
+
+    manifest = PrefabManifest();
+    for (const JsonValue& part : document["parts"].getElements()) {
+        PrefabPartManifest partManifest;
+        partManifest.mesh = resolveManifestPath(path, part["mesh"]);
+        partManifest.material = resolveManifestPath(path, part["material"]);
+        if (partManifest.mesh.empty() || partManifest.material.empty()) {
+            LOG_WARN("Prefab {} has a part without a mesh or material.", path);
+            continue;
+        }
+        partManifest.position = readVector(part["position"], partManifest.position);
+        partManifest.rotation = readVector(part["rotation"], partManifest.rotation);
+        partManifest.scale = readVector(part["scale"], partManifest.scale);
+        manifest.parts.push_back(std::move(partManifest));
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ResourceManifest.h
+ * @author Justin McKay
+ * @brief JSON manifests describing resources built from other resources: materials (.lfmat) and prefabs (.lfprefab).
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "rendering/Renderer.h"
+#include "rendering/Shader.h"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A material manifest: the shaders and textures a material is drawn with.
+ *
+ * @code{.json}
+ * {
+ *     "shaders": { "geometry": "shaders/default.shader" },
+ *     "diffuseMap": "textures/crate.png",
+ *     "features": 0
+ * }
+ * @endcode
+ */
+struct MaterialManifest {
+    std::vector<std::pair<RenderPass, std::string>> shaders;    ///< Shader of each render pass
+    std::string diffuseMap;                                     ///< Diffuse texture, or empty for none
+    ShaderFeatureMask features = 0;                             ///< Shader features the material requires
+};
+
+/**
+ * @brief One mesh of a prefab, drawn with a material at a transform relative to the prefab.
+ */
+struct PrefabPartManifest {
+    std::string mesh;                           ///< Mesh file
+    std::string material;                       ///< Material manifest
+    glm::vec3 position = glm::vec3(0.0f);       ///< Position relative to the prefab
+    glm::vec3 rotation = glm::vec3(0.0f);       ///< Rotation in degrees, applied in ZYX order
+    glm::vec3 scale = glm::vec3(1.0f);          ///< Scale
+};
+
+/**
+ * @brief A prefab manifest: the meshes and materials an object is built from.
+ *
+ * @code{.json}
+ * {
+ *     "parts": [
+ *         { "mesh": "meshes/crate.lfmesh", "material": "materials/crate.lfmat", "position": [0, 0.5, 0] }
+ *     ]
+ * }
+ * @endcode
+ */
+struct PrefabManifest {
+    std::vector<PrefabPartManifest> parts;      ///< Meshes of the prefab
+};
+
+/**
+ * @brief Checks whether a file is a material manifest, by its extension.
+ */
+bool isMaterialManifest(const std::string& path);
+
+/**
+ * @brief Checks whether a file is a prefab manifest, by its extension.
+ */
+bool isPrefabManifest(const std::string& path);
+
+/**
+ * @brief Reads a material manifest. Safe to call from any thread.
+ * @param path The path of the .lfmat file. Read from a mounted archive if it is packed in one.
+ * @param manifest Receives the manifest. Relative paths in it are resolved against the manifest's directory.
+ * @return true if the manifest was read.
+ */
+bool readMaterialManifest(const std::string& path, MaterialManifest& manifest);
+
+/**
+ * @brief Reads a prefab manifest. Safe to call from any thread.
+ * @param path The path of the .lfprefab file. Read from a mounted archive if it is packed in one.
+ * @param manifest Receives the manifest. Relative paths in it are resolved against the manifest's directory.
+ * @return true if the manifest was read.
+ */
+bool readPrefabManifest(const std::string& path, PrefabManifest& manifest);
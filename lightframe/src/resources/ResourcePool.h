@@ -0,0 +1,371 @@
+/**
+ * @file ResourcePool.h
+ * @author Justin McKay
+ * @brief Dense, per-type slot array of resources addressed by generational handles.
+ * @date 2026-03-16
+ */
+
+#pragma once
+
+#include "debug/Assertions.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Handle to a resource: a slot index in the low bits and the slot's generation in the high bits.
+ * A handle of 0 never refers to a resource.
+ */
+using ResourceHandle = uint32_t;
+
+/// Number of handle bits holding the slot index, allowing about a million resources of each type
+constexpr uint32_t RESOURCE_HANDLE_INDEX_BITS = 20;
+constexpr uint32_t RESOURCE_HANDLE_INDEX_MASK = (1u << RESOURCE_HANDLE_INDEX_BITS) - 1;
+constexpr uint32_t RESOURCE_HANDLE_GENERATION_MASK = (1u << (32 - RESOURCE_HANDLE_INDEX_BITS)) - 1;
+
+/**
+ * @brief Gets the slot index of a handle.
+ */
+constexpr uint32_t getHandleIndex(ResourceHandle handle) {
+    return handle & RESOURCE_HANDLE_INDEX_MASK;
+}
+
+/**
+ * @brief Gets the slot generation of a handle.
+ */
+constexpr uint32_t getHandleGeneration(ResourceHandle handle) {
+    return handle >> RESOURCE_HANDLE_INDEX_BITS;
+}
+
+/**
+ * @brief Packs a slot index and generation into a handle.
+ */
+constexpr ResourceHandle makeHandle(uint32_t index, uint32_t generation) {
+    return (generation << RESOURCE_HANDLE_INDEX_BITS) | index;
+}
+
+/**
+ * @brief Owns the resources of one type in an array of slots, safe to use from any thread.
+ *
+ * Looking up a handle is an array index and a generation compare, with no hashing. Removing a resource bumps its
+ * slot's generation, so handles that still refer to it are detected as stale rather than resolving to whatever
+ * reuses the slot. Free slots are reused least recently freed first, spreading churn across them, and a slot whose
+ * generations run out is never reused, so a generation never wraps back to one a stale handle holds. Resources are
+ * held by pointer, so references to them stay valid while others are added.
+ *
+ * Lookups are wait-free: they take no lock and never retry, so worker threads can resolve handles while others add
+ * and remove resources. Slots live in fixed pages that never move, and each slot's generation and reference count
+ * share one atomic word. Adding, replacing and removing resources serialise on a mutex. Removed and replaced
+ * resources are retired rather than destroyed, and destroyed by reclaim(), which the owner calls once a frame, so a
+ * pointer returned by get() stays valid until the next reclaim() even if the resource is removed meanwhile.
+ *
+ * Each slot also counts the ResourceRefs held to its resource and records when it was last used, measured on a
+ * clock the owner advances once a frame, so unreferenced resources can be unloaded least recently used first.
+ *
+ * @tparam T The resource type.
+ */
+template<typename T>
+class ResourcePool {
+public:
+    ResourcePool() = default;
+
+    ~ResourcePool() {
+        const uint32_t slotCount = _slotCount.load(std::memory_order_relaxed);
+        for (uint32_t index = 0; index < slotCount; ++index) {
+            delete getSlot(index)->resource.load(std::memory_order_relaxed);
+        }
+        for (std::atomic<Slot*>& page : _pages) {
+            delete[] page.load(std::memory_order_relaxed);
+        }
+    }
+
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    /**
+     * @brief Takes ownership of a resource, reusing a free slot if there is one.
+     * @param resource The resource to add.
+     * @return ResourceHandle The handle of the resource.
+     */
+    ResourceHandle add(std::unique_ptr<T> resource) {
+        std::lock_guard lock(_writeMutex);
+
+        uint32_t index;
+        if (!_freeIndices.empty()) {
+            index = _freeIndices.front();
+            _freeIndices.pop_front();
+        } else {
+            index = _slotCount.load(std::memory_order_relaxed);
+            LF_ASSERT_MSG(index <= RESOURCE_HANDLE_INDEX_MASK, "Resource pool is full.");
+
+            std::atomic<Slot*>& page = _pages[index >> PAGE_BITS];
+            if (!page.load(std::memory_order_relaxed)) {
+                page.store(new Slot[PAGE_SIZE], std::memory_order_release);
+            }
+            getSlot(index)->state.store(makeState(1, 0), std::memory_order_relaxed);
+            _slotCount.store(index + 1, std::memory_order_release);
+        }
+
+        // The generation was bumped when the slot was freed, so handles to its last resource are already stale
+        Slot* slot = getSlot(index);
+        slot->lastUsed.store(_clock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slot->resource.store(resource.release(), std::memory_order_release);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        return makeHandle(index, getStateGeneration(slot->state.load(std::memory_order_relaxed)));
+    }
+
+    /**
+     * @brief Gets the resource a handle refers to. Wait-free.
+     * @param handle The handle of the resource.
+     * @return T* The resource, or nullptr if the handle is invalid or the resource has been removed. Stays valid until
+     * the next reclaim().
+     */
+    T* get(ResourceHandle handle) const {
+        const Slot* slot = findSlot(handle);
+        if (!slot) {
+            return nullptr;
+        }
+
+        // Checking the generation again catches the slot being freed and reused between the two loads
+        T* resource = slot->resource.load(std::memory_order_acquire);
+        return getStateGeneration(slot->state.load(std::memory_order_relaxed)) == getHandleGeneration(handle) ? resource : nullptr;
+    }
+
+    /**
+     * @brief Checks whether a handle refers to a resource in the pool.
+     * @param handle The handle to check.
+     * @return true if the handle is valid and not stale.
+     */
+    bool contains(ResourceHandle handle) const { return get(handle) != nullptr; }
+
+    /**
+     * @brief Replaces the resource a handle refers to, keeping the handle valid.
+     * @param handle The handle of the resource.
+     * @param resource The new resource. The previous one is retired until the next reclaim().
+     * @return true if the handle was valid and the resource was replaced.
+     */
+    bool replace(ResourceHandle handle, std::unique_ptr<T> resource) {
+        std::lock_guard lock(_writeMutex);
+        if (!contains(handle)) {
+            return false;
+        }
+        _retired.emplace_back(getSlot(getHandleIndex(handle))->resource.exchange(resource.release(), std::memory_order_acq_rel));
+        return true;
+    }
+
+    /**
+     * @brief Removes a resource and frees its slot. The resource is retired until the next reclaim().
+     * @param handle The handle of the resource.
+     * @return true if the handle was valid and the resource was removed.
+     */
+    bool remove(ResourceHandle handle) {
+        std::lock_guard lock(_writeMutex);
+        if (!contains(handle)) {
+            return false;
+        }
+
+        const uint32_t index = getHandleIndex(handle);
+        Slot* slot = getSlot(index);
+
+        // Bumping the generation first makes lookups racing with the removal fail rather than see the slot empty
+        const uint32_t generation = getHandleGeneration(handle) + 1;
+        slot->state.store(makeState(generation, 0), std::memory_order_release);
+        _retired.emplace_back(slot->resource.exchange(nullptr, std::memory_order_acq_rel));
+
+        // The last generation is never handed out, so a slot reaching it is retired rather than wrapping around
+        if (generation < RESOURCE_HANDLE_GENERATION_MASK) {
+            _freeIndices.push_back(index);
+        }
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Destroys the resources removed or replaced since the last call. Call it once a frame, at a point where
+     * no thread still holds a pointer it got from get() earlier in the frame.
+     */
+    void reclaim() {
+        std::vector<std::unique_ptr<T>> retired;
+        {
+            std::lock_guard lock(_writeMutex);
+            retired.swap(_retired);
+        }
+    }
+
+    /**
+     * @brief Adds a reference to a resource, keeping it from being unloaded for being unused.
+     * @param handle The handle of the resource.
+     * @return true if the handle was valid.
+     */
+    bool acquire(ResourceHandle handle) {
+        Slot* slot = findSlot(handle);
+        if (!slot) {
+            return false;
+        }
+
+        // The count only changes while the generation still matches, so a racing removal can't be counted against
+        uint64_t state = slot->state.load(std::memory_order_relaxed);
+        do {
+            if (getStateGeneration(state) != getHandleGeneration(handle)) {
+                return false;
+            }
+        } while (!slot->state.compare_exchange_weak(state, state + 1, std::memory_order_relaxed));
+
+        slot->lastUsed.store(_clock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Drops a reference added by acquire(). Stale handles are ignored, as the resource is already gone.
+     * @param handle The handle of the resource.
+     */
+    void release(ResourceHandle handle) {
+        Slot* slot = findSlot(handle);
+        if (!slot) {
+            return;
+        }
+
+        uint64_t state = slot->state.load(std::memory_order_relaxed);
+        do {
+            if (getStateGeneration(state) != getHandleGeneration(handle)) {
+                return;
+            }
+            LF_ASSERT_MSG(getStateRefCount(state) > 0, "Resource released more times than it was acquired.");
+        } while (!slot->state.compare_exchange_weak(state, state - 1, std::memory_order_relaxed));
+
+        slot->lastUsed.store(_clock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of references held to a resource, or 0 if the handle is invalid.
+     */
+    uint32_t getRefCount(ResourceHandle handle) const {
+        const Slot* slot = findSlot(handle);
+        if (!slot) {
+            return 0;
+        }
+        const uint64_t state = slot->state.load(std::memory_order_relaxed);
+        return getStateGeneration(state) == getHandleGeneration(handle) ? getStateRefCount(state) : 0;
+    }
+
+    /**
+     * @brief Records that a resource was used at the current time.
+     * @param handle The handle of the resource.
+     */
+    void touch(ResourceHandle handle) {
+        if (Slot* slot = findSlot(handle)) {
+            slot->lastUsed.store(_clock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Gets the time a resource was last added, acquired, released or touched, or 0 if the handle is invalid.
+     */
+    uint64_t getLastUsed(ResourceHandle handle) const {
+        const Slot* slot = findSlot(handle);
+        return slot ? slot->lastUsed.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief Advances the clock resource use is recorded against, usually once a frame.
+     */
+    void advanceClock() { _clock.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the current time of the usage clock.
+     */
+    uint64_t getClock() const { return _clock.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of resources in the pool.
+     */
+    size_t size() const { return _count.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Calls a function for every resource in the pool, in slot order. Resources added or removed while it
+     * runs may or may not be visited.
+     * @param function Called with the handle and a reference to each resource.
+     */
+    template<typename Function>
+    void forEach(Function&& function) const {
+        const uint32_t slotCount = _slotCount.load(std::memory_order_acquire);
+        for (uint32_t index = 0; index < slotCount; ++index) {
+            const ResourceHandle handle = makeHandle(index, getStateGeneration(getSlot(index)->state.load(std::memory_order_acquire)));
+            if (T* resource = get(handle)) {
+                function(handle, *resource);
+            }
+        }
+    }
+
+private:
+
+    // Slots are allocated a page at a time, so pages never move and lookups need no lock
+    static constexpr uint32_t PAGE_BITS = 10;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr uint32_t PAGE_COUNT = (RESOURCE_HANDLE_INDEX_MASK + 1) / PAGE_SIZE;
+
+    /**
+     * @brief A resource, the generation handles to it must match, and the references held to it.
+     * The generation is the high half of the state and the reference count the low half.
+     */
+    struct Slot {
+        std::atomic<T*> resource = nullptr;
+        std::atomic<uint64_t> state = 0;
+        std::atomic<uint64_t> lastUsed = 0;
+    };
+
+    static constexpr uint64_t makeState(uint32_t generation, uint32_t refCount) {
+        return (static_cast<uint64_t>(generation) << 32) | refCount;
+    }
+
+    static constexpr uint32_t getStateGeneration(uint64_t state) { return static_cast<uint32_t>(state >> 32); }
+
+    static constexpr uint32_t getStateRefCount(uint64_t state) { return static_cast<uint32_t>(state); }
+
+    /**
+     * @brief Gets a slot that has been allocated.
+     */
+    Slot* getSlot(uint32_t index) const {
+        return &_pages[index >> PAGE_BITS].load(std::memory_order_acquire)[index & (PAGE_SIZE - 1)];
+    }
+
+    /**
+     * @brief Gets the slot a handle refers to, or nullptr if its slot was never allocated. The slot may have been
+     * reused since, so callers must still check its generation.
+     */
+    Slot* findSlot(ResourceHandle handle) const {
+        const uint32_t index = getHandleIndex(handle);
+        if (index >= _slotCount.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        Slot* slot = getSlot(index);
+        return getStateGeneration(slot->state.load(std::memory_order_acquire)) == getHandleGeneration(handle) ? slot : nullptr;
+    }
+
+    // Pages of slots in index order, allocated as they are needed; a slot's resource is null while it is free
+    std::array<std::atomic<Slot*>, PAGE_COUNT> _pages = {};
+
+    // Number of slots ever allocated
+    std::atomic<uint32_t> _slotCount = 0;
+
+    // Serialises adding, replacing and removing resources
+    std::mutex _writeMutex;
+
+    // Indices of free slots, reused least recently freed first
+    std::deque<uint32_t> _freeIndices;
+
+    // Resources removed or replaced since the last reclaim()
+    std::vector<std::unique_ptr<T>> _retired;
+
+    // Number of occupied slots
+    std::atomic<size_t> _count = 0;
+
+    // Time resource use is recorded against
+    std::atomic<uint64_t> _clock = 0;
+};
@@ -0,0 +1,106 @@
+/**
+ * @file ResourceRef.h
+ * @author Justin McKay
+ * @brief Counted reference to a resource owned by the ResourceManager.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "resources/ResourcePool.h"
+
+#include <utility>
+
+/**
+ * @brief Keeps a resource loaded for as long as the reference is held.
+ *
+ * Obtained from ResourceManager::acquire(). While any reference to a resource is held, the manager never unloads
+ * it to meet a memory budget. A reference made from a bare handle is not counted and keeps nothing loaded; it exists
+ * so code can hold either kind in one place.
+ *
+ * References are not thread safe, and must be released before the ResourceManager that issued them is destroyed.
+ *
+ * @tparam T The resource type.
+ */
+template<typename T>
+class ResourceRef {
+public:
+    ResourceRef() = default;
+
+    /**
+     * @brief Wraps a bare handle without counting a reference.
+     * @param handle The handle of the resource.
+     */
+    explicit ResourceRef(ResourceHandle handle) : _handle(handle) {}
+
+    ResourceRef(const ResourceRef& other) : _pool(other._pool), _handle(other._handle) {
+        if (_pool) {
+            _pool->acquire(_handle);
+        }
+    }
+
+    ResourceRef(ResourceRef&& other) noexcept
+        : _pool(std::exchange(other._pool, nullptr)), _handle(std::exchange(other._handle, 0)) {}
+
+    ResourceRef& operator=(ResourceRef other) noexcept {
+        std::swap(_pool, other._pool);
+        std::swap(_handle, other._handle);
+        return *this;
+    }
+
+    ~ResourceRef() { reset(); }
+
+    /**
+     * @brief Drops the reference, leaving this empty.
+     */
+    void reset() {
+        if (_pool) {
+            _pool->release(_handle);
+        }
+        _pool = nullptr;
+        _handle = 0;
+    }
+
+    /**
+     * @brief Gets the handle of the resource, or 0 if this is empty.
+     */
+    ResourceHandle getHandle() const { return _handle; }
+
+    /**
+     * @brief Gets the resource and records that it was used.
+     * @return T* The resource, or nullptr if this is empty, not counted, or the resource was unloaded explicitly.
+     */
+    T* get() const {
+        if (!_pool) {
+            return nullptr;
+        }
+        _pool->touch(_handle);
+        return _pool->get(_handle);
+    }
+
+    /**
+     * @brief Checks whether the reference is counted, and so keeps the resource loaded.
+     */
+    bool isCounted() const { return _pool != nullptr; }
+
+    /**
+     * @brief Checks whether the reference refers to a resource.
+     */
+    explicit operator bool() const { return _handle != 0; }
+
+private:
+    friend class ResourceManager;
+
+    /**
+     * @brief Counts a reference to a resource in a pool. The handle must be valid.
+     */
+    ResourceRef(ResourcePool<T>& pool, ResourceHandle handle) : _pool(&pool), _handle(handle) {
+        _pool->acquire(_handle);
+    }
+
+    // Pool the resource lives in, or nullptr for empty and uncounted references
+    ResourcePool<T>* _pool = nullptr;
+
+    // Handle of the resource
+    ResourceHandle _handle = 0;
+};
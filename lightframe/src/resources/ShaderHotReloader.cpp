@@ -0,0 +1,126 @@
+#include "ShaderHotReloader.h"
+
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "rendering/ShaderPreprocessor.h"
+#include "resources/ResourceManager.h"
+
+#include <algorithm>
+
+ShaderHotReloader::ShaderHotReloader(ResourceManager& resourceManager)
+        : _resourceManager(resourceManager), _fileWatcher(FileWatcher::create()) {}
+
+void ShaderHotReloader::watchShader(ShaderHandle handle, const std::string& shaderPath) {
+    // The preprocessor caches file contents, so this is cheap for a shader that has just been loaded
+    setDependencies(handle, ShaderPreprocessor::get()->process(shaderPath).dependencies);
+}
+
+void ShaderHotReloader::unwatchShader(ShaderHandle handle) {
+    setDependencies(handle, {});
+    std::erase_if(_pendingReloads, [handle](const PendingReload& reload) { return reload.handle == handle; });
+    std::erase_if(_pendingWatches, [handle](const PendingWatch& watch) { return watch.handle == handle; });
+}
+
+void ShaderHotReloader::update() {
+
+    _changedFiles.clear();
+    _fileWatcher->poll(_changedFiles);
+
+    if (!_changedFiles.empty()) {
+        std::unordered_set<ShaderHandle> changedShaders;
+        for (const std::string& filePath : _changedFiles) {
+            LOG_DEBUG("Shader source changed: {}", filePath);
+            ShaderPreprocessor::get()->invalidate(filePath);
+
+            auto it = _dependents.find(filePath);
+            if (it != _dependents.end()) {
+                changedShaders.insert(it->second.begin(), it->second.end());
+            }
+        }
+
+        for (ShaderHandle handle : changedShaders) {
+            queueReload(handle);
+        }
+    }
+
+    std::erase_if(_pendingWatches, [this](PendingWatch& watch) {
+        if (watch.dependencies.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        // A shader that can't be read mid-save has no dependencies, so it keeps the ones it had until it can be
+        std::vector<std::string> dependencies = watch.dependencies.get();
+        if (!dependencies.empty()) {
+            setDependencies(watch.handle, dependencies);
+        }
+        return true;
+    });
+
+    // Swap in every recompile that has finished; the rest keep compiling while the old programs stay in use
+    std::erase_if(_pendingReloads, [this](PendingReload& reload) {
+        switch (reload.shader->getStatus()) {
+            case ShaderStatus::Pending:
+                return false;
+            case ShaderStatus::Ready:
+                LOG_INFO("Reloaded shader {} (variant {:#x}).",
+                    _resourceManager.getShaderPath(reload.handle), reload.features);
+                _resourceManager.replaceShader(reload.handle, reload.features, std::move(reload.shader));
+                return true;
+            case ShaderStatus::Failed:
+                LOG_WARN("Failed to reload shader {} (variant {:#x}); keeping the previous version.",
+                    _resourceManager.getShaderPath(reload.handle), reload.features);
+                return true;
+        }
+        return true;
+    });
+}
+
+void ShaderHotReloader::queueReload(ShaderHandle handle) {
+    const std::string& shaderPath = _resourceManager.getShaderPath(handle);
+
+    for (ShaderFeatureMask features : _resourceManager.getShaderVariantFeatures(handle)) {
+        // A newer edit supersedes any recompile of the same program that is still in flight
+        std::erase_if(_pendingReloads, [&](const PendingReload& reload) {
+            return reload.handle == handle && reload.features == features;
+        });
+
+        _pendingReloads.push_back(PendingReload {
+            .handle = handle,
+            .features = features,
+            .shader = Shader::createAsync(shaderPath, features)
+        });
+    }
+
+    // The edit may have added or removed includes, so rescan the dependencies. The files were just invalidated, so this
+    // reads them again, which is done on a worker alongside the recompiles rather than stalling the frame
+    std::erase_if(_pendingWatches, [handle](const PendingWatch& watch) { return watch.handle == handle; });
+    _pendingWatches.push_back(PendingWatch {
+        .handle = handle,
+        .dependencies = ThreadPool::get()->submit([shaderPath]() {
+            return ShaderPreprocessor::get()->process(shaderPath).dependencies;
+        })
+    });
+}
+
+void ShaderHotReloader::setDependencies(ShaderHandle handle, const std::vector<std::string>& dependencies) {
+    // Files the shader no longer includes stop reloading it, and stop being watched once nothing includes them
+    const std::unordered_set<std::string> current(dependencies.begin(), dependencies.end());
+    for (auto it = _dependents.begin(); it != _dependents.end();) {
+        if (!current.contains(it->first)) {
+            it->second.erase(handle);
+        }
+        if (it->second.empty()) {
+            _fileWatcher->unwatch(it->first);
+            it = _dependents.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const std::string& dependency : dependencies) {
+        auto [it, inserted] = _dependents.try_emplace(dependency);
+        if (inserted) {
+            _fileWatcher->watch(dependency);
+        }
+        it->second.insert(handle);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ShaderHotReloader.h
+ * @author Justin McKay
+ * @brief Recompiles shaders in the background when their source files change, swapping them in once linked.
+ * @date 2026-03-09
+ */
+
+#pragma once
+
+#include "platform/FileWatcher.h"
+#include "rendering/Renderer.h"
+#include "rendering/Shader.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class ResourceManager;
+
+class ShaderHotReloader {
+public:
+    explicit ShaderHotReloader(ResourceManager& resourceManager);
+
+    /**
+     * @brief Watches a shader's source file and every file it includes.
+     * @param handle The handle of the shader.
+     * @param shaderPath The file path of the .shader file.
+     */
+    void watchShader(ShaderHandle handle, const std::string& shaderPath);
+
+    /**
+     * @brief Stops watching the sources of a shader and abandons any reload of it in progress.
+     * @param handle The handle of the shader being unloaded.
+     */
+    void unwatchShader(ShaderHandle handle);
+
+    /**
+     * @brief Submits recompiles for shaders whose sources changed and swaps in any that have finished linking.
+     *
+     * Must be called on the render thread between frames, so no shader being replaced is in use. A shader that fails
+     * to compile is reported and the previous program is kept, so a typo never takes down the running scene.
+     */
+    void update();
+
+    /**
+     * @brief Gets the number of shader programs waiting on a background recompile.
+     * @return size_t The pending reload count.
+     */
+    size_t getPendingCount() const { return _pendingReloads.size(); }
+
+private:
+
+    /**
+     * @brief A shader permutation being recompiled in the background.
+     */
+    struct PendingReload {
+        ShaderHandle handle;
+        ShaderFeatureMask features;
+        std::unique_ptr<Shader> shader;
+    };
+
+    /**
+     * @brief The files a reloaded shader is built from, being found by preprocessing it on a worker.
+     */
+    struct PendingWatch {
+        ShaderHandle handle;
+        std::future<std::vector<std::string>> dependencies;
+    };
+
+    // Owner of the shaders being reloaded
+    ResourceManager& _resourceManager;
+
+    // Platform watcher reporting changes to source files
+    std::unique_ptr<FileWatcher> _fileWatcher;
+
+    // The shaders built from each watched file, keyed by absolute normalised path
+    std::unordered_map<std::string, std::unordered_set<ShaderHandle>> _dependents;
+
+    // Recompiles that have been submitted but not yet finished
+    std::vector<PendingReload> _pendingReloads;
+
+    // Dependency scans of reloaded shaders that have not yet finished
+    std::vector<PendingWatch> _pendingWatches;
+
+    // Scratch list of changed files, reused between updates
+    std::vector<std::string> _changedFiles;
+
+    /**
+     * @brief Submits a recompile of a shader and every permutation of it that has been created.
+     * @param handle The handle of the shader to reload.
+     */
+    void queueReload(ShaderHandle handle);
+
+    /**
+     * @brief Replaces the files a shader is built from, watching any not already watched and unwatching those no
+     * shader is built from any more.
+     * @param handle The handle of the shader.
+     * @param dependencies The absolute normalised paths of the files.
+     */
+    void setDependencies(ShaderHandle handle, const std::vector<std::string>& dependencies);
+};
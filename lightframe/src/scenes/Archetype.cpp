@@ -0,0 +1,100 @@
+#include "Archetype.h"
+
+#include "debug/Assertions.h"
+
+#include <algorithm>
+#include <new>
+
+// Chunks start on a cache line, so arrays of small components don't share lines with a neighbouring allocation
+static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+static size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+Archetype::Archetype(const ComponentMask& mask) : _mask(mask) {
+    _columnsByType.fill(-1);
+
+    size_t rowBytes = sizeof(Entity);
+    _chunkAlignment = CHUNK_ALIGNMENT;
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENT_TYPES; ++typeId) {
+        if (!_mask.test(typeId)) {
+            continue;
+        }
+
+        const ComponentTypeInfo& info = getComponentTypeInfo(typeId);
+        _columnsByType[typeId] = static_cast<int16_t>(_types.size());
+        _types.push_back(typeId);
+        _columns.push_back(Column { .info = info, .offset = 0 });
+        rowBytes += info.size;
+        _chunkAlignment = std::max(_chunkAlignment, info.alignment);
+    }
+
+    // Fit as many rows as the chunk holds once each array is aligned; a row too large for a chunk gets a chunk of its own
+    _chunkCapacity = static_cast<uint32_t>(std::max<size_t>(1, CHUNK_BYTES / rowBytes));
+    while (true) {
+        size_t offset = sizeof(Entity) * _chunkCapacity;
+        for (Column& column : _columns) {
+            offset = alignUp(offset, column.info.alignment);
+            column.offset = offset;
+            offset += column.info.size * _chunkCapacity;
+        }
+        if (offset <= CHUNK_BYTES || _chunkCapacity == 1) {
+            _chunkBytes = alignUp(std::max(offset, CHUNK_BYTES), _chunkAlignment);
+            break;
+        }
+        --_chunkCapacity;
+    }
+}
+
+Archetype::~Archetype() {
+    for (size_t chunk = 0; chunk < _chunks.size(); ++chunk) {
+        for (uint32_t row = 0; row < _chunks[chunk].count; ++row) {
+            destroyRow(ArchetypeRow { static_cast<uint32_t>(chunk), row });
+        }
+        ::operator delete(_chunks[chunk].data, std::align_val_t(_chunkAlignment));
+    }
+}
+
+ArchetypeRow Archetype::allocateRow(Entity entity) {
+    if (_chunks.empty() || _chunks.back().count == _chunkCapacity) {
+        auto* data = static_cast<std::byte*>(::operator new(_chunkBytes, std::align_val_t(_chunkAlignment)));
+        _chunks.push_back(Chunk { .data = data, .count = 0 });
+    }
+
+    Chunk& chunk = _chunks.back();
+    const ArchetypeRow location { static_cast<uint32_t>(_chunks.size() - 1), chunk.count++ };
+    getEntities(location.chunk)[location.row] = entity;
+    ++_entityCount;
+    return location;
+}
+
+void Archetype::destroyRow(ArchetypeRow location) {
+    for (size_t column = 0; column < _columns.size(); ++column) {
+        _columns[column].info.destroy(getComponent(location, column));
+    }
+}
+
+Entity Archetype::removeRow(ArchetypeRow location) {
+    LF_ASSERT_MSG(location.chunk < _chunks.size() && location.row < _chunks[location.chunk].count, "Row out of range.");
+
+    const ArchetypeRow last { static_cast<uint32_t>(_chunks.size() - 1), _chunks.back().count - 1 };
+    Entity moved = NULL_ENTITY;
+    if (location.chunk != last.chunk || location.row != last.row) {
+        for (size_t column = 0; column < _columns.size(); ++column) {
+            void* source = getComponent(last, column);
+            _columns[column].info.moveConstruct(getComponent(location, column), source);
+            _columns[column].info.destroy(source);
+        }
+        moved = getEntities(last.chunk)[last.row];
+        getEntities(location.chunk)[location.row] = moved;
+    }
+
+    // Emptied chunks are freed straight away, so an archetype that shrinks gives its memory back
+    if (--_chunks.back().count == 0) {
+        ::operator delete(_chunks.back().data, std::align_val_t(_chunkAlignment));
+        _chunks.pop_back();
+    }
+    --_entityCount;
+    return moved;
+}
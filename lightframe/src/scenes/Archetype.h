@@ -0,0 +1,187 @@
+/**
+ * @file Archetype.h
+ * @author Justin McKay
+ * @brief Chunked, column-per-component storage for every entity with the same set of component types.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "ComponentType.h"
+#include "Entity.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Where an entity's components are stored within its archetype.
+ */
+struct ArchetypeRow {
+    uint32_t chunk = 0;
+    uint32_t row = 0;
+};
+
+/**
+ * @brief Stores the components of every entity that has exactly one set of component types.
+ *
+ * Entities are packed into fixed-size chunks. Within a chunk each component type has its own contiguous array,
+ * alongside an array of the entities themselves, so a query over a few component types reads just those arrays
+ * front to back. Rows are kept dense: removing one moves the archetype's last row into the gap, so every chunk but
+ * the last is full and iteration never skips holes.
+ *
+ * The archetype's set of types is kept as a mask, and a table indexed by component type ID gives each type's column,
+ * so checking for and finding a component are constant time whatever the number of types.
+ */
+class Archetype {
+public:
+
+    /// Size of a chunk, chosen so a chunk's arrays stay within the L1 and L2 caches while being iterated
+    static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+    /**
+     * @brief Creates an empty archetype.
+     * @param mask The component types of its entities.
+     */
+    explicit Archetype(const ComponentMask& mask);
+
+    /**
+     * @brief Destroys the components of every entity still stored and frees the chunks.
+     */
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    /**
+     * @brief Gets the component types of the archetype's entities, sorted by ID.
+     */
+    const std::vector<ComponentTypeId>& getTypes() const { return _types; }
+
+    /**
+     * @brief Gets the component types of the archetype's entities as a mask.
+     */
+    const ComponentMask& getMask() const { return _mask; }
+
+    /**
+     * @brief Finds the column holding a component type.
+     * @return int The column index, or -1 if entities of this archetype don't have the type.
+     */
+    int findColumn(ComponentTypeId typeId) const { return _columnsByType[typeId]; }
+
+    /**
+     * @brief Checks whether entities of this archetype have every one of a set of component types.
+     * @param mask The component types.
+     */
+    bool containsAll(const ComponentMask& mask) const { return (_mask & mask) == mask; }
+
+    /**
+     * @brief Gets the number of entities stored.
+     */
+    size_t getEntityCount() const { return _entityCount; }
+
+    /**
+     * @brief Gets the number of chunks allocated.
+     */
+    size_t getChunkCount() const { return _chunks.size(); }
+
+    /**
+     * @brief Gets the number of entities a chunk holds.
+     */
+    uint32_t getChunkCapacity() const { return _chunkCapacity; }
+
+    /**
+     * @brief Gets the number of entities stored in a chunk.
+     */
+    uint32_t getRowCount(size_t chunk) const { return _chunks[chunk].count; }
+
+    /**
+     * @brief Gets the array of entities stored in a chunk.
+     */
+    Entity* getEntities(size_t chunk) const { return reinterpret_cast<Entity*>(_chunks[chunk].data); }
+
+    /**
+     * @brief Gets the array of one component type in a chunk.
+     * @param chunk The chunk index.
+     * @param column The column index, as returned by findColumn().
+     */
+    void* getColumn(size_t chunk, size_t column) const { return _chunks[chunk].data + _columns[column].offset; }
+
+    /**
+     * @brief Gets one component of one entity.
+     * @param location Where the entity is stored.
+     * @param column The column index, as returned by findColumn().
+     */
+    void* getComponent(ArchetypeRow location, size_t column) const {
+        return static_cast<std::byte*>(getColumn(location.chunk, column)) + location.row * _columns[column].info.size;
+    }
+
+    /**
+     * @brief Appends a row for an entity. Its components are left uninitialised for the caller to construct.
+     * @param entity The entity the row belongs to.
+     * @return ArchetypeRow Where the row was added.
+     */
+    ArchetypeRow allocateRow(Entity entity);
+
+    /**
+     * @brief Destroys the components of a row.
+     * @param location The row.
+     */
+    void destroyRow(ArchetypeRow location);
+
+    /**
+     * @brief Removes a row whose components have already been destroyed or moved out, moving the last row into its
+     * place.
+     * @param location The row to remove.
+     * @return Entity The entity moved into the row, whose location must be updated, or NULL_ENTITY if the removed row
+     * was the last.
+     */
+    Entity removeRow(ArchetypeRow location);
+
+private:
+    friend class World;
+
+    /**
+     * @brief A component type's array within each chunk.
+     */
+    struct Column {
+        ComponentTypeInfo info;
+        size_t offset;
+    };
+
+    /**
+     * @brief A block of storage for a chunk's entities and components, and how many rows are in use.
+     */
+    struct Chunk {
+        std::byte* data;
+        uint32_t count;
+    };
+
+    // Component types of the archetype's entities, sorted by ID
+    std::vector<ComponentTypeId> _types;
+
+    // The same types as a mask
+    ComponentMask _mask;
+
+    // Column of each component type, indexed by type ID, or -1 for types the archetype doesn't have
+    std::array<int16_t, MAX_COMPONENT_TYPES> _columnsByType;
+
+    // Layout of each component type within a chunk, in the same order as _types
+    std::vector<Column> _columns;
+
+    // Chunks, all full except the last
+    std::vector<Chunk> _chunks;
+
+    // Number of rows a chunk holds, and the size and alignment of its storage
+    uint32_t _chunkCapacity = 0;
+    size_t _chunkBytes = 0;
+    size_t _chunkAlignment = 0;
+
+    size_t _entityCount = 0;
+
+    // Archetypes reached by adding or removing one component type, cached so structural changes don't search
+    std::unordered_map<ComponentTypeId, Archetype*> _addEdges;
+    std::unordered_map<ComponentTypeId, Archetype*> _removeEdges;
+};
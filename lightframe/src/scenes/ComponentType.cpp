@@ -0,0 +1,40 @@
+#include "ComponentType.h"
+
+#include "GameObject3D.h"
+#include "components/MeshRenderer.h"
+#include "debug/Assertions.h"
+
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Gets the registered component types, indexed by ID, with the engine component types at their fixed IDs.
+ * Deque, so references handed out stay valid as more types are registered.
+ */
+static std::deque<ComponentTypeInfo>& getComponentTypes() {
+    static std::deque<ComponentTypeInfo> componentTypes = {
+        makeComponentTypeInfo<Transform3D>(),
+        makeComponentTypeInfo<MeshRenderer>()
+    };
+    return componentTypes;
+}
+
+static_assert(ENGINE_COMPONENT_TYPE_ID<Transform3D> == 0 && ENGINE_COMPONENT_TYPE_ID<MeshRenderer> == 1
+    && ENGINE_COMPONENT_TYPE_COUNT == 2, "Engine component types must be registered in the order of their IDs");
+
+static std::mutex s_ComponentTypesMutex;
+
+ComponentTypeId registerComponentType(const ComponentTypeInfo& info) {
+    std::lock_guard lock(s_ComponentTypesMutex);
+    std::deque<ComponentTypeInfo>& componentTypes = getComponentTypes();
+    LF_ASSERT_MSG(componentTypes.size() < MAX_COMPONENT_TYPES, "Too many component types; raise MAX_COMPONENT_TYPES.");
+    componentTypes.push_back(info);
+    return static_cast<ComponentTypeId>(componentTypes.size() - 1);
+}
+
+const ComponentTypeInfo& getComponentTypeInfo(ComponentTypeId typeId) {
+    std::lock_guard lock(s_ComponentTypesMutex);
+    const std::deque<ComponentTypeInfo>& componentTypes = getComponentTypes();
+    LF_ASSERT_MSG(typeId < componentTypes.size(), "Unknown component type.");
+    return componentTypes[typeId];
+}
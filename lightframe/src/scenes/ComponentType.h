@@ -0,0 +1,126 @@
+/**
+ * @file ComponentType.h
+ * @author Justin McKay
+ * @brief Type-erased descriptions of the component types stored in a World.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+struct Transform3D;
+class MeshRenderer;
+
+/**
+ * @brief Identifies a component type. Engine components have fixed IDs from 0; other types are given the following
+ * IDs densely, the first time each is used.
+ */
+using ComponentTypeId = uint32_t;
+
+/// Most component types a program can use, so a set of them fits in a fixed-size mask
+constexpr size_t MAX_COMPONENT_TYPES = 128;
+
+/// A type that doesn't have a fixed ID
+constexpr ComponentTypeId INVALID_COMPONENT_TYPE_ID = ~0u;
+
+/**
+ * @brief A set of component types, one bit per ID.
+ */
+using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+/**
+ * @brief The fixed ID of an engine component type, known at compile time so lookups of the components every renderable
+ * entity has don't go through registration.
+ */
+template<typename T>
+inline constexpr ComponentTypeId ENGINE_COMPONENT_TYPE_ID = INVALID_COMPONENT_TYPE_ID;
+
+template<>
+inline constexpr ComponentTypeId ENGINE_COMPONENT_TYPE_ID<Transform3D> = 0;
+
+template<>
+inline constexpr ComponentTypeId ENGINE_COMPONENT_TYPE_ID<MeshRenderer> = 1;
+
+/// Number of engine component types, registered before any other type
+constexpr ComponentTypeId ENGINE_COMPONENT_TYPE_COUNT = 2;
+
+/**
+ * @brief How to lay out, move and destroy components of one type, so archetypes can store them without knowing it.
+ */
+struct ComponentTypeInfo {
+    size_t size;
+    size_t alignment;
+
+    /** Move-constructs a component into uninitialised storage, leaving the source to be destroyed */
+    void (*moveConstruct)(void* destination, void* source);
+
+    /** Destroys a component in place */
+    void (*destroy)(void* component);
+};
+
+/**
+ * @brief Describes how to lay out, move and destroy components of a type.
+ * @tparam T The component type. Must be move constructible.
+ */
+template<typename T>
+ComponentTypeInfo makeComponentTypeInfo() {
+    static_assert(std::is_move_constructible_v<T>, "Components are moved between archetypes, so must be move constructible");
+
+    return ComponentTypeInfo {
+        .size = sizeof(T),
+        .alignment = alignof(T),
+        .moveConstruct = [](void* destination, void* source) {
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        },
+        .destroy = [](void* component) {
+            static_cast<T*>(component)->~T();
+        }
+    };
+}
+
+/**
+ * @brief Registers a component type, giving it the next ID after the engine component types.
+ * @param info How to lay out, move and destroy components of the type.
+ * @return ComponentTypeId The ID of the type.
+ */
+ComponentTypeId registerComponentType(const ComponentTypeInfo& info);
+
+/**
+ * @brief Gets the description of a registered component type.
+ * @param typeId The ID of the type.
+ */
+const ComponentTypeInfo& getComponentTypeInfo(ComponentTypeId typeId);
+
+/**
+ * @brief Gets the ID of a component type. Engine component types return their fixed ID; other types are registered
+ * on first use. Const-qualified types share the ID of the unqualified type.
+ * @tparam T The component type. Must be move constructible.
+ */
+template<typename T>
+ComponentTypeId getComponentTypeId() {
+    if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+        return getComponentTypeId<std::remove_cv_t<T>>();
+    } else if constexpr (ENGINE_COMPONENT_TYPE_ID<T> != INVALID_COMPONENT_TYPE_ID) {
+        return ENGINE_COMPONENT_TYPE_ID<T>;
+    } else {
+        static const ComponentTypeId typeId = registerComponentType(makeComponentTypeInfo<T>());
+        return typeId;
+    }
+}
+
+/**
+ * @brief Gets the set of a number of component types.
+ * @tparam Ts The component types.
+ */
+template<typename... Ts>
+ComponentMask getComponentMask() {
+    ComponentMask mask;
+    (mask.set(getComponentTypeId<Ts>()), ...);
+    return mask;
+}
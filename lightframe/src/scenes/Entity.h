@@ -0,0 +1,45 @@
+/**
+ * @file Entity.h
+ * @author Justin McKay
+ * @brief 32-bit generational entity IDs for the scene world.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Identifies an entity in a World: a slot index in the low bits and the slot's generation in the high bits.
+ * An entity of 0 never refers to a live entity.
+ */
+using Entity = uint32_t;
+
+/// An entity that refers to nothing
+constexpr Entity NULL_ENTITY = 0;
+
+/// Number of entity bits holding the slot index, allowing about sixteen million entities per world
+constexpr uint32_t ENTITY_INDEX_BITS = 24;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = (1u << (32 - ENTITY_INDEX_BITS)) - 1;
+
+/**
+ * @brief Gets the slot index of an entity.
+ */
+constexpr uint32_t getEntityIndex(Entity entity) {
+    return entity & ENTITY_INDEX_MASK;
+}
+
+/**
+ * @brief Gets the slot generation of an entity.
+ */
+constexpr uint32_t getEntityGeneration(Entity entity) {
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+/**
+ * @brief Packs a slot index and generation into an entity.
+ */
+constexpr Entity makeEntity(uint32_t index, uint32_t generation) {
+    return (generation << ENTITY_INDEX_BITS) | index;
+}
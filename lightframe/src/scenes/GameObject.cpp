@@ -1,7 +1,24 @@
 #include "GameObject.h"
 
+#include "Scene.h"
 #include "core/ObjectId.h"
 
 GameObject::GameObject(ObjectId id)
     : _id(id) {}
 
+GameObject::~GameObject() {
+    if (_scene) {
+        _scene->getWorld().destroyEntity(_entity);
+    }
+}
+
+void GameObject::setScene(Scene* scene) {
+    LF_ASSERT_MSG(!_scene, "A game object can only be added to one scene.");
+    _scene = scene;
+    _entity = _scene->getWorld().createEntity();
+    onAddedToScene();
+}
+
+World& GameObject::getWorld() const {
+    return _scene->getWorld();
+}
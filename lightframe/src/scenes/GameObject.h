@@ -2,15 +2,24 @@
 #pragma once
 
 #include "core/ObjectId.h"
+#include "debug/Assertions.h"
 
+#include "Entity.h"
+#include "World.h"
 #include "components/Component.h"
 
-#include <memory>
-#include <vector>
+#include <type_traits>
 
 // Forward declare Scene to avoid circular dependency between GameObject and Scene.
 class Scene;
 
+/**
+ * @brief An object in a scene with an identity and a hierarchy, whose components are stored in the scene's World.
+ *
+ * A game object is a convenience over an entity. Its components live with those of every other entity in the
+ * world's archetype chunks, not in the object, so systems can iterate them as arrays without going through game
+ * objects at all. Scenes with very many objects can create entities in the world directly and skip game objects.
+ */
 class GameObject {
 public:
 
@@ -21,9 +30,9 @@ public:
     explicit GameObject(ObjectId id);
 
     /**
-     * @brief Destroys the GameObject.
+     * @brief Destroys the GameObject, and its entity if it was added to a scene.
      */
-    virtual ~GameObject() = default;
+    virtual ~GameObject();
 
     /**
      * @brief Gets the unique ObjectId of this game object.
@@ -32,10 +41,10 @@ public:
     ObjectId getId() const { return _id; }
 
     /**
-     * @brief Sets the scene that owns this game object. This is called by the Scene when the game object is added to the scene.
+     * @brief Sets the scene that owns this game object and creates its entity in the scene's world. This is called by the Scene when the game object is added to the scene.
      * @param scene The scene that owns this game object. This is a non-owning pointer, as the scene owns its game objects.
      */
-    void setScene(Scene* scene) { _scene = scene; }
+    void setScene(Scene* scene);
 
     /**
      * @brief Gets the scene that owns this game object.
@@ -43,6 +52,12 @@ public:
      */
     Scene* getScene() const { return _scene; }
 
+    /**
+     * @brief Gets the entity holding this game object's components in the scene's world.
+     * @return The entity, or NULL_ENTITY if the game object hasn't been added to a scene.
+     */
+    Entity getEntity() const { return _entity; }
+
     /**
      * @brief Sets the parent game object for this game object. This establishes a parent-child relationship between the two game objects, but does not transfer ownership (the scene still owns all game objects).
      * @param gameObject The parent game object to set for this game object. This is a non-owning reference, as the scene owns all game objects.
@@ -50,40 +65,75 @@ public:
     void setParent(const GameObject& gameObject) { _parentId = gameObject.getId(); }
 
     /**
-     * @brief Adds a component of type T to this game object. The game object takes ownership of the component.
+     * @brief Adds a component of type T to this game object, stored in the scene's world. The game object must have been added to a scene.
      * @tparam T The type of component to add (must derive from Component).
      * @param args Arguments to forward to the constructor of the component.
-     * @return Pointer to the added component (owned by the game object).
+     * @return Pointer to the added component (owned by the world), valid until a component is next added to or removed from any entity.
      */
     template<typename T, typename... Args>
     T* addComponent(Args&&... args) {
         static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        T* rawPtr = component.get();
-        rawPtr->setGameObject(this);
-        _components.push_back(std::move(component));
-        return rawPtr;
+        LF_ASSERT_MSG(_scene, "Components can only be added once the game object is in a scene.");
+        T& component = getWorld().template addComponent<T>(_entity, std::forward<Args>(args)...);
+        component.setGameObject(this);
+        return &component;
     }
 
     /**
-     * @brief Gets the first component of type T attached to this game object.
+     * @brief Gets the component of type T attached to this game object.
      * @tparam T The type of component to get (must derive from Component).
-     * @return Pointer to the component of type T if found, or nullptr if not found.
+     * @return Pointer to the component of type T if found, or nullptr if not found. Valid until a component is next added to or removed from any entity.
      */
     template<typename T>
     T* getComponent() const {
         static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
-        for (const auto& component : _components) {
-            if (auto* typed = dynamic_cast<T*>(component.get())) {
-                return typed;
-            }
+        return _scene ? getWorld().template getComponent<T>(_entity) : nullptr;
+    }
+
+    /**
+     * @brief Checks whether this game object has a component of type T.
+     * @tparam T The type of component to check for.
+     * @return True if the game object has the component.
+     */
+    template<typename T>
+    bool hasComponent() const { return hasComponents<T>(); }
+
+    /**
+     * @brief Checks whether this game object has a component of every one of a set of types, with one mask test.
+     * @tparam Ts The types of component to check for.
+     * @return True if the game object has all of the components.
+     */
+    template<typename... Ts>
+    bool hasComponents() const {
+        return _scene && getWorld().template hasComponents<Ts...>(_entity);
+    }
+
+    /**
+     * @brief Removes the component of type T from this game object, if it has one.
+     * @tparam T The type of component to remove.
+     */
+    template<typename T>
+    void removeComponent() {
+        if (_scene) {
+            getWorld().template removeComponent<T>(_entity);
         }
-        return nullptr;
     }
 
     template<class T>
     T *addChild(T &&child);
 
+protected:
+
+    /**
+     * @brief Gets the world of the scene that owns this game object. Must only be called once it has been added to a scene.
+     */
+    World& getWorld() const;
+
+    /**
+     * @brief Called once the game object has been added to a scene and has an entity, so subclasses can add the components every object of their type has.
+     */
+    virtual void onAddedToScene() {}
+
 private:
     ObjectId _id = ObjectId::empty();
     ObjectId _parentId = ObjectId::empty();
@@ -91,5 +141,6 @@ private:
     // Non-owning pointer to the scene that owns this game object
     Scene* _scene = nullptr;
 
-    std::vector<std::unique_ptr<Component>> _components;
+    // Entity holding the components of this game object in the scene's world
+    Entity _entity = NULL_ENTITY;
 };
\ No newline at end of file
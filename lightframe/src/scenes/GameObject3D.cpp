@@ -10,4 +10,8 @@
 
 GameObject3D::GameObject3D() : GameObject(ObjectId()) {}
 
-GameObject3D::GameObject3D(ObjectId id) : GameObject(id) {}
\ No newline at end of file
+GameObject3D::GameObject3D(ObjectId id) : GameObject(id) {}
+
+void GameObject3D::onAddedToScene() {
+    getWorld().addComponent<Transform3D>(getEntity());
+}
\ No newline at end of file
@@ -31,6 +31,9 @@ struct Transform3D {
     }
 };
 
+/**
+ * @brief A game object placed in the world, whose Transform3D is stored as a component of its entity.
+ */
 class GameObject3D : public GameObject {
 public:
     /**
@@ -44,6 +47,18 @@ public:
      */
     explicit GameObject3D(ObjectId id);
 
-    Transform3D transform;
+    /**
+     * @brief Gets the transform of this object. Must only be called once it has been added to a scene.
+     * @return Reference to the transform (owned by the world), valid until a component is next added to or removed from any entity.
+     */
+    Transform3D& getTransform() { return *getWorld().getComponent<Transform3D>(getEntity()); }
+    const Transform3D& getTransform() const { return *getWorld().getComponent<Transform3D>(getEntity()); }
+
+protected:
+
+    /**
+     * @brief Gives the object's entity its transform.
+     */
+    void onAddedToScene() override;
 
 };
\ No newline at end of file
@@ -6,10 +6,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 PerspectiveCamera::PerspectiveCamera(ObjectId id) 
-    : GameObject3D(id), _settings(PerspectiveCameraSettings()) {}
+    : GameObject(id), _settings(PerspectiveCameraSettings()) {}
     
 PerspectiveCamera::PerspectiveCamera(ObjectId id, PerspectiveCameraSettings& settings)
-    : GameObject3D(id), _settings(settings) {}
+    : GameObject(id), _settings(settings) {}
     
 glm::mat4 PerspectiveCamera::buildViewProjectionMatrix() const {
     
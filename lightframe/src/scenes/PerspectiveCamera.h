@@ -12,7 +12,10 @@ struct PerspectiveCameraSettings {
     float farPlane = 100.0f;
 };
 
-class PerspectiveCamera final : public GameObject3D {
+/**
+ * @brief The camera a scene is viewed through. Cameras aren't entities in the scene's world, so hold their own transform.
+ */
+class PerspectiveCamera final : public GameObject {
 public:
     
     /**
@@ -36,6 +39,14 @@ public:
      * @return The combined view-projection matrix for this camera.
      */
     glm::mat4 buildViewProjectionMatrix() const;
+
+    /**
+     * @brief Gets the projection settings of this camera.
+     * @return const PerspectiveCameraSettings& The field of view, view dimensions and clipping planes.
+     */
+    const PerspectiveCameraSettings& getSettings() const { return _settings; }
+
+    Transform3D transform;
     
 private:
     PerspectiveCameraSettings _settings;
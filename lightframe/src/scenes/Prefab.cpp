@@ -0,0 +1,19 @@
+#include "Prefab.h"
+
+#include "SceneTemplates.h"
+#include "components/MeshRenderer.h"
+
+std::vector<GameObject3D*> Prefab::instantiate(Scene& scene, const glm::vec3& position) const {
+    std::vector<GameObject3D*> gameObjects;
+    gameObjects.reserve(_parts.size());
+
+    for (const PrefabPart& part : _parts) {
+        auto* gameObject = scene.addGameObject<GameObject3D>(ObjectId());
+        Transform3D& transform = gameObject->getTransform();
+        transform = part.transform;
+        transform.position += position;
+        gameObject->addComponent<MeshRenderer>(part.mesh, part.material);
+        gameObjects.push_back(gameObject);
+    }
+    return gameObjects;
+}
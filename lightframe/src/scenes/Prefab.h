@@ -0,0 +1,54 @@
+/**
+ * @file Prefab.h
+ * @author Justin McKay
+ * @brief A reusable object template: meshes and the materials they are drawn with, instantiated into scenes.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "GameObject3D.h"
+#include "rendering/Material.h"
+#include "rendering/Mesh.h"
+#include "resources/ResourceRef.h"
+
+#include <vector>
+
+class Scene;
+
+/**
+ * @brief One mesh of a prefab, drawn with a material at a transform relative to the prefab.
+ */
+struct PrefabPart {
+    ResourceRef<Mesh> mesh;             ///< Mesh to draw
+    ResourceRef<Material> material;     ///< Material to draw the mesh with
+    Transform3D transform;              ///< Transform relative to the prefab
+};
+
+class Prefab {
+public:
+    Prefab() = default;
+
+    /**
+     * @brief Adds a mesh to the prefab. The prefab keeps the mesh and material loaded for as long as it exists.
+     * @param part The mesh, material and transform of the part.
+     */
+    void addPart(PrefabPart part) { _parts.push_back(std::move(part)); }
+
+    /**
+     * @brief Gets the meshes of the prefab.
+     */
+    const std::vector<PrefabPart>& getParts() const { return _parts; }
+
+    /**
+     * @brief Adds a game object with a MeshRenderer to a scene for each part of the prefab.
+     * @param scene The scene to add the objects to.
+     * @param position The position of the prefab in the scene, added to that of each part.
+     * @return std::vector<GameObject3D*> The objects added, one per part (owned by the scene).
+     */
+    std::vector<GameObject3D*> instantiate(Scene& scene, const glm::vec3& position = glm::vec3(0.0f)) const;
+
+private:
+    // Meshes of the prefab
+    std::vector<PrefabPart> _parts;
+};
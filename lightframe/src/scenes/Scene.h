@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PerspectiveCamera.h"
+#include "World.h"
 
 #include <memory>
 #include <vector>
@@ -23,6 +24,13 @@ public:
      */
     const std::vector<std::unique_ptr<GameObject>>& getGameObjects() const { return _gameObjects; }
 
+    /**
+     * @brief Gets the world holding the entities of the scene and their components, including those of its game objects.
+     * @return Reference to the scene's world.
+     */
+    World& getWorld() { return _world; }
+    const World& getWorld() const { return _world; }
+
     template<class T, class ... Args>
     T *addGameObject(Args &&... args);
 
@@ -31,6 +39,9 @@ public:
     
 private:
     std::string _name;
+
+    // Entities and their components. Declared before the game objects, which destroy their entities as they go.
+    World _world;
     
     // Scene owns all game objects
     std::vector<std::unique_ptr<GameObject>> _gameObjects;
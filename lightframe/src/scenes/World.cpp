@@ -0,0 +1,121 @@
+#include "World.h"
+
+World::World() {
+    _emptyArchetype = findOrCreateArchetype(ComponentMask());
+}
+
+World::~World() {
+    // Archetypes destroy the components they still hold
+    _archetypes.clear();
+}
+
+Entity World::createEntity() {
+    const Entity entity = allocateEntity();
+    EntityRecord& record = _entities[getEntityIndex(entity)];
+    record.archetype = _emptyArchetype;
+    record.location = _emptyArchetype->allocateRow(entity);
+    return entity;
+}
+
+void World::destroyEntity(Entity entity) {
+    EntityRecord* record = findRecord(entity);
+    if (!record) {
+        return;
+    }
+
+    record->archetype->destroyRow(record->location);
+    if (const Entity moved = record->archetype->removeRow(record->location); moved != NULL_ENTITY) {
+        _entities[getEntityIndex(moved)].location = record->location;
+    }
+
+    // Bumping the generation makes the entity, and any copies of it still held, stale
+    record->archetype = nullptr;
+    record->generation = (record->generation + 1) & ENTITY_GENERATION_MASK;
+    if (record->generation == 0) {
+        record->generation = 1;
+    }
+    _freeIndices.push_back(getEntityIndex(entity));
+    --_entityCount;
+}
+
+bool World::isAlive(Entity entity) const {
+    return const_cast<World*>(this)->findRecord(entity) != nullptr;
+}
+
+World::EntityRecord* World::findRecord(Entity entity) {
+    const uint32_t index = getEntityIndex(entity);
+    if (index >= _entities.size()) {
+        return nullptr;
+    }
+    EntityRecord& record = _entities[index];
+    return record.archetype && record.generation == getEntityGeneration(entity) ? &record : nullptr;
+}
+
+Entity World::allocateEntity() {
+    uint32_t index;
+    if (!_freeIndices.empty()) {
+        index = _freeIndices.back();
+        _freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(_entities.size());
+        LF_ASSERT_MSG(index <= ENTITY_INDEX_MASK, "Too many entities in one world.");
+        _entities.emplace_back();
+    }
+    ++_entityCount;
+    return makeEntity(index, _entities[index].generation);
+}
+
+Archetype* World::findOrCreateArchetype(const ComponentMask& mask) {
+    if (auto it = _archetypesByMask.find(mask); it != _archetypesByMask.end()) {
+        return it->second;
+    }
+
+    Archetype* archetype = _archetypes.emplace_back(std::make_unique<Archetype>(mask)).get();
+    _archetypesByMask.emplace(mask, archetype);
+    return archetype;
+}
+
+Archetype* World::getAddTarget(Archetype* archetype, ComponentTypeId typeId) {
+    if (auto it = archetype->_addEdges.find(typeId); it != archetype->_addEdges.end()) {
+        return it->second;
+    }
+
+    Archetype* target = findOrCreateArchetype(ComponentMask(archetype->getMask()).set(typeId));
+    archetype->_addEdges.emplace(typeId, target);
+    target->_removeEdges.emplace(typeId, archetype);
+    return target;
+}
+
+Archetype* World::getRemoveTarget(Archetype* archetype, ComponentTypeId typeId) {
+    if (auto it = archetype->_removeEdges.find(typeId); it != archetype->_removeEdges.end()) {
+        return it->second;
+    }
+
+    Archetype* target = findOrCreateArchetype(ComponentMask(archetype->getMask()).reset(typeId));
+    archetype->_removeEdges.emplace(typeId, target);
+    target->_addEdges.emplace(typeId, archetype);
+    return target;
+}
+
+void World::moveEntity(EntityRecord& record, Archetype* target) {
+    Archetype* source = record.archetype;
+    const ArchetypeRow from = record.location;
+    const Entity entity = source->getEntities(from.chunk)[from.row];
+    const ArchetypeRow to = target->allocateRow(entity);
+
+    const std::vector<ComponentTypeId>& sourceTypes = source->getTypes();
+    for (size_t sourceColumn = 0; sourceColumn < sourceTypes.size(); ++sourceColumn) {
+        const ComponentTypeInfo& info = source->_columns[sourceColumn].info;
+        void* component = source->getComponent(from, sourceColumn);
+        if (const int targetColumn = target->findColumn(sourceTypes[sourceColumn]); targetColumn >= 0) {
+            info.moveConstruct(target->getComponent(to, static_cast<size_t>(targetColumn)), component);
+        }
+        info.destroy(component);
+    }
+
+    if (const Entity moved = source->removeRow(from); moved != NULL_ENTITY) {
+        _entities[getEntityIndex(moved)].location = from;
+    }
+    record.archetype = target;
+    record.location = to;
+}
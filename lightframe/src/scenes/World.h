@@ -0,0 +1,311 @@
+/**
+ * @file World.h
+ * @author Justin McKay
+ * @brief Archetype-based entity component storage for a scene.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include "Archetype.h"
+#include "ComponentType.h"
+#include "Entity.h"
+#include "debug/Assertions.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Owns a scene's entities and their components.
+ *
+ * Entities are 32-bit generational IDs with no storage of their own. Their components live in archetypes, one per
+ * distinct set of component types, where each type is a contiguous array within fixed-size chunks. Queries visit
+ * the archetypes holding every requested type and hand over those arrays, so iterating a million entities streams
+ * through memory rather than chasing a pointer per object and per component.
+ *
+ * Adding or removing a component moves the entity's components to the archetype for its new set of types, so
+ * references to components are only valid until the next component is added to or removed from any entity, or an
+ * entity is destroyed. Hold the entity, not the reference. The world is not thread-safe.
+ */
+class World {
+public:
+    World();
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /**
+     * @brief Creates an entity with no components.
+     * @return Entity The new entity.
+     */
+    Entity createEntity();
+
+    /**
+     * @brief Creates an entity with a set of components, storing it directly in the archetype for their types.
+     * Cheaper than adding the components one at a time, which moves the entity once per component.
+     * @tparam Ts The component types, each at most once.
+     * @param components The components, moved into the world.
+     * @return Entity The new entity.
+     */
+    template<typename... Ts>
+    Entity createEntity(Ts&&... components);
+
+    /**
+     * @brief Destroys an entity and its components. Stale entities are ignored.
+     * @param entity The entity to destroy.
+     */
+    void destroyEntity(Entity entity);
+
+    /**
+     * @brief Checks whether an entity exists in this world.
+     */
+    bool isAlive(Entity entity) const;
+
+    /**
+     * @brief Gets the number of live entities.
+     */
+    size_t getEntityCount() const { return _entityCount; }
+
+    /**
+     * @brief Adds a component to an entity, replacing any it already has of the same type.
+     * @tparam T The component type.
+     * @param entity The entity.
+     * @param args Arguments to forward to the constructor of the component.
+     * @return T& The component, valid until the next structural change.
+     */
+    template<typename T, typename... Args>
+    T& addComponent(Entity entity, Args&&... args);
+
+    /**
+     * @brief Removes a component from an entity, if it has one.
+     * @tparam T The component type.
+     * @param entity The entity.
+     */
+    template<typename T>
+    void removeComponent(Entity entity);
+
+    /**
+     * @brief Gets a component of an entity.
+     * @tparam T The component type.
+     * @param entity The entity.
+     * @return T* The component, or nullptr if the entity doesn't have one or isn't alive.
+     */
+    template<typename T>
+    T* getComponent(Entity entity);
+
+    template<typename T>
+    const T* getComponent(Entity entity) const { return const_cast<World*>(this)->getComponent<T>(entity); }
+
+    /**
+     * @brief Checks whether an entity has a component.
+     */
+    template<typename T>
+    bool hasComponent(Entity entity) const { return hasComponents<T>(entity); }
+
+    /**
+     * @brief Checks whether an entity has every one of a set of components, with one mask test.
+     * @tparam Ts The component types.
+     * @param entity The entity.
+     * @return bool Whether the entity is alive and has all of the components.
+     */
+    template<typename... Ts>
+    bool hasComponents(Entity entity) const;
+
+    /**
+     * @brief Visits, a chunk at a time, the entities that have every one of a set of component types.
+     *
+     * The callback receives the number of entities in the chunk, their IDs, and a pointer to the start of each
+     * requested component array, so it can loop over raw arrays. The callback must not add or remove components or
+     * entities.
+     *
+     * @tparam Ts The component types.
+     * @param callback Called as callback(size_t count, const Entity* entities, Ts*... components).
+     */
+    template<typename... Ts, typename Callback>
+    void forEachChunk(Callback&& callback);
+
+    template<typename... Ts, typename Callback>
+    void forEachChunk(Callback&& callback) const;
+
+    /**
+     * @brief Visits each entity that has every one of a set of component types.
+     * @tparam Ts The component types.
+     * @param callback Called as callback(Entity entity, Ts&... components). Must not add or remove components or
+     * entities.
+     */
+    template<typename... Ts, typename Callback>
+    void forEach(Callback&& callback);
+
+    template<typename... Ts, typename Callback>
+    void forEach(Callback&& callback) const;
+
+private:
+
+    /**
+     * @brief The archetype and row holding an entity's components, and the generation of its slot.
+     */
+    struct EntityRecord {
+        Archetype* archetype = nullptr;
+        ArchetypeRow location;
+        uint32_t generation = 1;
+    };
+
+    /**
+     * @brief Gets the record of a live entity.
+     * @return EntityRecord* The record, or nullptr if the entity isn't alive.
+     */
+    EntityRecord* findRecord(Entity entity);
+
+    /**
+     * @brief Takes a free entity slot, or adds one.
+     */
+    Entity allocateEntity();
+
+    /**
+     * @brief Gets the archetype for a set of component types, creating it if this is the first entity to have them.
+     * @param mask The component types.
+     */
+    Archetype* findOrCreateArchetype(const ComponentMask& mask);
+
+    /**
+     * @brief Gets the archetype reached by adding or removing one component type, through the archetype's edge cache.
+     */
+    Archetype* getAddTarget(Archetype* archetype, ComponentTypeId typeId);
+    Archetype* getRemoveTarget(Archetype* archetype, ComponentTypeId typeId);
+
+    /**
+     * @brief Moves an entity's components to another archetype. Components the target doesn't have are destroyed,
+     * and components only the target has are left uninitialised for the caller to construct.
+     * @param record The record of the entity, updated with its new location.
+     * @param target The archetype to move to.
+     */
+    void moveEntity(EntityRecord& record, Archetype* target);
+
+    // Entity slots, indexed by entity index
+    std::vector<EntityRecord> _entities;
+
+    // Slots of destroyed entities, reused before new slots are added
+    std::vector<uint32_t> _freeIndices;
+
+    size_t _entityCount = 0;
+
+    // Every archetype created, in creation order
+    std::vector<std::unique_ptr<Archetype>> _archetypes;
+
+    // Archetypes by their component types
+    std::unordered_map<ComponentMask, Archetype*> _archetypesByMask;
+
+    // Archetype of entities with no components
+    Archetype* _emptyArchetype = nullptr;
+};
+
+template<typename... Ts>
+Entity World::createEntity(Ts&&... components) {
+    const ComponentMask mask = getComponentMask<std::decay_t<Ts>...>();
+    LF_ASSERT_MSG(mask.count() == sizeof...(Ts), "An entity can only have one component of each type.");
+
+    Archetype* archetype = findOrCreateArchetype(mask);
+    const Entity entity = allocateEntity();
+    EntityRecord& record = _entities[getEntityIndex(entity)];
+    record.archetype = archetype;
+    record.location = archetype->allocateRow(entity);
+
+    (new (archetype->getComponent(record.location, archetype->findColumn(getComponentTypeId<std::decay_t<Ts>>())))
+        std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+    return entity;
+}
+
+template<typename T, typename... Args>
+T& World::addComponent(Entity entity, Args&&... args) {
+    EntityRecord* record = findRecord(entity);
+    LF_ASSERT_MSG(record, "Adding a component to an entity that isn't alive.");
+
+    const ComponentTypeId typeId = getComponentTypeId<T>();
+    if (int column = record->archetype->findColumn(typeId); column >= 0) {
+        T& component = *static_cast<T*>(record->archetype->getComponent(record->location, column));
+        component = T(std::forward<Args>(args)...);
+        return component;
+    }
+
+    Archetype* target = getAddTarget(record->archetype, typeId);
+    moveEntity(*record, target);
+    return *new (target->getComponent(record->location, target->findColumn(typeId))) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void World::removeComponent(Entity entity) {
+    EntityRecord* record = findRecord(entity);
+    const ComponentTypeId typeId = getComponentTypeId<T>();
+    if (!record || record->archetype->findColumn(typeId) < 0) {
+        return;
+    }
+    moveEntity(*record, getRemoveTarget(record->archetype, typeId));
+}
+
+template<typename T>
+T* World::getComponent(Entity entity) {
+    EntityRecord* record = findRecord(entity);
+    if (!record) {
+        return nullptr;
+    }
+    const int column = record->archetype->findColumn(getComponentTypeId<T>());
+    return column >= 0 ? static_cast<T*>(record->archetype->getComponent(record->location, column)) : nullptr;
+}
+
+template<typename... Ts>
+bool World::hasComponents(Entity entity) const {
+    const EntityRecord* record = const_cast<World*>(this)->findRecord(entity);
+    return record && record->archetype->containsAll(getComponentMask<Ts...>());
+}
+
+template<typename... Ts, typename Callback>
+void World::forEachChunk(Callback&& callback) {
+    const ComponentMask mask = getComponentMask<Ts...>();
+    for (const std::unique_ptr<Archetype>& archetype : _archetypes) {
+        if (archetype->getEntityCount() == 0 || !archetype->containsAll(mask)) {
+            continue;
+        }
+
+        // Columns are looked up once per archetype, not per chunk or entity
+        const std::array<int, sizeof...(Ts)> columns = { archetype->findColumn(getComponentTypeId<Ts>())... };
+        for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+            std::apply([&](auto... columnIndices) {
+                callback(static_cast<size_t>(archetype->getRowCount(chunk)), static_cast<const Entity*>(archetype->getEntities(chunk)),
+                    static_cast<Ts*>(archetype->getColumn(chunk, static_cast<size_t>(columnIndices)))...);
+            }, columns);
+        }
+    }
+}
+
+template<typename... Ts, typename Callback>
+void World::forEachChunk(Callback&& callback) const {
+    const_cast<World*>(this)->forEachChunk<Ts...>([&](size_t count, const Entity* entities, Ts*... components) {
+        callback(count, entities, static_cast<const Ts*>(components)...);
+    });
+}
+
+template<typename... Ts, typename Callback>
+void World::forEach(Callback&& callback) {
+    forEachChunk<Ts...>([&](size_t count, const Entity* entities, Ts*... components) {
+        for (size_t i = 0; i < count; ++i) {
+            callback(entities[i], components[i]...);
+        }
+    });
+}
+
+template<typename... Ts, typename Callback>
+void World::forEach(Callback&& callback) const {
+    forEachChunk<Ts...>([&](size_t count, const Entity* entities, const Ts*... components) {
+        for (size_t i = 0; i < count; ++i) {
+            callback(entities[i], components[i]...);
+        }
+    });
+}
@@ -9,8 +9,11 @@
 #pragma once
 #include "Component.h"
 
+#include "debug/Assertions.h"
+
 #include "rendering/Mesh.h"
 #include "rendering/Material.h"
+#include "resources/ResourceRef.h"
 
 class MeshRenderer : public Component {
 public:
@@ -22,17 +25,31 @@ public:
      */
     MeshRenderer(Mesh* mesh, Material* material) : _mesh(mesh), _material(material) {}
 
+    /**
+     * @brief Constructs a MeshRenderer component that holds references to a mesh and material, keeping both loaded
+     * for as long as the component exists. References made from bare handles resolve to nothing, so must not be
+     * passed here.
+     * @param mesh Reference to the mesh to render, acquired from a resource manager.
+     * @param material Reference to the material to use for rendering, acquired from a resource manager.
+     */
+    MeshRenderer(ResourceRef<Mesh> mesh, ResourceRef<Material> material)
+        : _mesh(nullptr), _material(nullptr), _meshRef(std::move(mesh)), _materialRef(std::move(material)) {
+        LF_ASSERT_MSG((!_meshRef || _meshRef.isCounted()) && (!_materialRef || _materialRef.isCounted()),
+            "MeshRenderer needs counted references; acquire them from the ResourceManager.");
+    }
+
     /**
      * @brief Gets the mesh to render. This is a non-owning pointer, as the mesh is managed by a resource manager.
-     * @return Non-owning pointer to the mesh to render (owned by a resource manager).
+     * @return Non-owning pointer to the mesh to render (owned by a resource manager), or nullptr if it was unloaded.
      */
-    Mesh* getMesh() const { return _mesh; }
+    Mesh* getMesh() const { return _meshRef.isCounted() ? _meshRef.get() : _mesh; }
 
     /**
      * @brief Gets the material to use for rendering. This is a non-owning pointer, as the material is managed by a resource manager.
-     * @return Non-owning pointer to the material to use for rendering (owned by a resource manager).
+     * @return Non-owning pointer to the material to use for rendering (owned by a resource manager), or nullptr if
+     * it was unloaded.
      */
-    Material* getMaterial() const { return _material; }
+    Material* getMaterial() const { return _materialRef.isCounted() ? _materialRef.get() : _material; }
 
 private:
     // Non-owning pointer to the mesh to render (owned by a resource manager).
@@ -40,4 +57,10 @@ private:
 
     // Non-owning pointer to the material to use for rendering (owned by a resource manager).
     Material* _material;
+
+    // Reference to the mesh to render, when constructed from one
+    ResourceRef<Mesh> _meshRef;
+
+    // Reference to the material to use for rendering, when constructed from one
+    ResourceRef<Material> _materialRef;
 };
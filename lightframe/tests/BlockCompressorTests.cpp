@@ -0,0 +1,205 @@
+#include "Test.h"
+
+#include "assets/BlockCompressor.h"
+#include "rendering/Image.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using Pixel = std::array<uint8_t, 4>;
+
+static uint32_t readBits(const uint8_t* block, uint32_t& position, uint32_t count) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < count; ++i, ++position) {
+        value |= ((block[position / 8] >> (position % 8)) & 1u) << i;
+    }
+    return value;
+}
+
+/**
+ * @brief Decodes one pixel of a BC1 block, as a GPU would.
+ */
+static Pixel decodeBC1(const uint8_t* block, int pixel) {
+    const uint16_t packed[2] = { static_cast<uint16_t>(block[0] | block[1] << 8), static_cast<uint16_t>(block[2] | block[3] << 8) };
+    int colors[4][3];
+    for (int e = 0; e < 2; ++e) {
+        const int r = (packed[e] >> 11) & 31;
+        const int g = (packed[e] >> 5) & 63;
+        const int b = packed[e] & 31;
+        colors[e][0] = (r << 3) | (r >> 2);
+        colors[e][1] = (g << 2) | (g >> 4);
+        colors[e][2] = (b << 3) | (b >> 2);
+    }
+    for (int c = 0; c < 3; ++c) {
+        if (packed[0] > packed[1]) {
+            colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+            colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+        } else {
+            colors[2][c] = (colors[0][c] + colors[1][c]) / 2;
+            colors[3][c] = 0;
+        }
+    }
+
+    const uint32_t indices = block[4] | block[5] << 8 | block[6] << 16 | static_cast<uint32_t>(block[7]) << 24;
+    const int* color = colors[(indices >> (pixel * 2)) & 3];
+    return { static_cast<uint8_t>(color[0]), static_cast<uint8_t>(color[1]), static_cast<uint8_t>(color[2]), 255 };
+}
+
+/**
+ * @brief Decodes one value of a BC4 block.
+ */
+static uint8_t decodeBC4(const uint8_t* block, int pixel) {
+    const int endpoints[2] = { block[0], block[1] };
+    uint32_t position = 16 + pixel * 3;
+    const uint32_t index = readBits(block, position, 3);
+    if (index < 2) {
+        return static_cast<uint8_t>(endpoints[index]);
+    }
+    if (endpoints[0] > endpoints[1]) {
+        return static_cast<uint8_t>(((8 - index) * endpoints[0] + (index - 1) * endpoints[1]) / 7);
+    }
+    if (index >= 6) {
+        return index == 6 ? 0 : 255;
+    }
+    return static_cast<uint8_t>(((6 - index) * endpoints[0] + (index - 1) * endpoints[1]) / 5);
+}
+
+/**
+ * @brief Decodes one pixel of a BC7 block, which must be mode 6.
+ */
+static Pixel decodeBC7(const uint8_t* block, int pixel) {
+    static constexpr int WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    uint32_t position = 0;
+    LF_TEST_CHECK(readBits(block, position, 7) == 1u << 6);
+
+    int endpoints[2][4];
+    for (int c = 0; c < 4; ++c) {
+        endpoints[0][c] = static_cast<int>(readBits(block, position, 7));
+        endpoints[1][c] = static_cast<int>(readBits(block, position, 7));
+    }
+    for (int e = 0; e < 2; ++e) {
+        const int pBit = static_cast<int>(readBits(block, position, 1));
+        for (int c = 0; c < 4; ++c) {
+            endpoints[e][c] = endpoints[e][c] << 1 | pBit;
+        }
+    }
+
+    // The first index has an implied top bit of zero
+    uint32_t index = 0;
+    for (int i = 0; i <= pixel; ++i) {
+        index = readBits(block, position, i == 0 ? 3 : 4);
+    }
+
+    Pixel result;
+    for (int c = 0; c < 4; ++c) {
+        const int weight = WEIGHTS[index];
+        result[c] = static_cast<uint8_t>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+    }
+    return result;
+}
+
+static Image makeImage(uint32_t width, uint32_t height, const std::vector<Pixel>& pixels) {
+    std::vector<uint8_t> data;
+    for (const Pixel& pixel : pixels) {
+        data.insert(data.end(), pixel.begin(), pixel.end());
+    }
+    return Image::fromPixels(data.data(), width, height, 4, false);
+}
+
+static Image makeSolidImage(uint32_t width, uint32_t height, Pixel color) {
+    return makeImage(width, height, std::vector<Pixel>(static_cast<size_t>(width) * height, color));
+}
+
+/**
+ * @brief Decodes the pixel at (x, y) of the base level of a compressed image.
+ */
+static Pixel decodePixel(const Image& image, uint32_t x, uint32_t y) {
+    const uint32_t blocksWide = (image.width + 3) / 4;
+    const uint8_t* block = image.getMipData(0) + ((y / 4) * blocksWide + x / 4) * getBlockBytes(image.format);
+    const int pixel = static_cast<int>((y % 4) * 4 + x % 4);
+    switch (image.format) {
+        case ImageFormat::BC1: return decodeBC1(block, pixel);
+        case ImageFormat::BC4: return { decodeBC4(block, pixel), 0, 0, 255 };
+        case ImageFormat::BC7: return decodeBC7(block, pixel);
+        default: return {};
+    }
+}
+
+/**
+ * @brief Checks every pixel of a compressed image decodes to the source, in the channels the format stores.
+ */
+static void checkExact(const Image& compressed, const std::vector<Pixel>& pixels, int channelCount) {
+    LF_TEST_CHECK(!compressed.mips.empty());
+    if (compressed.mips.empty()) {
+        return;
+    }
+    for (uint32_t y = 0; y < compressed.height; ++y) {
+        for (uint32_t x = 0; x < compressed.width; ++x) {
+            const Pixel decoded = decodePixel(compressed, x, y);
+            const Pixel& expected = pixels[y * compressed.width + x];
+            for (int c = 0; c < channelCount; ++c) {
+                LF_TEST_CHECK(decoded[c] == expected[c]);
+            }
+        }
+    }
+}
+
+static void testSolidBC1() {
+    // Colours that RGB565 holds exactly
+    for (Pixel color : { Pixel { 0, 0, 0, 255 }, Pixel { 255, 255, 255, 255 }, Pixel { 132, 130, 132, 255 }, Pixel { 255, 0, 66, 255 } }) {
+        const Image compressed = compressImage(makeSolidImage(4, 4, color), ImageFormat::BC1);
+        checkExact(compressed, std::vector<Pixel>(16, color), 3);
+    }
+}
+
+static void testSolidBC4() {
+    for (int value = 0; value < 256; ++value) {
+        const Pixel color = { static_cast<uint8_t>(value), 0, 0, 255 };
+        const Image compressed = compressImage(makeSolidImage(4, 4, color), ImageFormat::BC4);
+        checkExact(compressed, std::vector<Pixel>(16, color), 1);
+    }
+}
+
+static void testSolidBC7() {
+    // Mode 6 endpoints hold 7 bits per channel plus a p-bit shared by the channels, so a single endpoint is exact for
+    // colours whose channels are all even or all odd
+    for (Pixel color : { Pixel { 0, 0, 0, 0 }, Pixel { 255, 255, 255, 255 }, Pixel { 200, 64, 12, 128 }, Pixel { 201, 77, 13, 255 } }) {
+        const Image compressed = compressImage(makeSolidImage(4, 4, color), ImageFormat::BC7);
+        checkExact(compressed, std::vector<Pixel>(16, color), 4);
+    }
+}
+
+static void testPartialBlocks() {
+    // Sizes that aren't a multiple of 4 get partial blocks at the right and bottom edges
+    for (auto [width, height] : { std::pair { 1u, 1u }, std::pair { 5u, 3u }, std::pair { 7u, 9u }, std::pair { 4u, 6u } }) {
+        for (ImageFormat format : { ImageFormat::BC1, ImageFormat::BC4, ImageFormat::BC7 }) {
+            // A colour each format holds exactly: RGB565 for BC1, and channels sharing a p-bit for BC7
+            const Pixel color = format == ImageFormat::BC7 ? Pixel { 201, 77, 13, 255 } : Pixel { 66, 130, 66, 255 };
+            const Image compressed = compressImage(makeSolidImage(width, height, color), format);
+            LF_TEST_CHECK(compressed.format == format);
+            LF_TEST_CHECK(compressed.width == width && compressed.height == height);
+            LF_TEST_CHECK(compressed.getMipCount() == 1);
+            LF_TEST_CHECK(compressed.data.size() == ((width + 3) / 4) * ((height + 3) / 4) * getBlockBytes(format));
+            checkExact(compressed, std::vector<Pixel>(static_cast<size_t>(width) * height, color), format == ImageFormat::BC4 ? 1 : 3);
+        }
+
+        // With two values per block, BC4 stores both exactly as its endpoints, so padding the edge must not add a third
+        std::vector<Pixel> checkerboard;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                checkerboard.push_back({ static_cast<uint8_t>((x + y) % 2 ? 30 : 220), 0, 0, 255 });
+            }
+        }
+        checkExact(compressImage(makeImage(width, height, checkerboard), ImageFormat::BC4), checkerboard, 1);
+    }
+}
+
+int main() {
+    testSolidBC1();
+    testSolidBC4();
+    testSolidBC7();
+    testPartialBlocks();
+    return finishTests();
+}
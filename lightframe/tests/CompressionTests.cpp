@@ -0,0 +1,146 @@
+#include "Test.h"
+
+#include "core/Compression.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Compresses data, checks it decompresses back exactly, and returns the compressed block.
+ */
+static std::vector<uint8_t> checkRoundTrip(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> compressed(getCompressBound(data.size()));
+    const size_t compressedSize = compressBlock(data, compressed);
+    LF_TEST_CHECK(compressedSize > 0);
+    compressed.resize(compressedSize);
+
+    std::vector<uint8_t> decompressed(data.size());
+    LF_TEST_CHECK(decompressBlock(compressed, decompressed));
+    LF_TEST_CHECK(decompressed == data);
+    return compressed;
+}
+
+static std::vector<uint8_t> randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return data;
+}
+
+static void testEmptyInput() {
+    const std::vector<uint8_t> compressed = checkRoundTrip({});
+
+    // An empty block still holds the final, empty run of literals
+    LF_TEST_CHECK(compressed.size() == 1);
+
+    std::vector<uint8_t> destination(1);
+    LF_TEST_CHECK(!decompressBlock(compressed, destination));
+    LF_TEST_CHECK(!decompressBlock({}, {}));
+}
+
+static void testLiteralsOnly() {
+    // Shorter than a match, and long enough to need extra length bytes
+    for (size_t size : { 1, 3, 14, 15, 16, 269, 270, 271, 4096 }) {
+        checkRoundTrip(randomBytes(size, static_cast<uint32_t>(size)));
+    }
+}
+
+static void testLiteralTail() {
+    // Matches up to a tail too short to match, which must come out as the final literals
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 64; ++i) {
+        data.insert(data.end(), { 'l', 'i', 'g', 'h', 't' });
+    }
+    for (size_t tail = 1; tail <= 20; ++tail) {
+        std::vector<uint8_t> withTail = data;
+        const std::vector<uint8_t> literals = randomBytes(tail, static_cast<uint32_t>(tail));
+        withTail.insert(withTail.end(), literals.begin(), literals.end());
+        checkRoundTrip(withTail);
+    }
+}
+
+static void testOverlappingMatches() {
+    // A run copies from one byte back, so every match overlaps the bytes it is writing
+    const std::vector<uint8_t> run(100000, 0x5A);
+    LF_TEST_CHECK(checkRoundTrip(run).size() < run.size() / 100);
+
+    // A short repeating pattern overlaps with an offset shorter than the match
+    for (size_t period : { 2, 3, 7 }) {
+        std::vector<uint8_t> pattern;
+        for (size_t i = 0; i < 5000; ++i) {
+            pattern.push_back(static_cast<uint8_t>('a' + i % period));
+        }
+        LF_TEST_CHECK(checkRoundTrip(pattern).size() < pattern.size() / 10);
+    }
+
+    // Repeats further back than the largest offset can't be matched, but must still round trip
+    std::vector<uint8_t> distant = randomBytes(70000, 1);
+    distant.insert(distant.end(), distant.begin(), distant.begin() + 1000);
+    checkRoundTrip(distant);
+}
+
+static void testTruncatedInput() {
+    std::vector<uint8_t> data = randomBytes(300, 2);
+    data.insert(data.end(), data.begin(), data.end());
+    const std::vector<uint8_t> compressed = checkRoundTrip(data);
+
+    std::vector<uint8_t> destination(data.size());
+    for (size_t size = 0; size < compressed.size(); ++size) {
+        LF_TEST_CHECK(!decompressBlock(std::span(compressed.data(), size), destination));
+    }
+}
+
+static void testWrongDestinationSize() {
+    const std::vector<uint8_t> data = randomBytes(1000, 3);
+    const std::vector<uint8_t> compressed = checkRoundTrip(data);
+
+    std::vector<uint8_t> tooSmall(data.size() - 1);
+    std::vector<uint8_t> tooLarge(data.size() + 1);
+    LF_TEST_CHECK(!decompressBlock(compressed, tooSmall));
+    LF_TEST_CHECK(!decompressBlock(compressed, tooLarge));
+}
+
+static void testCorruptInput() {
+    // A match reaching back before the start of the output
+    const uint8_t badOffset[] = { 0x10, 'x', 0x02, 0x00 };
+    std::vector<uint8_t> destination(5);
+    LF_TEST_CHECK(!decompressBlock(badOffset, destination));
+
+    // A zero offset
+    const uint8_t zeroOffset[] = { 0x10, 'x', 0x00, 0x00 };
+    LF_TEST_CHECK(!decompressBlock(zeroOffset, destination));
+
+    // A literal run longer than the input holds
+    const uint8_t shortLiterals[] = { 0x50, 'a', 'b' };
+    LF_TEST_CHECK(!decompressBlock(shortLiterals, destination));
+
+    // A length whose extra bytes run off the end of the input
+    const uint8_t unterminatedLength[] = { 0xF0, 255, 255 };
+    LF_TEST_CHECK(!decompressBlock(unterminatedLength, destination));
+
+    // Random damage must be rejected or decode without touching memory outside the buffers
+    std::vector<uint8_t> data = randomBytes(2000, 4);
+    data.insert(data.end(), data.begin(), data.begin() + 2000);
+    const std::vector<uint8_t> compressed = checkRoundTrip(data);
+    std::mt19937 random(5);
+    std::vector<uint8_t> output(data.size());
+    for (int i = 0; i < 1000; ++i) {
+        std::vector<uint8_t> damaged = compressed;
+        damaged[random() % damaged.size()] ^= static_cast<uint8_t>(1 + random() % 255);
+        decompressBlock(damaged, output);
+    }
+}
+
+int main() {
+    testEmptyInput();
+    testLiteralsOnly();
+    testLiteralTail();
+    testOverlappingMatches();
+    testTruncatedInput();
+    testWrongDestinationSize();
+    testCorruptInput();
+    return finishTests();
+}
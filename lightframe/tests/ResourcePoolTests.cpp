@@ -0,0 +1,140 @@
+#include "Test.h"
+
+#include "resources/ResourcePool.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+// Number of TrackedResources destroyed so far
+static int s_Destroyed = 0;
+
+/**
+ * @brief A resource that counts its destruction, so tests can see when the pool destroys it.
+ */
+struct TrackedResource {
+    int value = 0;
+
+    explicit TrackedResource(int value) : value(value) {}
+    ~TrackedResource() { ++s_Destroyed; }
+};
+
+static std::unique_ptr<TrackedResource> makeResource(int value) {
+    return std::make_unique<TrackedResource>(value);
+}
+
+static void testStaleHandles() {
+    ResourcePool<TrackedResource> pool;
+    const ResourceHandle first = pool.add(makeResource(1));
+    LF_TEST_CHECK(first != 0);
+    LF_TEST_CHECK(pool.contains(first));
+    LF_TEST_CHECK(pool.get(first)->value == 1);
+
+    LF_TEST_CHECK(pool.remove(first));
+    LF_TEST_CHECK(!pool.contains(first));
+    LF_TEST_CHECK(!pool.remove(first));
+    LF_TEST_CHECK(!pool.acquire(first));
+    LF_TEST_CHECK(pool.getRefCount(first) == 0);
+
+    // The slot is reused under a new generation, and the old handle still doesn't resolve
+    const ResourceHandle second = pool.add(makeResource(2));
+    LF_TEST_CHECK(getHandleIndex(second) == getHandleIndex(first));
+    LF_TEST_CHECK(second != first);
+    LF_TEST_CHECK(!pool.contains(first));
+    LF_TEST_CHECK(pool.get(second)->value == 2);
+    LF_TEST_CHECK(!pool.replace(first, makeResource(3)));
+    LF_TEST_CHECK(pool.get(second)->value == 2);
+
+    LF_TEST_CHECK(!pool.contains(0));
+    LF_TEST_CHECK(pool.size() == 1);
+}
+
+static void testFreeSlotsReusedInOrder() {
+    ResourcePool<TrackedResource> pool;
+    std::vector<ResourceHandle> handles;
+    for (int i = 0; i < 4; ++i) {
+        handles.push_back(pool.add(makeResource(i)));
+    }
+
+    // Freed slots come back in the order they were freed
+    pool.remove(handles[2]);
+    pool.remove(handles[0]);
+    pool.remove(handles[3]);
+    LF_TEST_CHECK(getHandleIndex(pool.add(makeResource(10))) == getHandleIndex(handles[2]));
+    LF_TEST_CHECK(getHandleIndex(pool.add(makeResource(11))) == getHandleIndex(handles[0]));
+    LF_TEST_CHECK(getHandleIndex(pool.add(makeResource(12))) == getHandleIndex(handles[3]));
+
+    // With no free slot left a new one is allocated
+    LF_TEST_CHECK(getHandleIndex(pool.add(makeResource(13))) == 4);
+    LF_TEST_CHECK(pool.size() == 5);
+}
+
+static void testGenerationsNeverWrap() {
+    ResourcePool<TrackedResource> pool;
+    const ResourceHandle first = pool.add(makeResource(0));
+    std::unordered_set<ResourceHandle> issued = { first };
+
+    // Churning one slot runs through its generations; once they are spent it is retired and a new slot used
+    ResourceHandle handle = first;
+    for (uint32_t i = 0; i < RESOURCE_HANDLE_GENERATION_MASK + 10; ++i) {
+        pool.remove(handle);
+        handle = pool.add(makeResource(static_cast<int>(i)));
+        LF_TEST_CHECK(handle != 0);
+        LF_TEST_CHECK(issued.insert(handle).second);
+        pool.reclaim();
+    }
+
+    LF_TEST_CHECK(!pool.contains(first));
+    LF_TEST_CHECK(getHandleIndex(handle) != getHandleIndex(first));
+    LF_TEST_CHECK(pool.size() == 1);
+}
+
+static void testReclaim() {
+    s_Destroyed = 0;
+    {
+        ResourcePool<TrackedResource> pool;
+        const ResourceHandle kept = pool.add(makeResource(1));
+        const ResourceHandle removed = pool.add(makeResource(2));
+
+        // Removed and replaced resources stay alive until reclaim(), so pointers from get() outlast the frame
+        TrackedResource* removedResource = pool.get(removed);
+        pool.remove(removed);
+        pool.replace(kept, makeResource(3));
+        LF_TEST_CHECK(s_Destroyed == 0);
+        LF_TEST_CHECK(removedResource->value == 2);
+        LF_TEST_CHECK(pool.get(kept)->value == 3);
+
+        pool.reclaim();
+        LF_TEST_CHECK(s_Destroyed == 2);
+        pool.reclaim();
+        LF_TEST_CHECK(s_Destroyed == 2);
+    }
+
+    // The pool destroys what it still holds
+    LF_TEST_CHECK(s_Destroyed == 3);
+}
+
+static void testReferenceCounts() {
+    ResourcePool<TrackedResource> pool;
+    const ResourceHandle handle = pool.add(makeResource(1));
+    LF_TEST_CHECK(pool.acquire(handle));
+    LF_TEST_CHECK(pool.acquire(handle));
+    LF_TEST_CHECK(pool.getRefCount(handle) == 2);
+    pool.release(handle);
+    LF_TEST_CHECK(pool.getRefCount(handle) == 1);
+
+    // Removing the resource drops its count with it, and releasing the stale handle is ignored
+    pool.remove(handle);
+    pool.release(handle);
+    const ResourceHandle reused = pool.add(makeResource(2));
+    LF_TEST_CHECK(pool.getRefCount(reused) == 0);
+}
+
+int main() {
+    testStaleHandles();
+    testFreeSlotsReusedInOrder();
+    testGenerationsNeverWrap();
+    testReclaim();
+    testReferenceCounts();
+    return finishTests();
+}
@@ -0,0 +1,37 @@
+/**
+ * @file Test.h
+ * @author Justin McKay
+ * @brief Minimal checks for the engine's ctest executables.
+ * @date 2026-03-18
+ */
+
+#pragma once
+
+#include <cstdio>
+
+// Number of checks that have failed so far in this test executable
+inline int s_TestFailures = 0;
+
+/**
+ * @brief Records a failure, with the expression and where it is, if a condition is false. Carries on either way, so
+ * one run reports every failing check.
+ */
+#define LF_TEST_CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+            ++s_TestFailures; \
+        } \
+    } while (0)
+
+/**
+ * @brief Reports the result of the test executable.
+ * @return int The exit code for ctest: 0 if every check passed.
+ */
+inline int finishTests() {
+    if (s_TestFailures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", s_TestFailures);
+        return 1;
+    }
+    return 0;
+}
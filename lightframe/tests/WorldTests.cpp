@@ -0,0 +1,276 @@
+#include "Test.h"
+
+#include "scenes/Archetype.h"
+#include "scenes/World.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A component that counts its live instances and flags any destroyed twice or moved from after destruction,
+ * so tests can check the world runs every constructor, move and destructor exactly once.
+ */
+struct Counted {
+    static constexpr uint32_t ALIVE = 0xA11CE;
+    static constexpr uint32_t DEAD = 0xDEAD;
+
+    static inline int s_Live = 0;
+    static inline int s_Errors = 0;
+
+    uint32_t state = ALIVE;
+    int value = 0;
+
+    explicit Counted(int value) : value(value) { ++s_Live; }
+
+    Counted(Counted&& other) noexcept : value(other.value) {
+        s_Errors += other.state != ALIVE;
+        ++s_Live;
+    }
+
+    Counted& operator=(Counted&& other) noexcept {
+        s_Errors += state != ALIVE || other.state != ALIVE;
+        value = other.value;
+        return *this;
+    }
+
+    ~Counted() {
+        s_Errors += state != ALIVE;
+        state = DEAD;
+        --s_Live;
+    }
+};
+
+/**
+ * @brief A component owning heap memory, which leaks or double frees if moves and destruction go wrong.
+ */
+struct Name {
+    std::string text;
+};
+
+/**
+ * @brief A large component, so only a few rows fit in a chunk and removals move rows across chunks.
+ */
+struct Payload {
+    std::array<uint8_t, 3000> bytes = {};
+    int id = 0;
+};
+
+/**
+ * @brief A small component, added and removed to move entities between archetypes.
+ */
+struct Tag {
+    int marker = 0;
+};
+
+static std::string nameOf(int value) {
+    return "entity number " + std::to_string(value) + ", long enough to live on the heap";
+}
+
+/**
+ * @brief Checks that an entity still holds the components it was created with.
+ */
+static void checkEntity(World& world, Entity entity, int value) {
+    LF_TEST_CHECK(world.isAlive(entity));
+    const Counted* counted = world.getComponent<Counted>(entity);
+    const Name* name = world.getComponent<Name>(entity);
+    const Payload* payload = world.getComponent<Payload>(entity);
+    LF_TEST_CHECK(counted && counted->value == value);
+    LF_TEST_CHECK(name && name->text == nameOf(value));
+    LF_TEST_CHECK(payload && payload->id == value && payload->bytes[value % 3000] == static_cast<uint8_t>(value));
+}
+
+static Entity createFull(World& world, int value) {
+    Payload payload;
+    payload.id = value;
+    payload.bytes[value % 3000] = static_cast<uint8_t>(value);
+    return world.createEntity(Counted(value), Name { nameOf(value) }, std::move(payload));
+}
+
+static void testCreateAndDestroy() {
+    Counted::s_Errors = 0;
+    {
+        World world;
+        std::vector<Entity> entities;
+        for (int i = 0; i < 100; ++i) {
+            entities.push_back(createFull(world, i));
+        }
+        LF_TEST_CHECK(world.getEntityCount() == 100);
+        LF_TEST_CHECK(Counted::s_Live == 100);
+
+        // Destroying from the front, middle and back swaps the last row into each hole, across chunks
+        std::vector<bool> destroyed(entities.size(), false);
+        for (size_t i : { size_t(0), size_t(99), size_t(50), size_t(1) }) {
+            world.destroyEntity(entities[i]);
+            destroyed[i] = true;
+        }
+        for (size_t i = 2; i < entities.size(); i += 3) {
+            if (!destroyed[i]) {
+                world.destroyEntity(entities[i]);
+                destroyed[i] = true;
+            }
+        }
+
+        int alive = 0;
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (destroyed[i]) {
+                LF_TEST_CHECK(!world.isAlive(entities[i]));
+                LF_TEST_CHECK(world.getComponent<Counted>(entities[i]) == nullptr);
+            } else {
+                checkEntity(world, entities[i], static_cast<int>(i));
+                ++alive;
+            }
+        }
+        LF_TEST_CHECK(world.getEntityCount() == static_cast<size_t>(alive));
+        LF_TEST_CHECK(Counted::s_Live == alive);
+
+        // Destroying a stale entity does nothing
+        world.destroyEntity(entities[0]);
+        LF_TEST_CHECK(world.getEntityCount() == static_cast<size_t>(alive));
+
+        // A reused slot gets a new generation, so the destroyed entity stays stale
+        const Entity reused = createFull(world, 1000);
+        LF_TEST_CHECK(reused != entities[1]);
+        LF_TEST_CHECK(!world.isAlive(entities[1]));
+        checkEntity(world, reused, 1000);
+    }
+
+    // The world destroys the components it still holds
+    LF_TEST_CHECK(Counted::s_Live == 0);
+    LF_TEST_CHECK(Counted::s_Errors == 0);
+}
+
+static void testAddAndRemove() {
+    Counted::s_Errors = 0;
+    {
+        World world;
+        const Entity entity = world.createEntity();
+        LF_TEST_CHECK(world.isAlive(entity));
+        LF_TEST_CHECK(!world.hasComponent<Counted>(entity));
+
+        world.addComponent<Counted>(entity, 5);
+        world.addComponent<Name>(entity, nameOf(5));
+        LF_TEST_CHECK(Counted::s_Live == 1);
+        LF_TEST_CHECK((world.hasComponents<Counted, Name>(entity)));
+
+        // Adding a type the entity already has replaces it in place
+        world.addComponent<Counted>(entity, 6);
+        LF_TEST_CHECK(Counted::s_Live == 1);
+        LF_TEST_CHECK(world.getComponent<Counted>(entity)->value == 6);
+
+        world.removeComponent<Counted>(entity);
+        LF_TEST_CHECK(Counted::s_Live == 0);
+        LF_TEST_CHECK(!world.hasComponent<Counted>(entity));
+        LF_TEST_CHECK(world.getComponent<Name>(entity)->text == nameOf(5));
+
+        // Removing a type the entity doesn't have does nothing
+        world.removeComponent<Counted>(entity);
+        LF_TEST_CHECK(world.getComponent<Name>(entity)->text == nameOf(5));
+
+        // Moving many entities back and forth between archetypes keeps every component with its entity
+        std::vector<Entity> entities;
+        for (int i = 0; i < 40; ++i) {
+            entities.push_back(createFull(world, i));
+        }
+        for (int pass = 0; pass < 3; ++pass) {
+            for (size_t i = pass % 2; i < entities.size(); i += 2) {
+                world.addComponent<Tag>(entities[i], static_cast<int>(i));
+            }
+            for (size_t i = 0; i < entities.size(); i += 3) {
+                world.removeComponent<Tag>(entities[i]);
+            }
+        }
+        for (size_t i = 0; i < entities.size(); ++i) {
+            checkEntity(world, entities[i], static_cast<int>(i));
+            if (const Tag* tag = world.getComponent<Tag>(entities[i])) {
+                LF_TEST_CHECK(tag->marker == static_cast<int>(i));
+            }
+        }
+        LF_TEST_CHECK(Counted::s_Live == 40);
+    }
+    LF_TEST_CHECK(Counted::s_Live == 0);
+    LF_TEST_CHECK(Counted::s_Errors == 0);
+}
+
+static void testForEach() {
+    World world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 30; ++i) {
+        entities.push_back(createFull(world, i));
+        if (i % 2 == 0) {
+            world.addComponent<Tag>(entities.back(), i);
+        }
+    }
+
+    // Entities in both archetypes are visited, each once, with its own components
+    int visited = 0;
+    int valueSum = 0;
+    world.forEach<Counted, Name>([&](Entity entity, Counted& counted, Name& name) {
+        LF_TEST_CHECK(name.text == nameOf(counted.value));
+        LF_TEST_CHECK(entity == entities[static_cast<size_t>(counted.value)]);
+        ++visited;
+        valueSum += counted.value;
+    });
+    LF_TEST_CHECK(visited == 30);
+    LF_TEST_CHECK(valueSum == 29 * 30 / 2);
+
+    int tagged = 0;
+    world.forEach<Tag, Counted>([&](Entity, Tag& tag, Counted& counted) {
+        LF_TEST_CHECK(tag.marker == counted.value);
+        ++tagged;
+    });
+    LF_TEST_CHECK(tagged == 15);
+
+    size_t chunkRows = 0;
+    world.forEachChunk<Payload>([&](size_t count, const Entity*, Payload*) {
+        LF_TEST_CHECK(count > 0);
+        chunkRows += count;
+    });
+    LF_TEST_CHECK(chunkRows == 30);
+
+    // Emptied chunks are freed, so nothing is left to visit
+    for (Entity entity : entities) {
+        world.destroyEntity(entity);
+    }
+    int chunks = 0;
+    world.forEachChunk<Counted>([&](size_t, const Entity*, Counted*) { ++chunks; });
+    LF_TEST_CHECK(chunks == 0);
+    LF_TEST_CHECK(world.getEntityCount() == 0);
+}
+
+static void testChunksFreed() {
+    Archetype archetype(getComponentMask<Payload>());
+    const size_t column = static_cast<size_t>(archetype.findColumn(getComponentTypeId<Payload>()));
+    const uint32_t capacity = archetype.getChunkCapacity();
+    LF_TEST_CHECK(capacity > 1);
+
+    // Fill one chunk and spill a row into a second
+    std::vector<ArchetypeRow> rows;
+    for (uint32_t i = 0; i <= capacity; ++i) {
+        rows.push_back(archetype.allocateRow(makeEntity(i, 1)));
+        Payload* payload = new (archetype.getComponent(rows.back(), column)) Payload();
+        payload->id = static_cast<int>(i);
+    }
+    LF_TEST_CHECK(archetype.getChunkCount() == 2);
+
+    // Removing the first row moves the spilled row back into the first chunk and frees the second
+    archetype.destroyRow(rows[0]);
+    LF_TEST_CHECK(archetype.removeRow(rows[0]) == makeEntity(capacity, 1));
+    LF_TEST_CHECK(archetype.getChunkCount() == 1);
+    LF_TEST_CHECK(static_cast<Payload*>(archetype.getComponent(rows[0], column))->id == static_cast<int>(capacity));
+
+    // Removing the last row moves nothing
+    const ArchetypeRow last { 0, capacity - 1 };
+    archetype.destroyRow(last);
+    LF_TEST_CHECK(archetype.removeRow(last) == NULL_ENTITY);
+    LF_TEST_CHECK(archetype.getEntityCount() == capacity - 1);
+}
+
+int main() {
+    testCreateAndDestroy();
+    testAddAndRemove();
+    testForEach();
+    testChunksFreed();
+    return finishTests();
+}
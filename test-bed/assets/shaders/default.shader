@@ -8,10 +8,12 @@ out vec3 vColor;
 out vec2 vTexCoord;
 
 uniform mat4 uTransform;
+// Scale (xy) and offset (zw) into the material's region of an atlas
+uniform vec4 uUvTransform = vec4(1.0, 1.0, 0.0, 0.0);
 
 void main() {
     vColor = color;
-    vTexCoord = texCoord;
+    vTexCoord = texCoord * uUvTransform.xy + uUvTransform.zw;
     gl_Position = uTransform * vec4(position, 1.0);
 }
 
@@ -29,5 +31,10 @@ uniform sampler2D uTexture2;
 void main() {
     //FragColor = vec4(vColor, 1.0);
     FragColor = texture(uTexture1, vTexCoord);
+#ifdef ALPHA_TEST
+    if (FragColor.a < 0.5) {
+        discard;
+    }
+#endif
     //FragColor = mix(texture(uTexture1, vTexCoord), texture(uTexture2, vTexCoord), 0.5);
 }
\ No newline at end of file
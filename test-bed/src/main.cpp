@@ -4,6 +4,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Window.h"
+#include "core/Logger.h"
 #include "resources/ResourceManager.h"
 #include "rendering/Material.h"
 #include "rendering/Mesh.h"
@@ -36,36 +37,48 @@ int main() {
         .vSyncEnabled = true
     });
     
+    // Declared before the scene, so the references its components hold are released first
+    ResourceManager resourceManager;
+
     Scene scene = Scene("main_level");
     scene.worldCamera.transform.position = glm::vec3(0.0f, -3.5f, 3.5f);
     
-    ResourceManager resourceManager;
-    ShaderHandle shaderHndl = resourceManager.load<Shader>("/home/justin/Development/lightframe-engine/test-bed/assets/shaders/default.shader", "default");
-    TextureHandle textureHndl = resourceManager.load<Texture2D>("/home/justin/Pictures/wallhaven-5g2y73.jpg", "frog_man");
+    ShaderHandle shaderHndl = resourceManager.loadAsync<Shader>("/home/justin/Development/lightframe-engine/test-bed/assets/shaders/default.shader", "default");
+    TextureHandle textureHndl = resourceManager.loadAsync<Texture2D>("/home/justin/Pictures/wallhaven-5g2y73.jpg", "frog_man");
+    resourceManager.onLoaded<Shader>(shaderHndl, [](ResourceHandle, bool loaded) {
+        LOG_INFO("Default shader {}.", loaded ? "ready" : "failed to load");
+        Shader::logCacheStats();
+    });
+#ifdef DEBUG
+    resourceManager.setShaderHotReloadEnabled(true);
+#endif
     
     std::unique_ptr<Renderer> renderer = Renderer::create(resourceManager);
     
-    Mesh cubeMesh = Mesh::createCubeMesh();
-    Mesh sphereMesh = Mesh::createSphereMesh(12 , 12);
+    ResourceHandle cubeMesh = resourceManager.add(std::make_unique<Mesh>(Mesh::createCubeMesh()), "cube");
+    ResourceHandle sphereMesh = resourceManager.add(std::make_unique<Mesh>(Mesh::createSphereMesh(12 , 12)), "sphere");
     
-    Material material;
-    material.addShader(RenderPass::Geometry, shaderHndl);
-    material.setDiffuseMap(textureHndl);
+    ResourceHandle material = resourceManager.add(std::make_unique<Material>(), "default_material");
+    resourceManager.get<Material>(material).addShader(RenderPass::Geometry, resourceManager.acquire<Shader>(shaderHndl));
+    resourceManager.get<Material>(material).setDiffuseMap(resourceManager.acquire<Texture2D>(textureHndl));
+
+    // Keep unused textures within 256 MB of video memory
+    resourceManager.setMemoryBudget<Texture2D>(ResourceMemoryBudget { .gpuBytes = 256ull * 1024 * 1024 });
 
     auto* player = scene.addGameObject<GameObject3D>(ObjectId());
-    player->transform.position = glm::vec3(0.0f, 0.0f, 0.0f);
-    player->transform.rotation = glm::vec3(0.0f, 0.0f, 0.0f);
-    scene.getGameObjects()[0]->addComponent<MeshRenderer>(&cubeMesh, &material);
+    player->getTransform().position = glm::vec3(0.0f, 0.0f, 0.0f);
+    player->getTransform().rotation = glm::vec3(0.0f, 0.0f, 0.0f);
+    scene.getGameObjects()[0]->addComponent<MeshRenderer>(resourceManager.acquire<Mesh>(cubeMesh), resourceManager.acquire<Material>(material));
 
     auto* player2 = scene.addGameObject<GameObject3D>(ObjectId());
-    player2->transform.position = glm::vec3(2.0f, -1.0f, 0.0f);
-    player2->transform.rotation = glm::vec3(45.0f, 45.0f, 0.0f);
-    scene.getGameObjects()[1]->addComponent<MeshRenderer>(&cubeMesh, &material);
+    player2->getTransform().position = glm::vec3(2.0f, -1.0f, 0.0f);
+    player2->getTransform().rotation = glm::vec3(45.0f, 45.0f, 0.0f);
+    scene.getGameObjects()[1]->addComponent<MeshRenderer>(resourceManager.acquire<Mesh>(cubeMesh), resourceManager.acquire<Material>(material));
 
     auto* player3 = scene.addGameObject<GameObject3D>(ObjectId());
-    player3->transform.position = glm::vec3(-2.0f, 1.0f, 0.0f);
-    player3->transform.rotation = glm::vec3(0.0f, 0.0f, 0.0f);
-    scene.getGameObjects()[2]->addComponent<MeshRenderer>(&sphereMesh, &material);
+    player3->getTransform().position = glm::vec3(-2.0f, 1.0f, 0.0f);
+    player3->getTransform().rotation = glm::vec3(0.0f, 0.0f, 0.0f);
+    scene.getGameObjects()[2]->addComponent<MeshRenderer>(resourceManager.acquire<Mesh>(sphereMesh), resourceManager.acquire<Material>(material));
 
     // Main Application Loop
     while (!window.shouldClose()) {
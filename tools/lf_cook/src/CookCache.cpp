@@ -0,0 +1,47 @@
+#include "CookCache.h"
+
+#include "core/Hash.h"
+#include "core/Logger.h"
+
+#include <fstream>
+#include <map>
+
+void CookCache::load(const std::string& manifestPath) {
+    _keys.clear();
+
+    std::ifstream file(manifestPath);
+    std::string line;
+    while (std::getline(file, line)) {
+        // Each line is the key in hex, a space, then the output path, which may itself contain spaces
+        const size_t separator = line.find(' ');
+        if (separator == std::string::npos || separator == 0) {
+            continue;
+        }
+
+        try {
+            _keys[line.substr(separator + 1)] = std::stoull(line.substr(0, separator), nullptr, 16);
+        } catch (const std::exception&) {
+            LOG_WARN("Ignoring invalid cook cache entry: {}", line);
+        }
+    }
+}
+
+bool CookCache::save(const std::string& manifestPath) const {
+    std::ofstream file(manifestPath, std::ios::trunc);
+    if (!file) {
+        LOG_WARN("Unable to write cook cache {}.", manifestPath);
+        return false;
+    }
+
+    // Sorted so the manifest diffs cleanly between cooks
+    const std::map<std::string, uint64_t> sorted(_keys.begin(), _keys.end());
+    for (const auto& [outputName, key] : sorted) {
+        file << hashToString(key) << ' ' << outputName << '\n';
+    }
+    return file.good();
+}
+
+bool CookCache::isUpToDate(const std::string& outputName, uint64_t key) const {
+    auto it = _keys.find(outputName);
+    return it != _keys.end() && it->second == key;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file CookCache.h
+ * @author Justin McKay
+ * @brief Records the content hash each cooked output was built from, so unchanged sources are skipped.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Manifest of cooked outputs and the keys they were cooked from.
+ *
+ * A key hashes everything that affects an output: the source contents, including any files it includes, the cook
+ * settings and the cooker version. An output is up to date if it exists and was cooked from the same key.
+ */
+class CookCache {
+public:
+
+    /**
+     * @brief Reads the manifest. A missing manifest leaves the cache empty.
+     * @param manifestPath The path of the manifest file.
+     */
+    void load(const std::string& manifestPath);
+
+    /**
+     * @brief Writes the manifest.
+     * @param manifestPath The path of the manifest file.
+     * @return true if the manifest was written.
+     */
+    bool save(const std::string& manifestPath) const;
+
+    /**
+     * @brief Checks whether an output was cooked from the given key.
+     * @param outputName The path of the output, relative to the output directory.
+     * @param key The key of the source as it is now.
+     * @return true if the output does not need cooking again.
+     */
+    bool isUpToDate(const std::string& outputName, uint64_t key) const;
+
+    /**
+     * @brief Records the key an output was cooked from.
+     * @param outputName The path of the output, relative to the output directory.
+     * @param key The key of the source it was cooked from.
+     */
+    void update(const std::string& outputName, uint64_t key) { _keys[outputName] = key; }
+
+private:
+    // Key each output was cooked from, by output path
+    std::unordered_map<std::string, uint64_t> _keys;
+};
@@ -0,0 +1,290 @@
+#include "Cooker.h"
+
+#include "assets/AssetArchive.h"
+#include "assets/BlockCompressor.h"
+#include "assets/MeshFile.h"
+#include "assets/MeshImporter.h"
+#include "assets/MeshOptimizer.h"
+#include "assets/TextureFile.h"
+#include "core/Hash.h"
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "rendering/MipGenerator.h"
+#include "rendering/ShaderPreprocessor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+// Bump whenever the output of a cook changes, so every output is rebuilt
+static constexpr uint64_t COOKER_VERSION = 1;
+
+// Manifest of the keys every output was cooked from, kept in the output directory
+static constexpr const char* COOK_CACHE_NAME = ".lfcook";
+
+/**
+ * @brief Checks whether a texture holds tangent-space normals, by the usual "_n" or "_normal" suffix.
+ */
+static bool isNormalMap(const std::filesystem::path& path) {
+    const std::string stem = path.stem().string();
+    return stem.ends_with("_n") || stem.ends_with("_normal");
+}
+
+/**
+ * @brief Reads a whole file.
+ * @return true if the file was read.
+ */
+static bool readFileBytes(const std::filesystem::path& path, std::vector<uint8_t>& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+Cooker::Cooker(CookSettings settings) : _settings(std::move(settings)), _shaderPreprocessor(ShaderPreprocessor::get()) {}
+
+bool Cooker::run() {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::error_code error;
+    std::filesystem::create_directories(_settings.outputDirectory, error);
+    if (error) {
+        LOG_ERROR("Unable to create output directory {}: {}", _settings.outputDirectory.string(), error.message());
+        return false;
+    }
+
+    const std::string cachePath = (_settings.outputDirectory / COOK_CACHE_NAME).string();
+    if (!_settings.force) {
+        _cache.load(cachePath);
+    }
+
+    std::vector<CookItem> items = gatherSources();
+    LOG_INFO("Cooking {} sources from {}.", items.size(), _settings.sourceDirectory.string());
+
+    // One source per task; large textures spread their compression across the pool themselves
+    ThreadPool::get()->parallelFor(items.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            cookItem(items[i]);
+        }
+    });
+
+    size_t cooked = 0;
+    size_t skipped = 0;
+    size_t failed = 0;
+    for (const CookItem& item : items) {
+        if (item.failed) {
+            ++failed;
+        } else {
+            item.skipped ? ++skipped : ++cooked;
+            _cache.update(item.outputName, item.key);
+        }
+    }
+    _cache.save(cachePath);
+
+    const bool packed = _settings.archivePath.empty() || writeArchive(items);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    LOG_INFO("Cook finished in {:.2f}s: {} cooked, {} up to date, {} failed.", seconds, cooked, skipped, failed);
+    return failed == 0 && packed;
+}
+
+std::vector<Cooker::CookItem> Cooker::gatherSources() const {
+    std::vector<CookItem> items;
+
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(_settings.sourceDirectory, error);
+        it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (error || !it->is_regular_file()) {
+            continue;
+        }
+
+        const std::filesystem::path& source = it->path();
+        std::string extension = source.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        CookItem item;
+        item.source = source;
+        std::filesystem::path outputName = std::filesystem::relative(source, _settings.sourceDirectory);
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp") {
+            item.kind = AssetKind::Texture;
+            outputName.replace_extension(".lftex");
+        } else if (extension == ".shader") {
+            item.kind = AssetKind::Shader;
+        } else if (isImportableMesh(source.string())) {
+            item.kind = AssetKind::Mesh;
+            outputName.replace_extension(".lfmesh");
+        } else {
+            continue;
+        }
+
+        item.outputName = outputName.generic_string();
+        items.push_back(std::move(item));
+    }
+
+    // Sorted so cooks are reproducible whatever order the file system lists the sources in
+    std::sort(items.begin(), items.end(), [](const CookItem& a, const CookItem& b) { return a.outputName < b.outputName; });
+    return items;
+}
+
+void Cooker::cookItem(CookItem& item) const {
+    item.key = computeKey(item);
+    if (item.key == 0) {
+        LOG_WARN("Unable to read {}.", item.source.string());
+        item.failed = true;
+        return;
+    }
+
+    const std::filesystem::path outputPath = _settings.outputDirectory / item.outputName;
+    if (_cache.isUpToDate(item.outputName, item.key) && std::filesystem::exists(outputPath)) {
+        item.skipped = true;
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(outputPath.parent_path(), error);
+
+    bool cooked = false;
+    switch (item.kind) {
+        case AssetKind::Texture:
+            cooked = cookTexture(item, outputPath);
+            break;
+        case AssetKind::Shader:
+            cooked = cookShader(item, outputPath);
+            break;
+        case AssetKind::Mesh:
+            cooked = cookMesh(item, outputPath);
+            break;
+    }
+    if (!cooked) {
+        item.failed = true;
+        return;
+    }
+    LOG_INFO("Cooked {}", item.outputName);
+}
+
+bool Cooker::cookTexture(const CookItem& item, const std::filesystem::path& outputPath) const {
+    const bool normalMap = isNormalMap(item.source);
+
+    Image image;
+    if (!readImageFile(item.source.string(), !normalMap, image)) {
+        LOG_WARN("Unable to decode texture {}.", item.source.string());
+        return false;
+    }
+
+    generateMipChain(image, _settings.mipFilter);
+
+    const ImageFormat compression = normalMap ? ImageFormat::BC5 : _settings.colorCompression;
+    if (compression != ImageFormat::None) {
+        Image compressed = compressImage(image, compression);
+        if (compressed.data.empty()) {
+            LOG_WARN("Unable to compress texture {}.", item.source.string());
+            return false;
+        }
+        image = std::move(compressed);
+    }
+
+    return writeTextureFile(outputPath.string(), image);
+}
+
+bool Cooker::cookShader(const CookItem& item, const std::filesystem::path& outputPath) const {
+    const PreprocessedShader shader = _shaderPreprocessor->process(item.source.string());
+
+    // The driver isn't available to compile against, so check what can be checked without it
+    for (ShaderType stage : { ShaderType::Vertex, ShaderType::Fragment }) {
+        auto it = shader.sources.find(stage);
+        if (it == shader.sources.end() || it->second.empty()) {
+            LOG_WARN("Shader {} is missing its {} stage.", item.source.string(), stage == ShaderType::Vertex ? "vertex" : "fragment");
+            return false;
+        }
+        if (it->second.find("#version") == std::string::npos || it->second.find("main(") == std::string::npos) {
+            LOG_WARN("Shader {} has a {} stage without a #version line or main function.", item.source.string(),
+                stage == ShaderType::Vertex ? "vertex" : "fragment");
+            return false;
+        }
+    }
+
+    // Includes are already expanded, so the cooked shader needs no other files at runtime
+    std::ofstream file(outputPath, std::ios::trunc);
+    file << "//:vertex\n" << shader.sources.at(ShaderType::Vertex) << '\n';
+    file << "//:fragment\n" << shader.sources.at(ShaderType::Fragment) << '\n';
+    return file.good();
+}
+
+bool Cooker::cookMesh(const CookItem& item, const std::filesystem::path& outputPath) const {
+    MeshData mesh;
+    if (!importMesh(item.source.string(), mesh)) {
+        return false;
+    }
+
+    // Bounds are measured at full precision, before quantizing
+    optimizeVertexCache(mesh.indices, mesh.getVertexCount());
+    optimizeVertexFetch(mesh);
+    calculateMeshBounds(mesh);
+    return writeMeshFile(outputPath.string(), quantizeMesh(mesh));
+}
+
+uint64_t Cooker::computeKey(const CookItem& item) const {
+    uint64_t key = hashCombine(COOKER_VERSION, static_cast<uint64_t>(item.kind));
+
+    if (item.kind == AssetKind::Shader) {
+        // The preprocessed sources cover every included file, so editing an include recooks the shaders using it
+        const PreprocessedShader shader = _shaderPreprocessor->process(item.source.string());
+        if (shader.dependencies.empty()) {
+            return 0;
+        }
+        for (ShaderType stage : { ShaderType::Vertex, ShaderType::Fragment }) {
+            auto it = shader.sources.find(stage);
+            key = hashCombine(key, it != shader.sources.end() ? hash64(it->second) : 0);
+        }
+        return key;
+    }
+
+    std::vector<uint8_t> bytes;
+    if (!readFileBytes(item.source, bytes)) {
+        return 0;
+    }
+    key = hashCombine(key, hash64(bytes.data(), bytes.size()));
+
+    if (item.kind == AssetKind::Mesh) {
+        // A .gltf is usually only the scene description; the geometry lives in the buffers next to it
+        for (const std::string& dependency : getMeshImportDependencies(item.source.string())) {
+            if (!readFileBytes(dependency, bytes)) {
+                return 0;
+            }
+            key = hashCombine(key, hash64(bytes.data(), bytes.size()));
+        }
+        return key;
+    }
+
+    key = hashCombine(key, static_cast<uint64_t>(isNormalMap(item.source) ? ImageFormat::BC5 : _settings.colorCompression));
+    key = hashCombine(key, static_cast<uint64_t>(_settings.mipFilter));
+    return key;
+}
+
+bool Cooker::writeArchive(const std::vector<CookItem>& items) const {
+    std::vector<AssetArchiveEntry> entries;
+    entries.reserve(items.size());
+    for (const CookItem& item : items) {
+        if (item.failed) {
+            continue;
+        }
+
+        AssetArchiveEntry entry;
+        entry.name = item.outputName;
+        if (!readFileBytes(_settings.outputDirectory / item.outputName, entry.data)) {
+            LOG_WARN("Unable to read cooked file {} for packing.", item.outputName);
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    if (!writeAssetArchive(_settings.archivePath.string(), entries, _settings.archiveChunkSize)) {
+        return false;
+    }
+    LOG_INFO("Packed {} files into {}.", entries.size(), _settings.archivePath.string());
+    return true;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file Cooker.h
+ * @author Justin McKay
+ * @brief Converts a tree of source assets into runtime-ready files, in parallel and incrementally.
+ * @date 2026-03-17
+ */
+
+#pragma once
+
+#include "CookCache.h"
+
+#include "assets/AssetArchive.h"
+#include "rendering/Image.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+class ShaderPreprocessor;
+
+/**
+ * @brief Options for a cook.
+ */
+struct CookSettings {
+    std::filesystem::path sourceDirectory;              ///< Root of the source assets
+    std::filesystem::path outputDirectory;              ///< Root the cooked files are written under
+    std::filesystem::path archivePath;                  ///< .lfpak to pack the cooked files into, or empty for none
+    uint32_t archiveChunkSize = ASSET_ARCHIVE_CHUNK_SIZE; ///< Size of the chunks packed files are compressed in, or 0
+    ImageFormat colorCompression = ImageFormat::BC7;    ///< Format color textures are compressed to, or None
+    MipFilter mipFilter = MipFilter::Kaiser;            ///< Filter used to build texture mip chains
+    bool force = false;                                 ///< Cook every source even if its output is up to date
+};
+
+/**
+ * @brief Cooks every recognised source asset under a directory.
+ *
+ * Textures are decoded, mipped and block compressed into .lftex files, and shaders are preprocessed into single
+ * self-contained .shader files and checked for both stages, and OBJ and glTF meshes are reordered for the vertex
+ * cache and fetch, bounded and quantized into .lfmesh files. Sources are cooked in parallel on the engine thread pool.
+ * A manifest in the output directory records the content hash each output was cooked from, so a cook only redoes the
+ * sources that changed.
+ */
+class Cooker {
+public:
+
+    /**
+     * @brief Creates a cooker.
+     * @param settings The cook options.
+     */
+    explicit Cooker(CookSettings settings);
+
+    /**
+     * @brief Cooks the source directory and packs the results if an archive was requested.
+     * @return true if every source cooked successfully.
+     */
+    bool run();
+
+private:
+
+    /**
+     * @brief Kinds of source asset the cooker understands.
+     */
+    enum class AssetKind {
+        Texture,
+        Shader,
+        Mesh
+    };
+
+    /**
+     * @brief A source asset and what becomes of it.
+     */
+    struct CookItem {
+        std::filesystem::path source;
+        std::string outputName;
+        AssetKind kind;
+        uint64_t key = 0;
+        bool skipped = false;
+        bool failed = false;
+    };
+
+    // The cook options
+    CookSettings _settings;
+
+    // Keys the existing outputs were cooked from
+    CookCache _cache;
+
+    // Preprocessor shared by every shader cook, created before the cook spreads across the thread pool
+    ShaderPreprocessor* _shaderPreprocessor = nullptr;
+
+    /**
+     * @brief Finds every source the cooker recognises, with the path its output is written to.
+     */
+    std::vector<CookItem> gatherSources() const;
+
+    /**
+     * @brief Cooks a single source unless its output is up to date.
+     * @param item The source, updated with its key and whether it was skipped or failed.
+     */
+    void cookItem(CookItem& item) const;
+
+    /**
+     * @brief Decodes, mips and compresses a texture into a .lftex file.
+     * @return true if the texture was cooked.
+     */
+    bool cookTexture(const CookItem& item, const std::filesystem::path& outputPath) const;
+
+    /**
+     * @brief Writes preprocessed shader sources to a self-contained .shader file.
+     * @return true if the shader was cooked.
+     */
+    bool cookShader(const CookItem& item, const std::filesystem::path& outputPath) const;
+
+    /**
+     * @brief Imports, optimizes, measures and quantizes a mesh into a .lfmesh file.
+     * @return true if the mesh was cooked.
+     */
+    bool cookMesh(const CookItem& item, const std::filesystem::path& outputPath) const;
+
+    /**
+     * @brief Computes the key of a source from everything its output depends on.
+     * @param item The source.
+     * @return uint64_t The key, or 0 if the source could not be read.
+     */
+    uint64_t computeKey(const CookItem& item) const;
+
+    /**
+     * @brief Packs every cooked output into the archive.
+     * @param items The cooked sources.
+     * @return true if the archive was written.
+     */
+    bool writeArchive(const std::vector<CookItem>& items) const;
+};
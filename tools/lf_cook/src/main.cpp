@@ -0,0 +1,78 @@
+#include "Cooker.h"
+
+#include "core/Logger.h"
+
+#include <charconv>
+#include <string_view>
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage() {
+    LOG_INFO("Usage: lf_cook <source-dir> <output-dir> [--pack <archive.lfpak>] [--pack-chunk <KiB>|0] [--compression bc1|bc3|bc7|none] [--force]");
+}
+
+/**
+ * @brief Parses the chunk size packed files are compressed in, in KiB. 0 turns compression off.
+ * @return true if the size is 0 or between 16 and 1024 KiB.
+ */
+static bool parseChunkSize(std::string_view text, uint32_t& chunkSize) {
+    uint32_t kibibytes = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), kibibytes);
+    if (error != std::errc() || end != text.data() + text.size() || (kibibytes != 0 && (kibibytes < 16 || kibibytes > 1024))) {
+        return false;
+    }
+    chunkSize = kibibytes * 1024;
+    return true;
+}
+
+/**
+ * @brief Parses a texture compression option.
+ * @return true if the name is a known compression.
+ */
+static bool parseCompression(std::string_view name, ImageFormat& format) {
+    if (name == "bc1") {
+        format = ImageFormat::BC1;
+    } else if (name == "bc3") {
+        format = ImageFormat::BC3;
+    } else if (name == "bc7") {
+        format = ImageFormat::BC7;
+    } else if (name == "none") {
+        format = ImageFormat::None;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    CookSettings settings;
+    settings.sourceDirectory = argv[1];
+    settings.outputDirectory = argv[2];
+
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--force") {
+            settings.force = true;
+        } else if (option == "--pack" && i + 1 < argc) {
+            settings.archivePath = argv[++i];
+        } else if (option == "--pack-chunk" && i + 1 < argc && parseChunkSize(argv[i + 1], settings.archiveChunkSize)) {
+            ++i;
+        } else if (option == "--compression" && i + 1 < argc && parseCompression(argv[i + 1], settings.colorCompression)) {
+            ++i;
+        } else {
+            LOG_ERROR("Unknown option {}", option);
+            printUsage();
+            return 1;
+        }
+    }
+
+    Cooker cooker(std::move(settings));
+    return cooker.run() ? 0 : 1;
+}